@@ -0,0 +1,102 @@
+// Times CommandIndex searches over a synthetic palette of program, setting and channel entries,
+// typing each query one keystroke at a time as the palette does. Usage:
+// command_index_bench [entries] [query...]
+
+#include "core/command_index.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kResultLimit = 50;
+constexpr int kRepetitions = 51;
+
+const std::vector<std::string> kWords{
+    "alpha", "studio", "launcher", "python", "terminal", "editor", "player", "viewer", "monitor", "manager",
+    "system", "network", "audio", "video", "image", "office", "writer", "calc", "shell", "browser",
+    "mail", "chat", "notes", "tasks", "music", "photo", "code", "build", "debug", "server"};
+
+colony::CommandIndex BuildIndex(std::size_t count)
+{
+    std::mt19937 random{42};
+    std::uniform_int_distribution<std::size_t> word(0, kWords.size() - 1);
+    std::uniform_int_distribution<int> wordCount(1, 4);
+
+    colony::CommandIndex index;
+    index.Reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        colony::CommandEntry entry;
+        entry.kind = i % 10 == 0 ? colony::CommandKind::Setting : colony::CommandKind::Program;
+        for (int w = wordCount(random); w > 0; --w)
+        {
+            entry.title += (entry.title.empty() ? "" : " ") + kWords[word(random)];
+        }
+        entry.title += " " + std::to_string(i);
+        entry.id = "program_" + std::to_string(i);
+        entry.keywords = entry.id + " " + kWords[word(random)];
+        index.Add(std::move(entry));
+    }
+    return index;
+}
+
+// Median and worst time of each keystroke of `query`, the first against a cold index.
+void MeasureQuery(const colony::CommandIndex& index, const std::string& query)
+{
+    std::vector<std::vector<double>> samplesMs(query.size());
+    std::size_t matches = 0;
+    for (int repetition = 0; repetition < kRepetitions; ++repetition)
+    {
+        // An empty query drops the narrowing state, as reopening the palette does.
+        static_cast<void>(index.Search("", kResultLimit));
+        for (std::size_t length = 1; length <= query.size(); ++length)
+        {
+            const auto start = Clock::now();
+            matches = index.Search(std::string_view{query}.substr(0, length), kResultLimit).size();
+            samplesMs[length - 1].push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+    }
+
+    std::cout << "\"" << query << "\" (" << matches << " shown):";
+    for (std::size_t i = 0; i < query.size(); ++i)
+    {
+        auto& samples = samplesMs[i];
+        std::sort(samples.begin(), samples.end());
+        std::cout << ' ' << query.substr(0, i + 1) << '=' << samples[samples.size() / 2] << '/' << samples.back() << "ms";
+    }
+    std::cout << '\n';
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 50000;
+    std::vector<std::string> queries;
+    for (int i = 2; i < argc; ++i)
+    {
+        queries.emplace_back(argv[i]);
+    }
+    if (queries.empty())
+    {
+        queries = {"e", "sta", "pyth", "mus pl", "zq"};
+    }
+
+    const auto buildStart = Clock::now();
+    const colony::CommandIndex index = BuildIndex(count);
+    std::cout << count << " entries indexed in "
+              << std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count() << " ms\n";
+    std::cout << "keystroke=median/worst\n";
+    for (const auto& query : queries)
+    {
+        MeasureQuery(index, query);
+    }
+    return 0;
+}
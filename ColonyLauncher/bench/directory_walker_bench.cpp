@@ -0,0 +1,179 @@
+// Compares DirectoryWalker against the std::filesystem calls it replaced on a generated tree
+// of roughly 100k entries. Usage: directory_walker_bench [folders] [files-per-folder]
+
+#include "core/directory_walker.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double MeasureMs(const std::function<std::size_t()>& run, std::size_t& visited)
+{
+    const auto start = Clock::now();
+    visited = run();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void BuildTree(const std::filesystem::path& root, int folders, int filesPerFolder)
+{
+    for (int folder = 0; folder < folders; ++folder)
+    {
+        const auto folderPath = root / ("program-" + std::to_string(folder));
+        std::filesystem::create_directories(folderPath);
+        for (int file = 0; file < filesPerFolder; ++file)
+        {
+            const bool launcher = file == filesPerFolder - 1;
+            const auto filePath = folderPath / ("asset-" + std::to_string(file) + (launcher ? ".sh" : ".dat"));
+            std::ofstream{filePath} << 'x';
+            if (launcher)
+            {
+                std::filesystem::permissions(filePath, std::filesystem::perms::owner_exec, std::filesystem::perm_options::add);
+            }
+        }
+    }
+}
+
+// What the Add App dialog did per entry before: status, access and last_write_time.
+std::size_t FilesystemFullMetadata(const std::filesystem::path& root)
+{
+    std::size_t visited = 0;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end;
+         it.increment(ec))
+    {
+        std::error_code entryError;
+        const bool isDirectory = std::filesystem::is_directory(it->status(entryError));
+#if !defined(_WIN32)
+        if (!isDirectory)
+        {
+            static_cast<void>(::access(it->path().c_str(), X_OK));
+        }
+#endif
+        static_cast<void>(std::filesystem::last_write_time(it->path(), entryError));
+        ++visited;
+    }
+    return visited;
+}
+
+std::size_t WalkerFullMetadata(const std::filesystem::path& root)
+{
+    std::size_t visited = 0;
+    colony::WalkDirectoryTree(root, {.executable = true, .lastWriteTime = true}, [&](const auto&, auto&) {
+        ++visited;
+        return true;
+    });
+    return visited;
+}
+
+// What the `*` search needs before it knows whether a name matches.
+std::size_t FilesystemTypesOnly(const std::filesystem::path& root)
+{
+    std::size_t visited = 0;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end;
+         it.increment(ec))
+    {
+        std::error_code entryError;
+        static_cast<void>(it->is_directory(entryError));
+        ++visited;
+    }
+    return visited;
+}
+
+std::size_t WalkerTypesOnly(const std::filesystem::path& root)
+{
+    std::size_t visited = 0;
+    colony::WalkDirectoryTree(root, colony::DirectoryWalkOptions{}, [&](const auto&, auto&) {
+        ++visited;
+        return true;
+    });
+    return visited;
+}
+
+// The launch candidate search discovery runs in every program folder: regular files with their
+// exec bit.
+std::size_t FilesystemLaunchCandidates(const std::filesystem::path& root)
+{
+    std::size_t executables = 0;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator folder(root, ec), end; !ec && folder != end; folder.increment(ec))
+    {
+        for (std::filesystem::directory_iterator it(folder->path(), ec), fileEnd; !ec && it != fileEnd; it.increment(ec))
+        {
+            std::error_code entryError;
+            if (!it->is_regular_file(entryError))
+            {
+                continue;
+            }
+            const auto perms = it->status(entryError).permissions();
+            executables += static_cast<std::size_t>((perms & std::filesystem::perms::owner_exec) != std::filesystem::perms::none);
+        }
+    }
+    return executables;
+}
+
+std::size_t WalkerLaunchCandidates(const std::filesystem::path& root)
+{
+    std::size_t executables = 0;
+    std::error_code ec;
+    for (const auto& folder : colony::ListDirectory(root, colony::DirectoryWalkOptions{}, ec))
+    {
+        for (const auto& entry : colony::ListDirectory(root / folder.name, {.executable = true}, ec))
+        {
+            executables += static_cast<std::size_t>(entry.isExecutable);
+        }
+    }
+    return executables;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int folders = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int filesPerFolder = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    const auto root = std::filesystem::temp_directory_path() / "colony-directory-walker-bench";
+    std::filesystem::remove_all(root);
+    BuildTree(root, folders, filesPerFolder);
+    std::cout << "tree: " << folders << " folders x " << filesPerFolder << " files\n";
+
+    const struct
+    {
+        const char* name;
+        std::size_t (*filesystem)(const std::filesystem::path&);
+        std::size_t (*walker)(const std::filesystem::path&);
+    } cases[] = {
+        {"full metadata walk", FilesystemFullMetadata, WalkerFullMetadata},
+        {"types-only walk", FilesystemTypesOnly, WalkerTypesOnly},
+        {"launch candidates", FilesystemLaunchCandidates, WalkerLaunchCandidates},
+    };
+
+    for (const auto& benchCase : cases)
+    {
+        // Warm the dentry cache once so both sides measure the same thing.
+        benchCase.filesystem(root);
+        std::size_t filesystemCount = 0;
+        std::size_t walkerCount = 0;
+        const double filesystemMs = MeasureMs([&]() { return benchCase.filesystem(root); }, filesystemCount);
+        const double walkerMs = MeasureMs([&]() { return benchCase.walker(root); }, walkerCount);
+        std::cout << benchCase.name << ": std::filesystem " << filesystemMs << " ms, walker " << walkerMs << " ms ("
+                  << filesystemCount << " / " << walkerCount << ")\n";
+    }
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Times PathIndex builds and searches against the live walk the `*` search used before.
+// Usage: path_index_bench [root] [needle...]
+
+#include "core/directory_walker.hpp"
+#include "core/path_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// The previous `*` search: walk until 512 paths contain the needle.
+std::size_t WalkSearch(const std::filesystem::path& root, const std::string& needle)
+{
+    std::size_t matches = 0;
+    colony::WalkDirectoryTree(root, colony::DirectoryWalkOptions{}, [&](const std::filesystem::path& parent, auto& info) {
+        std::string path = (parent / info.name).string();
+        std::transform(path.begin(), path.end(), path.begin(), [](unsigned char ch) {
+            return static_cast<char>(std::tolower(ch));
+        });
+        matches += static_cast<std::size_t>(path.find(needle) != std::string::npos);
+        return matches < 512;
+    });
+    return matches;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::filesystem::path root = argc > 1 ? argv[1] : "/usr";
+    std::vector<std::string> needles;
+    for (int arg = 2; arg < argc; ++arg)
+    {
+        needles.emplace_back(argv[arg]);
+    }
+    if (needles.empty())
+    {
+        needles = {"python", "lib", "zzzz-no-match", "bin/py"};
+    }
+
+    const auto indexFile = std::filesystem::temp_directory_path() / "colony-path-index-bench.bin";
+
+    auto start = Clock::now();
+    if (!colony::PathIndex::Build(root, indexFile, nullptr, nullptr))
+    {
+        std::cerr << "build failed\n";
+        return 1;
+    }
+    std::cout << "full build: " << ElapsedMs(start) << " ms\n";
+
+    colony::PathIndex previous;
+    start = Clock::now();
+    if (!previous.Open(indexFile))
+    {
+        std::cerr << "open failed\n";
+        return 1;
+    }
+    std::cout << "open: " << ElapsedMs(start) << " ms, " << previous.Size() << " entries, "
+              << std::filesystem::file_size(indexFile) / 1024 << " KiB\n";
+
+    start = Clock::now();
+    colony::PathIndex::Build(root, indexFile, &previous, nullptr);
+    std::cout << "incremental rebuild: " << ElapsedMs(start) << " ms\n";
+
+    colony::PathIndex index;
+    index.Open(indexFile);
+    for (const auto& needle : needles)
+    {
+        start = Clock::now();
+        const std::size_t indexed = index.Search(needle).size();
+        const double indexMs = ElapsedMs(start);
+        start = Clock::now();
+        const std::size_t walked = WalkSearch(root, needle);
+        std::cout << '"' << needle << "\": index " << indexMs << " ms (" << indexed << " matches), walk "
+                  << ElapsedMs(start) << " ms (" << walked << " matches, capped at 512)\n";
+    }
+
+    std::filesystem::remove(indexFile);
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Compares ProcessLauncher against the std::system call on a detached thread that the Add App
+// launches used before, by starting a short-lived program many times and waiting until every
+// run has been reaped. Usage: process_launcher_bench [launches] [program]
+
+#include "core/process_launcher.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// One detached thread and one /bin/sh per launch, as LaunchUserApp did.
+double MeasureSystemMs(int launches, const std::string& program)
+{
+    std::atomic<int> finished{0};
+    const std::string command = "\"" + program + "\"";
+    const auto start = Clock::now();
+    for (int launch = 0; launch < launches; ++launch)
+    {
+        std::thread launcherThread([&finished, command]() {
+            static_cast<void>(std::system(command.c_str()));
+            ++finished;
+        });
+        launcherThread.detach();
+    }
+    while (finished.load() < launches)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double MeasureLauncherMs(int launches, const std::string& program, int& failures)
+{
+    colony::ProcessLauncher launcher;
+    int reaped = 0;
+    failures = 0;
+    const auto start = Clock::now();
+    for (int launch = 0; launch < launches; ++launch)
+    {
+        std::error_code ec;
+        if (launcher.Spawn({program}, "bench", ec) == 0)
+        {
+            ++failures;
+        }
+    }
+    while (reaped + failures < launches)
+    {
+        reaped += static_cast<int>(launcher.TakeExits().size());
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int launches = argc > 1 ? std::atoi(argv[1]) : 500;
+    const std::string program = argc > 2 ? argv[2] : "/bin/true";
+
+    int failures = 0;
+    const double systemMs = MeasureSystemMs(launches, program);
+    const double launcherMs = MeasureLauncherMs(launches, program, failures);
+    std::cout << launches << " launches of " << program << '\n';
+    std::cout << "std::system on detached threads: " << systemMs << " ms (" << launches * 1000.0 / systemMs
+              << " launches/s)\n";
+    std::cout << "ProcessLauncher: " << launcherMs << " ms (" << launches * 1000.0 / launcherMs << " launches/s";
+    if (failures > 0)
+    {
+        std::cout << ", " << failures << " failed to start";
+    }
+    std::cout << ")\n";
+    return 0;
+}
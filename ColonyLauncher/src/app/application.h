@@ -1,8 +1,21 @@
 #pragma once
 
+#include "app/frame_scheduler.hpp"
 #include "controllers/navigation_controller.hpp"
+#include "core/async_channel_discovery.hpp"
+#include "core/command_index.hpp"
+#include "core/directory_query.hpp"
+#include "core/discovery_watcher.hpp"
 #include "core/content.hpp"
+#include "core/hub_search_index.hpp"
+#include "core/launch_history.hpp"
+#include "core/launch_prefetcher.hpp"
+#include "core/launch_telemetry.hpp"
 #include "core/localization_manager.hpp"
+#include "core/path_index_updater.hpp"
+#include "core/process_launcher.hpp"
+#include "core/resource_monitor.hpp"
+#include "core/window_watcher.hpp"
 #include "frontend/models/library_view_model.hpp"
 #include "frontend/utils/debounce.hpp"
 #include "input/input_handlers.hpp"
@@ -22,6 +35,9 @@
 #include "ui/program_visuals.hpp"
 #include "ui/settings_panel.hpp"
 #include "ui/theme.hpp"
+#include "utils/draw_list.hpp"
+#include "utils/frame_invalidator.hpp"
+#include "utils/glyph_atlas.hpp"
 #include "utils/sdl_wrappers.hpp"
 #include "utils/text.hpp"
 #include "views/view_factory.hpp"
@@ -31,7 +47,9 @@
 #include <SDL2/SDL_ttf.h>
 
 #include <array>
+#include <chrono>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -48,6 +66,9 @@ class Application
     int Run();
     void ShowHub();
     void EnterMainInterface();
+    void Invalidate() noexcept;
+    void RequestFrame() noexcept;
+    [[nodiscard]] const DrawListStats& LastFrameDrawStats() const noexcept { return lastFrameDrawStats_; }
 
     static constexpr std::string_view kLocalAppsChannelId = "local_apps";
     static constexpr std::string_view kLocalAppsChannelLabel = "Local Apps";
@@ -76,6 +97,7 @@ class Application
         sdl::FontHandle status;
     };
 
+    friend class input::CommandPaletteInputHandler;
     friend class input::NavigationInputHandler;
     friend class input::HubInputHandler;
     friend class input::DialogInputHandler;
@@ -91,7 +113,9 @@ class Application
     void InitializeViews();
     void InitializeInputRouter();
     void RebuildTheme();
+    void RebuildNavigationRail();
     void RebuildProgramVisuals();
+    void UpdateProgramVisuals(const std::string& programId);
     void ActivateChannel(int index);
     void ActivateProgram(const std::string& programId);
     void ActivateProgramInChannel(int programIndex);
@@ -99,6 +123,10 @@ class Application
     int EnsureLocalAppsChannel();
     [[nodiscard]] std::string GetActiveProgramId() const;
     bool UpdateCustomizationValueFromPosition(const std::string& id, int mouseX);
+    [[nodiscard]] bool IsReducedMotionEnabled() const;
+    [[nodiscard]] bool HasActiveAnimations() const;
+    [[nodiscard]] int ComputeIdleWaitTimeoutMs() const;
+    [[nodiscard]] int ComputeFrameWaitTimeoutMs(double nowSeconds) const;
     void RenderFrame(double deltaSeconds);
     void RenderHubFrame(double deltaSeconds);
     void RenderMainInterfaceFrame(double deltaSeconds);
@@ -110,6 +138,7 @@ class Application
     [[nodiscard]] float GetAppearanceCustomizationValue(std::string_view id) const;
     void QueueLibraryFilterUpdate();
     void BuildHubPanel();
+    void UpdateHubSearchResults();
     void HandleHubMouseClick(int x, int y);
     void HandleHubMouseMotion(const SDL_MouseMotionEvent& motion);
     void HandleHubMouseWheel(const SDL_MouseWheelEvent& wheel);
@@ -118,8 +147,6 @@ class Application
     void ActivateHubBranchByIndex(int index);
     [[nodiscard]] int FindHubBranchIndexById(const std::string& branchId) const;
     void ResetHubInteractionState();
-    [[nodiscard]] std::string NormalizeHubSearchString(std::string_view value) const;
-    [[nodiscard]] std::vector<std::string> TokenizeHubSearch(std::string_view value) const;
     void EnsureHubScrollWithinBounds();
     void FocusHubSearch();
     void ClearHubSearchQuery();
@@ -130,14 +157,25 @@ class Application
 
     [[nodiscard]] static std::filesystem::path ResolveContentPath();
     [[nodiscard]] static std::filesystem::path ResolveLocalizationDirectory();
+    [[nodiscard]] static std::filesystem::path ResolvePrefFilePath(std::string_view fileName);
     [[nodiscard]] std::filesystem::path ResolveSettingsPath() const;
+    [[nodiscard]] std::filesystem::path ResolveLaunchHistoryPath() const;
+    [[nodiscard]] std::filesystem::path ResolveDiscoverySnapshotPath() const;
+    [[nodiscard]] std::filesystem::path ResolvePathIndexPath() const;
+    [[nodiscard]] std::filesystem::path ResolveLaunchTelemetryPath() const;
     void DiscoverFilesystemChannels();
+    void ApplyDiscoveredChannels();
+    void MergeDiscoveredChannel(const DiscoveredChannel& channel);
+    void ApplyDiscoveryChanges();
+    void UpsertDiscoveredProgram(const DiscoveredProgram& program);
+    void RemoveDiscoveredProgram(int channelIndex, const std::string& programId);
     [[nodiscard]] bool PointInRect(const SDL_Rect& rect, int x, int y) const;
     [[nodiscard]] std::string GetLocalizedString(std::string_view key) const;
     [[nodiscard]] std::string GetLocalizedString(std::string_view key, std::string_view fallback) const;
     void ShowAddAppDialog();
     void HideAddAppDialog();
     void RefreshAddAppDialogEntries();
+    void ApplyAddAppDialogResults();
     void RenderAddAppDialog(double timeSeconds);
     bool HandleAddAppDialogMouseClick(int x, int y);
     bool HandleAddAppDialogMouseWheel(const SDL_MouseWheelEvent& wheel);
@@ -158,6 +196,15 @@ class Application
     bool HandleCustomThemeDialogText(const SDL_TextInputEvent& text);
     bool ApplyCustomThemeDialog();
     void EnsureCustomThemeFieldVisible(int focusIndex);
+    void ShowCommandPalette();
+    void HideCommandPalette();
+    void RebuildCommandIndex();
+    void RefreshCommandPaletteResults();
+    void RenderCommandPalette(double timeSeconds);
+    bool HandleCommandPaletteMouseClick(int x, int y);
+    bool HandleCommandPaletteKey(SDL_Keycode key);
+    bool HandleCommandPaletteText(const SDL_TextInputEvent& text);
+    void ActivateCommandPaletteEntry(std::size_t entryIndex);
     void UpdateTextInputState();
     bool AddUserApplication(const std::filesystem::path& executablePath);
     struct UserApplicationEntry
@@ -166,7 +213,17 @@ class Application
         bool isPythonScript = false;
     };
 
-    void LaunchUserApp(const UserApplicationEntry& appEntry, const std::string& programId);
+    // `clickTime` is when the user asked for the launch, for the click-to-spawn latency.
+    void LaunchUserApp(
+        const UserApplicationEntry& appEntry,
+        const std::string& programId,
+        std::chrono::steady_clock::time_point clickTime);
+    void ApplyProcessExits();
+    void ApplyFirstWindows();
+    void ApplyResourceUsage();
+    void ApplyLaunchTelemetry(const std::string& programId, ViewContent& view) const;
+    // Warms the page cache for a program the user is likely to launch next.
+    void PrefetchProgram(const std::string& programId);
     static std::string ColorToHex(SDL_Color color);
     static std::string MakeDisplayNameFromPath(const std::filesystem::path& path);
     static bool IsValidHexColor(const std::string& value);
@@ -200,6 +257,9 @@ class Application
 
     std::unordered_map<std::string, ui::ProgramVisuals> programVisuals_;
     frontend::models::LibraryViewModel libraryViewModel_{};
+    // Session lengths are recorded by ApplyProcessExits once a launched program exits.
+    std::shared_ptr<LaunchHistory> launchHistory_ = std::make_shared<LaunchHistory>();
+    std::shared_ptr<DiscoverySnapshot> discoverySnapshot_ = std::make_shared<DiscoverySnapshot>();
     std::vector<int> channelSelections_;
     int activeChannelIndex_ = 0;
     std::string activeProgramId_;
@@ -230,6 +290,11 @@ class Application
     std::vector<SDL_Rect> channelButtonRects_;
     std::vector<SDL_Rect> programTileRects_;
     std::optional<SDL_Rect> addAppButtonRect_;
+    SDL_Rect libraryGridViewport_{0, 0, 0, 0};
+    int libraryContentHeight_ = 0;
+    int libraryScrollOffset_ = 0;
+    // Set by keyboard navigation so the next frame scrolls the selected card into view.
+    bool libraryRevealSelection_ = false;
     std::optional<SDL_Rect> libraryFilterInputRect_;
     std::vector<ui::panels::LibraryRenderResult::SortChipHitbox> librarySortChipHitboxes_;
     std::optional<SDL_Rect> heroActionRect_;
@@ -239,6 +304,7 @@ class Application
     int focusedHubBranchIndex_ = -1;
     std::vector<std::string> hubRenderedBranchIds_;
     std::vector<std::string> hubSearchTokens_;
+    HubSearchIndex hubSearchIndex_;
     int hubScrollOffset_ = 0;
     int hubScrollMaxOffset_ = 0;
     SDL_Rect hubScrollViewport_{0, 0, 0, 0};
@@ -270,13 +336,14 @@ class Application
         {
             std::filesystem::path path;
             bool isDirectory = false;
-            colony::TextTexture label;
+            // Rasterized only while the row is on screen, through SharedTextTextureCache.
+            std::string label;
+            DirectoryQuerySortKey sortKey;
         };
 
         bool visible = false;
         std::filesystem::path currentDirectory;
         std::vector<Entry> entries;
-        std::vector<SDL_Rect> entryRects;
         SDL_Rect panelRect{0, 0, 0, 0};
         SDL_Rect listViewport{0, 0, 0, 0};
         SDL_Rect confirmButtonRect{0, 0, 0, 0};
@@ -293,6 +360,9 @@ class Application
         int scrollOffset = 0;
         int contentHeight = 0;
         std::string errorMessage;
+        // Restored once the entries they refer to arrive from the background query.
+        std::filesystem::path pendingSelectionPath;
+        int pendingScrollOffset = -1;
         int sortModeIndex = 0;
         int fileTypeFilterIndex = 0;
         bool filterDropdownOpen = false;
@@ -338,12 +408,27 @@ class Application
         SDL_Rect cancelButtonRect{0, 0, 0, 0};
     } customThemeDialog_{};
 
+    struct CommandPaletteState
+    {
+        bool visible = false;
+        std::string query;
+        std::vector<CommandMatch> results;
+        int selectedIndex = 0;
+        SDL_Rect panelRect{0, 0, 0, 0};
+        std::vector<SDL_Rect> resultRects;
+    } commandPalette_{};
+
+    CommandIndex commandIndex_;
+    std::uint64_t commandIndexGeneration_ = 0;
+    bool commandIndexDirty_ = true;
+
     [[maybe_unused]] ui::dialogs::AddAppDialog addAppDialogController_;
     [[maybe_unused]] ui::dialogs::EditUserAppDialog editUserAppDialogController_;
     [[maybe_unused]] ui::dialogs::CustomThemeDialog customThemeDialogController_;
 
     NavigationController navigationController_;
     input::InputRouter inputRouter_;
+    input::CommandPaletteInputHandler commandPaletteInputHandler_;
     input::NavigationInputHandler navigationInputHandler_;
     input::HubInputHandler hubInputHandler_;
     input::DialogInputHandler dialogInputHandler_;
@@ -351,12 +436,30 @@ class Application
     ViewRegistry viewRegistry_;
     ViewFactory viewFactory_;
     RenderContext viewContext_{};
+    GlyphAtlasCache glyphAtlases_;
     std::string statusBuffer_;
 
     double animationTimeSeconds_ = 0.0;
-    Uint64 lastFrameCounter_ = 0;
+    FrameScheduler frameScheduler_;
+    FrameInvalidator frameInvalidator_;
+    // Declared after frameInvalidator_ so their destructors stop the threads that wake the loop.
+    AsyncChannelDiscovery channelDiscovery_;
+    DiscoveryWatcher discoveryWatcher_;
+    AsyncDirectoryQuery addAppDirectoryQuery_;
+    PathIndexUpdater pathIndexUpdater_;
+    ProcessLauncher processLauncher_;
+    LaunchPrefetcher launchPrefetcher_;
+    FirstWindowWatcher firstWindowWatcher_;
+    ResourceMonitor resourceMonitor_;
+    LaunchTelemetry launchTelemetry_;
+    // Resolved once at startup: SDL_GetPrefPath allocates and creates directories on each call.
+    std::filesystem::path launchTelemetryPath_;
+    DrawListStats lastFrameDrawStats_{};
+    bool logDrawStats_ = false;
+    Uint64 lastDrawStatsLogTicks_ = 0;
 
     std::vector<std::string> programTileProgramIds_;
+    std::string hoveredProgramTileId_;
     bool textInputActive_ = false;
 
     std::unordered_map<std::string, UserApplicationEntry> userApplications_;
@@ -365,6 +468,7 @@ class Application
     static constexpr int kWindowWidth = 1600;
     static constexpr int kWindowHeight = 900;
     static constexpr int kStatusBarHeight = 52;
+    static constexpr int kIdleWaitTimeoutMs = 500;
     static constexpr std::string_view kSettingsAppearanceProgramId = "SETTINGS_APPEARANCE";
     static constexpr std::string_view kSettingsLanguageProgramId = "SETTINGS_LANGUAGE";
     static constexpr std::string_view kSettingsGeneralProgramId = "SETTINGS_GENERAL";
@@ -1,6 +1,8 @@
 #include "app/application.h"
 
 #include "core/content_loader.hpp"
+#include "core/directory_query.hpp"
+#include "core/process_launcher.hpp"
 #include "frontend/utils/font_loader.hpp"
 #include "frontend/views/dashboard_page.hpp"
 #include "nexus/nexus_main.hpp"
@@ -11,6 +13,7 @@
 #include "utils/asset_paths.hpp"
 #include "utils/font_manager.hpp"
 #include "utils/text.hpp"
+#include "utils/text_texture_cache.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -26,7 +29,6 @@
 #include <string>
 #include <stdexcept>
 #include <system_error>
-#include <thread>
 #include <vector>
 #include <cstdlib>
 #if !defined(_WIN32)
@@ -119,6 +121,34 @@ const std::vector<AddDialogFileTypeFilter>& GetAddDialogFileTypeFilters()
     return kFilters;
 }
 
+DirectoryQuerySort AddDialogQuerySort(int sortModeIndex)
+{
+    // Same order as GetAddDialogSortOptions.
+    switch (sortModeIndex)
+    {
+    case 1:
+        return DirectoryQuerySort::NameDescending;
+    case 2:
+        return DirectoryQuerySort::NewestFirst;
+    case 3:
+        return DirectoryQuerySort::OldestFirst;
+    case 0:
+    default:
+        return DirectoryQuerySort::NameAscending;
+    }
+}
+
+// Bounds how many streamed entries one frame merges into the list; the rest arrive over the
+// following frames.
+constexpr std::size_t kAddDialogEntriesPerFrame = 4096;
+
+// Rows above and below the viewport whose labels are rasterized ahead of scrolling.
+constexpr int kAddDialogOverscanRows = 4;
+
+// The path index behind '*' searches is rebuilt in the background when the dialog opens and
+// the index is older than this.
+constexpr std::chrono::minutes kPathIndexMaxAge{15};
+
 } // namespace
 
 std::string Application::ColorToHex(SDL_Color color)
@@ -1114,7 +1144,6 @@ void Application::ShowAddAppDialog()
     HideEditUserAppDialog();
     addAppDialog_.visible = true;
     addAppDialog_.errorMessage.clear();
-    addAppDialog_.entryRects.clear();
     addAppDialog_.entries.clear();
     addAppDialog_.selectedIndex = -1;
     addAppDialog_.scrollOffset = 0;
@@ -1154,6 +1183,7 @@ void Application::ShowAddAppDialog()
         addAppDialog_.currentDirectory = current;
     }
 
+    pathIndexUpdater_.RefreshIfStale(DirectoryQuerySearchRoot(addAppDialog_.currentDirectory), kPathIndexMaxAge);
     RefreshAddAppDialogEntries();
     UpdateTextInputState();
 }
@@ -1161,8 +1191,10 @@ void Application::ShowAddAppDialog()
 void Application::HideAddAppDialog()
 {
     addAppDialog_.visible = false;
+    addAppDirectoryQuery_.Cancel();
+    addAppDialog_.pendingSelectionPath.clear();
+    addAppDialog_.pendingScrollOffset = -1;
     addAppDialog_.entries.clear();
-    addAppDialog_.entryRects.clear();
     addAppDialog_.errorMessage.clear();
     addAppDialog_.parentAvailable = false;
     addAppDialog_.selectedIndex = -1;
@@ -1188,9 +1220,14 @@ void Application::RefreshAddAppDialogEntries()
     {
         previouslySelectedPath = addAppDialog_.entries[addAppDialog_.selectedIndex].path;
     }
+    else
+    {
+        // Still waiting for the previous query: carry over what it was going to restore.
+        previouslySelectedPath = addAppDialog_.pendingSelectionPath;
+    }
 
+    addAppDirectoryQuery_.Cancel();
     addAppDialog_.entries.clear();
-    addAppDialog_.entryRects.clear();
     addAppDialog_.filterDropdownOpen = false;
     addAppDialog_.filterDropdownRect = SDL_Rect{0, 0, 0, 0};
     addAppDialog_.filterDropdownOptionRects.clear();
@@ -1201,20 +1238,14 @@ void Application::RefreshAddAppDialogEntries()
     addAppDialog_.errorMessage.clear();
     addAppDialog_.parentAvailable = false;
     addAppDialog_.selectedIndex = -1;
+    addAppDialog_.pendingSelectionPath.clear();
+    addAppDialog_.pendingScrollOffset = -1;
 
     if (!addAppDialog_.visible)
     {
         return;
     }
 
-    SDL_Renderer* renderer = rendererHost_.Renderer();
-    TTF_Font* font = fonts_.heroBody.get();
-    if (renderer == nullptr || font == nullptr)
-    {
-        return;
-    }
-
-    std::error_code ec;
     const std::filesystem::path directory = addAppDialog_.currentDirectory;
     if (directory.empty())
     {
@@ -1222,429 +1253,124 @@ void Application::RefreshAddAppDialogEntries()
         return;
     }
 
-    if (!std::filesystem::exists(directory, ec) || !std::filesystem::is_directory(directory, ec))
+    addAppDialog_.parentAvailable = directory.has_parent_path() && directory.parent_path() != directory;
+    addAppDialog_.pendingSelectionPath = std::move(previouslySelectedPath);
+    addAppDialog_.pendingScrollOffset = previousScroll;
+
+    const auto& fileFilters = GetAddDialogFileTypeFilters();
+    int fileFilterIndex = addAppDialog_.fileTypeFilterIndex;
+    if (fileFilterIndex < 0 || fileFilterIndex >= static_cast<int>(fileFilters.size()))
     {
-        addAppDialog_.errorMessage = "Directory unavailable.";
-        return;
+        fileFilterIndex = 0;
     }
+    const auto& selectedFilter = fileFilters[fileFilterIndex];
 
-    addAppDialog_.parentAvailable = directory.has_parent_path() && directory.parent_path() != directory;
+    // Listing, filtering and sorting run on a worker; ApplyAddAppDialogResults picks up what it
+    // finds on the following frames. Starting a new query cancels the one still running, so
+    // typing into the search box never waits on the previous keystroke's listing.
+    DirectoryQuery query;
+    query.directory = directory;
+    query.search = addAppDialog_.searchQuery;
+    query.sort = AddDialogQuerySort(addAppDialog_.sortModeIndex);
+    query.typeFilter.extensions = selectedFilter.extensions;
+    query.typeFilter.includeDirectories = selectedFilter.includeDirectories;
+    query.typeFilter.directoriesOnly = selectedFilter.directoriesOnly;
+    query.typeFilter.requireExecutable = selectedFilter.requireExecutablePermission;
+    query.pathIndex = pathIndexUpdater_.Current();
+    addAppDirectoryQuery_.Start(std::move(query), [this]() { Invalidate(); });
+}
 
-    struct RawEntry
+void Application::ApplyAddAppDialogResults()
+{
+    if (!addAppDialog_.visible || !addAppDirectoryQuery_.IsActive())
     {
-        std::filesystem::path path;
-        bool isDirectory = false;
-        std::filesystem::file_time_type lastWriteTime{};
-        bool hasWriteTime = false;
-        bool isExecutable = false;
-        bool hasExecutableInfo = false;
-    };
-
-    std::vector<RawEntry> directories;
-    std::vector<RawEntry> files;
-    bool enumeratedAny = false;
+        return;
+    }
 
-    std::string searchFilter = addAppDialog_.searchQuery;
-    bool globalSearch = false;
-    if (!searchFilter.empty() && searchFilter.front() == '*')
+    auto results = addAppDirectoryQuery_.TakeResults(kAddDialogEntriesPerFrame);
+    if (results.entries.empty() && !results.finished)
     {
-        globalSearch = true;
-        searchFilter.erase(searchFilter.begin());
-        while (!searchFilter.empty() && std::isspace(static_cast<unsigned char>(searchFilter.front())))
-        {
-            searchFilter.erase(searchFilter.begin());
-        }
+        return;
     }
 
-    std::transform(searchFilter.begin(), searchFilter.end(), searchFilter.begin(), [](unsigned char ch) {
-        return static_cast<char>(std::tolower(ch));
-    });
-    const bool hasFilter = !searchFilter.empty();
-    if (globalSearch && !hasFilter)
+    std::filesystem::path selectedPath = addAppDialog_.pendingSelectionPath;
+    if (addAppDialog_.selectedIndex >= 0 && addAppDialog_.selectedIndex < static_cast<int>(addAppDialog_.entries.size()))
     {
-        globalSearch = false;
+        selectedPath = addAppDialog_.entries[addAppDialog_.selectedIndex].path;
     }
 
-    auto normalizedKey = [globalSearch](const std::filesystem::path& path) {
-        std::string key;
-        if (globalSearch)
-        {
-            key = path.string();
-        }
-        else
-        {
-            key = path.filename().string();
-        }
-        if (key.empty())
-        {
-            key = path.string();
-        }
-        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char ch) {
-            return static_cast<char>(std::tolower(ch));
-        });
-        return key;
+    const DirectoryQuerySort sort = AddDialogQuerySort(addAppDialog_.sortModeIndex);
+    const auto entryLess = [sort](const AddAppDialogState::Entry& lhs, const AddAppDialogState::Entry& rhs) {
+        return DirectoryQueryLess(lhs.sortKey, rhs.sortKey, sort);
     };
-
-    if (globalSearch && hasFilter)
+    for (auto& result : results.entries)
     {
-        constexpr std::size_t kMaxResults = 512;
-        std::filesystem::path searchRoot = directory;
-        if (searchRoot.has_root_path())
-        {
-            searchRoot = searchRoot.root_path();
-            if (searchRoot.empty())
-            {
-                searchRoot = directory;
-            }
-        }
-        else if (!searchRoot.is_absolute())
-        {
-            std::error_code rootError;
-            searchRoot = std::filesystem::current_path(rootError);
-            if (rootError)
-            {
-                searchRoot = directory;
-            }
-        }
-
-        std::error_code iteratorError;
-        std::filesystem::recursive_directory_iterator iterator(
-            searchRoot,
-            std::filesystem::directory_options::skip_permission_denied,
-            iteratorError);
-        std::filesystem::recursive_directory_iterator end;
-        if (iteratorError)
-        {
-            addAppDialog_.errorMessage = "Unable to enumerate directory.";
-            return;
-        }
-
-        for (; iterator != end && (directories.size() + files.size()) < kMaxResults; iterator.increment(iteratorError))
-        {
-            if (iteratorError)
-            {
-                iteratorError.clear();
-                continue;
-            }
-
-            RawEntry entry;
-            entry.path = iterator->path();
-            std::error_code statusError;
-            std::filesystem::file_status status = iterator->status(statusError);
-            if (statusError)
-            {
-                statusError.clear();
-                status = iterator->symlink_status(statusError);
-            }
-            if (!statusError)
-            {
-                entry.isDirectory = std::filesystem::is_directory(status);
-            }
-            else
-            {
-                statusError.clear();
-                std::error_code dirError;
-                entry.isDirectory = std::filesystem::is_directory(entry.path, dirError);
-                if (dirError)
-                {
-                    entry.isDirectory = false;
-                }
-            }
+        AddAppDialogState::Entry entry;
+        entry.path = std::move(result.path);
+        entry.isDirectory = result.sortKey.isDirectory;
+        entry.label = std::move(result.label);
+        entry.sortKey = std::move(result.sortKey);
 
-            if (!entry.isDirectory)
-            {
-                entry.hasExecutableInfo = true;
-#if !defined(_WIN32)
-                entry.isExecutable = (::access(entry.path.c_str(), X_OK) == 0);
-#endif
-            }
-
-            std::error_code timeError;
-            entry.lastWriteTime = std::filesystem::last_write_time(entry.path, timeError);
-            entry.hasWriteTime = !timeError;
-
-            enumeratedAny = true;
+        // A directory listing arrives sorted, so this appends; search matches land in place.
+        const auto position = std::upper_bound(addAppDialog_.entries.begin(), addAppDialog_.entries.end(), entry, entryLess);
+        addAppDialog_.entries.insert(position, std::move(entry));
+    }
 
-            const std::string key = normalizedKey(entry.path);
-            if (key.find(searchFilter) == std::string::npos)
-            {
-                continue;
-            }
+    addAppDialog_.contentHeight = static_cast<int>(addAppDialog_.entries.size()) * AddDialogRowHeight();
 
-            if (entry.isDirectory)
-            {
-                directories.emplace_back(std::move(entry));
-            }
-            else
-            {
-                files.emplace_back(std::move(entry));
-            }
-        }
-    }
-    else
+    if (!selectedPath.empty())
     {
-        std::filesystem::directory_iterator iterator{directory, ec};
-        if (ec)
-        {
-            addAppDialog_.errorMessage = "Unable to open directory.";
-            return;
-        }
-
-        const auto end = std::filesystem::directory_iterator{};
-        for (; iterator != end; iterator.increment(ec))
+        const auto selected = std::find_if(addAppDialog_.entries.begin(), addAppDialog_.entries.end(), [&](const auto& entry) {
+            return entry.path == selectedPath;
+        });
+        if (selected != addAppDialog_.entries.end())
         {
-            if (ec)
-            {
-                addAppDialog_.errorMessage = "Unable to enumerate directory.";
-                return;
-            }
-
-            RawEntry entry;
-            entry.path = iterator->path();
-            std::error_code statusError;
-            std::filesystem::file_status status = iterator->status(statusError);
-            if (statusError)
-            {
-                statusError.clear();
-                status = iterator->symlink_status(statusError);
-            }
-            if (!statusError)
-            {
-                entry.isDirectory = std::filesystem::is_directory(status);
-            }
-            else
-            {
-                statusError.clear();
-                std::error_code dirError;
-                entry.isDirectory = std::filesystem::is_directory(entry.path, dirError);
-                if (dirError)
-                {
-                    entry.isDirectory = false;
-                }
-            }
-
-            if (!entry.isDirectory)
-            {
-                entry.hasExecutableInfo = true;
-#if !defined(_WIN32)
-                entry.isExecutable = (::access(entry.path.c_str(), X_OK) == 0);
-#endif
-            }
-
-            std::error_code timeError;
-            entry.lastWriteTime = std::filesystem::last_write_time(entry.path, timeError);
-            entry.hasWriteTime = !timeError;
-
-            enumeratedAny = true;
-
-            if (entry.isDirectory)
-            {
-                directories.emplace_back(entry);
-            }
-            else
-            {
-                files.emplace_back(entry);
-            }
+            addAppDialog_.selectedIndex = static_cast<int>(selected - addAppDialog_.entries.begin());
+            addAppDialog_.pendingSelectionPath.clear();
         }
     }
 
-    const auto& sortOptions = GetAddDialogSortOptions();
-    int sortModeIndex = addAppDialog_.sortModeIndex;
-    if (sortModeIndex < 0 || sortModeIndex >= static_cast<int>(sortOptions.size()))
+    if (addAppDialog_.pendingScrollOffset >= 0)
     {
-        sortModeIndex = 0;
-    }
-
-    const auto compareByNameAscending = [&](const RawEntry& lhs, const RawEntry& rhs) {
-        const std::string lhsKey = normalizedKey(lhs.path);
-        const std::string rhsKey = normalizedKey(rhs.path);
-        if (lhsKey == rhsKey)
+        const int maxScroll = std::max(0, addAppDialog_.contentHeight - addAppDialog_.listViewport.h);
+        addAppDialog_.scrollOffset = std::min(addAppDialog_.pendingScrollOffset, maxScroll);
+        if (addAppDialog_.scrollOffset == addAppDialog_.pendingScrollOffset)
         {
-            const std::string lhsLabel = globalSearch ? lhs.path.string() : lhs.path.filename().string();
-            const std::string rhsLabel = globalSearch ? rhs.path.string() : rhs.path.filename().string();
-            return lhsLabel < rhsLabel;
+            addAppDialog_.pendingScrollOffset = -1;
         }
-        return lhsKey < rhsKey;
-    };
-
-    const auto compareByNameDescending = [&](const RawEntry& lhs, const RawEntry& rhs) {
-        return compareByNameAscending(rhs, lhs);
-    };
-
-    const auto compareByModified = [&](const RawEntry& lhs, const RawEntry& rhs, bool newestFirst) {
-        if (lhs.hasWriteTime && rhs.hasWriteTime && lhs.lastWriteTime != rhs.lastWriteTime)
-        {
-            if (newestFirst)
-            {
-                return lhs.lastWriteTime > rhs.lastWriteTime;
-            }
-            return lhs.lastWriteTime < rhs.lastWriteTime;
-        }
-
-        if (lhs.hasWriteTime != rhs.hasWriteTime)
-        {
-            if (newestFirst)
-            {
-                return lhs.hasWriteTime;
-            }
-            return !lhs.hasWriteTime;
-        }
-
-        return compareByNameAscending(lhs, rhs);
-    };
-
-    auto sortEntries = [&](std::vector<RawEntry>& entries) {
-        std::sort(entries.begin(), entries.end(), [&](const RawEntry& lhs, const RawEntry& rhs) {
-            switch (sortModeIndex)
-            {
-            case 1:
-                return compareByNameDescending(lhs, rhs);
-            case 2:
-                return compareByModified(lhs, rhs, true);
-            case 3:
-                return compareByModified(lhs, rhs, false);
-            case 0:
-            default:
-                return compareByNameAscending(lhs, rhs);
-            }
-        });
-    };
-
-    sortEntries(directories);
-    sortEntries(files);
-
-    const bool filterDuringAppend = hasFilter && !globalSearch;
-
-    const auto& fileFilters = GetAddDialogFileTypeFilters();
-    int fileFilterIndex = addAppDialog_.fileTypeFilterIndex;
-    if (fileFilterIndex < 0 || fileFilterIndex >= static_cast<int>(fileFilters.size()))
-    {
-        fileFilterIndex = 0;
     }
 
-    const auto& selectedFilter = fileFilters[fileFilterIndex];
-    const bool fileTypeFilterActive = fileFilterIndex != 0;
-    const bool allowDirectories = selectedFilter.includeDirectories;
-    const bool directoriesOnly = selectedFilter.directoriesOnly;
-    const bool filterHasExtensions = !selectedFilter.extensions.empty();
-    const bool requireExecutablePermission = selectedFilter.requireExecutablePermission;
-
-    auto passesFileTypeFilter = [&](const RawEntry& raw) {
-        if (raw.isDirectory)
-        {
-            return allowDirectories;
-        }
-
-        if (directoriesOnly)
-        {
-            return false;
-        }
-
-        if (requireExecutablePermission)
-        {
-            if (!raw.hasExecutableInfo || !raw.isExecutable)
-            {
-                return false;
-            }
-        }
-
-        if (!filterHasExtensions)
-        {
-            return true;
-        }
-
-        std::string extension = raw.path.extension().string();
-        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char ch) {
-            return static_cast<char>(std::tolower(ch));
-        });
-
-        for (const auto& allowed : selectedFilter.extensions)
-        {
-            if (extension == allowed)
-            {
-                return true;
-            }
-        }
-        return false;
-    };
+    if (results.finished)
+    {
+        addAppDialog_.pendingSelectionPath.clear();
+        addAppDialog_.pendingScrollOffset = -1;
 
-    auto appendEntries = [&](const std::vector<RawEntry>& source) {
-        for (const auto& raw : source)
+        using Error = DirectoryQueryResults::Error;
+        switch (results.error)
         {
-            if (filterDuringAppend)
-            {
-                const std::string key = normalizedKey(raw.path);
-                if (key.find(searchFilter) == std::string::npos)
-                {
-                    continue;
-                }
-            }
-
-            if (!passesFileTypeFilter(raw))
-            {
-                continue;
-            }
-
-            AddAppDialogState::Entry entry;
-            entry.path = raw.path;
-            entry.isDirectory = raw.isDirectory;
-            std::string label;
-            if (globalSearch)
-            {
-                label = raw.path.string();
-            }
-            else
-            {
-                label = raw.path.filename().string();
-                if (label.empty())
-                {
-                    label = raw.path.string();
-                }
-            }
-            if (entry.isDirectory && (label.empty() || label.back() != '/'))
+        case Error::DirectoryUnavailable:
+            addAppDialog_.errorMessage = "Directory unavailable.";
+            break;
+        case Error::DirectoryUnreadable:
+            addAppDialog_.errorMessage = "Unable to open directory.";
+            break;
+        case Error::SearchRootUnavailable:
+            addAppDialog_.errorMessage = "Unable to enumerate directory.";
+            break;
+        case Error::None:
+            if (addAppDialog_.entries.empty())
             {
-                label.push_back('/');
+                addAppDialog_.errorMessage = results.filtered && results.enumeratedAny ? "No items match your filters."
+                                                                                       : "Directory is empty.";
             }
-            SDL_Color textColor = entry.isDirectory ? theme_.heroTitle : theme_.heroBody;
-            entry.label = CreateTextTexture(renderer, font, label, textColor);
-            addAppDialog_.entries.emplace_back(std::move(entry));
-        }
-    };
-
-    appendEntries(directories);
-    appendEntries(files);
-
-    addAppDialog_.contentHeight = static_cast<int>(addAppDialog_.entries.size()) * AddDialogRowHeight();
-    addAppDialog_.entryRects.assign(addAppDialog_.entries.size(), SDL_Rect{0, 0, 0, 0});
-
-    if (addAppDialog_.entries.empty())
-    {
-        const bool searchActive = hasFilter && (globalSearch || filterDuringAppend);
-        const bool anyFilterActive = searchActive || fileTypeFilterActive;
-        if (globalSearch)
-        {
-            addAppDialog_.errorMessage = anyFilterActive ? "No items match your filters." : "Directory is empty.";
-        }
-        else
-        {
-            addAppDialog_.errorMessage = anyFilterActive && enumeratedAny ? "No items match your filters." : "Directory is empty.";
+            break;
         }
     }
-
-    if (!previouslySelectedPath.empty())
+    else if (results.entries.size() == kAddDialogEntriesPerFrame)
     {
-        for (std::size_t index = 0; index < addAppDialog_.entries.size(); ++index)
-        {
-            if (addAppDialog_.entries[index].path == previouslySelectedPath)
-            {
-                addAppDialog_.selectedIndex = static_cast<int>(index);
-                break;
-            }
-        }
+        // More may already be queued; the worker only wakes the loop when the queue was empty.
+        Invalidate();
     }
-
-    const int maxScroll = std::max(0, addAppDialog_.contentHeight - addAppDialog_.listViewport.h);
-    addAppDialog_.scrollOffset = std::clamp(previousScroll, 0, maxScroll);
 }
 
 void Application::RenderAddAppDialog(double timeSeconds)
@@ -1991,19 +1717,32 @@ void Application::RenderAddAppDialog(double timeSeconds)
     SDL_Rect contentClip = listViewport;
     SDL_RenderSetClipRect(renderer, &contentClip);
 
+    // Only rows that intersect the viewport are drawn, and only they and a few overscan rows get
+    // a label texture; the shared cache drops labels that scrolled away, so the cost of a frame
+    // does not depend on how many entries the directory has.
     const int rowRadius = ui::Scale(10);
-    int rowTop = listViewport.y - addAppDialog_.scrollOffset;
-    addAppDialog_.entryRects.assign(addAppDialog_.entries.size(), SDL_Rect{0, 0, 0, 0});
-    for (std::size_t index = 0; index < addAppDialog_.entries.size(); ++index)
+    const int rowHeight = AddDialogRowHeight();
+    const int entryCount = static_cast<int>(addAppDialog_.entries.size());
+    const int firstVisibleRow = addAppDialog_.scrollOffset / rowHeight;
+    const int lastVisibleRow = std::min(entryCount, (addAppDialog_.scrollOffset + listViewport.h + rowHeight - 1) / rowHeight);
+    TTF_Font* entryFont = fonts_.heroBody.get();
+    const auto acquireLabel = [&](int index) {
+        const auto& entry = addAppDialog_.entries[static_cast<std::size_t>(index)];
+        const SDL_Color textColor = entry.isDirectory ? theme_.heroTitle : theme_.heroBody;
+        return SharedTextTextureCache().Acquire(renderer, entryFont, entry.label, textColor);
+    };
+    for (int index = std::max(0, firstVisibleRow - kAddDialogOverscanRows); index < firstVisibleRow; ++index)
     {
-        SDL_Rect rowRect{listViewport.x, rowTop, listViewport.w, AddDialogRowHeight()};
-        addAppDialog_.entryRects[index] = rowRect;
-        rowTop += AddDialogRowHeight();
+        static_cast<void>(acquireLabel(index));
+    }
+    for (int index = lastVisibleRow; index < std::min(entryCount, lastVisibleRow + kAddDialogOverscanRows); ++index)
+    {
+        static_cast<void>(acquireLabel(index));
+    }
 
-        if (rowRect.y + rowRect.h <= listViewport.y || rowRect.y >= listViewport.y + listViewport.h)
-        {
-            continue;
-        }
+    for (int index = firstVisibleRow; index < lastVisibleRow; ++index)
+    {
+        SDL_Rect rowRect{listViewport.x, listViewport.y + index * rowHeight - addAppDialog_.scrollOffset, listViewport.w, rowHeight};
 
         SDL_Rect clippedRow{
             rowRect.x,
@@ -2011,7 +1750,7 @@ void Application::RenderAddAppDialog(double timeSeconds)
             rowRect.w,
             std::min(rowRect.y + rowRect.h, listViewport.y + listViewport.h) - std::max(rowRect.y, listViewport.y)};
 
-        const bool isSelected = static_cast<int>(index) == addAppDialog_.selectedIndex;
+        const bool isSelected = index == addAppDialog_.selectedIndex;
         SDL_Color rowColor = isSelected ? color::Mix(theme_.libraryCardActive, theme_.channelBadge, 0.35f)
                                         : color::Mix(theme_.libraryBackground, theme_.libraryCard, 0.45f);
         SDL_SetRenderDrawColor(renderer, rowColor.r, rowColor.g, rowColor.b, rowColor.a);
@@ -2036,22 +1775,22 @@ void Application::RenderAddAppDialog(double timeSeconds)
             glyphRect.y = listViewport.y;
         }
 
-        const auto& entry = addAppDialog_.entries[index];
+        const auto& entry = addAppDialog_.entries[static_cast<std::size_t>(index)];
         SDL_Color glyphColor = entry.isDirectory ? theme_.channelBadge : theme_.muted;
         SDL_SetRenderDrawColor(renderer, glyphColor.r, glyphColor.g, glyphColor.b, glyphColor.a);
         colony::drawing::RenderFilledRoundedRect(renderer, glyphRect, ui::Scale(4));
 
         int textX = glyphRect.x + glyphRect.w + ui::Scale(12);
-        if (entry.label.texture)
+        if (const TextTexture* label = acquireLabel(index))
         {
-            SDL_Rect textRect{textX, rowRect.y + (rowRect.h - entry.label.height) / 2, entry.label.width, entry.label.height};
+            SDL_Rect textRect{textX, rowRect.y + (rowRect.h - label->height) / 2, label->width, label->height};
             SDL_Rect clipRect{
                 listViewport.x + ui::Scale(12),
                 listViewport.y,
                 listViewport.w - ui::Scale(24),
                 listViewport.h};
             SDL_RenderSetClipRect(renderer, &clipRect);
-            RenderTexture(renderer, entry.label, textRect);
+            RenderTexture(renderer, *label, textRect);
             SDL_RenderSetClipRect(renderer, &contentClip);
         }
     }
@@ -2626,9 +2365,13 @@ bool Application::HandleAddAppDialogMouseClick(int x, int y)
         return true;
     }
 
-    for (std::size_t index = 0; index < addAppDialog_.entries.size(); ++index)
+    // Rows are laid out at fixed height, so the row under the cursor follows from the scroll
+    // offset without keeping a rectangle per entry.
+    if (PointInRect(addAppDialog_.listViewport, x, y))
     {
-        if (PointInRect(addAppDialog_.entryRects[index], x, y))
+        const std::size_t index
+            = static_cast<std::size_t>((y - addAppDialog_.listViewport.y + addAppDialog_.scrollOffset) / AddDialogRowHeight());
+        if (index < addAppDialog_.entries.size())
         {
             closeFilterDropdown();
             addAppDialog_.errorMessage.clear();
@@ -2698,6 +2441,7 @@ bool Application::HandleAddAppDialogMouseWheel(const SDL_MouseWheelEvent& wheel)
         return true;
     }
 
+    addAppDialog_.pendingScrollOffset = -1;
     addAppDialog_.scrollOffset = std::clamp(
         addAppDialog_.scrollOffset - wheelY * AddDialogRowHeight(),
         0,
@@ -3064,6 +2808,7 @@ bool Application::ApplyEditUserAppChanges()
     view.statusMessage = "Ready to launch " + trimmedName;
     view.accentColor = ColorToHex(accent);
     view.heroGradient = {ColorToHex(gradientStart), ColorToHex(gradientEnd)};
+    MarkViewChanged(content_, view);
 
     RebuildProgramVisuals();
     viewRegistry_.BindContent(content_);
@@ -3084,7 +2829,8 @@ bool Application::ApplyEditUserAppChanges()
 
 void Application::UpdateTextInputState()
 {
-    const bool shouldEnable = hubSearchFocused_
+    const bool shouldEnable = commandPalette_.visible
+        || hubSearchFocused_
         || libraryFilterFocused_
         || (addAppDialog_.visible && addAppDialog_.searchFocused)
         || (editAppDialog_.visible && (editAppDialog_.nameFocused || editAppDialog_.colorFocused))
@@ -3169,6 +2915,7 @@ int Application::EnsureLocalAppsChannel()
         auto insertPos = settingsIt != content_.channels.end() ? settingsIt : content_.channels.end();
         const int index = static_cast<int>(std::distance(content_.channels.begin(), insertPos));
         content_.channels.insert(insertPos, std::move(localChannel));
+        MarkContentChanged(content_);
 
         if (channelSelections_.empty())
         {
@@ -3208,6 +2955,7 @@ int Application::EnsureLocalAppsChannel()
 
     auto insertPos = settingsIt != content_.channels.end() ? settingsIt : content_.channels.end();
     auto insertedIt = content_.channels.insert(insertPos, std::move(localChannel));
+    MarkContentChanged(content_);
     const int index = static_cast<int>(std::distance(content_.channels.begin(), insertedIt));
 
     if (channelSelections_.empty())
@@ -3234,6 +2982,44 @@ bool PathIsPythonScript(const std::filesystem::path& path)
 
     return extension == ".py";
 }
+
+// The interpreter setting is either a path, which may contain spaces, or a command like "py -3".
+std::vector<std::string> InterpreterCommand(const std::string& interpreter)
+{
+    std::error_code ec;
+    return std::filesystem::exists(interpreter, ec) ? std::vector<std::string>{interpreter} : SplitCommandLine(interpreter);
+}
+
+std::string FormatRuntime(std::int64_t seconds)
+{
+    if (seconds < 60)
+    {
+        return std::to_string(seconds) + "s";
+    }
+    if (seconds < 3600)
+    {
+        return std::to_string(seconds / 60) + "m " + std::to_string(seconds % 60) + "s";
+    }
+    return std::to_string(seconds / 3600) + "h " + std::to_string((seconds % 3600) / 60) + "m";
+}
+
+std::string DescribeProcessExit(const ProcessExit& exit, std::int64_t seconds)
+{
+    const std::string runtime = " after " + FormatRuntime(seconds) + ".";
+    if (!exit.statusKnown)
+    {
+        return " closed" + runtime;
+    }
+    if (exit.signal != 0)
+    {
+        return " was stopped by signal " + std::to_string(exit.signal) + runtime;
+    }
+    if (exit.exitCode != 0)
+    {
+        return " exited with code " + std::to_string(exit.exitCode) + runtime;
+    }
+    return " exited" + runtime;
+}
 }
 
 bool Application::AddUserApplication(const std::filesystem::path& executablePath)
@@ -3293,7 +3079,10 @@ bool Application::AddUserApplication(const std::filesystem::path& executablePath
     viewContent.accentColor = ColorToHex(accentColor);
     viewContent.heroGradient = {ColorToHex(gradientStart), ColorToHex(gradientEnd)};
 
-    content_.views[programId] = viewContent;
+    auto& storedView = content_.views[programId];
+    storedView = viewContent;
+    ApplyLaunchTelemetry(programId, storedView);
+    MarkViewChanged(content_, storedView);
 
     viewRegistry_.Register(viewFactory_.CreateSimpleTextView(programId));
     viewRegistry_.BindContent(content_);
@@ -3309,6 +3098,7 @@ bool Application::AddUserApplication(const std::filesystem::path& executablePath
 
     auto& targetChannel = content_.channels[static_cast<std::size_t>(targetChannelIndex)];
     targetChannel.programs.emplace_back(programId);
+    MarkContentChanged(content_);
     if (static_cast<std::size_t>(targetChannelIndex) >= channelSelections_.size())
     {
         channelSelections_.resize(content_.channels.size(), 0);
@@ -3332,7 +3122,10 @@ bool Application::AddUserApplication(const std::filesystem::path& executablePath
     return true;
 }
 
-void Application::LaunchUserApp(const UserApplicationEntry& appEntry, const std::string& programId)
+void Application::LaunchUserApp(
+    const UserApplicationEntry& appEntry,
+    const std::string& programId,
+    std::chrono::steady_clock::time_point clickTime)
 {
     const std::filesystem::path& executablePath = appEntry.executablePath;
     std::error_code ec;
@@ -3346,69 +3139,71 @@ void Application::LaunchUserApp(const UserApplicationEntry& appEntry, const std:
     const std::string displayName = viewIt != content_.views.end() ? viewIt->second.heading : executablePath.filename().string();
     UpdateStatusMessage("Launching " + displayName + "...");
 
+    // Each candidate is an argv vector; the next one is only tried when the previous one
+    // could not be started at all.
+    std::vector<std::vector<std::string>> candidates;
     if (appEntry.isPythonScript)
     {
-        std::vector<std::string> commands;
-
         const std::string configuredInterpreter = settingsService_.ResolvedPythonInterpreter();
         const auto buildPythonCommand = [&](const std::string& interpreter) {
-#if defined(_WIN32)
-            return std::string{"start \"\" "} + interpreter + " \"" + executablePath.string() + "\"";
-#else
-            return interpreter + " \"" + executablePath.string() + "\" &";
-#endif
+            std::vector<std::string> argv = InterpreterCommand(interpreter);
+            if (!argv.empty())
+            {
+                argv.push_back(executablePath.string());
+            }
+            return argv;
         };
 
         if (!configuredInterpreter.empty())
         {
-            commands.push_back(buildPythonCommand(configuredInterpreter));
+            candidates.push_back(buildPythonCommand(configuredInterpreter));
         }
 
 #if defined(_WIN32)
         if (configuredInterpreter != "python.exe")
         {
-            commands.push_back(buildPythonCommand("python.exe"));
+            candidates.push_back(buildPythonCommand("python.exe"));
         }
 #endif
 
-        if (commands.empty())
+        std::erase_if(candidates, [](const auto& argv) { return argv.empty(); });
+        if (candidates.empty())
         {
             UpdateStatusMessage("No Python interpreter configured.");
             return;
         }
-
-        std::thread launcherThread([commands = std::move(commands)]() {
-            for (const auto& command : commands)
-            {
-                if (command.empty())
-                {
-                    continue;
-                }
-
-                const int result = std::system(command.c_str());
-                if (result == 0)
-                {
-                    break;
-                }
-            }
-        });
-        launcherThread.detach();
     }
     else
     {
-#if defined(_WIN32)
-        std::string command = "start \"\" \"" + executablePath.string() + "\"";
-#else
-        std::string command = "\"" + executablePath.string() + "\" &";
-#endif
+        candidates.push_back({executablePath.string()});
+    }
 
-        std::thread launcherThread([command]() { std::system(command.c_str()); });
-        launcherThread.detach();
+    std::int64_t pid = 0;
+    std::error_code spawnError;
+    for (const auto& argv : candidates)
+    {
+        pid = processLauncher_.Spawn(argv, programId, spawnError);
+        if (pid != 0)
+        {
+            break;
+        }
+    }
+    if (pid == 0)
+    {
+        UpdateStatusMessage("Unable to launch " + displayName + ": " + spawnError.message());
+        return;
     }
 
+    const auto spawnTime = std::chrono::steady_clock::now();
+    launchHistory_->RecordLaunch(programId, static_cast<std::int64_t>(std::time(nullptr)));
+    launchTelemetry_.RecordSpawn(programId, std::chrono::duration_cast<std::chrono::milliseconds>(spawnTime - clickTime));
+    firstWindowWatcher_.Watch(pid, programId, spawnTime);
+    resourceMonitor_.Watch(pid, programId);
+
     if (viewIt != content_.views.end())
     {
         auto& view = viewIt->second;
+        ApplyLaunchTelemetry(programId, view);
         std::time_t nowTime = std::time(nullptr);
         std::tm local{};
 #if defined(_WIN32)
@@ -3419,14 +3214,143 @@ void Application::LaunchUserApp(const UserApplicationEntry& appEntry, const std:
         std::ostringstream timeStream;
         timeStream << "Launched " << std::put_time(&local, "%H:%M");
         view.lastLaunched = timeStream.str();
-        view.statusMessage = appEntry.isPythonScript ? "Launch command sent to " + displayName + " (Python)."
-                                                     : "Launch command sent to " + displayName + ".";
+        view.statusMessage = appEntry.isPythonScript
+            ? displayName + " is running with Python (PID " + std::to_string(pid) + ")."
+            : displayName + " is running (PID " + std::to_string(pid) + ").";
+        MarkViewChanged(content_, view);
         UpdateStatusMessage(view.statusMessage);
     }
 
     RebuildProgramVisuals();
 }
 
+void Application::ApplyFirstWindows()
+{
+    for (const FirstWindowEvent& event : firstWindowWatcher_.TakeEvents())
+    {
+        launchTelemetry_.RecordFirstWindow(event.tag, event.elapsed);
+
+        const auto viewIt = content_.views.find(event.tag);
+        if (viewIt == content_.views.end())
+        {
+            continue;
+        }
+
+        ApplyLaunchTelemetry(event.tag, viewIt->second);
+        MarkViewChanged(content_, viewIt->second);
+        UpdateProgramVisuals(event.tag);
+        Invalidate();
+    }
+}
+
+void Application::ApplyResourceUsage()
+{
+    // The monitor hands over one batch per sampling tick, so this redraws at most once per tick.
+    const auto batch = resourceMonitor_.TakeUsage();
+    if (batch.empty())
+    {
+        return;
+    }
+
+    for (const ResourceUsage& usage : batch)
+    {
+        const auto viewIt = content_.views.find(usage.tag);
+        if (viewIt == content_.views.end())
+        {
+            continue;
+        }
+
+        auto& view = viewIt->second;
+        // Only the hero panel shows usage, so the view keeps its revision: library cards and the
+        // command index are not rebuilt every tick. Programs in the background just keep the
+        // text; their chip is drawn when they are activated.
+        view.resourceUsage = FormatResourceUsage(usage);
+        if (usage.tag != activeProgramId_)
+        {
+            continue;
+        }
+
+        if (const auto visualsIt = programVisuals_.find(usage.tag); visualsIt != programVisuals_.end())
+        {
+            ui::RebuildResourceUsage(visualsIt->second, rendererHost_.Renderer(), fonts_.tileMeta.get(), theme_.muted);
+        }
+        UpdateStatusMessage(view.statusMessage + " — " + view.resourceUsage);
+        Invalidate();
+    }
+}
+
+void Application::ApplyLaunchTelemetry(const std::string& programId, ViewContent& view) const
+{
+    const LaunchTelemetryStats* stats = launchTelemetry_.Find(programId);
+    view.launchMetrics = stats != nullptr ? FormatLaunchTelemetry(*stats) : std::string{};
+}
+
+void Application::PrefetchProgram(const std::string& programId)
+{
+    const auto appIt = userApplications_.find(programId);
+    if (appIt == userApplications_.end())
+    {
+        return;
+    }
+
+    const UserApplicationEntry& appEntry = appIt->second;
+    std::vector<std::filesystem::path> files;
+    if (appEntry.isPythonScript)
+    {
+        const std::vector<std::string> interpreter = InterpreterCommand(settingsService_.ResolvedPythonInterpreter());
+        if (!interpreter.empty())
+        {
+            files.emplace_back(interpreter.front());
+        }
+    }
+    files.push_back(appEntry.executablePath);
+    launchPrefetcher_.Prefetch(programId, std::move(files));
+}
+
+void Application::ApplyProcessExits()
+{
+    const std::vector<ProcessExit> exits = processLauncher_.TakeExits();
+    if (exits.empty())
+    {
+        return;
+    }
+
+    for (const ProcessExit& exit : exits)
+    {
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(exit.runtime).count();
+        launchHistory_->RecordSession(exit.tag, seconds);
+        firstWindowWatcher_.Forget(exit.pid);
+        const bool otherInstanceRunning = resourceMonitor_.Forget(exit.pid);
+        const bool failed = exit.statusKnown && (exit.signal != 0 || exit.exitCode != 0);
+        launchTelemetry_.RecordExit(exit.tag, exit.runtime, failed);
+
+        const auto viewIt = content_.views.find(exit.tag);
+        if (viewIt == content_.views.end())
+        {
+            continue;
+        }
+
+        auto& view = viewIt->second;
+        view.statusMessage = view.heading + DescribeProcessExit(exit, seconds);
+        if (!otherInstanceRunning)
+        {
+            view.resourceUsage.clear();
+        }
+        ApplyLaunchTelemetry(exit.tag, view);
+        MarkViewChanged(content_, view);
+        UpdateProgramVisuals(exit.tag);
+        if (exit.tag == activeProgramId_)
+        {
+            UpdateStatusMessage(view.statusMessage);
+        }
+        Invalidate();
+    }
+
+    // Persisted once per batch of exits, together with the spawn and first-window samples
+    // recorded since; anything still unsaved is written at shutdown.
+    launchTelemetry_.Save(launchTelemetryPath_);
+}
+
 void Application::ChangeLanguage(const std::string& languageId)
 {
     if (languageId.empty() || languageId == settingsService_.ActiveLanguageId())
@@ -3461,21 +3385,44 @@ std::filesystem::path Application::ResolveLocalizationDirectory()
     return colony::paths::ResolveAssetDirectory(kLocalizationDir);
 }
 
-std::filesystem::path Application::ResolveSettingsPath() const
+std::filesystem::path Application::ResolvePrefFilePath(std::string_view fileName)
 {
-    constexpr char kSettingsFileName[] = "settings.json";
-
     if (char* prefPath = SDL_GetPrefPath("OpenAI", "Colony"); prefPath != nullptr)
     {
         std::filesystem::path base{prefPath};
         SDL_free(prefPath);
         if (!base.empty())
         {
-            return base / kSettingsFileName;
+            return base / fileName;
         }
     }
 
-    return std::filesystem::path{kSettingsFileName};
+    return std::filesystem::path{fileName};
+}
+
+std::filesystem::path Application::ResolveSettingsPath() const
+{
+    return ResolvePrefFilePath("settings.json");
+}
+
+std::filesystem::path Application::ResolveLaunchHistoryPath() const
+{
+    return ResolvePrefFilePath("launch_history.log");
+}
+
+std::filesystem::path Application::ResolveDiscoverySnapshotPath() const
+{
+    return ResolvePrefFilePath("discovery_snapshot.txt");
+}
+
+std::filesystem::path Application::ResolvePathIndexPath() const
+{
+    return ResolvePrefFilePath("path_index.bin");
+}
+
+std::filesystem::path Application::ResolveLaunchTelemetryPath() const
+{
+    return ResolvePrefFilePath("launch_telemetry.tsv");
 }
 
 bool Application::PointInRect(const SDL_Rect& rect, int x, int y) const
@@ -46,8 +46,6 @@ void Application::BuildHubPanel()
 
     const auto& hubConfig = content_.hub;
 
-    hubSearchTokens_ = TokenizeHubSearch(hubSearchQuery_);
-
     ui::panels::HubContent hubContent;
     hubContent.searchPlaceholder = GetLocalizedString("hub.search.placeholder", "Rechercher une destination");
 
@@ -79,7 +77,8 @@ void Application::BuildHubPanel()
         }
     }
 
-    hubRenderedBranchIds_.clear();
+    std::vector<std::string> searchDocuments;
+    searchDocuments.reserve(hubConfig.branches.size());
     hubContent.branches.reserve(hubConfig.branches.size());
 
     for (std::size_t index = 0; index < hubConfig.branches.size(); ++index)
@@ -120,20 +119,7 @@ void Application::BuildHubPanel()
             haystack.push_back(' ');
             haystack += metricsText;
         }
-        const std::string normalizedHaystack = NormalizeHubSearchString(haystack);
-        bool matchesQuery = true;
-        for (const auto& token : hubSearchTokens_)
-        {
-            if (normalizedHaystack.find(token) == std::string::npos)
-            {
-                matchesQuery = false;
-                break;
-            }
-        }
-        if (!matchesQuery)
-        {
-            continue;
-        }
+        searchDocuments.push_back(std::move(haystack));
 
         ui::panels::HubBranchContent branchContent;
         branchContent.id = branch.id;
@@ -171,22 +157,8 @@ void Application::BuildHubPanel()
         }
 
         hubContent.branches.emplace_back(std::move(branchContent));
-        hubRenderedBranchIds_.push_back(branch.id);
-    }
-
-    if (hubContent.highlights.empty())
-    {
-        const int count = static_cast<int>(hubContent.branches.size());
-        if (!hubSearchTokens_.empty())
-        {
-            hubContent.highlights.push_back(std::to_string(count) + (count == 1 ? " résultat" : " résultats"));
-        }
-        else
-        {
-            const int total = static_cast<int>(hubConfig.branches.size());
-            hubContent.highlights.push_back(std::to_string(total) + (total == 1 ? " destination" : " destinations"));
-        }
     }
+    hubSearchIndex_.Build(searchDocuments);
 
     if (!hubConfig.primaryActionLocalizationKey.empty())
     {
@@ -235,17 +207,9 @@ void Application::BuildHubPanel()
         hubWidgetPage_ = std::clamp(hubWidgetPage_, 0, widgetPageCount - 1);
     }
 
-    if (focusedHubBranchIndex_ >= static_cast<int>(hubContent.branches.size()))
-    {
-        focusedHubBranchIndex_ = hubContent.branches.empty() ? -1 : 0;
-    }
-    if (hubContent.branches.empty())
-    {
-        hoveredHubBranchIndex_ = -1;
-    }
-
     hubPanel_.Build(
         renderer,
+        glyphAtlases_,
         hubContent,
         fonts_.heroTitle.get(),
         fonts_.heroBody.get(),
@@ -253,6 +217,52 @@ void Application::BuildHubPanel()
         fonts_.tileSubtitle.get(),
         theme_);
 
+    UpdateHubSearchResults();
+}
+
+void Application::UpdateHubSearchResults()
+{
+    const auto& hubConfig = content_.hub;
+    hubSearchTokens_ = HubSearchIndex::Tokenize(hubSearchQuery_);
+    std::vector<std::size_t> matches = hubSearchIndex_.Match(hubSearchTokens_);
+
+    hubRenderedBranchIds_.clear();
+    hubRenderedBranchIds_.reserve(matches.size());
+    for (const std::size_t index : matches)
+    {
+        hubRenderedBranchIds_.push_back(hubConfig.branches[index].id);
+    }
+
+    std::string resultSummary;
+    const bool hasHighlights = std::any_of(
+        hubConfig.highlightLocalizationKeys.begin(),
+        hubConfig.highlightLocalizationKeys.end(),
+        [](const std::string& key) { return !key.empty(); });
+    if (!hasHighlights)
+    {
+        const int count = static_cast<int>(matches.size());
+        if (!hubSearchTokens_.empty())
+        {
+            resultSummary = std::to_string(count) + (count == 1 ? " résultat" : " résultats");
+        }
+        else
+        {
+            const int total = static_cast<int>(hubConfig.branches.size());
+            resultSummary = std::to_string(total) + (total == 1 ? " destination" : " destinations");
+        }
+    }
+
+    const int visibleCount = static_cast<int>(matches.size());
+    if (focusedHubBranchIndex_ >= visibleCount)
+    {
+        focusedHubBranchIndex_ = visibleCount == 0 ? -1 : 0;
+    }
+    if (visibleCount == 0 || hoveredHubBranchIndex_ >= visibleCount)
+    {
+        hoveredHubBranchIndex_ = -1;
+    }
+
+    hubPanel_.SetVisibleBranches(std::move(matches), std::move(resultSummary));
     EnsureHubScrollWithinBounds();
 }
 
@@ -275,70 +285,7 @@ void Application::ResetHubInteractionState()
     hubSearchClearRect_.reset();
     hubHeroToggleRect_.reset();
     hubDetailActionRect_.reset();
-}
-
-std::vector<std::string> Application::TokenizeHubSearch(std::string_view value) const
-{
-    std::vector<std::string> tokens;
-    std::string normalized = NormalizeHubSearchString(value);
-    std::string current;
-    current.reserve(normalized.size());
-    for (char ch : normalized)
-    {
-        if (ch == ' ')
-        {
-            if (!current.empty())
-            {
-                tokens.push_back(current);
-                current.clear();
-            }
-        }
-        else
-        {
-            current.push_back(ch);
-        }
-    }
-    if (!current.empty())
-    {
-        tokens.push_back(current);
-    }
-    return tokens;
-}
-
-std::string Application::NormalizeHubSearchString(std::string_view value) const
-{
-    std::string normalized;
-    normalized.reserve(value.size());
-    bool previousSpace = false;
-    for (unsigned char raw : value)
-    {
-        if (std::isalnum(raw) != 0)
-        {
-            normalized.push_back(static_cast<char>(std::tolower(raw)));
-            previousSpace = false;
-        }
-        else if (std::isspace(raw) != 0)
-        {
-            if (!previousSpace && !normalized.empty())
-            {
-                normalized.push_back(' ');
-                previousSpace = true;
-            }
-        }
-        else
-        {
-            if (!previousSpace && !normalized.empty())
-            {
-                normalized.push_back(' ');
-                previousSpace = true;
-            }
-        }
-    }
-    if (!normalized.empty() && normalized.back() == ' ')
-    {
-        normalized.pop_back();
-    }
-    return normalized;
+    UpdateHubSearchResults();
 }
 
 void Application::EnsureHubScrollWithinBounds()
@@ -419,13 +366,12 @@ void Application::HandleHubMouseClick(int x, int y)
     {
         isHubHeroCollapsed_ = !isHubHeroCollapsed_;
         handled = true;
-        BuildHubPanel();
     }
 
     if (!handled && hubSearchClearRect_ && PointInRect(*hubSearchClearRect_, x, y) && !hubSearchQuery_.empty())
     {
         ClearHubSearchQuery();
-        BuildHubPanel();
+        UpdateHubSearchResults();
         handled = true;
     }
 
@@ -526,7 +472,7 @@ bool Application::HandleHubKeyDown(SDL_Keycode key)
             if (!hubSearchQuery_.empty())
             {
                 ClearHubSearchQuery();
-                BuildHubPanel();
+                UpdateHubSearchResults();
             }
             else
             {
@@ -548,7 +494,7 @@ bool Application::HandleHubKeyDown(SDL_Keycode key)
                     --eraseIt;
                 } while (eraseIt != hubSearchQuery_.begin() && ((*eraseIt & 0xC0) == 0x80));
                 hubSearchQuery_.erase(eraseIt, hubSearchQuery_.end());
-                BuildHubPanel();
+                UpdateHubSearchResults();
             }
             else
             {
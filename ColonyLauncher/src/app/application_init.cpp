@@ -11,7 +11,9 @@
 #include "utils/drawing.hpp"
 #include "utils/asset_paths.hpp"
 #include "utils/font_manager.hpp"
+#include "utils/render_layer.hpp"
 #include "utils/text.hpp"
+#include "utils/text_texture_cache.hpp"
 
 #include <algorithm>
 #include <array>
@@ -41,6 +43,10 @@ namespace
 {
 constexpr const char* kContentRootEnvVariable = "COLONY_CONTENT_ROOT";
 constexpr const char* kNexusModulesRoot = "Nexus/Modules";
+constexpr const char* kTargetFrameRateEnvVariable = "COLONY_TARGET_FPS";
+constexpr const char* kDrawStatsEnvVariable = "COLONY_DRAW_STATS";
+constexpr const char* kPrefetchStatsEnvVariable = "COLONY_PREFETCH_STATS";
+constexpr std::chrono::milliseconds kDiscoveryTimeout{10000};
 
 // Nexus filesystem auto-discovery is intentionally limited to these folders under the Nexus Modules root.
 // Other windows (e.g., Launcher) own their own discovery logic.
@@ -75,6 +81,41 @@ std::filesystem::path ResolveContentRootOverride()
     return resolvedRoot;
 }
 
+int ResolveTargetFrameRate(int configuredFrameRate)
+{
+    const char* envValue = std::getenv(kTargetFrameRateEnvVariable);
+    if (envValue == nullptr || envValue[0] == '\0')
+    {
+        return configuredFrameRate;
+    }
+
+    if (std::string_view{envValue} == "uncapped")
+    {
+        return 0;
+    }
+
+    char* end = nullptr;
+    const long parsed = std::strtol(envValue, &end, 10);
+    if (end == envValue || *end != '\0' || parsed < 0)
+    {
+        std::cerr << "Ignoring invalid " << kTargetFrameRateEnvVariable << " value: " << envValue << '\n';
+        return configuredFrameRate;
+    }
+
+    return static_cast<int>(std::min(parsed, 480L));
+}
+
+double CurrentTimeSeconds()
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    if (frequency == 0)
+    {
+        return static_cast<double>(SDL_GetTicks64()) / 1000.0;
+    }
+
+    return static_cast<double>(SDL_GetPerformanceCounter()) / static_cast<double>(frequency);
+}
+
 void RemoveLastUtf8Codepoint(std::string& value)
 {
     if (value.empty())
@@ -131,7 +172,8 @@ std::string_view Application::SettingsSectionForProgram(std::string_view program
 }
 
 Application::Application()
-    : navigationInputHandler_(*this)
+    : commandPaletteInputHandler_(*this)
+    , navigationInputHandler_(*this)
     , hubInputHandler_(*this)
     , dialogInputHandler_(*this)
     , libraryInputHandler_(*this)
@@ -161,6 +203,14 @@ int Application::Run()
     }
 
     settingsService_.Load(ResolveSettingsPath(), themeManager_);
+    launchHistory_->Load(ResolveLaunchHistoryPath());
+    pathIndexUpdater_.Load(ResolvePathIndexPath());
+    processLauncher_.SetNotify([this]() { Invalidate(); });
+    firstWindowWatcher_.SetNotify([this]() { Invalidate(); });
+    resourceMonitor_.SetNotify([this]() { Invalidate(); });
+    launchTelemetryPath_ = ResolveLaunchTelemetryPath();
+    launchTelemetry_.Load(launchTelemetryPath_);
+    libraryViewModel_.SetLaunchHistory(launchHistory_.get());
 
     if (!InitializeLocalization())
     {
@@ -177,43 +227,156 @@ int Application::Run()
 
     bool running = true;
     SDL_Event event{};
-    lastFrameCounter_ = SDL_GetPerformanceCounter();
+    const auto dispatchEvent = [this, &running](const SDL_Event& pendingEvent) {
+        if (pendingEvent.type == frameInvalidator_.WakeEventType())
+        {
+            return;
+        }
+        if (pendingEvent.type == SDL_RENDER_TARGETS_RESET || pendingEvent.type == SDL_RENDER_DEVICE_RESET)
+        {
+            RenderLayer::InvalidateAll();
+        }
+        frameInvalidator_.RequestFrame();
+        inputRouter_.Dispatch(pendingEvent, running);
+    };
+
+    frameInvalidator_.RegisterWakeEvent();
+    frameInvalidator_.RequestFrame();
+    frameScheduler_.SetTargetFrameRate(ResolveTargetFrameRate(settingsService_.TargetFrameRate()));
+    rendererHost_.SetVSyncEnabled(frameScheduler_.TargetFrameRate() > 0);
+    resourceMonitor_.SetInterval(std::chrono::milliseconds{settingsService_.ResourceSampleIntervalMs()});
+    frameScheduler_.Reset(CurrentTimeSeconds());
     animationTimeSeconds_ = 0.0;
+    if (const char* drawStats = std::getenv(kDrawStatsEnvVariable); drawStats != nullptr && drawStats[0] != '\0')
+    {
+        logDrawStats_ = std::string_view{drawStats} != "0";
+    }
 
     while (running)
     {
-        const Uint64 now = SDL_GetPerformanceCounter();
-        const Uint64 elapsedTicks = now - lastFrameCounter_;
-        lastFrameCounter_ = now;
-
-        double deltaSeconds = 0.0;
-        if (SDL_GetPerformanceFrequency() != 0)
+        const bool animating = HasActiveAnimations();
+        const bool frameWanted = animating || frameInvalidator_.IsRequested();
+        const int waitTimeoutMs =
+            frameWanted ? ComputeFrameWaitTimeoutMs(CurrentTimeSeconds()) : ComputeIdleWaitTimeoutMs();
+        if (waitTimeoutMs > 0)
         {
-            deltaSeconds = static_cast<double>(elapsedTicks) / static_cast<double>(SDL_GetPerformanceFrequency());
+            if (SDL_WaitEventTimeout(&event, waitTimeoutMs) != 0)
+            {
+                dispatchEvent(event);
+            }
+            else if (!frameWanted && libraryFilterDebouncer_.HasPending())
+            {
+                frameInvalidator_.RequestFrame();
+            }
         }
-        deltaSeconds = std::min(deltaSeconds, 0.25);
 
-        const auto& toggleStates = settingsService_.ToggleStates();
-        const auto reduceMotionIt = toggleStates.find("reduced_motion");
-        const bool reduceMotion = reduceMotionIt != toggleStates.end() && reduceMotionIt->second;
-        if (!reduceMotion)
+        while (running && SDL_PollEvent(&event))
         {
-            animationTimeSeconds_ += deltaSeconds;
+            dispatchEvent(event);
         }
 
-        while (SDL_PollEvent(&event))
+        ApplyDiscoveredChannels();
+        ApplyDiscoveryChanges();
+        ApplyAddAppDialogResults();
+        ApplyProcessExits();
+        ApplyFirstWindows();
+        ApplyResourceUsage();
+
+        const double nowSeconds = CurrentTimeSeconds();
+        frameScheduler_.AdvanceAnimation(nowSeconds, animating);
+        animationTimeSeconds_ = frameScheduler_.AnimationTimeSeconds();
+
+        if ((animating || frameInvalidator_.IsRequested()) && frameScheduler_.IsRenderDue(nowSeconds))
         {
-            inputRouter_.Dispatch(event, running);
+            frameInvalidator_.Consume();
+            const double deltaSeconds = frameScheduler_.MarkRendered(nowSeconds);
+            RenderFrame(IsReducedMotionEnabled() ? 0.0 : deltaSeconds);
         }
-
-        RenderFrame(reduceMotion ? 0.0 : deltaSeconds);
     }
 
+    channelDiscovery_.Cancel();
+    discoveryWatcher_.Stop();
+    addAppDirectoryQuery_.Cancel();
+    pathIndexUpdater_.Cancel();
+    processLauncher_.Stop();
+    firstWindowWatcher_.Stop();
+    resourceMonitor_.Stop();
+    launchTelemetry_.Save(launchTelemetryPath_);
+    launchPrefetcher_.Cancel();
+    if (const char* prefetchStats = std::getenv(kPrefetchStatsEnvVariable);
+        prefetchStats != nullptr && prefetchStats[0] != '\0' && std::string_view{prefetchStats} != "0")
+    {
+        const LaunchPrefetchStats prefetch = launchPrefetcher_.Stats();
+        std::cerr << "Launch prefetch: " << prefetch.requests << " requests (" << prefetch.rateLimited
+                  << " rate-limited, " << prefetch.superseded << " superseded), files " << prefetch.fileHits
+                  << " cached / " << prefetch.fileMisses << " read, pages " << prefetch.pageHits << " cached / "
+                  << prefetch.pageMisses << " read (" << prefetch.bytesRequested / 1024 << " KiB)\n";
+    }
     settingsService_.Save(ResolveSettingsPath(), themeManager_);
+    SharedTextTextureCache().Clear();
+    drawing::ReleaseCachedTextures();
+    DrawList::ReleaseSharedResources();
     rendererHost_.Shutdown();
     return EXIT_SUCCESS;
 }
 
+void Application::Invalidate() noexcept
+{
+    frameInvalidator_.Invalidate();
+}
+
+void Application::RequestFrame() noexcept
+{
+    frameInvalidator_.RequestFrame();
+}
+
+bool Application::IsReducedMotionEnabled() const
+{
+    const auto& toggleStates = settingsService_.ToggleStates();
+    const auto reduceMotionIt = toggleStates.find("reduced_motion");
+    return reduceMotionIt != toggleStates.end() && reduceMotionIt->second;
+}
+
+bool Application::HasActiveAnimations() const
+{
+    if (IsReducedMotionEnabled())
+    {
+        return false;
+    }
+
+    SDL_Window* window = rendererHost_.Window();
+    if (window == nullptr)
+    {
+        return false;
+    }
+
+    const Uint32 flags = SDL_GetWindowFlags(window);
+    if ((flags & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) != 0)
+    {
+        return false;
+    }
+
+    return (flags & SDL_WINDOW_INPUT_FOCUS) != 0;
+}
+
+int Application::ComputeFrameWaitTimeoutMs(double nowSeconds) const
+{
+    const double remainingMs = std::floor(frameScheduler_.SecondsUntilRenderDue(nowSeconds) * 1000.0);
+    return std::clamp(static_cast<int>(remainingMs), 0, kIdleWaitTimeoutMs);
+}
+
+int Application::ComputeIdleWaitTimeoutMs() const
+{
+    if (!libraryFilterDebouncer_.HasPending())
+    {
+        return kIdleWaitTimeoutMs;
+    }
+
+    const double nowSeconds = static_cast<double>(SDL_GetTicks64()) / 1000.0;
+    const double remainingMs = std::ceil(libraryFilterDebouncer_.SecondsUntilDue(nowSeconds) * 1000.0);
+    return std::clamp(static_cast<int>(remainingMs), 1, kIdleWaitTimeoutMs);
+}
+
 void Application::ShowHub()
 {
     interfaceState_ = InterfaceState::Hub;
@@ -271,6 +434,8 @@ bool Application::InitializeFonts()
         return sdl::FontHandle{TTF_OpenFont(path.c_str(), ui::ScaleDynamic(size))};
     };
 
+    glyphAtlases_.Clear();
+    SharedTextTextureCache().Clear();
     fonts_.brand = openRoleFont(frontend::fonts::FontRole::Headline, typography.headline.size);
     fonts_.navigation = openRoleFont(frontend::fonts::FontRole::Label, typography.label.size);
     fonts_.channel = openRoleFont(frontend::fonts::FontRole::Title, typography.title.size);
@@ -320,9 +485,13 @@ bool Application::InitializeFonts()
 
 bool Application::LoadContent()
 {
+    // Folder channels arrive only after the first frame, so with folder discovery on, a content
+    // file without channels is valid: Local Apps shows until the scans merge theirs in.
+    const bool folderDiscovery = !kFolderChannelSpecs.empty();
     try
     {
-        content_ = LoadContentFromFile(ResolveContentPath().string());
+        content_ = LoadContentFromFile(ResolveContentPath().string(), folderDiscovery);
+        MarkContentChanged(content_);
     }
     catch (const std::exception& ex)
     {
@@ -332,7 +501,7 @@ bool Application::LoadContent()
 
     DiscoverFilesystemChannels();
 
-    if (content_.channels.empty())
+    if (content_.channels.empty() && !folderDiscovery)
     {
         std::cerr << "No channels defined in content file." << '\n';
         return false;
@@ -345,38 +514,223 @@ bool Application::LoadContent()
 
 void Application::DiscoverFilesystemChannels()
 {
-    const auto discoveredChannels = DiscoverChannelsFromFilesystem(
-        ResolveContentRootOverride(), std::vector<FolderChannelSpec>{kFolderChannelSpecs.begin(), kFolderChannelSpecs.end()});
+    // Channels from the content file render immediately; each folder merges in as its scan
+    // finishes, so a slow or hung mount never holds up the first frame. The watcher starts
+    // first so nothing that changes during the scan is missed.
+    const std::filesystem::path contentRoot = ResolveContentRootOverride();
+    std::vector<FolderChannelSpec> specs{kFolderChannelSpecs.begin(), kFolderChannelSpecs.end()};
+    discoveryWatcher_.Start(contentRoot, specs, [this]() { Invalidate(); });
+    discoverySnapshot_->Load(ResolveDiscoverySnapshotPath());
+    channelDiscovery_.Start(
+        contentRoot, std::move(specs), kDiscoveryTimeout, [this]() { Invalidate(); }, discoverySnapshot_);
+}
 
-    for (const auto& channel : discoveredChannels)
+void Application::ApplyDiscoveredChannels()
+{
+    auto discoveredChannels = channelDiscovery_.TakeResults();
+    if (discoveredChannels.empty())
     {
-        const auto channelIt = std::find_if(
-            content_.channels.begin(),
-            content_.channels.end(),
-            [&](const Channel& existing) { return existing.id == channel.id; });
+        return;
+    }
 
-        Channel* targetChannel = nullptr;
-        if (channelIt == content_.channels.end())
+    for (const auto& channel : discoveredChannels)
+    {
+        if (!channel.complete)
         {
-            content_.channels.push_back(Channel{channel.id, channel.label, {}});
-            targetChannel = &content_.channels.back();
+            std::cerr << "Discovery of '" << channel.id << "' timed out; showing " << channel.programs.size()
+                      << " program(s) found so far." << '\n';
         }
-        else
+        MergeDiscoveredChannel(channel);
+    }
+
+    MarkContentChanged(content_);
+    commandIndexDirty_ = true;
+    RebuildNavigationRail();
+    RequestFrame();
+
+    if (!channelDiscovery_.IsRunning())
+    {
+        discoverySnapshot_->Save(ResolveDiscoverySnapshotPath());
+    }
+}
+
+void Application::MergeDiscoveredChannel(const DiscoveredChannel& channel)
+{
+    if (channel.programs.empty())
+    {
+        return;
+    }
+
+    auto channelIt = std::find_if(
+        content_.channels.begin(),
+        content_.channels.end(),
+        [&](const Channel& existing) { return existing.id == channel.id; });
+
+    if (channelIt == content_.channels.end())
+    {
+        // New folder channels go ahead of Local Apps and Settings, as they did when discovery ran
+        // before EnsureLocalAppsChannel.
+        auto insertPos = std::find_if(content_.channels.begin(), content_.channels.end(), [](const Channel& existing) {
+            return existing.id == kLocalAppsChannelId || existing.id == "settings";
+        });
+        const int index = static_cast<int>(std::distance(content_.channels.begin(), insertPos));
+        channelIt = content_.channels.insert(insertPos, Channel{channel.id, channel.label, {}});
+        channelSelections_.insert(channelSelections_.begin() + index, 0);
+        if (index <= activeChannelIndex_)
         {
-            targetChannel = &(*channelIt);
-            targetChannel->label = channel.label;
-            targetChannel->programs.clear();
+            ++activeChannelIndex_;
         }
+        SyncNavigationEntries();
+        navigationController_.Activate(activeChannelIndex_);
+    }
+
+    const int channelIndex = static_cast<int>(std::distance(content_.channels.begin(), channelIt));
+    Channel& targetChannel = *channelIt;
+    const std::string selectedProgramId = targetChannel.programs.empty()
+        ? std::string{}
+        : targetChannel.programs[std::clamp(
+              channelSelections_[channelIndex], 0, static_cast<int>(targetChannel.programs.size()) - 1)];
 
-        for (const auto& program : channel.programs)
+    std::vector<std::string> programs;
+    programs.reserve(channel.programs.size() + targetChannel.programs.size());
+    for (const auto& program : channel.programs)
+    {
+        programs.push_back(program.programId);
+        UpsertDiscoveredProgram(program);
+    }
+
+    // Apps added through the dialog while the scan was running stay in the channel.
+    for (const auto& programId : targetChannel.programs)
+    {
+        if (userApplications_.contains(programId) && std::find(programs.begin(), programs.end(), programId) == programs.end())
         {
-            targetChannel->programs.push_back(program.programId);
-            content_.views[program.programId] = program.view;
+            programs.push_back(programId);
+        }
+    }
+
+    targetChannel.label = channel.label;
+    targetChannel.programs = std::move(programs);
+
+    const auto selectedIt = std::find(targetChannel.programs.begin(), targetChannel.programs.end(), selectedProgramId);
+    channelSelections_[channelIndex] = selectedIt != targetChannel.programs.end()
+        ? static_cast<int>(std::distance(targetChannel.programs.begin(), selectedIt))
+        : 0;
+
+    if (channelIndex == activeChannelIndex_ && GetActiveProgramId() != activeProgramId_)
+    {
+        ActivateProgramInChannel(channelSelections_[channelIndex]);
+    }
+}
 
-            if (!program.launchTarget.empty())
+void Application::ApplyDiscoveryChanges()
+{
+    const auto changes = discoveryWatcher_.TakeChanges();
+    if (changes.empty())
+    {
+        return;
+    }
+
+    const std::size_t channelCount = content_.channels.size();
+    for (const auto& change : changes)
+    {
+        const auto channelIt = std::find_if(content_.channels.begin(), content_.channels.end(), [&](const Channel& channel) {
+            return channel.id == change.channelId;
+        });
+        const int channelIndex = static_cast<int>(std::distance(content_.channels.begin(), channelIt));
+
+        if (change.kind == DiscoveryChange::Kind::Remove)
+        {
+            if (channelIt != content_.channels.end())
             {
-                userApplications_[program.programId] = UserApplicationEntry{program.launchTarget, program.isPythonScript};
+                RemoveDiscoveredProgram(channelIndex, change.programId);
             }
+            continue;
+        }
+
+        if (channelIt == content_.channels.end())
+        {
+            const auto specIt = std::find_if(kFolderChannelSpecs.begin(), kFolderChannelSpecs.end(), [&](const auto& spec) {
+                return spec.id == change.channelId;
+            });
+            const std::string label = specIt != kFolderChannelSpecs.end() ? specIt->label : change.channelId;
+            MergeDiscoveredChannel(DiscoveredChannel{change.channelId, label, {change.program}});
+            continue;
+        }
+
+        UpsertDiscoveredProgram(change.program);
+        auto& programs = channelIt->programs;
+        if (std::find(programs.begin(), programs.end(), change.programId) == programs.end())
+        {
+            programs.push_back(change.programId);
+        }
+
+        if (change.programId == activeProgramId_ || (channelIndex == activeChannelIndex_ && activeProgramId_.empty()))
+        {
+            ActivateProgramInChannel(channelSelections_[channelIndex]);
+        }
+    }
+
+    MarkContentChanged(content_);
+    commandIndexDirty_ = true;
+    if (content_.channels.size() != channelCount)
+    {
+        RebuildNavigationRail();
+    }
+    RequestFrame();
+}
+
+void Application::UpsertDiscoveredProgram(const DiscoveredProgram& program)
+{
+    auto& view = content_.views[program.programId];
+    view = program.view;
+    ApplyLaunchTelemetry(program.programId, view);
+    MarkViewChanged(content_, view);
+
+    if (!viewRegistry_.Contains(program.programId))
+    {
+        viewRegistry_.Register(viewFactory_.CreateSimpleTextView(program.programId));
+    }
+    viewRegistry_.BindContent(program.programId, view);
+
+    if (!program.launchTarget.empty())
+    {
+        userApplications_[program.programId] = UserApplicationEntry{program.launchTarget, program.isPythonScript};
+    }
+    else
+    {
+        userApplications_.erase(program.programId);
+    }
+    UpdateProgramVisuals(program.programId);
+}
+
+void Application::RemoveDiscoveredProgram(int channelIndex, const std::string& programId)
+{
+    auto& programs = content_.channels[static_cast<std::size_t>(channelIndex)].programs;
+    const auto programIt = std::find(programs.begin(), programs.end(), programId);
+    if (programIt == programs.end())
+    {
+        return;
+    }
+
+    const int removedIndex = static_cast<int>(std::distance(programs.begin(), programIt));
+    programs.erase(programIt);
+    int& selection = channelSelections_[static_cast<std::size_t>(channelIndex)];
+    if (removedIndex < selection || selection >= static_cast<int>(programs.size()))
+    {
+        selection = std::max(0, selection - 1);
+    }
+
+    viewRegistry_.Unregister(programId);
+    userApplications_.erase(programId);
+    content_.views.erase(programId);
+    UpdateProgramVisuals(programId);
+
+    if (programId == activeProgramId_)
+    {
+        activeProgramId_.clear();
+        if (channelIndex == activeChannelIndex_)
+        {
+            ActivateProgramInChannel(selection);
         }
     }
 }
@@ -438,6 +792,7 @@ void Application::InitializeViews()
 
 void Application::InitializeInputRouter()
 {
+    commandPaletteInputHandler_.Register(inputRouter_);
     navigationInputHandler_.Register(inputRouter_);
     hubInputHandler_.Register(inputRouter_);
     dialogInputHandler_.Register(inputRouter_);
@@ -446,6 +801,10 @@ void Application::InitializeInputRouter()
 
 void Application::RebuildTheme()
 {
+    RequestFrame();
+    SharedTextTextureCache().Clear();
+    RenderLayer::InvalidateAll();
+    commandIndexDirty_ = true;
     const int previousSettingsScrollOffset = settingsScrollOffset_;
 
     const auto themeData = themeService_.BuildTheme(settingsService_);
@@ -456,14 +815,7 @@ void Application::RebuildTheme()
 
     const auto localize = [this](std::string_view key) { return GetLocalizedString(key); };
 
-    navigationRail_.Build(
-        rendererHost_.Renderer(),
-        fonts_.brand.get(),
-        fonts_.navigation.get(),
-        fonts_.tileMeta.get(),
-        content_,
-        theme_,
-        typography_);
+    RebuildNavigationRail();
 
     libraryPanel_.Build(rendererHost_.Renderer(), fonts_.tileMeta.get(), theme_, localize);
     heroPanel_.Build(rendererHost_.Renderer(), fonts_.tileMeta.get(), theme_, localize);
@@ -527,43 +879,63 @@ void Application::RebuildTheme()
     {
         viewRegistry_.DeactivateActive();
     }
+}
 
-    if (addAppDialog_.visible)
-    {
-        RefreshAddAppDialogEntries();
-    }
+void Application::RebuildNavigationRail()
+{
+    navigationRail_.Build(
+        rendererHost_.Renderer(),
+        fonts_.brand.get(),
+        fonts_.navigation.get(),
+        fonts_.tileMeta.get(),
+        content_,
+        theme_,
+        typography_);
 }
 
 void Application::RebuildProgramVisuals()
 {
     programVisuals_.clear();
-    const SDL_Color heroSubtitleColor = color::Mix(theme_.heroBody, theme_.heroTitle, 0.35f);
-
     for (const auto& [id, view] : content_.views)
     {
-        programVisuals_.emplace(
-            id,
-            ui::BuildProgramVisuals(
-                view,
-                rendererHost_.Renderer(),
-                fonts_.heroTitle.get(),
-                fonts_.heroSubtitle.get(),
-                fonts_.heroBody.get(),
-                fonts_.button.get(),
-                fonts_.tileTitle.get(),
-                fonts_.tileSubtitle.get(),
-                fonts_.tileMeta.get(),
-                fonts_.patchTitle.get(),
-                fonts_.patchBody.get(),
-                fonts_.status.get(),
-                theme_.heroTitle,
-                theme_.heroBody,
-                heroSubtitleColor,
-                theme_.muted,
-                theme_.statusBarText,
-                theme_.heroGradientFallbackStart,
-                theme_.heroGradientFallbackEnd));
+        UpdateProgramVisuals(id);
+    }
+}
+
+void Application::UpdateProgramVisuals(const std::string& programId)
+{
+    const auto viewIt = content_.views.find(programId);
+    if (viewIt == content_.views.end())
+    {
+        programVisuals_.erase(programId);
+        return;
     }
+
+    const SDL_Color heroSubtitleColor = color::Mix(theme_.heroBody, theme_.heroTitle, 0.35f);
+    const ViewContent& view = viewIt->second;
+    programVisuals_.insert_or_assign(
+        programId,
+        ui::BuildProgramVisuals(
+            view,
+            rendererHost_.Renderer(),
+            glyphAtlases_,
+            fonts_.heroTitle.get(),
+            fonts_.heroSubtitle.get(),
+            fonts_.heroBody.get(),
+            fonts_.button.get(),
+            fonts_.tileTitle.get(),
+            fonts_.tileSubtitle.get(),
+            fonts_.tileMeta.get(),
+            fonts_.patchTitle.get(),
+            fonts_.patchBody.get(),
+            fonts_.status.get(),
+            theme_.heroTitle,
+            theme_.heroBody,
+            heroSubtitleColor,
+            theme_.muted,
+            theme_.statusBarText,
+            theme_.heroGradientFallbackStart,
+            theme_.heroGradientFallbackEnd));
 }
 
 void Application::UpdateTopBarTitle()
@@ -604,6 +976,10 @@ void Application::ActivateChannel(int index)
         return;
     }
 
+    if (index != activeChannelIndex_)
+    {
+        libraryScrollOffset_ = 0;
+    }
     activeChannelIndex_ = index;
     const std::string programId = GetActiveProgramId();
     ActivateProgram(programId);
@@ -670,6 +1046,8 @@ void Application::ActivateProgram(const std::string& programId)
 
     if (const auto visualsIt = programVisuals_.find(activeProgramId_); visualsIt != programVisuals_.end())
     {
+        // Usage sampled while the program was in the background only updated its text.
+        ui::RebuildResourceUsage(visualsIt->second, rendererHost_.Renderer(), fonts_.tileMeta.get(), theme_.muted);
         UpdateStatusMessage(visualsIt->second.content->statusMessage);
         viewContext_.accentColor = visualsIt->second.accent;
         viewRegistry_.Activate(activeProgramId_, viewContext_);
@@ -702,6 +1080,7 @@ void Application::ActivateProgramInChannel(int programIndex)
     const int clamped = std::clamp(programIndex, 0, static_cast<int>(channel.programs.size()) - 1);
     selection = clamped;
     ActivateProgram(channel.programs[clamped]);
+    PrefetchProgram(channel.programs[clamped]);
 }
 
 std::string Application::GetActiveProgramId() const
@@ -0,0 +1,415 @@
+#include "app/application.h"
+
+#include "ui/layout.hpp"
+#include "utils/color.hpp"
+#include "utils/drawing.hpp"
+#include "utils/text_texture_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace colony
+{
+namespace
+{
+constexpr std::size_t kCommandPaletteResultLimit = 8;
+constexpr std::size_t kMaxCommandPaletteQueryLength = 120;
+constexpr int kCommandPaletteCornerRadius = 18;
+
+void RemoveLastCodepoint(std::string& value)
+{
+    if (value.empty())
+    {
+        return;
+    }
+
+    auto it = value.end();
+    do
+    {
+        --it;
+    } while (it != value.begin() && ((*it & 0xC0) == 0x80));
+    value.erase(it, value.end());
+}
+
+int FindChannelIndex(const AppContent& content, const std::string& channelId)
+{
+    for (std::size_t index = 0; index < content.channels.size(); ++index)
+    {
+        if (content.channels[index].id == channelId)
+        {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+} // namespace
+
+void Application::ShowCommandPalette()
+{
+    if (commandIndexDirty_ || commandIndexGeneration_ != content_.generation)
+    {
+        RebuildCommandIndex();
+    }
+
+    commandPalette_.visible = true;
+    commandPalette_.query.clear();
+    RefreshCommandPaletteResults();
+    UpdateTextInputState();
+    RequestFrame();
+}
+
+void Application::HideCommandPalette()
+{
+    if (!commandPalette_.visible)
+    {
+        return;
+    }
+
+    commandPalette_.visible = false;
+    commandPalette_.query.clear();
+    commandPalette_.results.clear();
+    commandPalette_.resultRects.clear();
+    commandPalette_.selectedIndex = 0;
+    UpdateTextInputState();
+    RequestFrame();
+}
+
+void Application::RebuildCommandIndex()
+{
+    std::size_t entryCount = content_.channels.size() + content_.hub.branches.size();
+    for (const auto& channel : content_.channels)
+    {
+        entryCount += channel.programs.size();
+    }
+
+    commandIndex_.Clear();
+    commandIndex_.Reserve(entryCount);
+
+    const std::string channelDetail = GetLocalizedString("palette.kind.channel", "Channel");
+    for (const auto& channel : content_.channels)
+    {
+        commandIndex_.Add(CommandEntry{CommandKind::Channel, channel.id, channel.label, channelDetail, channel.id, channel.id});
+
+        for (const auto& programId : channel.programs)
+        {
+            const auto viewIt = content_.views.find(programId);
+            std::string title = viewIt != content_.views.end() && !viewIt->second.heading.empty()
+                ? viewIt->second.heading
+                : programId;
+            const CommandKind kind = IsSettingsProgramId(programId) ? CommandKind::Setting : CommandKind::Program;
+            commandIndex_.Add(CommandEntry{kind, programId, std::move(title), channel.label, channel.id, programId + ' ' + channel.label});
+        }
+    }
+
+    const std::string hubDetail = GetLocalizedString("palette.kind.hub", "Hub");
+    for (const auto& branch : content_.hub.branches)
+    {
+        std::string title = branch.titleLocalizationKey.empty()
+            ? branch.id
+            : GetLocalizedString(branch.titleLocalizationKey, branch.id);
+        commandIndex_.Add(CommandEntry{CommandKind::HubBranch, branch.id, std::move(title), hubDetail, {}, branch.id});
+    }
+
+    commandIndexGeneration_ = content_.generation;
+    commandIndexDirty_ = false;
+}
+
+void Application::RefreshCommandPaletteResults()
+{
+    commandPalette_.results = commandIndex_.Search(commandPalette_.query, kCommandPaletteResultLimit);
+    commandPalette_.selectedIndex = 0;
+    RequestFrame();
+}
+
+void Application::RenderCommandPalette(double timeSeconds)
+{
+    SDL_Renderer* renderer = rendererHost_.Renderer();
+    if (!renderer)
+    {
+        return;
+    }
+
+    SDL_BlendMode previousBlendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+    const platform::RendererDimensions outputDimensions = rendererHost_.OutputSize();
+    SDL_Rect overlayRect{0, 0, outputDimensions.width, outputDimensions.height};
+    SDL_SetRenderDrawColor(renderer, 6, 10, 26, 170);
+    SDL_RenderFillRect(renderer, &overlayRect);
+
+    const int panelPadding = ui::Scale(18);
+    const int fieldHeight = ui::Scale(48);
+    const int rowHeight = ui::Scale(48);
+    const int rowSpacing = ui::Scale(4);
+    const int visibleRows = std::max<int>(1, static_cast<int>(commandPalette_.results.size()));
+
+    const int panelWidth = std::clamp(overlayRect.w - ui::Scale(160), std::min(overlayRect.w, ui::Scale(420)), ui::Scale(720));
+    const int panelHeight = 2 * panelPadding + fieldHeight + ui::Scale(12) + visibleRows * (rowHeight + rowSpacing);
+    SDL_Rect panelRect{
+        overlayRect.x + (overlayRect.w - panelWidth) / 2,
+        overlayRect.y + std::max(ui::Scale(24), overlayRect.h / 6),
+        panelWidth,
+        panelHeight};
+    commandPalette_.panelRect = panelRect;
+
+    SDL_Color panelFill = color::Mix(theme_.libraryCardActive, theme_.background, 0.4f);
+    SDL_SetRenderDrawColor(renderer, panelFill.r, panelFill.g, panelFill.b, panelFill.a);
+    colony::drawing::RenderFilledRoundedRect(renderer, panelRect, kCommandPaletteCornerRadius);
+    SDL_SetRenderDrawColor(renderer, theme_.border.r, theme_.border.g, theme_.border.b, theme_.border.a);
+    colony::drawing::RenderRoundedRect(renderer, panelRect, kCommandPaletteCornerRadius);
+
+    TextTextureCache& textCache = SharedTextTextureCache();
+    const int contentX = panelRect.x + panelPadding;
+    const int contentWidth = panelRect.w - 2 * panelPadding;
+
+    SDL_Rect fieldRect{contentX, panelRect.y + panelPadding, contentWidth, fieldHeight};
+    SDL_Color fieldFill = color::Mix(theme_.libraryCardActive, theme_.background, 0.6f);
+    SDL_SetRenderDrawColor(renderer, fieldFill.r, fieldFill.g, fieldFill.b, fieldFill.a);
+    colony::drawing::RenderFilledRoundedRect(renderer, fieldRect, 12);
+    SDL_SetRenderDrawColor(renderer, theme_.channelBadge.r, theme_.channelBadge.g, theme_.channelBadge.b, theme_.channelBadge.a);
+    colony::drawing::RenderRoundedRect(renderer, fieldRect, 12);
+
+    SDL_Rect queryClip{fieldRect.x + ui::Scale(14), fieldRect.y, fieldRect.w - ui::Scale(28), fieldRect.h};
+    SDL_RenderSetClipRect(renderer, &queryClip);
+    const bool hasQuery = !commandPalette_.query.empty();
+    const TextTexture* queryTexture = hasQuery
+        ? textCache.Acquire(renderer, fonts_.tileTitle.get(), commandPalette_.query, theme_.heroTitle)
+        : textCache.Acquire(
+              renderer,
+              fonts_.tileTitle.get(),
+              GetLocalizedString("palette.placeholder", "Jump to a program, channel or setting"),
+              theme_.muted);
+    int caretOffset = 0;
+    if (queryTexture != nullptr && queryTexture->texture)
+    {
+        // Long queries scroll left so the caret stays in view.
+        const int overflow = std::max(0, queryTexture->width - queryClip.w + ui::Scale(4));
+        SDL_Rect queryRect{
+            queryClip.x - (hasQuery ? overflow : 0),
+            fieldRect.y + (fieldRect.h - queryTexture->height) / 2,
+            queryTexture->width,
+            queryTexture->height};
+        RenderTexture(renderer, *queryTexture, queryRect);
+        caretOffset = hasQuery ? queryTexture->width - overflow : 0;
+    }
+
+    if (std::fmod(timeSeconds, 1.0) < 0.5)
+    {
+        const int caretX = queryClip.x + caretOffset + ui::Scale(2);
+        SDL_SetRenderDrawColor(renderer, theme_.heroTitle.r, theme_.heroTitle.g, theme_.heroTitle.b, theme_.heroTitle.a);
+        SDL_RenderDrawLine(renderer, caretX, fieldRect.y + ui::Scale(10), caretX, fieldRect.y + fieldRect.h - ui::Scale(10));
+    }
+    SDL_RenderSetClipRect(renderer, nullptr);
+
+    int cursorY = fieldRect.y + fieldRect.h + ui::Scale(12);
+    commandPalette_.resultRects.clear();
+    commandPalette_.resultRects.reserve(commandPalette_.results.size());
+
+    if (commandPalette_.results.empty())
+    {
+        const TextTexture* emptyTexture = textCache.Acquire(
+            renderer,
+            fonts_.tileSubtitle.get(),
+            GetLocalizedString("palette.empty", "No matches"),
+            theme_.muted);
+        if (emptyTexture != nullptr && emptyTexture->texture)
+        {
+            SDL_Rect emptyRect{
+                contentX + ui::Scale(14),
+                cursorY + (rowHeight - emptyTexture->height) / 2,
+                emptyTexture->width,
+                emptyTexture->height};
+            RenderTexture(renderer, *emptyTexture, emptyRect);
+        }
+    }
+
+    for (std::size_t row = 0; row < commandPalette_.results.size(); ++row)
+    {
+        const CommandEntry& entry = commandIndex_.Entry(commandPalette_.results[row].entryIndex);
+        SDL_Rect rowRect{contentX, cursorY, contentWidth, rowHeight};
+        commandPalette_.resultRects.push_back(rowRect);
+        cursorY += rowHeight + rowSpacing;
+
+        if (static_cast<int>(row) == commandPalette_.selectedIndex)
+        {
+            SDL_Color rowFill = color::Mix(theme_.channelBadge, theme_.libraryCardActive, 0.35f);
+            SDL_SetRenderDrawColor(renderer, rowFill.r, rowFill.g, rowFill.b, rowFill.a);
+            colony::drawing::RenderFilledRoundedRect(renderer, rowRect, 12);
+        }
+
+        int detailWidth = 0;
+        const TextTexture* detailTexture = entry.detail.empty()
+            ? nullptr
+            : textCache.Acquire(renderer, fonts_.tileMeta.get(), entry.detail, theme_.muted);
+        if (detailTexture != nullptr && detailTexture->texture)
+        {
+            detailWidth = detailTexture->width;
+            SDL_Rect detailRect{
+                rowRect.x + rowRect.w - ui::Scale(14) - detailWidth,
+                rowRect.y + (rowRect.h - detailTexture->height) / 2,
+                detailWidth,
+                detailTexture->height};
+            RenderTexture(renderer, *detailTexture, detailRect);
+        }
+
+        const TextTexture* titleTexture = textCache.Acquire(renderer, fonts_.tileTitle.get(), entry.title, theme_.heroTitle);
+        if (titleTexture != nullptr && titleTexture->texture)
+        {
+            SDL_Rect titleClip{
+                rowRect.x + ui::Scale(14),
+                rowRect.y,
+                std::max(0, rowRect.w - ui::Scale(42) - detailWidth),
+                rowRect.h};
+            SDL_RenderSetClipRect(renderer, &titleClip);
+            SDL_Rect titleRect{
+                titleClip.x,
+                rowRect.y + (rowRect.h - titleTexture->height) / 2,
+                titleTexture->width,
+                titleTexture->height};
+            RenderTexture(renderer, *titleTexture, titleRect);
+            SDL_RenderSetClipRect(renderer, nullptr);
+        }
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+}
+
+bool Application::HandleCommandPaletteMouseClick(int x, int y)
+{
+    if (!commandPalette_.visible)
+    {
+        return false;
+    }
+
+    for (std::size_t row = 0; row < commandPalette_.resultRects.size() && row < commandPalette_.results.size(); ++row)
+    {
+        if (PointInRect(commandPalette_.resultRects[row], x, y))
+        {
+            ActivateCommandPaletteEntry(commandPalette_.results[row].entryIndex);
+            return true;
+        }
+    }
+
+    if (!PointInRect(commandPalette_.panelRect, x, y))
+    {
+        HideCommandPalette();
+    }
+    return true;
+}
+
+bool Application::HandleCommandPaletteKey(SDL_Keycode key)
+{
+    if (!commandPalette_.visible)
+    {
+        return false;
+    }
+
+    const int resultCount = static_cast<int>(commandPalette_.results.size());
+    switch (key)
+    {
+    case SDLK_ESCAPE:
+        HideCommandPalette();
+        return true;
+    case SDLK_UP:
+        if (resultCount > 0)
+        {
+            commandPalette_.selectedIndex = (commandPalette_.selectedIndex + resultCount - 1) % resultCount;
+            RequestFrame();
+        }
+        return true;
+    case SDLK_DOWN:
+    case SDLK_TAB:
+        if (resultCount > 0)
+        {
+            commandPalette_.selectedIndex = (commandPalette_.selectedIndex + 1) % resultCount;
+            RequestFrame();
+        }
+        return true;
+    case SDLK_RETURN:
+    case SDLK_KP_ENTER:
+        if (commandPalette_.selectedIndex >= 0 && commandPalette_.selectedIndex < resultCount)
+        {
+            ActivateCommandPaletteEntry(commandPalette_.results[static_cast<std::size_t>(commandPalette_.selectedIndex)].entryIndex);
+        }
+        return true;
+    case SDLK_BACKSPACE:
+        if (!commandPalette_.query.empty())
+        {
+            RemoveLastCodepoint(commandPalette_.query);
+            RefreshCommandPaletteResults();
+        }
+        return true;
+    default:
+        return true;
+    }
+}
+
+bool Application::HandleCommandPaletteText(const SDL_TextInputEvent& text)
+{
+    if (!commandPalette_.visible)
+    {
+        return false;
+    }
+
+    const std::size_t incomingLength = std::strlen(text.text);
+    const std::size_t currentLength = commandPalette_.query.size();
+    if (incomingLength == 0 || currentLength >= kMaxCommandPaletteQueryLength)
+    {
+        return true;
+    }
+
+    commandPalette_.query.append(text.text, std::min(incomingLength, kMaxCommandPaletteQueryLength - currentLength));
+    RefreshCommandPaletteResults();
+    return true;
+}
+
+void Application::ActivateCommandPaletteEntry(std::size_t entryIndex)
+{
+    if (entryIndex >= commandIndex_.Size())
+    {
+        return;
+    }
+
+    const CommandEntry entry = commandIndex_.Entry(entryIndex);
+    HideCommandPalette();
+
+    if (entry.kind == CommandKind::HubBranch)
+    {
+        ActivateHubBranch(entry.id);
+        return;
+    }
+
+    const int channelIndex = FindChannelIndex(content_, entry.scope);
+    if (channelIndex < 0)
+    {
+        return;
+    }
+
+    if (interfaceState_ == InterfaceState::Hub)
+    {
+        EnterMainInterface();
+    }
+
+    if (entry.kind == CommandKind::Channel)
+    {
+        navigationController_.Activate(channelIndex);
+        return;
+    }
+
+    const auto& programs = content_.channels[static_cast<std::size_t>(channelIndex)].programs;
+    const auto it = std::find(programs.begin(), programs.end(), entry.id);
+    if (it == programs.end())
+    {
+        return;
+    }
+
+    const int programIndex = static_cast<int>(std::distance(programs.begin(), it));
+    channelSelections_[channelIndex] = programIndex;
+    navigationController_.Activate(channelIndex);
+    ActivateProgramInChannel(programIndex);
+}
+
+} // namespace colony
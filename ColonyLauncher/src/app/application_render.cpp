@@ -11,6 +11,7 @@
 #include "utils/asset_paths.hpp"
 #include "utils/font_manager.hpp"
 #include "utils/text.hpp"
+#include "utils/text_texture_cache.hpp"
 
 #include <algorithm>
 #include <chrono>
@@ -47,6 +48,20 @@ void Application::RenderFrame(double deltaSeconds)
         RenderMainInterfaceFrame(deltaSeconds);
         break;
     }
+
+    SharedTextTextureCache().Trim();
+
+    lastFrameDrawStats_ = DrawList::TakeFrameStats();
+    if (logDrawStats_)
+    {
+        const Uint64 nowTicks = SDL_GetTicks64();
+        if (nowTicks - lastDrawStatsLogTicks_ >= 1000)
+        {
+            lastDrawStatsLogTicks_ = nowTicks;
+            std::cerr << "Draw list: " << lastFrameDrawStats_.commands << " commands, " << lastFrameDrawStats_.drawCalls
+                      << " draw calls, " << lastFrameDrawStats_.vertices << " vertices\n";
+        }
+    }
 }
 
 void Application::RenderHubFrame(double deltaSeconds)
@@ -118,6 +133,11 @@ void Application::RenderHubFrame(double deltaSeconds)
         hubWidgetPage_ = std::clamp(hubWidgetPage_, 0, hubWidgetPageCount_ - 1);
     }
 
+    if (commandPalette_.visible)
+    {
+        RenderCommandPalette(timeSeconds);
+    }
+
     SDL_RenderPresent(renderer);
 }
 
@@ -210,7 +230,7 @@ void Application::RenderMainInterfaceFrame(double deltaSeconds)
     const auto sortChips = libraryViewModel_.BuildSortChips([this](std::string_view key) {
         return GetLocalizedString(key);
     });
-    auto programEntries = libraryViewModel_.BuildProgramList(content_, activeChannelIndex_, channelSelections_);
+    const auto& programEntries = libraryViewModel_.BuildProgramList(content_, activeChannelIndex_, channelSelections_);
 
     auto libraryResult = libraryPanel_.Render(
         renderer,
@@ -228,7 +248,13 @@ void Application::RenderMainInterfaceFrame(double deltaSeconds)
         libraryFilterDraft_,
         libraryFilterFocused_,
         programEntries,
-        sortChips);
+        sortChips,
+        libraryScrollOffset_,
+        libraryRevealSelection_);
+    libraryRevealSelection_ = false;
+    libraryScrollOffset_ = libraryResult.scrollOffset;
+    libraryGridViewport_ = libraryResult.gridViewport;
+    libraryContentHeight_ = libraryResult.contentHeight;
     programTileRects_ = libraryResult.tileRects;
     addAppButtonRect_ = libraryResult.addButtonRect;
     programTileProgramIds_ = libraryResult.programIds;
@@ -344,6 +370,11 @@ void Application::RenderMainInterfaceFrame(double deltaSeconds)
         RenderEditUserAppDialog(timeSeconds);
     }
 
+    if (commandPalette_.visible)
+    {
+        RenderCommandPalette(timeSeconds);
+    }
+
     SDL_RenderPresent(renderer);
 }
 
@@ -354,7 +385,12 @@ void Application::LaunchNexusApp()
 
     UpdateStatusMessage("Nexus is running in a separate window. Close it to return to Colony.");
 
+    launchHistory_->RecordLaunch(kNexusProgramId, static_cast<std::int64_t>(std::time(nullptr)));
+    const auto startTime = std::chrono::steady_clock::now();
     const nexus::NexusResult result = nexus::LaunchStandalone();
+    launchHistory_->RecordSession(
+        kNexusProgramId,
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime).count());
 
     if (result.propagateQuit)
     {
@@ -369,6 +405,7 @@ void Application::LaunchNexusApp()
 void Application::UpdateStatusMessage(const std::string& statusText)
 {
     statusBuffer_ = statusText;
+    RequestFrame();
     if (activeProgramId_.empty())
     {
         return;
@@ -376,7 +413,8 @@ void Application::UpdateStatusMessage(const std::string& statusText)
 
     if (auto it = programVisuals_.find(activeProgramId_); it != programVisuals_.end())
     {
-        it->second.statusBar = CreateTextTexture(
+        it->second.statusBar = CreateGlyphText(
+            glyphAtlases_,
             rendererHost_.Renderer(),
             fonts_.status.get(),
             statusBuffer_,
@@ -418,6 +456,7 @@ void Application::QueueLibraryFilterUpdate()
     libraryFilterDebouncer_.Schedule(nowSeconds, [this, draft = libraryFilterDraft_]() {
         libraryViewModel_.SetFilter(draft);
         libraryFilterDraft_ = libraryViewModel_.Filter();
+        libraryScrollOffset_ = 0;
     });
 }
 
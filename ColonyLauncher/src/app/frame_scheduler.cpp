@@ -0,0 +1,81 @@
+#include "app/frame_scheduler.hpp"
+
+#include <algorithm>
+
+namespace colony
+{
+namespace
+{
+constexpr double kRenderDueToleranceSeconds = 0.001;
+} // namespace
+
+void FrameScheduler::SetTargetFrameRate(int framesPerSecond) noexcept
+{
+    targetFrameRate_ = std::max(0, framesPerSecond);
+}
+
+double FrameScheduler::TargetFrameIntervalSeconds() const noexcept
+{
+    if (targetFrameRate_ <= 0)
+    {
+        return 0.0;
+    }
+
+    return 1.0 / static_cast<double>(targetFrameRate_);
+}
+
+void FrameScheduler::Reset(double nowSeconds) noexcept
+{
+    animationTimeSeconds_ = 0.0;
+    animationAccumulatorSeconds_ = 0.0;
+    lastAnimationSampleSeconds_ = nowSeconds;
+    lastRenderSeconds_ = nowSeconds;
+    hasRendered_ = false;
+}
+
+int FrameScheduler::AdvanceAnimation(double nowSeconds, bool animationsEnabled) noexcept
+{
+    const double elapsed = std::clamp(nowSeconds - lastAnimationSampleSeconds_, 0.0, kMaxCatchUpSeconds);
+    lastAnimationSampleSeconds_ = nowSeconds;
+
+    if (!animationsEnabled)
+    {
+        animationAccumulatorSeconds_ = 0.0;
+        return 0;
+    }
+
+    animationAccumulatorSeconds_ += elapsed;
+    int steps = 0;
+    while (animationAccumulatorSeconds_ >= kAnimationStepSeconds)
+    {
+        animationTimeSeconds_ += kAnimationStepSeconds;
+        animationAccumulatorSeconds_ -= kAnimationStepSeconds;
+        ++steps;
+    }
+    return steps;
+}
+
+bool FrameScheduler::IsRenderDue(double nowSeconds) const noexcept
+{
+    return SecondsUntilRenderDue(nowSeconds) <= kRenderDueToleranceSeconds;
+}
+
+double FrameScheduler::SecondsUntilRenderDue(double nowSeconds) const noexcept
+{
+    if (!hasRendered_ || targetFrameRate_ <= 0)
+    {
+        return 0.0;
+    }
+
+    return std::max(0.0, TargetFrameIntervalSeconds() - (nowSeconds - lastRenderSeconds_));
+}
+
+double FrameScheduler::MarkRendered(double nowSeconds) noexcept
+{
+    const double delta = hasRendered_ ? std::clamp(nowSeconds - lastRenderSeconds_, 0.0, kMaxCatchUpSeconds) : 0.0;
+    lastRenderSeconds_ = nowSeconds;
+    hasRendered_ = true;
+    return delta;
+}
+
+} // namespace colony
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace colony
+{
+
+// Paces the main loop: animation time advances in fixed steps, while frames are only
+// presented once the target frame interval has elapsed. A target of 0 renders uncapped.
+class FrameScheduler
+{
+  public:
+    static constexpr double kAnimationStepSeconds = 1.0 / 120.0;
+    static constexpr double kMaxCatchUpSeconds = 0.25;
+
+    void SetTargetFrameRate(int framesPerSecond) noexcept;
+    [[nodiscard]] int TargetFrameRate() const noexcept { return targetFrameRate_; }
+    [[nodiscard]] double TargetFrameIntervalSeconds() const noexcept;
+
+    void Reset(double nowSeconds) noexcept;
+
+    int AdvanceAnimation(double nowSeconds, bool animationsEnabled) noexcept;
+    [[nodiscard]] double AnimationTimeSeconds() const noexcept { return animationTimeSeconds_; }
+
+    [[nodiscard]] bool IsRenderDue(double nowSeconds) const noexcept;
+    [[nodiscard]] double SecondsUntilRenderDue(double nowSeconds) const noexcept;
+    double MarkRendered(double nowSeconds) noexcept;
+
+  private:
+    int targetFrameRate_ = 60;
+    double animationTimeSeconds_ = 0.0;
+    double animationAccumulatorSeconds_ = 0.0;
+    double lastAnimationSampleSeconds_ = 0.0;
+    double lastRenderSeconds_ = 0.0;
+    bool hasRendered_ = false;
+};
+
+} // namespace colony
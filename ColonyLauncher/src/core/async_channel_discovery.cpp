@@ -0,0 +1,109 @@
+#include "core/async_channel_discovery.hpp"
+
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace colony
+{
+
+AsyncChannelDiscovery::~AsyncChannelDiscovery()
+{
+    Cancel();
+}
+
+void AsyncChannelDiscovery::Start(
+    std::filesystem::path contentRoot,
+    std::vector<FolderChannelSpec> specs,
+    std::chrono::milliseconds timeout,
+    Notify notify,
+    std::shared_ptr<DiscoverySnapshot> snapshot)
+{
+    Cancel();
+
+    state_ = std::make_shared<State>();
+    state_->notify = std::move(notify);
+    state_->snapshot = std::move(snapshot);
+    state_->running = specs.size();
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (auto& spec : specs)
+    {
+        std::thread worker(
+            [state = state_, contentRoot, spec = std::move(spec), deadline]() {
+                RunWorker(state, contentRoot, spec, deadline);
+            });
+        worker.detach();
+    }
+}
+
+void AsyncChannelDiscovery::Cancel()
+{
+    if (!state_)
+    {
+        return;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    state_->cancelled.store(true, std::memory_order_relaxed);
+    state_->notify = nullptr;
+    state_->results.clear();
+}
+
+std::vector<DiscoveredChannel> AsyncChannelDiscovery::TakeResults()
+{
+    if (!state_)
+    {
+        return {};
+    }
+
+    std::lock_guard lock(state_->mutex);
+    return std::exchange(state_->results, {});
+}
+
+bool AsyncChannelDiscovery::IsRunning() const
+{
+    if (!state_)
+    {
+        return false;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    return state_->running > 0 && !state_->cancelled.load(std::memory_order_relaxed);
+}
+
+void AsyncChannelDiscovery::RunWorker(
+    const std::shared_ptr<State>& state,
+    const std::filesystem::path& contentRoot,
+    const FolderChannelSpec& spec,
+    std::chrono::steady_clock::time_point deadline)
+{
+    DiscoveredChannel channel;
+    try
+    {
+        channel = DiscoverChannelFromFilesystem(contentRoot, spec, deadline, &state->cancelled, state->snapshot.get());
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Discovery of '" << spec.id << "' failed: " << ex.what() << '\n';
+        channel.id = spec.id;
+        channel.label = spec.label;
+        channel.complete = false;
+    }
+
+    std::lock_guard lock(state->mutex);
+    --state->running;
+    if (state->cancelled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    state->results.push_back(std::move(channel));
+    if (state->notify)
+    {
+        state->notify();
+    }
+}
+
+} // namespace colony
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/filesystem_discovery.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace colony
+{
+
+// Runs DiscoverChannelFromFilesystem for every spec on its own worker so a slow mount only
+// delays its own channel. Finished channels queue up until the owner takes them on its own
+// thread; `notify` runs on the worker after each one so that thread can be woken.
+//
+// Workers are detached: shutting down never waits on a hung mount. Once Cancel returns, no
+// worker calls `notify` again and late results are dropped.
+class AsyncChannelDiscovery
+{
+  public:
+    using Notify = std::function<void()>;
+
+    AsyncChannelDiscovery() = default;
+    AsyncChannelDiscovery(const AsyncChannelDiscovery&) = delete;
+    AsyncChannelDiscovery& operator=(const AsyncChannelDiscovery&) = delete;
+    ~AsyncChannelDiscovery();
+
+    // Cancels any previous run. Each worker stops at `timeout` and reports what it found. The
+    // snapshot, if any, is shared with the workers and outlives a cancelled run.
+    void Start(
+        std::filesystem::path contentRoot,
+        std::vector<FolderChannelSpec> specs,
+        std::chrono::milliseconds timeout,
+        Notify notify,
+        std::shared_ptr<DiscoverySnapshot> snapshot = nullptr);
+    void Cancel();
+
+    // Channels finished since the last call, in completion order.
+    [[nodiscard]] std::vector<DiscoveredChannel> TakeResults();
+    [[nodiscard]] bool IsRunning() const;
+
+  private:
+    struct State
+    {
+        std::mutex mutex;
+        std::vector<DiscoveredChannel> results;
+        std::size_t running = 0;
+        std::atomic<bool> cancelled{false};
+        Notify notify;
+        std::shared_ptr<DiscoverySnapshot> snapshot;
+    };
+
+    static void RunWorker(
+        const std::shared_ptr<State>& state,
+        const std::filesystem::path& contentRoot,
+        const FolderChannelSpec& spec,
+        std::chrono::steady_clock::time_point deadline);
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace colony
@@ -0,0 +1,352 @@
+#include "core/command_index.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <optional>
+#include <utility>
+
+namespace colony
+{
+namespace
+{
+constexpr int kScoreMatch = 16;
+constexpr int kBonusBoundary = 12;
+constexpr int kBonusFirstCharacter = 8;
+constexpr int kBonusConsecutive = 6;
+constexpr int kPenaltyGapStart = 3;
+constexpr int kPenaltyGapExtension = 1;
+constexpr int kMaxGapExtension = 8;
+constexpr int kMaxLeadingPenalty = 12;
+constexpr int kKeywordPenalty = 24;
+
+bool IsWordCharacter(char ch) noexcept
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z');
+}
+
+std::uint64_t CharacterBit(char ch) noexcept
+{
+    const auto value = static_cast<unsigned char>(ch);
+    if (value >= 'a' && value <= 'z')
+    {
+        return std::uint64_t{1} << (value - 'a');
+    }
+    if (value >= '0' && value <= '9')
+    {
+        return std::uint64_t{1} << (26 + value - '0');
+    }
+    return std::uint64_t{1} << (36 + value % 28);
+}
+
+std::uint64_t CharacterMask(std::string_view text) noexcept
+{
+    std::uint64_t mask = 0;
+    for (const char ch : text)
+    {
+        mask |= CharacterBit(ch);
+    }
+    return mask;
+}
+
+// Score of a one-character pattern whose first occurrence in `text` is at `position`.
+int ScoreSingleCharacter(std::string_view text, std::size_t position) noexcept
+{
+    const int bonus = position == 0 ? kBonusFirstCharacter + kBonusBoundary
+        : !IsWordCharacter(text[position - 1]) ? kBonusBoundary
+                                                : 0;
+    return kScoreMatch + bonus - std::min(kMaxLeadingPenalty, static_cast<int>(position));
+}
+
+void AppendLowercase(std::string& target, std::string_view value)
+{
+    for (const unsigned char ch : value)
+    {
+        target.push_back(static_cast<char>(std::tolower(ch)));
+    }
+}
+} // namespace
+
+int ScoreFuzzyMatch(std::string_view pattern, std::string_view text) noexcept
+{
+    if (pattern.empty())
+    {
+        return 0;
+    }
+    if (pattern.size() > text.size())
+    {
+        return kNoFuzzyMatch;
+    }
+    if (pattern.size() == 1)
+    {
+        // The first keystroke scores every entry; with one character the window is its first
+        // occurrence, so skip the passes below.
+        const std::size_t position = text.find(pattern.front());
+        return position == std::string_view::npos ? kNoFuzzyMatch : ScoreSingleCharacter(text, position);
+    }
+
+    // The forward pass finds where the earliest complete match ends; walking back from there
+    // finds the latest start, i.e. the tightest window ending at that position.
+    // find() is memchr, which skips the text between pattern characters far faster than a loop.
+    std::size_t end = std::string_view::npos;
+    for (std::size_t patternIndex = 0, from = 0; patternIndex < pattern.size(); ++patternIndex, from = end + 1)
+    {
+        end = text.find(pattern[patternIndex], from);
+        if (end == std::string_view::npos)
+        {
+            return kNoFuzzyMatch;
+        }
+    }
+
+    std::size_t start = end;
+    std::size_t patternIndex = pattern.size();
+    for (std::size_t i = end + 1; i-- > 0;)
+    {
+        if (text[i] == pattern[patternIndex - 1] && --patternIndex == 0)
+        {
+            start = i;
+            break;
+        }
+    }
+
+    int score = 0;
+    std::size_t previous = std::string_view::npos;
+    patternIndex = 0;
+    for (std::size_t i = start; i <= end && patternIndex < pattern.size(); ++i)
+    {
+        if (text[i] != pattern[patternIndex])
+        {
+            continue;
+        }
+
+        score += kScoreMatch;
+        if (i == 0)
+        {
+            score += kBonusFirstCharacter + kBonusBoundary;
+        }
+        else if (!IsWordCharacter(text[i - 1]))
+        {
+            score += kBonusBoundary;
+        }
+
+        if (previous != std::string_view::npos)
+        {
+            const auto gap = static_cast<int>(i - previous - 1);
+            if (gap == 0)
+            {
+                score += kBonusConsecutive;
+            }
+            else
+            {
+                score -= kPenaltyGapStart + kPenaltyGapExtension * std::min(gap - 1, kMaxGapExtension);
+            }
+        }
+        previous = i;
+        ++patternIndex;
+    }
+
+    score -= std::min(kMaxLeadingPenalty, static_cast<int>(start));
+    return score;
+}
+
+void CommandIndex::Clear() noexcept
+{
+    entries_.clear();
+    keys_.clear();
+    text_.clear();
+    for (auto& postings : postings_)
+    {
+        postings.clear();
+    }
+    lastMatchesValid_ = false;
+}
+
+void CommandIndex::Reserve(std::size_t count)
+{
+    entries_.reserve(count);
+    keys_.reserve(count);
+}
+
+std::size_t CommandIndex::Add(CommandEntry entry)
+{
+    SearchKey key;
+    key.titleOffset = static_cast<std::uint32_t>(text_.size());
+    key.titleLength = static_cast<std::uint32_t>(entry.title.size());
+    AppendLowercase(text_, entry.title);
+    key.keywordsOffset = static_cast<std::uint32_t>(text_.size());
+    key.keywordsLength = static_cast<std::uint32_t>(entry.keywords.size());
+    AppendLowercase(text_, entry.keywords);
+    key.titleMask = CharacterMask(std::string_view{text_}.substr(key.titleOffset, key.titleLength));
+    key.mask = key.titleMask | CharacterMask(std::string_view{text_}.substr(key.keywordsOffset));
+
+    // The first occurrence of each letter and digit gives the entry's score for that character,
+    // as ScoreEntry would compute it: from the title, else from the keywords with the penalty.
+    const auto entryIndex = static_cast<std::uint32_t>(entries_.size());
+    const std::uint64_t postingBits = (std::uint64_t{1} << kPostingLists) - 1;
+    std::uint64_t posted = 0;
+    const auto post = [&](std::string_view text, int penalty) {
+        for (std::size_t position = 0; position < text.size(); ++position)
+        {
+            const std::uint64_t bit = CharacterBit(text[position]);
+            if ((bit & postingBits & ~posted) == 0)
+            {
+                continue;
+            }
+            posted |= bit;
+            postings_[static_cast<std::size_t>(std::countr_zero(bit))].push_back(
+                Posting{entryIndex, ScoreSingleCharacter(text, position) - penalty});
+        }
+    };
+    post(std::string_view{text_}.substr(key.titleOffset, key.titleLength), 0);
+    post(std::string_view{text_}.substr(key.keywordsOffset, key.keywordsLength), kKeywordPenalty);
+
+    entries_.push_back(std::move(entry));
+    keys_.push_back(std::move(key));
+    lastMatchesValid_ = false;
+    return entries_.size() - 1;
+}
+
+std::vector<CommandMatch> CommandIndex::Search(std::string_view query, std::size_t limit) const
+{
+    std::string pattern;
+    pattern.reserve(query.size());
+    for (const unsigned char ch : query)
+    {
+        if (std::isspace(ch) == 0)
+        {
+            pattern.push_back(static_cast<char>(std::tolower(ch)));
+        }
+    }
+
+    std::vector<CommandMatch> results;
+    if (pattern.empty())
+    {
+        lastMatchesValid_ = false;
+        const std::size_t count = std::min(limit, entries_.size());
+        results.reserve(count);
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            results.push_back(CommandMatch{index, 0});
+        }
+        return results;
+    }
+
+    const auto better = [](const ScoredMatch& lhs, const ScoredMatch& rhs) {
+        if (lhs.score != rhs.score)
+        {
+            return lhs.score > rhs.score;
+        }
+        if (lhs.titleLength != rhs.titleLength)
+        {
+            return lhs.titleLength < rhs.titleLength;
+        }
+        return lhs.entryIndex < rhs.entryIndex;
+    };
+
+    // Candidates for the best `limit` matches. Whenever the buffer doubles past the limit it is
+    // cut back to the best `limit`, and the weakest of those becomes the bar every later match
+    // must clear, so nearly all matches are turned away by one comparison.
+    ranked_.clear();
+    std::optional<ScoredMatch> bar;
+    const auto keepBest = [&]() {
+        const auto last = ranked_.begin() + static_cast<std::ptrdiff_t>(limit - 1);
+        std::nth_element(ranked_.begin(), last, ranked_.end(), better);
+        ranked_.resize(limit);
+        bar = *last;
+    };
+    const auto rank = [&](const ScoredMatch& candidate) {
+        if (limit == 0 || (bar && !better(candidate, *bar)))
+        {
+            return;
+        }
+        ranked_.push_back(candidate);
+        if (ranked_.size() == 2 * limit)
+        {
+            keepBest();
+        }
+    };
+    const std::uint64_t patternMask = CharacterMask(pattern);
+    std::vector<std::uint32_t>& matches = scratchMatches_;
+    matches.clear();
+    const auto consider = [&](std::uint32_t index) {
+        const SearchKey& key = keys_[index];
+        if ((key.mask & patternMask) != patternMask)
+        {
+            return;
+        }
+        const int score = ScoreEntry(key, pattern, patternMask);
+        if (score == kNoFuzzyMatch)
+        {
+            return;
+        }
+        matches.push_back(index);
+        rank(ScoredMatch{index, key.titleLength, score});
+    };
+
+    if (pattern.size() == 1 && patternMask < (std::uint64_t{1} << kPostingLists))
+    {
+        // Every entry in the list matches and is already scored; the bar turns most away before
+        // their title length is looked up.
+        const std::vector<Posting>& postings = postings_[static_cast<std::size_t>(std::countr_zero(patternMask))];
+        matches.reserve(postings.size());
+        for (const Posting& posting : postings)
+        {
+            matches.push_back(posting.entryIndex);
+            if (limit == 0 || (bar && posting.score < bar->score))
+            {
+                continue;
+            }
+            rank(ScoredMatch{posting.entryIndex, keys_[posting.entryIndex].titleLength, posting.score});
+        }
+    }
+    // Anything matching the longer pattern also matches its prefix, so typing narrows the
+    // previous result instead of rescanning every entry.
+    else if (lastMatchesValid_ && pattern.starts_with(lastPattern_))
+    {
+        for (const std::uint32_t index : lastMatches_)
+        {
+            consider(index);
+        }
+    }
+    else
+    {
+        matches.reserve(entries_.size());
+        for (std::size_t index = 0; index < entries_.size(); ++index)
+        {
+            consider(static_cast<std::uint32_t>(index));
+        }
+    }
+
+    lastPattern_ = std::move(pattern);
+    std::swap(lastMatches_, scratchMatches_);
+    lastMatchesValid_ = true;
+
+    if (ranked_.size() > limit)
+    {
+        keepBest();
+    }
+    std::sort(ranked_.begin(), ranked_.end(), better);
+    results.reserve(ranked_.size());
+    for (const ScoredMatch& match : ranked_)
+    {
+        results.push_back(CommandMatch{match.entryIndex, match.score});
+    }
+    return results;
+}
+
+int CommandIndex::ScoreEntry(const SearchKey& key, std::string_view pattern, std::uint64_t patternMask) const noexcept
+{
+    const char* text = text_.data();
+    if ((key.titleMask & patternMask) == patternMask)
+    {
+        const int titleScore = ScoreFuzzyMatch(pattern, std::string_view{text + key.titleOffset, key.titleLength});
+        if (titleScore != kNoFuzzyMatch)
+        {
+            return titleScore;
+        }
+    }
+    const int keywordScore = ScoreFuzzyMatch(pattern, std::string_view{text + key.keywordsOffset, key.keywordsLength});
+    return keywordScore == kNoFuzzyMatch ? kNoFuzzyMatch : keywordScore - kKeywordPenalty;
+}
+
+} // namespace colony
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace colony
+{
+
+enum class CommandKind
+{
+    Program,
+    Setting,
+    Channel,
+    HubBranch
+};
+
+struct CommandEntry
+{
+    CommandKind kind = CommandKind::Program;
+    std::string id;
+    std::string title;
+    std::string detail;
+    // Where the entry is activated, e.g. the id of the channel that lists a program.
+    std::string scope;
+    // Extra text that may match with a lower score, e.g. the program id or channel label.
+    std::string keywords;
+};
+
+struct CommandMatch
+{
+    std::size_t entryIndex = 0;
+    int score = 0;
+};
+
+inline constexpr int kNoFuzzyMatch = std::numeric_limits<int>::min();
+
+// Scores `pattern` as a subsequence of `text`, both already lowercased; kNoFuzzyMatch if it is
+// not one. Matches at word starts, runs of consecutive characters and early, tight matches
+// score higher.
+[[nodiscard]] int ScoreFuzzyMatch(std::string_view pattern, std::string_view text) noexcept;
+
+// Flat index behind the command palette. Entries are lowercased once when added into one shared
+// buffer and carry a character-set mask, so most non-matching entries are rejected without
+// scoring. A query that extends the previous one only re-scores the previous matches. A
+// one-letter query, which nearly every entry matches, is answered from a per-letter posting list
+// whose scores were computed when the entries were added.
+class CommandIndex
+{
+  public:
+    void Clear() noexcept;
+    void Reserve(std::size_t count);
+    std::size_t Add(CommandEntry entry);
+
+    [[nodiscard]] std::size_t Size() const noexcept { return entries_.size(); }
+    [[nodiscard]] const CommandEntry& Entry(std::size_t index) const { return entries_[index]; }
+
+    // Best `limit` matches, highest score first. An empty query lists the first entries.
+    [[nodiscard]] std::vector<CommandMatch> Search(std::string_view query, std::size_t limit) const;
+
+  private:
+    struct SearchKey
+    {
+        // Characters of the title and keywords together, and of the title alone.
+        std::uint64_t mask = 0;
+        std::uint64_t titleMask = 0;
+        std::uint32_t titleOffset = 0;
+        std::uint32_t titleLength = 0;
+        std::uint32_t keywordsOffset = 0;
+        std::uint32_t keywordsLength = 0;
+    };
+
+    // A match with its tie-breaker inline, so ranking never reaches back into keys_.
+    struct ScoredMatch
+    {
+        std::uint32_t entryIndex = 0;
+        std::uint32_t titleLength = 0;
+        int score = 0;
+    };
+
+    // An entry containing a letter or digit, with its score for that character alone.
+    struct Posting
+    {
+        std::uint32_t entryIndex = 0;
+        int score = 0;
+    };
+
+    // One list per letter and digit, i.e. per character bit below 36.
+    static constexpr std::size_t kPostingLists = 36;
+
+    [[nodiscard]] int ScoreEntry(const SearchKey& key, std::string_view pattern, std::uint64_t patternMask) const noexcept;
+
+    std::vector<CommandEntry> entries_;
+    std::vector<SearchKey> keys_;
+    std::string text_;
+    std::array<std::vector<Posting>, kPostingLists> postings_;
+
+    // Narrowing only needs which entries matched; the ranking is kept apart in a buffer of at
+    // most twice the result limit. The buffers keep their capacity between searches.
+    mutable std::string lastPattern_;
+    mutable std::vector<std::uint32_t> lastMatches_;
+    mutable std::vector<std::uint32_t> scratchMatches_;
+    mutable std::vector<ScoredMatch> ranked_;
+    mutable bool lastMatchesValid_ = false;
+};
+
+} // namespace colony
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -28,7 +29,12 @@ struct ViewContent
     std::string installState;
     std::string availability;
     std::string lastLaunched;
+    // Launch latencies and crashes measured by Colony; empty until the first launch.
+    std::string launchMetrics;
+    // Live CPU, memory and threads while the program runs; empty otherwise.
+    std::string resourceUsage;
     std::string accentColor{"#3B82F6"};
+    std::uint64_t revision = 0;
 };
 
 struct Channel
@@ -84,6 +90,17 @@ struct AppContent
     std::vector<Channel> channels;
     std::unordered_map<std::string, ViewContent> views;
     HubConfiguration hub;
+    std::uint64_t generation = 0;
 };
 
+inline void MarkContentChanged(AppContent& content) noexcept
+{
+    ++content.generation;
+}
+
+inline void MarkViewChanged(AppContent& content, ViewContent& view) noexcept
+{
+    view.revision = ++content.generation;
+}
+
 } // namespace colony
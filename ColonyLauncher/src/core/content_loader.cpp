@@ -28,6 +28,10 @@ std::ifstream OpenFile(const std::string& filePath)
 
 } // namespace
 
+ContentValidator::ContentValidator(bool allowEmptyChannels)
+    : allowEmptyChannels_(allowEmptyChannels)
+{}
+
 AppContent ContentValidator::LoadFromFile(const std::string& filePath) const
 {
     auto input = OpenFile(filePath);
@@ -458,7 +462,7 @@ void ContentValidator::ParseChannelsSection(const nlohmann::json& document, AppC
         content.channels.emplace_back(std::move(channel));
     }
 
-    if (content.channels.empty())
+    if (content.channels.empty() && !allowEmptyChannels_)
     {
         throw std::runtime_error("Content file must declare at least one channel.");
     }
@@ -476,9 +480,9 @@ void ContentValidator::ParseChannelsSection(const nlohmann::json& document, AppC
     }
 }
 
-AppContent LoadContentFromFile(const std::string& filePath)
+AppContent LoadContentFromFile(const std::string& filePath, bool allowEmptyChannels)
 {
-    ContentValidator validator;
+    ContentValidator validator{allowEmptyChannels};
     return validator.LoadFromFile(filePath);
 }
 
@@ -11,6 +11,9 @@ namespace colony
 class ContentValidator
 {
   public:
+    // Channels may come from elsewhere too, e.g. folder discovery; then the file may declare none.
+    explicit ContentValidator(bool allowEmptyChannels = false);
+
     AppContent LoadFromFile(const std::string& filePath) const;
 
   private:
@@ -22,8 +25,10 @@ class ContentValidator
     void ParseHubSection(const nlohmann::json& document, AppContent& content) const;
     HubBranch ParseHubBranch(const nlohmann::json& json) const;
     HubWidget ParseHubWidget(const nlohmann::json& json) const;
+
+    bool allowEmptyChannels_ = false;
 };
 
-AppContent LoadContentFromFile(const std::string& filePath);
+AppContent LoadContentFromFile(const std::string& filePath, bool allowEmptyChannels = false);
 
 } // namespace colony
@@ -0,0 +1,406 @@
+#include "core/directory_query.hpp"
+
+#include "core/directory_walker.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace colony
+{
+namespace
+{
+std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return text;
+}
+
+bool IsTypeFilterActive(const DirectoryQueryTypeFilter& filter) noexcept
+{
+    return !filter.extensions.empty() || !filter.includeDirectories || filter.directoriesOnly
+        || filter.requireExecutable;
+}
+
+bool PassesTypeFilter(const DirectoryQueryTypeFilter& filter, const std::string& name, const DirectoryEntryInfo& info)
+{
+    if (info.type == DirectoryEntryType::Directory)
+    {
+        return filter.includeDirectories;
+    }
+    if (filter.directoriesOnly)
+    {
+        return false;
+    }
+    if (filter.requireExecutable && !info.isExecutable)
+    {
+        return false;
+    }
+    if (filter.extensions.empty())
+    {
+        return true;
+    }
+
+    const std::string extension = ToLower(std::filesystem::path{name}.extension().string());
+    return std::find(filter.extensions.begin(), filter.extensions.end(), extension) != filter.extensions.end();
+}
+
+DirectoryQueryEntry MakeEntry(std::filesystem::path path, const DirectoryEntryInfo& info, bool wholePath)
+{
+    DirectoryQueryEntry entry;
+    entry.sortKey.isDirectory = info.type == DirectoryEntryType::Directory;
+    entry.sortKey.tieBreak = wholePath ? path.string() : path.filename().string();
+    if (entry.sortKey.tieBreak.empty())
+    {
+        entry.sortKey.tieBreak = path.string();
+    }
+    entry.sortKey.name = ToLower(entry.sortKey.tieBreak);
+    if (info.hasLastWriteTime)
+    {
+        entry.sortKey.lastWriteTime = info.lastWriteTime;
+    }
+
+    entry.label = entry.sortKey.tieBreak;
+    if (entry.sortKey.isDirectory && (entry.label.empty() || entry.label.back() != '/'))
+    {
+        entry.label.push_back('/');
+    }
+    entry.path = std::move(path);
+    return entry;
+}
+
+} // namespace
+
+std::filesystem::path DirectoryQuerySearchRoot(const std::filesystem::path& directory)
+{
+    if (directory.has_root_path())
+    {
+        return directory.root_path();
+    }
+
+    std::error_code ec;
+    std::filesystem::path current = std::filesystem::current_path(ec);
+    return ec ? directory : current;
+}
+
+bool DirectoryQueryLess(const DirectoryQuerySortKey& lhs, const DirectoryQuerySortKey& rhs, DirectoryQuerySort sort)
+{
+    if (lhs.rank != rhs.rank)
+    {
+        return lhs.rank < rhs.rank;
+    }
+    if (lhs.isDirectory != rhs.isDirectory)
+    {
+        return lhs.isDirectory;
+    }
+
+    const auto nameLess = [](const DirectoryQuerySortKey& a, const DirectoryQuerySortKey& b) {
+        if (a.name == b.name)
+        {
+            return a.tieBreak < b.tieBreak;
+        }
+        return a.name < b.name;
+    };
+
+    switch (sort)
+    {
+    case DirectoryQuerySort::NameDescending:
+        return nameLess(rhs, lhs);
+    case DirectoryQuerySort::NewestFirst:
+    case DirectoryQuerySort::OldestFirst:
+    {
+        const bool newestFirst = sort == DirectoryQuerySort::NewestFirst;
+        if (lhs.lastWriteTime && rhs.lastWriteTime && *lhs.lastWriteTime != *rhs.lastWriteTime)
+        {
+            return newestFirst ? *lhs.lastWriteTime > *rhs.lastWriteTime : *lhs.lastWriteTime < *rhs.lastWriteTime;
+        }
+        if (lhs.lastWriteTime.has_value() != rhs.lastWriteTime.has_value())
+        {
+            // Entries without a time go last when newest come first, and first otherwise.
+            return newestFirst == lhs.lastWriteTime.has_value();
+        }
+        return nameLess(lhs, rhs);
+    }
+    case DirectoryQuerySort::NameAscending:
+    default:
+        return nameLess(lhs, rhs);
+    }
+}
+
+AsyncDirectoryQuery::~AsyncDirectoryQuery()
+{
+    Cancel();
+}
+
+void AsyncDirectoryQuery::Start(DirectoryQuery query, Notify notify)
+{
+    Cancel();
+
+    state_ = std::make_shared<State>();
+    state_->notify = std::move(notify);
+
+    std::thread worker([state = state_, query = std::move(query)]() {
+        try
+        {
+            Run(state, query);
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Listing '" << query.directory.string() << "' failed: " << ex.what() << '\n';
+            Finish(*state, DirectoryQueryResults::Error::DirectoryUnreadable, false, false);
+        }
+    });
+    worker.detach();
+}
+
+void AsyncDirectoryQuery::Cancel()
+{
+    if (!state_)
+    {
+        return;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    state_->cancelled.store(true, std::memory_order_relaxed);
+    state_->notify = nullptr;
+    state_->pending.clear();
+}
+
+DirectoryQueryResults AsyncDirectoryQuery::TakeResults(std::size_t maxEntries)
+{
+    DirectoryQueryResults results;
+    if (!state_)
+    {
+        return results;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    if (state_->cancelled.load(std::memory_order_relaxed) || state_->delivered)
+    {
+        return results;
+    }
+
+    const std::size_t count = std::min(maxEntries, state_->pending.size());
+    results.entries.reserve(count);
+    std::move(state_->pending.begin(), state_->pending.begin() + static_cast<std::ptrdiff_t>(count), std::back_inserter(results.entries));
+    state_->pending.erase(state_->pending.begin(), state_->pending.begin() + static_cast<std::ptrdiff_t>(count));
+
+    if (state_->finished && state_->pending.empty())
+    {
+        state_->delivered = true;
+        results.finished = true;
+        results.error = state_->error;
+        results.enumeratedAny = state_->enumeratedAny;
+        results.filtered = state_->filtered;
+    }
+    return results;
+}
+
+bool AsyncDirectoryQuery::IsActive() const
+{
+    if (!state_)
+    {
+        return false;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    return !state_->cancelled.load(std::memory_order_relaxed) && !state_->delivered;
+}
+
+void AsyncDirectoryQuery::Run(const std::shared_ptr<State>& state, const DirectoryQuery& query)
+{
+    using Error = DirectoryQueryResults::Error;
+    const auto cancelled = [&state]() { return state->cancelled.load(std::memory_order_relaxed); };
+
+    std::string searchFilter = query.search;
+    bool globalSearch = false;
+    if (!searchFilter.empty() && searchFilter.front() == '*')
+    {
+        globalSearch = true;
+        searchFilter.erase(searchFilter.begin());
+        while (!searchFilter.empty() && std::isspace(static_cast<unsigned char>(searchFilter.front())))
+        {
+            searchFilter.erase(searchFilter.begin());
+        }
+    }
+    searchFilter = ToLower(std::move(searchFilter));
+    const bool hasFilter = !searchFilter.empty();
+    globalSearch = globalSearch && hasFilter;
+    const bool filtered = hasFilter || IsTypeFilterActive(query.typeFilter);
+
+    std::error_code ec;
+    const std::filesystem::path& directory = query.directory;
+    if (directory.empty() || !std::filesystem::is_directory(directory, ec))
+    {
+        Finish(*state, Error::DirectoryUnavailable, false, filtered);
+        return;
+    }
+
+    // Only stat what the filter or sort mode will look at; a plain name listing needs none.
+    const DirectoryWalkOptions metadata{
+        .executable = query.typeFilter.requireExecutable,
+        .lastWriteTime = query.sort == DirectoryQuerySort::NewestFirst || query.sort == DirectoryQuerySort::OldestFirst};
+
+    if (globalSearch)
+    {
+        const std::filesystem::path searchRoot = DirectoryQuerySearchRoot(directory);
+        if (!std::filesystem::is_directory(searchRoot, ec))
+        {
+            Finish(*state, Error::SearchRootUnavailable, false, filtered);
+            return;
+        }
+
+        if (query.pathIndex && query.pathIndex->Root() == searchRoot)
+        {
+            std::vector<DirectoryQueryEntry> entries;
+            for (auto& match : query.pathIndex->Search(searchFilter, &state->cancelled))
+            {
+                if (cancelled())
+                {
+                    return;
+                }
+
+                // The index only knows whether an entry is a directory; anything else the filter
+                // or sort mode needs comes from the disk, for matches alone.
+                DirectoryEntryInfo info;
+                info.name = match.path.filename().string();
+                info.type = match.isDirectory ? DirectoryEntryType::Directory : DirectoryEntryType::Regular;
+                info.isSymlink = match.isSymlink;
+                ResolveEntryMetadata(match.path.parent_path(), metadata, info);
+                if (PassesTypeFilter(query.typeFilter, info.name, info))
+                {
+                    DirectoryQueryEntry& entry = entries.emplace_back(MakeEntry(std::move(match.path), info, true));
+                    entry.sortKey.rank = match.rank;
+                }
+            }
+
+            std::sort(entries.begin(), entries.end(), [&query](const DirectoryQueryEntry& lhs, const DirectoryQueryEntry& rhs) {
+                return DirectoryQueryLess(lhs.sortKey, rhs.sortKey, query.sort);
+            });
+            if (cancelled())
+            {
+                return;
+            }
+
+            const bool enumeratedAny = query.pathIndex->Size() > 0;
+            Publish(*state, entries);
+            Finish(*state, Error::None, enumeratedAny, filtered);
+            return;
+        }
+
+        // The walk itself only reads directory entries; metadata is fetched for matches alone,
+        // and each match is published as soon as it is found.
+        bool enumeratedAny = false;
+        std::size_t matches = 0;
+        std::vector<DirectoryQueryEntry> batch;
+        WalkDirectoryTree(
+            searchRoot,
+            DirectoryWalkOptions{},
+            [&](const std::filesystem::path& parent, DirectoryEntryInfo& info) {
+                if (cancelled())
+                {
+                    return false;
+                }
+                enumeratedAny = true;
+                std::filesystem::path path = parent / info.name;
+                if (ToLower(path.string()).find(searchFilter) == std::string::npos)
+                {
+                    return true;
+                }
+
+                ResolveEntryMetadata(parent, metadata, info);
+                if (!PassesTypeFilter(query.typeFilter, info.name, info))
+                {
+                    return true;
+                }
+                batch.push_back(MakeEntry(std::move(path), info, true));
+                Publish(*state, batch);
+                return ++matches < query.maxSearchResults;
+            });
+
+        Finish(*state, Error::None, enumeratedAny, filtered);
+        return;
+    }
+
+    // With a search, stats happen after the name filter so a huge folder only pays for matches.
+    auto listing = ListDirectory(directory, hasFilter ? DirectoryWalkOptions{} : metadata, ec);
+    if (ec)
+    {
+        Finish(*state, Error::DirectoryUnreadable, false, filtered);
+        return;
+    }
+
+    std::vector<DirectoryQueryEntry> entries;
+    entries.reserve(listing.size());
+    for (auto& info : listing)
+    {
+        if (cancelled())
+        {
+            return;
+        }
+        if (hasFilter)
+        {
+            if (ToLower(info.name).find(searchFilter) == std::string::npos)
+            {
+                continue;
+            }
+            ResolveEntryMetadata(directory, metadata, info);
+        }
+        if (PassesTypeFilter(query.typeFilter, info.name, info))
+        {
+            entries.push_back(MakeEntry(directory / info.name, info, false));
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [&query](const DirectoryQueryEntry& lhs, const DirectoryQueryEntry& rhs) {
+        return DirectoryQueryLess(lhs.sortKey, rhs.sortKey, query.sort);
+    });
+    if (cancelled())
+    {
+        return;
+    }
+
+    Publish(*state, entries);
+    Finish(*state, Error::None, !listing.empty(), filtered);
+}
+
+void AsyncDirectoryQuery::Publish(State& state, std::vector<DirectoryQueryEntry>& entries)
+{
+    std::lock_guard lock(state.mutex);
+    if (state.cancelled.load(std::memory_order_relaxed))
+    {
+        entries.clear();
+        return;
+    }
+
+    const bool wasEmpty = state.pending.empty();
+    std::move(entries.begin(), entries.end(), std::back_inserter(state.pending));
+    entries.clear();
+    if (wasEmpty && state.notify)
+    {
+        state.notify();
+    }
+}
+
+void AsyncDirectoryQuery::Finish(State& state, DirectoryQueryResults::Error error, bool enumeratedAny, bool filtered)
+{
+    std::lock_guard lock(state.mutex);
+    state.finished = true;
+    state.error = error;
+    state.enumeratedAny = enumeratedAny;
+    state.filtered = filtered;
+    if (!state.cancelled.load(std::memory_order_relaxed) && state.notify)
+    {
+        state.notify();
+    }
+}
+
+} // namespace colony
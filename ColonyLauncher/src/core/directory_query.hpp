@@ -0,0 +1,146 @@
+#pragma once
+
+#include "core/path_index.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace colony
+{
+
+enum class DirectoryQuerySort
+{
+    NameAscending,
+    NameDescending,
+    NewestFirst,
+    OldestFirst,
+};
+
+struct DirectoryQueryTypeFilter
+{
+    // Lower-case extensions including the dot; empty accepts any file.
+    std::vector<std::string> extensions;
+    bool includeDirectories = true;
+    bool directoriesOnly = false;
+    bool requireExecutable = false;
+};
+
+struct DirectoryQuery
+{
+    std::filesystem::path directory;
+    // As typed. A leading '*' searches the whole filesystem for paths containing the rest.
+    std::string search;
+    DirectoryQuerySort sort = DirectoryQuerySort::NameAscending;
+    DirectoryQueryTypeFilter typeFilter;
+    // Answers filesystem searches when it covers the search root, without a result cap.
+    // Without it the search walks the disk and stops at maxSearchResults.
+    std::shared_ptr<const PathIndex> pathIndex;
+    std::size_t maxSearchResults = 512;
+};
+
+// Where a filesystem search from `directory` starts: the root of its drive.
+[[nodiscard]] std::filesystem::path DirectoryQuerySearchRoot(const std::filesystem::path& directory);
+
+// What entries are ordered by: search rank, directories first, then the sort mode, then the name.
+struct DirectoryQuerySortKey
+{
+    // PathIndex rank of a filesystem search match; listings leave it at 0.
+    std::uint8_t rank = 0;
+    bool isDirectory = false;
+    // Lower-cased file name, or whole path for a filesystem search.
+    std::string name;
+    std::string tieBreak;
+    std::optional<std::filesystem::file_time_type> lastWriteTime;
+};
+
+[[nodiscard]] bool DirectoryQueryLess(
+    const DirectoryQuerySortKey& lhs,
+    const DirectoryQuerySortKey& rhs,
+    DirectoryQuerySort sort);
+
+struct DirectoryQueryEntry
+{
+    std::filesystem::path path;
+    // File name, or the whole path for a filesystem search; directories end in '/'.
+    std::string label;
+    DirectoryQuerySortKey sortKey;
+};
+
+struct DirectoryQueryResults
+{
+    enum class Error
+    {
+        None,
+        DirectoryUnavailable,
+        DirectoryUnreadable,
+        SearchRootUnavailable,
+    };
+
+    // Entries found since the previous call. Listings and indexed searches arrive already
+    // sorted; a search that walks the disk arrives in walk order and has to be merged with
+    // DirectoryQueryLess.
+    std::vector<DirectoryQueryEntry> entries;
+    // Set once every entry has been taken.
+    bool finished = false;
+    Error error = Error::None;
+    // Whether anything was listed before filtering, to tell an empty folder from no matches.
+    bool enumeratedAny = false;
+    // Whether the search text or type filter could have hidden anything.
+    bool filtered = false;
+};
+
+// Lists or searches a directory for the Add App dialog on a worker thread. Each Start cancels
+// the previous query, whose worker notices at its next entry and whose results are never seen
+// again; workers are detached so a hung mount cannot block the caller.
+//
+// Results queue up until the owner takes them on its own thread; `notify` runs on the worker
+// when the queue stops being empty and when the query finishes.
+class AsyncDirectoryQuery
+{
+  public:
+    using Notify = std::function<void()>;
+
+    AsyncDirectoryQuery() = default;
+    AsyncDirectoryQuery(const AsyncDirectoryQuery&) = delete;
+    AsyncDirectoryQuery& operator=(const AsyncDirectoryQuery&) = delete;
+    ~AsyncDirectoryQuery();
+
+    void Start(DirectoryQuery query, Notify notify);
+    void Cancel();
+
+    // Takes at most `maxEntries` queued entries so the caller can bound per-frame work.
+    [[nodiscard]] DirectoryQueryResults TakeResults(std::size_t maxEntries);
+    // True from Start until the finished results have been taken or the query is cancelled.
+    [[nodiscard]] bool IsActive() const;
+
+  private:
+    struct State
+    {
+        mutable std::mutex mutex;
+        std::deque<DirectoryQueryEntry> pending;
+        bool finished = false;
+        bool delivered = false;
+        DirectoryQueryResults::Error error = DirectoryQueryResults::Error::None;
+        bool enumeratedAny = false;
+        bool filtered = false;
+        std::atomic<bool> cancelled{false};
+        Notify notify;
+    };
+
+    static void Run(const std::shared_ptr<State>& state, const DirectoryQuery& query);
+    static void Publish(State& state, std::vector<DirectoryQueryEntry>& entries);
+    static void Finish(State& state, DirectoryQueryResults::Error error, bool enumeratedAny, bool filtered);
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace colony
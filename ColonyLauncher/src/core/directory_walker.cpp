@@ -0,0 +1,353 @@
+#include "core/directory_walker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+#if defined(__linux__)
+
+// Layout the kernel fills in for getdents64; glibc does not export it.
+struct LinuxDirent64
+{
+    std::uint64_t d_ino;
+    std::int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+class FileDescriptor
+{
+  public:
+    explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    ~FileDescriptor()
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    [[nodiscard]] int Get() const noexcept { return fd_; }
+
+  private:
+    int fd_;
+};
+
+// What access(X_OK) decides, from the owner and mode statx already returned.
+class ExecutePermission
+{
+  public:
+    ExecutePermission()
+        : uid_(geteuid())
+        , gid_(getegid())
+    {
+        const int count = getgroups(0, nullptr);
+        if (count > 0)
+        {
+            groups_.resize(static_cast<std::size_t>(count));
+            groups_.resize(static_cast<std::size_t>(std::max(0, getgroups(count, groups_.data()))));
+        }
+    }
+
+    [[nodiscard]] bool Allows(const struct statx& status) const noexcept
+    {
+        const unsigned mode = status.stx_mode;
+        if (uid_ == 0)
+        {
+            return (mode & (S_IXUSR | S_IXGRP | S_IXOTH)) != 0;
+        }
+        if (status.stx_uid == uid_)
+        {
+            return (mode & S_IXUSR) != 0;
+        }
+        if (status.stx_gid == gid_
+            || std::find(groups_.begin(), groups_.end(), static_cast<gid_t>(status.stx_gid)) != groups_.end())
+        {
+            return (mode & S_IXGRP) != 0;
+        }
+        return (mode & S_IXOTH) != 0;
+    }
+
+  private:
+    uid_t uid_;
+    gid_t gid_;
+    std::vector<gid_t> groups_;
+};
+
+DirectoryEntryType TypeFromMode(unsigned mode) noexcept
+{
+    if (S_ISDIR(mode))
+    {
+        return DirectoryEntryType::Directory;
+    }
+    if (S_ISREG(mode))
+    {
+        return DirectoryEntryType::Regular;
+    }
+    return DirectoryEntryType::Other;
+}
+
+std::filesystem::file_time_type ToFileTime(const struct statx_timestamp& timestamp)
+{
+    const std::chrono::sys_time<std::chrono::nanoseconds> systemTime{
+        std::chrono::seconds{timestamp.tv_sec} + std::chrono::nanoseconds{timestamp.tv_nsec}};
+    return std::chrono::time_point_cast<std::filesystem::file_time_type::duration>(
+        std::chrono::file_clock::from_sys(systemTime));
+}
+
+// Stats `name` (relative to `directoryFd`) if the entry still lacks its type or anything the
+// options ask for.
+void ResolveEntry(
+    int directoryFd,
+    const char* name,
+    const DirectoryWalkOptions& options,
+    const ExecutePermission* permission,
+    DirectoryEntryInfo& entry)
+{
+    const bool typeUnknown = entry.type == DirectoryEntryType::Unknown;
+    const bool wantsExecutable = options.executable && entry.type != DirectoryEntryType::Directory;
+    if (!typeUnknown && !wantsExecutable && !options.lastWriteTime)
+    {
+        return;
+    }
+
+    unsigned mask = STATX_TYPE;
+    if (options.executable)
+    {
+        mask |= STATX_MODE | STATX_UID | STATX_GID;
+    }
+    if (options.lastWriteTime)
+    {
+        mask |= STATX_MTIME;
+    }
+
+    struct statx status{};
+    if (typeUnknown && !entry.isSymlink)
+    {
+        // No d_type: find out whether this is a link before following it, so a directory
+        // symlink is never mistaken for a directory to recurse into.
+        if (statx(directoryFd, name, AT_SYMLINK_NOFOLLOW, STATX_TYPE, &status) != 0)
+        {
+            return;
+        }
+        entry.isSymlink = S_ISLNK(status.stx_mode);
+    }
+    if (statx(directoryFd, name, AT_STATX_SYNC_AS_STAT, mask, &status) != 0)
+    {
+        return;
+    }
+
+    entry.type = TypeFromMode(status.stx_mode);
+    if (permission != nullptr && entry.type != DirectoryEntryType::Directory)
+    {
+        entry.isExecutable = permission->Allows(status);
+    }
+    if (options.lastWriteTime && (status.stx_mask & STATX_MTIME) != 0)
+    {
+        entry.lastWriteTime = ToFileTime(status.stx_mtime);
+        entry.hasLastWriteTime = true;
+    }
+}
+
+#else
+
+void ResolveEntry(const std::filesystem::path& path, const DirectoryWalkOptions& options, DirectoryEntryInfo& entry)
+{
+    std::error_code ec;
+    entry.isSymlink = std::filesystem::is_symlink(std::filesystem::symlink_status(path, ec));
+    const auto status = std::filesystem::status(path, ec);
+    if (!ec)
+    {
+        entry.type = std::filesystem::is_directory(status) ? DirectoryEntryType::Directory
+            : std::filesystem::is_regular_file(status)     ? DirectoryEntryType::Regular
+                                                           : DirectoryEntryType::Other;
+        if (options.executable && entry.type != DirectoryEntryType::Directory)
+        {
+            const auto execBits = std::filesystem::perms::owner_exec | std::filesystem::perms::group_exec
+                | std::filesystem::perms::others_exec;
+            entry.isExecutable = (status.permissions() & execBits) != std::filesystem::perms::none;
+        }
+    }
+    if (options.lastWriteTime)
+    {
+        entry.lastWriteTime = std::filesystem::last_write_time(path, ec);
+        entry.hasLastWriteTime = !ec;
+    }
+}
+
+#endif
+} // namespace
+
+#if defined(__linux__)
+
+std::vector<DirectoryEntryInfo> ListDirectory(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    std::error_code& ec)
+{
+    ec.clear();
+    std::vector<DirectoryEntryInfo> entries;
+
+    const FileDescriptor directoryFd(open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (directoryFd.Get() < 0)
+    {
+        ec.assign(errno, std::generic_category());
+        return entries;
+    }
+
+    // Pass 1: names and d_type only.
+    alignas(LinuxDirent64) char buffer[32 * 1024];
+    while (true)
+    {
+        const long bytes = syscall(SYS_getdents64, directoryFd.Get(), buffer, sizeof(buffer));
+        if (bytes < 0)
+        {
+            ec.assign(errno, std::generic_category());
+            return entries;
+        }
+        if (bytes == 0)
+        {
+            break;
+        }
+
+        for (long offset = 0; offset < bytes;)
+        {
+            const auto* record = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+            offset += record->d_reclen;
+
+            const char* name = record->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            {
+                continue;
+            }
+
+            DirectoryEntryInfo& entry = entries.emplace_back();
+            entry.name.assign(name);
+            switch (record->d_type)
+            {
+            case DT_DIR:
+                entry.type = DirectoryEntryType::Directory;
+                break;
+            case DT_REG:
+                entry.type = DirectoryEntryType::Regular;
+                break;
+            case DT_LNK:
+                entry.isSymlink = true;
+                break;
+            case DT_UNKNOWN:
+                break;
+            default:
+                entry.type = DirectoryEntryType::Other;
+                break;
+            }
+        }
+    }
+
+    // Pass 2: one statx per entry that still needs something, relative to the open directory.
+    std::optional<ExecutePermission> permission;
+    if (options.executable)
+    {
+        permission.emplace();
+    }
+
+    for (auto& entry : entries)
+    {
+        ResolveEntry(directoryFd.Get(), entry.name.c_str(), options, permission ? &*permission : nullptr, entry);
+    }
+
+    return entries;
+}
+
+#else
+
+std::vector<DirectoryEntryInfo> ListDirectory(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    std::error_code& ec)
+{
+    ec.clear();
+    std::vector<DirectoryEntryInfo> entries;
+
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+    {
+        DirectoryEntryInfo& entry = entries.emplace_back();
+        entry.name = it->path().filename().string();
+        ResolveEntry(it->path(), options, entry);
+    }
+
+    return entries;
+}
+
+#endif
+
+void ResolveEntryMetadata(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    DirectoryEntryInfo& entry)
+{
+#if defined(__linux__)
+    std::optional<ExecutePermission> permission;
+    if (options.executable)
+    {
+        permission.emplace();
+    }
+    const std::filesystem::path path = directory / entry.name;
+    ResolveEntry(AT_FDCWD, path.c_str(), options, permission ? &*permission : nullptr, entry);
+#else
+    ResolveEntry(directory / entry.name, options, entry);
+#endif
+}
+
+namespace
+{
+bool WalkBelow(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    const std::function<bool(const std::filesystem::path&, DirectoryEntryInfo&)>& visit)
+{
+    std::error_code ec;
+    auto entries = ListDirectory(directory, options, ec);
+    for (auto& entry : entries)
+    {
+        if (!visit(directory, entry))
+        {
+            return false;
+        }
+        if (entry.type == DirectoryEntryType::Directory && !entry.isSymlink
+            && !WalkBelow(directory / entry.name, options, visit))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+void WalkDirectoryTree(
+    const std::filesystem::path& root,
+    const DirectoryWalkOptions& options,
+    const std::function<bool(const std::filesystem::path&, DirectoryEntryInfo&)>& visit)
+{
+    WalkBelow(root, options, visit);
+}
+
+} // namespace colony
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace colony
+{
+
+enum class DirectoryEntryType
+{
+    Unknown,
+    Directory,
+    Regular,
+    Other,
+};
+
+struct DirectoryEntryInfo
+{
+    std::string name;
+    // Symlinks report their target's type, like std::filesystem::status; a dangling link is Unknown.
+    DirectoryEntryType type = DirectoryEntryType::Unknown;
+    bool isSymlink = false;
+    // Only filled for non-directories when DirectoryWalkOptions::executable is set.
+    bool isExecutable = false;
+    // Only filled when DirectoryWalkOptions::lastWriteTime is set.
+    bool hasLastWriteTime = false;
+    std::filesystem::file_time_type lastWriteTime{};
+};
+
+// Metadata beyond the entry type costs a stat per entry; ask only for what is used.
+struct DirectoryWalkOptions
+{
+    bool executable = false;
+    bool lastWriteTime = false;
+};
+
+// Lists one directory in the order the filesystem returns it, without "." and "..".
+//
+// On Linux the entries come from getdents64 and their types from d_type, so listing costs no
+// stat at all unless the options ask for metadata or the filesystem leaves d_type unset. What
+// is still needed is resolved in one pass of statx calls relative to the open directory, after
+// the listing, instead of one path lookup per std::filesystem call. Other platforms use
+// std::filesystem.
+std::vector<DirectoryEntryInfo> ListDirectory(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    std::error_code& ec);
+
+// Fills in what `options` asks for on an entry listed without it, e.g. only for the entries
+// of a walk that survive a name filter.
+void ResolveEntryMetadata(
+    const std::filesystem::path& directory,
+    const DirectoryWalkOptions& options,
+    DirectoryEntryInfo& entry);
+
+// Pre-order walk below `root` that skips unreadable directories and does not follow directory
+// symlinks, like recursive_directory_iterator with skip_permission_denied. `visit` receives
+// each entry's directory and returns false to stop the walk.
+void WalkDirectoryTree(
+    const std::filesystem::path& root,
+    const DirectoryWalkOptions& options,
+    const std::function<bool(const std::filesystem::path&, DirectoryEntryInfo&)>& visit);
+
+} // namespace colony
@@ -0,0 +1,190 @@
+#include "core/discovery_snapshot.hpp"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace colony
+{
+namespace
+{
+constexpr std::string_view kSnapshotHeader = "colony-discovery-snapshot 1";
+
+// Fields are tab separated; names that would break a line are simply never cached.
+bool IsStorableField(std::string_view value) noexcept
+{
+    return value.find_first_of("\t\r\n") == std::string_view::npos;
+}
+
+std::vector<std::string_view> SplitFields(std::string_view line)
+{
+    std::vector<std::string_view> fields;
+    std::size_t start = 0;
+    while (true)
+    {
+        const std::size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == std::string_view::npos ? std::string_view::npos : tab - start));
+        if (tab == std::string_view::npos)
+        {
+            return fields;
+        }
+        start = tab + 1;
+    }
+}
+
+bool ParseMtime(std::string_view text, std::int64_t& mtime)
+{
+    try
+    {
+        std::size_t consumed = 0;
+        mtime = std::stoll(std::string{text}, &consumed);
+        return consumed == text.size();
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+} // namespace
+
+bool DiscoverySnapshot::Load(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex_);
+    channels_.clear();
+    dirty_ = false;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec))
+    {
+        return true;
+    }
+
+    std::ifstream input(path);
+    std::string line;
+    if (!input || !std::getline(input, line) || line != kSnapshotHeader)
+    {
+        std::cerr << "Ignoring unreadable discovery snapshot: " << path.string() << '\n';
+        return false;
+    }
+
+    SnapshotChannelFolder* channel = nullptr;
+    while (std::getline(input, line))
+    {
+        const auto fields = SplitFields(line);
+        if (fields.size() == 3 && fields[0] == "C")
+        {
+            std::int64_t mtime = 0;
+            channel = ParseMtime(fields[1], mtime) ? &channels_[std::string{fields[2]}] : nullptr;
+            if (channel != nullptr)
+            {
+                *channel = SnapshotChannelFolder{mtime, {}};
+            }
+        }
+        else if (fields.size() == 5 && fields[0] == "P" && channel != nullptr)
+        {
+            SnapshotProgramFolder program;
+            if (ParseMtime(fields[1], program.mtime))
+            {
+                program.isPythonScript = fields[2] == "1";
+                program.folderName = std::string{fields[3]};
+                program.launchTarget = std::string{fields[4]};
+                channel->programs.push_back(std::move(program));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool DiscoverySnapshot::Save(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex_);
+    if (!dirty_)
+    {
+        return true;
+    }
+
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::trunc);
+        if (!output)
+        {
+            std::cerr << "Unable to write discovery snapshot: " << temporaryPath.string() << '\n';
+            return false;
+        }
+
+        output << kSnapshotHeader << '\n';
+        for (const auto& [channelFolder, channel] : channels_)
+        {
+            if (!IsStorableField(channelFolder))
+            {
+                continue;
+            }
+            output << "C\t" << channel.mtime << '\t' << channelFolder << '\n';
+            for (const auto& program : channel.programs)
+            {
+                if (IsStorableField(program.folderName) && IsStorableField(program.launchTarget))
+                {
+                    output << "P\t" << program.mtime << '\t' << (program.isPythonScript ? '1' : '0') << '\t'
+                           << program.folderName << '\t' << program.launchTarget << '\n';
+                }
+            }
+        }
+        if (!output)
+        {
+            std::cerr << "Unable to write discovery snapshot: " << temporaryPath.string() << '\n';
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec)
+    {
+        std::cerr << "Unable to replace discovery snapshot: " << ec.message() << '\n';
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+
+    dirty_ = false;
+    return true;
+}
+
+std::optional<SnapshotChannelFolder> DiscoverySnapshot::Find(const std::filesystem::path& channelFolder) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = channels_.find(channelFolder.string());
+    if (it == channels_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void DiscoverySnapshot::Store(const std::filesystem::path& channelFolder, SnapshotChannelFolder channel)
+{
+    std::lock_guard lock(mutex_);
+    const auto [it, inserted] = channels_.try_emplace(channelFolder.string());
+    if (inserted || it->second != channel)
+    {
+        it->second = std::move(channel);
+        dirty_ = true;
+    }
+}
+
+std::int64_t DiscoverySnapshot::FolderMtime(const std::filesystem::path& folder)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(folder, ec);
+    if (ec)
+    {
+        return kUnknownMtime;
+    }
+    return static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+} // namespace colony
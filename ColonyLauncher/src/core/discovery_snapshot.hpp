@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+// What a scan derived from one program folder. The launch target is a file name inside the
+// folder; an empty name means the folder had no files.
+struct SnapshotProgramFolder
+{
+    std::string folderName;
+    std::int64_t mtime = 0;
+    std::string launchTarget;
+    bool isPythonScript = false;
+
+    bool operator==(const SnapshotProgramFolder&) const = default;
+};
+
+struct SnapshotChannelFolder
+{
+    std::int64_t mtime = 0;
+    std::vector<SnapshotProgramFolder> programs;
+
+    bool operator==(const SnapshotChannelFolder&) const = default;
+};
+
+// Results of the previous discovery run, keyed by channel folder path. A directory's mtime
+// changes whenever an entry inside it is added, removed or renamed, so an unchanged channel
+// folder mtime means its program folders are the ones recorded, and an unchanged program
+// folder mtime means its launch target can be reused without listing the folder.
+//
+// Discovery workers look up and store channels concurrently, so every member locks.
+class DiscoverySnapshot
+{
+  public:
+    static constexpr std::int64_t kUnknownMtime = std::numeric_limits<std::int64_t>::min();
+
+    // Returns false if an existing snapshot could not be read; it then starts empty.
+    bool Load(const std::filesystem::path& path);
+    // Writes the snapshot if anything was stored since the last Load or Save.
+    bool Save(const std::filesystem::path& path);
+
+    [[nodiscard]] std::optional<SnapshotChannelFolder> Find(const std::filesystem::path& channelFolder) const;
+    void Store(const std::filesystem::path& channelFolder, SnapshotChannelFolder channel);
+
+    [[nodiscard]] static std::int64_t FolderMtime(const std::filesystem::path& folder);
+
+  private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, SnapshotChannelFolder> channels_;
+    bool dirty_ = false;
+};
+
+} // namespace colony
@@ -0,0 +1,429 @@
+#include "core/discovery_watcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+// Unpacking an archive or copying a folder produces a burst of events; waiting for a quiet
+// period turns the burst into one rebuild. The cap keeps a constantly busy folder visible.
+constexpr auto kSettleDelay = std::chrono::milliseconds{150};
+constexpr auto kMaxBatchDelay = std::chrono::milliseconds{1000};
+
+#if defined(__linux__)
+constexpr std::uint32_t kChannelFolderMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB | IN_ONLYDIR;
+constexpr std::uint32_t kProgramFolderMask = kChannelFolderMask | IN_CLOSE_WRITE;
+// Only channel folders appearing or going away matter at the root.
+constexpr std::uint32_t kContentRootMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#endif
+} // namespace
+
+DiscoveryWatcher::~DiscoveryWatcher()
+{
+    Stop();
+}
+
+#if defined(__linux__)
+
+DiscoveryWatcher::State::~State()
+{
+    if (inotifyFd >= 0)
+    {
+        close(inotifyFd);
+    }
+    if (stopFd >= 0)
+    {
+        close(stopFd);
+    }
+}
+
+bool DiscoveryWatcher::Start(std::filesystem::path contentRoot, std::vector<FolderChannelSpec> specs, Notify notify)
+{
+    Stop();
+
+    auto state = std::make_shared<State>();
+    state->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (state->inotifyFd < 0)
+    {
+        std::cerr << "Unable to watch content folders; discovery stays startup-only." << '\n';
+        return false;
+    }
+    state->stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (state->stopFd < 0)
+    {
+        return false;
+    }
+
+    state->contentRoot = std::move(contentRoot);
+    state->specs = std::move(specs);
+    state->notify = std::move(notify);
+    state_ = std::move(state);
+    std::thread([state = state_]() { Run(state); }).detach();
+    return true;
+}
+
+void DiscoveryWatcher::Stop()
+{
+    if (!state_)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->cancelled.store(true, std::memory_order_relaxed);
+        state_->notify = nullptr;
+        state_->changes.clear();
+    }
+    // Wakes the thread if it is waiting for events; if it is stuck listing a folder it sees
+    // the flag once that returns.
+    const std::uint64_t value = 1;
+    [[maybe_unused]] const auto written = write(state_->stopFd, &value, sizeof(value));
+    state_.reset();
+}
+
+void DiscoveryWatcher::Run(const std::shared_ptr<State>& state)
+{
+    // The root is watched first so a channel folder created while the others are listed is
+    // not missed.
+    const int rootDescriptor = inotify_add_watch(state->inotifyFd, state->contentRoot.c_str(), kContentRootMask);
+    if (rootDescriptor >= 0)
+    {
+        state->watches[rootDescriptor] = WatchTarget{kContentRootTarget, {}};
+    }
+    for (std::size_t specIndex = 0; specIndex < state->specs.size(); ++specIndex)
+    {
+        if (state->cancelled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        WatchChannelFolder(*state, specIndex, nullptr);
+    }
+
+    std::vector<DirtyFolder> dirty;
+    auto batchStart = std::chrono::steady_clock::now();
+    while (!state->cancelled.load(std::memory_order_relaxed))
+    {
+        int timeoutMs = -1;
+        if (!dirty.empty())
+        {
+            const auto remaining = kMaxBatchDelay - (std::chrono::steady_clock::now() - batchStart);
+            timeoutMs = static_cast<int>(std::clamp(
+                std::chrono::duration_cast<std::chrono::milliseconds>(remaining).count(),
+                std::chrono::milliseconds::rep{0},
+                std::chrono::milliseconds{kSettleDelay}.count()));
+        }
+
+        pollfd fds[2]{{state->inotifyFd, POLLIN, 0}, {state->stopFd, POLLIN, 0}};
+        const int ready = poll(fds, 2, timeoutMs);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        if ((fds[1].revents & POLLIN) != 0)
+        {
+            break;
+        }
+
+        if (ready > 0)
+        {
+            const bool wasEmpty = dirty.empty();
+            if (!ReadEvents(*state, dirty))
+            {
+                break;
+            }
+            if (wasEmpty)
+            {
+                batchStart = std::chrono::steady_clock::now();
+            }
+            if (std::chrono::steady_clock::now() - batchStart < kMaxBatchDelay)
+            {
+                continue;
+            }
+        }
+
+        if (!dirty.empty())
+        {
+            Publish(*state, dirty);
+            dirty.clear();
+        }
+    }
+}
+
+void DiscoveryWatcher::WatchChannelFolder(State& state, std::size_t specIndex, std::vector<DirtyFolder>* dirty)
+{
+    const std::filesystem::path channelFolder = state.contentRoot / state.specs[specIndex].folderName;
+    const int descriptor = inotify_add_watch(state.inotifyFd, channelFolder.c_str(), kChannelFolderMask);
+    if (descriptor < 0)
+    {
+        return;
+    }
+    state.watches[descriptor] = WatchTarget{specIndex, {}};
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(channelFolder, ec), end; !ec && it != end; it.increment(ec))
+    {
+        if (it->is_directory(ec))
+        {
+            const std::string folderName = it->path().filename().string();
+            WatchProgramFolder(state, specIndex, folderName);
+            if (dirty != nullptr)
+            {
+                AddDirty(*dirty, DirtyFolder{specIndex, folderName});
+            }
+        }
+    }
+}
+
+void DiscoveryWatcher::WatchProgramFolder(State& state, std::size_t specIndex, const std::string& folderName)
+{
+    const std::filesystem::path programFolder = state.contentRoot / state.specs[specIndex].folderName / folderName;
+    const int descriptor = inotify_add_watch(state.inotifyFd, programFolder.c_str(), kProgramFolderMask);
+    if (descriptor >= 0)
+    {
+        state.watches[descriptor] = WatchTarget{specIndex, folderName};
+    }
+}
+
+void DiscoveryWatcher::ForgetChannelFolder(State& state, std::size_t specIndex, std::vector<DirtyFolder>& dirty)
+{
+    // Rebuilding the folders it held reports each of their programs as removed.
+    std::erase_if(state.watches, [&](const auto& entry) {
+        if (entry.second.specIndex != specIndex)
+        {
+            return false;
+        }
+        if (!entry.second.folderName.empty())
+        {
+            AddDirty(dirty, DirtyFolder{specIndex, entry.second.folderName});
+        }
+        inotify_rm_watch(state.inotifyFd, entry.first);
+        return true;
+    });
+}
+
+void DiscoveryWatcher::MarkAllDirty(State& state, std::vector<DirtyFolder>& dirty)
+{
+    for (const auto& [descriptor, target] : state.watches)
+    {
+        if (target.specIndex != kContentRootTarget && !target.folderName.empty())
+        {
+            AddDirty(dirty, DirtyFolder{target.specIndex, target.folderName});
+        }
+    }
+    for (std::size_t specIndex = 0; specIndex < state.specs.size(); ++specIndex)
+    {
+        WatchChannelFolder(state, specIndex, &dirty);
+    }
+}
+
+bool DiscoveryWatcher::ReadEvents(State& state, std::vector<DirtyFolder>& dirty)
+{
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        const ssize_t length = read(state.inotifyFd, buffer, sizeof(buffer));
+        if (length < 0)
+        {
+            return errno == EAGAIN || errno == EINTR;
+        }
+        if (length == 0)
+        {
+            return false;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                MarkAllDirty(state, dirty);
+                continue;
+            }
+
+            const auto watchIt = state.watches.find(event->wd);
+            if (watchIt == state.watches.end())
+            {
+                continue;
+            }
+            if ((event->mask & IN_IGNORED) != 0)
+            {
+                state.watches.erase(watchIt);
+                continue;
+            }
+
+            const WatchTarget target = watchIt->second;
+            if (!target.folderName.empty())
+            {
+                AddDirty(dirty, DirtyFolder{target.specIndex, target.folderName});
+                continue;
+            }
+
+            // Plain files next to the program folders are not programs.
+            if ((event->mask & IN_ISDIR) == 0 || event->len == 0)
+            {
+                continue;
+            }
+
+            const std::string folderName{event->name};
+            if (target.specIndex == kContentRootTarget)
+            {
+                const auto specIt = std::find_if(state.specs.begin(), state.specs.end(), [&](const FolderChannelSpec& spec) {
+                    return spec.folderName == folderName;
+                });
+                if (specIt == state.specs.end())
+                {
+                    continue;
+                }
+                const auto specIndex = static_cast<std::size_t>(std::distance(state.specs.begin(), specIt));
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+                {
+                    WatchChannelFolder(state, specIndex, &dirty);
+                }
+                else
+                {
+                    ForgetChannelFolder(state, specIndex, dirty);
+                }
+                continue;
+            }
+
+            AddDirty(dirty, DirtyFolder{target.specIndex, folderName});
+            if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+            {
+                WatchProgramFolder(state, target.specIndex, folderName);
+            }
+            else if ((event->mask & IN_MOVED_FROM) != 0)
+            {
+                // The watch follows the inode; drop it so the moved folder stops reporting
+                // under its old name.
+                const auto movedIt = std::find_if(state.watches.begin(), state.watches.end(), [&](const auto& entry) {
+                    return entry.second.specIndex == target.specIndex && entry.second.folderName == folderName;
+                });
+                if (movedIt != state.watches.end())
+                {
+                    inotify_rm_watch(state.inotifyFd, movedIt->first);
+                    state.watches.erase(movedIt);
+                }
+            }
+        }
+    }
+}
+
+#else
+
+DiscoveryWatcher::State::~State()
+{
+}
+
+bool DiscoveryWatcher::Start(std::filesystem::path, std::vector<FolderChannelSpec>, Notify)
+{
+    return false;
+}
+
+void DiscoveryWatcher::Stop()
+{
+}
+
+void DiscoveryWatcher::Run(const std::shared_ptr<State>&)
+{
+}
+
+void DiscoveryWatcher::WatchChannelFolder(State&, std::size_t, std::vector<DirtyFolder>*)
+{
+}
+
+void DiscoveryWatcher::WatchProgramFolder(State&, std::size_t, const std::string&)
+{
+}
+
+void DiscoveryWatcher::ForgetChannelFolder(State&, std::size_t, std::vector<DirtyFolder>&)
+{
+}
+
+void DiscoveryWatcher::MarkAllDirty(State&, std::vector<DirtyFolder>&)
+{
+}
+
+bool DiscoveryWatcher::ReadEvents(State&, std::vector<DirtyFolder>&)
+{
+    return false;
+}
+
+#endif
+
+void DiscoveryWatcher::Publish(State& state, const std::vector<DirtyFolder>& dirty)
+{
+    std::vector<DiscoveryChange> changes;
+    changes.reserve(dirty.size());
+    for (const auto& folder : dirty)
+    {
+        const FolderChannelSpec& spec = state.specs[folder.specIndex];
+        DiscoveryChange change;
+        change.channelId = spec.id;
+        if (auto program = DiscoverProgramFromFolder(spec.id, state.contentRoot / spec.folderName / folder.folderName))
+        {
+            change.kind = DiscoveryChange::Kind::Upsert;
+            change.programId = program->programId;
+            change.program = std::move(*program);
+        }
+        else
+        {
+            change.kind = DiscoveryChange::Kind::Remove;
+            change.programId = DiscoveredProgramId(spec.id, folder.folderName);
+        }
+        changes.push_back(std::move(change));
+    }
+
+    std::lock_guard lock(state.mutex);
+    if (state.cancelled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    state.changes.insert(
+        state.changes.end(), std::make_move_iterator(changes.begin()), std::make_move_iterator(changes.end()));
+    if (state.notify)
+    {
+        state.notify();
+    }
+}
+
+void DiscoveryWatcher::AddDirty(std::vector<DirtyFolder>& dirty, DirtyFolder folder)
+{
+    if (std::find(dirty.begin(), dirty.end(), folder) == dirty.end())
+    {
+        dirty.push_back(std::move(folder));
+    }
+}
+
+std::vector<DiscoveryChange> DiscoveryWatcher::TakeChanges()
+{
+    if (!state_)
+    {
+        return {};
+    }
+
+    std::lock_guard lock(state_->mutex);
+    return std::exchange(state_->changes, {});
+}
+
+} // namespace colony
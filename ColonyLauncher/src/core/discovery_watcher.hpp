@@ -0,0 +1,113 @@
+#pragma once
+
+#include "core/filesystem_discovery.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+struct DiscoveryChange
+{
+    enum class Kind
+    {
+        Upsert,
+        Remove,
+    };
+
+    Kind kind = Kind::Upsert;
+    std::string channelId;
+    std::string programId;
+    // Only set for Upsert.
+    DiscoveredProgram program;
+};
+
+// Watches the channel folders and each program folder inside them with inotify, so programs
+// dropped in, removed, renamed or made executable show up without a restart. Events are
+// coalesced per program folder until the tree has been quiet for a short while; each dirty
+// folder is then rebuilt on its own and reported as a single change. The content root is
+// watched too, so a channel folder created or moved in later is picked up with its programs.
+//
+// The watcher thread queues changes until the owner takes them; `notify` runs on that thread
+// after each batch. Only Linux has a backend; elsewhere Start returns false.
+//
+// The thread is detached, like AsyncChannelDiscovery's workers: it lists folders and rebuilds
+// programs, which can hang on a dead mount, and Stop must not wait for that. Once Stop returns
+// no change is queued and `notify` never runs again; the thread exits when it next wakes.
+class DiscoveryWatcher
+{
+  public:
+    using Notify = std::function<void()>;
+
+    DiscoveryWatcher() = default;
+    DiscoveryWatcher(const DiscoveryWatcher&) = delete;
+    DiscoveryWatcher& operator=(const DiscoveryWatcher&) = delete;
+    ~DiscoveryWatcher();
+
+    bool Start(std::filesystem::path contentRoot, std::vector<FolderChannelSpec> specs, Notify notify);
+    void Stop();
+
+    [[nodiscard]] std::vector<DiscoveryChange> TakeChanges();
+
+  private:
+    struct DirtyFolder
+    {
+        std::size_t specIndex = 0;
+        std::string folderName;
+
+        bool operator==(const DirtyFolder&) const = default;
+    };
+
+    struct WatchTarget
+    {
+        // kContentRootTarget for the content root.
+        std::size_t specIndex = 0;
+        // Empty for the channel folder itself.
+        std::string folderName;
+    };
+
+    static constexpr std::size_t kContentRootTarget = static_cast<std::size_t>(-1);
+
+    // Shared with the thread, which holds it until it exits; the descriptors close with it.
+    struct State
+    {
+        State() = default;
+        State(const State&) = delete;
+        State& operator=(const State&) = delete;
+        ~State();
+
+        std::filesystem::path contentRoot;
+        std::vector<FolderChannelSpec> specs;
+        int inotifyFd = -1;
+        int stopFd = -1;
+        std::atomic<bool> cancelled{false};
+        // Only touched by the watcher thread.
+        std::unordered_map<int, WatchTarget> watches;
+
+        std::mutex mutex;
+        std::vector<DiscoveryChange> changes;
+        Notify notify;
+    };
+
+    static void AddDirty(std::vector<DirtyFolder>& dirty, DirtyFolder folder);
+
+    static void Run(const std::shared_ptr<State>& state);
+    static void WatchChannelFolder(State& state, std::size_t specIndex, std::vector<DirtyFolder>* dirty);
+    static void WatchProgramFolder(State& state, std::size_t specIndex, const std::string& folderName);
+    static void ForgetChannelFolder(State& state, std::size_t specIndex, std::vector<DirtyFolder>& dirty);
+    static void MarkAllDirty(State& state, std::vector<DirtyFolder>& dirty);
+    static bool ReadEvents(State& state, std::vector<DirtyFolder>& dirty);
+    static void Publish(State& state, const std::vector<DirtyFolder>& dirty);
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace colony
@@ -1,17 +1,19 @@
 #include "core/filesystem_discovery.hpp"
 
+#include "core/directory_walker.hpp"
+
 #include <algorithm>
 #include <cctype>
 #include <fstream>
 #include <optional>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace colony
 {
-namespace
-{
-std::string SanitizeProgramId(std::string_view channelId, std::string_view folderName)
+
+std::string DiscoveredProgramId(std::string_view channelId, std::string_view folderName)
 {
     std::string programId;
     programId.reserve(channelId.size() + folderName.size() + 1);
@@ -53,6 +55,8 @@ std::string SanitizeProgramId(std::string_view channelId, std::string_view folde
     return programId;
 }
 
+namespace
+{
 std::string MakeDisplayName(std::string name)
 {
     std::replace(name.begin(), name.end(), '_', ' ');
@@ -77,71 +81,52 @@ std::string MakeDisplayName(std::string name)
     return name;
 }
 
-bool HasExecutableBit(const std::filesystem::directory_entry& entry)
-{
-    std::error_code ec;
-    const auto status = entry.status(ec);
-    if (ec)
-    {
-        return false;
-    }
-
-    return (status.permissions() & std::filesystem::perms::owner_exec) != std::filesystem::perms::none
-        || (status.permissions() & std::filesystem::perms::group_exec) != std::filesystem::perms::none
-        || (status.permissions() & std::filesystem::perms::others_exec) != std::filesystem::perms::none;
-}
-
-bool IsExecutableFile(const std::filesystem::directory_entry& entry)
+bool HasKnownExecutableExtension(const std::string& fileName)
 {
-    if (!entry.is_regular_file())
-    {
-        return false;
-    }
-
-    const std::filesystem::path path = entry.path();
-    const std::string extension = path.extension().string();
-
     static const std::vector<std::string> kKnownExecutableExtensions{
         ".exe", ".bat", ".cmd", ".sh", ".py", ".appimage"};
 
-    if (HasExecutableBit(entry))
-    {
-        return true;
-    }
-
+    const std::string extension = std::filesystem::path{fileName}.extension().string();
     return std::find(kKnownExecutableExtensions.begin(), kKnownExecutableExtensions.end(), extension)
         != kKnownExecutableExtensions.end();
 }
 
-std::optional<std::filesystem::directory_entry> FindLaunchCandidate(const std::filesystem::path& folder)
+// First file that is executable or looks like a launcher, else the first file at all.
+std::optional<std::filesystem::path> FindLaunchCandidate(const std::filesystem::path& folder)
 {
-    std::optional<std::filesystem::directory_entry> firstFile;
+    std::error_code ec;
+    const auto entries = ListDirectory(folder, DirectoryWalkOptions{.executable = true}, ec);
 
-    for (const auto& entry : std::filesystem::directory_iterator(folder))
+    const DirectoryEntryInfo* firstFile = nullptr;
+    for (const auto& entry : entries)
     {
-        if (!entry.is_regular_file())
+        if (entry.type != DirectoryEntryType::Regular)
         {
             continue;
         }
 
-        if (!firstFile)
+        if (firstFile == nullptr)
         {
-            firstFile = entry;
+            firstFile = &entry;
         }
 
-        if (IsExecutableFile(entry))
+        if (entry.isExecutable || HasKnownExecutableExtension(entry.name))
         {
-            return entry;
+            return folder / entry.name;
         }
     }
 
-    return firstFile;
+    if (firstFile == nullptr)
+    {
+        return std::nullopt;
+    }
+    return folder / firstFile->name;
 }
 
 ViewContent BuildViewFromFolder(
     const std::string& folderName,
     const std::filesystem::path& folderPath,
-    const std::optional<std::filesystem::directory_entry>& launchCandidate)
+    const std::filesystem::path& launchTarget)
 {
     ViewContent view;
     view.heading = MakeDisplayName(folderName);
@@ -150,59 +135,168 @@ ViewContent BuildViewFromFolder(
     view.statusMessage = "Select launch target";
     view.paragraphs.push_back("Folder: " + folderPath.string());
 
-    if (launchCandidate.has_value())
+    if (!launchTarget.empty())
     {
         view.sections.push_back(ViewSection{
             .title = "Launch targets",
-            .options = {launchCandidate->path().filename().string()},
+            .options = {launchTarget.filename().string()},
         });
     }
 
     return view;
 }
 
-DiscoveredProgram BuildProgramFromFolder(
+DiscoveredProgram BuildProgram(
     const std::string& channelId,
-    const std::filesystem::directory_entry& folder)
+    const std::filesystem::path& folderPath,
+    std::filesystem::path launchTarget)
 {
-    const auto launchCandidate = FindLaunchCandidate(folder.path());
-    const std::string programId = SanitizeProgramId(channelId, folder.path().filename().string());
+    const std::string folderName = folderPath.filename().string();
 
     DiscoveredProgram program;
-    program.programId = programId;
-    program.launchTarget = launchCandidate ? launchCandidate->path() : std::filesystem::path{};
-    program.isPythonScript = launchCandidate && launchCandidate->path().extension() == ".py";
-    program.view = BuildViewFromFolder(folder.path().filename().string(), folder.path(), launchCandidate);
+    program.programId = DiscoveredProgramId(channelId, folderName);
+    program.isPythonScript = launchTarget.extension() == ".py";
+    program.view = BuildViewFromFolder(folderName, folderPath, launchTarget);
+    program.launchTarget = std::move(launchTarget);
 
     return program;
 }
 
-std::vector<DiscoveredProgram> DiscoverProgramsForChannel(
+DiscoveredProgram BuildProgramFromFolder(const std::string& channelId, const std::filesystem::path& folderPath)
+{
+    const auto launchCandidate = FindLaunchCandidate(folderPath);
+    return BuildProgram(channelId, folderPath, launchCandidate.value_or(std::filesystem::path{}));
+}
+
+} // namespace
+
+std::optional<DiscoveredProgram> DiscoverProgramFromFolder(
+    const std::string& channelId,
+    const std::filesystem::path& programFolder)
+{
+    std::error_code ec;
+    const std::filesystem::directory_entry entry(programFolder, ec);
+    if (ec || !entry.is_directory(ec))
+    {
+        return std::nullopt;
+    }
+    return BuildProgramFromFolder(channelId, programFolder);
+}
+
+DiscoveredChannel DiscoverChannelFromFilesystem(
     const std::filesystem::path& contentRoot,
-    const FolderChannelSpec& channel)
+    const FolderChannelSpec& spec,
+    std::chrono::steady_clock::time_point deadline,
+    const std::atomic<bool>* cancelled,
+    DiscoverySnapshot* snapshot)
 {
-    std::vector<DiscoveredProgram> programs;
+    DiscoveredChannel channel;
+    channel.id = spec.id;
+    channel.label = spec.label;
 
-    const std::filesystem::path folderPath = contentRoot / channel.folderName;
+    const auto shouldStop = [&]() {
+        return (cancelled != nullptr && cancelled->load(std::memory_order_relaxed))
+            || std::chrono::steady_clock::now() >= deadline;
+    };
+
+    const std::filesystem::path folderPath = contentRoot / spec.folderName;
     std::error_code ec;
+    if (shouldStop())
+    {
+        channel.complete = false;
+        return channel;
+    }
     if (!std::filesystem::is_directory(folderPath, ec))
     {
-        return programs;
+        return channel;
     }
 
-    for (const auto& entry : std::filesystem::directory_iterator(folderPath))
+    SnapshotChannelFolder record;
+    record.mtime = DiscoverySnapshot::FolderMtime(folderPath);
+    const std::optional<SnapshotChannelFolder> cached = snapshot != nullptr ? snapshot->Find(folderPath) : std::nullopt;
+    std::unordered_map<std::string_view, const SnapshotProgramFolder*> cachedPrograms;
+    if (cached)
     {
-        if (!entry.is_directory())
+        cachedPrograms.reserve(cached->programs.size());
+        for (const auto& program : cached->programs)
         {
-            continue;
+            cachedPrograms.emplace(program.folderName, &program);
+        }
+    }
+
+    const auto addProgram = [&](const std::filesystem::path& programFolder, std::int64_t mtime) {
+        SnapshotProgramFolder entry;
+        entry.folderName = programFolder.filename().string();
+        entry.mtime = mtime;
+
+        const auto cachedIt = cachedPrograms.find(entry.folderName);
+        if (mtime != DiscoverySnapshot::kUnknownMtime && cachedIt != cachedPrograms.end() && cachedIt->second->mtime == mtime)
+        {
+            entry = *cachedIt->second;
+            channel.programs.push_back(BuildProgram(
+                spec.id,
+                programFolder,
+                entry.launchTarget.empty() ? std::filesystem::path{} : programFolder / entry.launchTarget));
+        }
+        else
+        {
+            channel.programs.push_back(BuildProgramFromFolder(spec.id, programFolder));
+            const DiscoveredProgram& program = channel.programs.back();
+            entry.launchTarget = program.launchTarget.filename().string();
+            entry.isPythonScript = program.isPythonScript;
+        }
+        record.programs.push_back(std::move(entry));
+    };
+
+    if (cached && record.mtime != DiscoverySnapshot::kUnknownMtime && cached->mtime == record.mtime)
+    {
+        // No entry was added, removed or renamed in the channel folder, so the recorded program
+        // folders are still the complete list: one stat each instead of listing the tree.
+        for (const auto& program : cached->programs)
+        {
+            if (shouldStop())
+            {
+                channel.complete = false;
+                break;
+            }
+
+            const std::filesystem::path programFolder = folderPath / program.folderName;
+            const std::int64_t mtime = DiscoverySnapshot::FolderMtime(programFolder);
+            if (mtime != DiscoverySnapshot::kUnknownMtime)
+            {
+                addProgram(programFolder, mtime);
+            }
         }
+    }
+    else
+    {
+        const auto entries = ListDirectory(folderPath, DirectoryWalkOptions{.lastWriteTime = snapshot != nullptr}, ec);
+        for (const auto& entry : entries)
+        {
+            if (shouldStop())
+            {
+                channel.complete = false;
+                break;
+            }
 
-        programs.emplace_back(BuildProgramFromFolder(channel.id, entry));
+            if (entry.type != DirectoryEntryType::Directory)
+            {
+                continue;
+            }
+
+            const std::int64_t mtime = entry.hasLastWriteTime
+                ? static_cast<std::int64_t>(entry.lastWriteTime.time_since_epoch().count())
+                : DiscoverySnapshot::kUnknownMtime;
+            addProgram(folderPath / entry.name, mtime);
+        }
     }
 
-    return programs;
+    if (snapshot != nullptr && channel.complete)
+    {
+        snapshot->Store(folderPath, std::move(record));
+    }
+    return channel;
 }
-} // namespace
 
 std::vector<DiscoveredChannel> DiscoverChannelsFromFilesystem(
     const std::filesystem::path& contentRoot,
@@ -213,11 +307,7 @@ std::vector<DiscoveredChannel> DiscoverChannelsFromFilesystem(
 
     for (const auto& spec : channelSpecs)
     {
-        DiscoveredChannel channel;
-        channel.id = spec.id;
-        channel.label = spec.label;
-        channel.programs = DiscoverProgramsForChannel(contentRoot, spec);
-
+        DiscoveredChannel channel = DiscoverChannelFromFilesystem(contentRoot, spec);
         if (!channel.programs.empty())
         {
             channels.push_back(std::move(channel));
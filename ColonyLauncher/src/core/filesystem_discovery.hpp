@@ -1,9 +1,14 @@
 #pragma once
 
 #include "core/content.hpp"
+#include "core/discovery_snapshot.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace colony
@@ -29,8 +34,32 @@ struct DiscoveredChannel
     std::string id;
     std::string label;
     std::vector<DiscoveredProgram> programs;
+    // False when the scan hit its deadline or was cancelled; `programs` holds what was found
+    // up to that point.
+    bool complete = true;
 };
 
+// Id of the program discovered in `folderName`; it depends only on the names, so a removed
+// folder can be mapped back to the program it produced.
+std::string DiscoveredProgramId(std::string_view channelId, std::string_view folderName);
+
+// Rebuilds the program for a single folder, or nullopt when it no longer is a directory.
+std::optional<DiscoveredProgram> DiscoverProgramFromFolder(
+    const std::string& channelId,
+    const std::filesystem::path& programFolder);
+
+// Scans the program folders of one channel. The deadline and cancel flag are checked before
+// each program folder, so a slow mount stops the scan between folders rather than mid-folder.
+// With a snapshot, folders whose mtime matches the recorded one reuse the recorded launch
+// target, and a complete scan is stored back into it.
+DiscoveredChannel DiscoverChannelFromFilesystem(
+    const std::filesystem::path& contentRoot,
+    const FolderChannelSpec& spec,
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(),
+    const std::atomic<bool>* cancelled = nullptr,
+    DiscoverySnapshot* snapshot = nullptr);
+
+// Synchronous scan of every channel; channels without programs are left out.
 std::vector<DiscoveredChannel> DiscoverChannelsFromFilesystem(
     const std::filesystem::path& contentRoot,
     const std::vector<FolderChannelSpec>& channelSpecs);
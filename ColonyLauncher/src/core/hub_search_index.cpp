@@ -0,0 +1,155 @@
+#include "core/hub_search_index.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <utility>
+
+namespace colony
+{
+
+void HubSearchIndex::Build(const std::vector<std::string>& documents)
+{
+    terms_.clear();
+    documentCount_ = documents.size();
+
+    std::vector<std::pair<std::string, std::uint32_t>> postings;
+    for (std::size_t index = 0; index < documents.size(); ++index)
+    {
+        for (auto& token : Tokenize(documents[index]))
+        {
+            postings.emplace_back(std::move(token), static_cast<std::uint32_t>(index));
+        }
+    }
+
+    std::sort(postings.begin(), postings.end());
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+    for (auto& [text, document] : postings)
+    {
+        if (terms_.empty() || terms_.back().text != text)
+        {
+            terms_.push_back(Term{std::move(text), {}});
+        }
+        terms_.back().documents.push_back(document);
+    }
+}
+
+void HubSearchIndex::Clear() noexcept
+{
+    terms_.clear();
+    documentCount_ = 0;
+}
+
+std::vector<std::size_t> HubSearchIndex::Match(const std::vector<std::string>& tokens) const
+{
+    std::vector<std::size_t> result;
+    if (tokens.empty())
+    {
+        result.resize(documentCount_);
+        std::iota(result.begin(), result.end(), std::size_t{0});
+        return result;
+    }
+
+    std::vector<std::uint8_t> matched(documentCount_, 1);
+    std::vector<std::uint8_t> hits(documentCount_, 0);
+    for (const auto& token : tokens)
+    {
+        std::fill(hits.begin(), hits.end(), std::uint8_t{0});
+        CollectMatches(token, hits);
+        for (std::size_t index = 0; index < documentCount_; ++index)
+        {
+            matched[index] &= hits[index];
+        }
+    }
+
+    for (std::size_t index = 0; index < documentCount_; ++index)
+    {
+        if (matched[index] != 0)
+        {
+            result.push_back(index);
+        }
+    }
+    return result;
+}
+
+void HubSearchIndex::CollectMatches(std::string_view token, std::vector<std::uint8_t>& hits) const
+{
+    const auto mark = [&hits](const Term& term) {
+        for (const std::uint32_t document : term.documents)
+        {
+            hits[document] = 1;
+        }
+    };
+
+    // Terms are sorted, so the ones starting with the token form a single run.
+    const auto prefixBegin = std::lower_bound(
+        terms_.begin(),
+        terms_.end(),
+        token,
+        [](const Term& term, std::string_view value) { return std::string_view{term.text} < value; });
+    auto prefixEnd = prefixBegin;
+    while (prefixEnd != terms_.end() && prefixEnd->text.starts_with(token))
+    {
+        mark(*prefixEnd);
+        ++prefixEnd;
+    }
+
+    // Everything else can only contain the token past its first character.
+    const auto scan = [&](auto begin, auto end) {
+        for (auto it = begin; it != end; ++it)
+        {
+            if (it->text.size() > token.size() && it->text.find(token, 1) != std::string::npos)
+            {
+                mark(*it);
+            }
+        }
+    };
+    scan(terms_.begin(), prefixBegin);
+    scan(prefixEnd, terms_.end());
+}
+
+std::string HubSearchIndex::Normalize(std::string_view value)
+{
+    std::string normalized;
+    normalized.reserve(value.size());
+    bool previousSpace = false;
+    for (unsigned char raw : value)
+    {
+        if (std::isalnum(raw) != 0)
+        {
+            normalized.push_back(static_cast<char>(std::tolower(raw)));
+            previousSpace = false;
+        }
+        else if (!previousSpace && !normalized.empty())
+        {
+            normalized.push_back(' ');
+            previousSpace = true;
+        }
+    }
+    if (!normalized.empty() && normalized.back() == ' ')
+    {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+std::vector<std::string> HubSearchIndex::Tokenize(std::string_view value)
+{
+    std::vector<std::string> tokens;
+    const std::string normalized = Normalize(value);
+    std::size_t start = 0;
+    while (start < normalized.size())
+    {
+        std::size_t end = normalized.find(' ', start);
+        if (end == std::string::npos)
+        {
+            end = normalized.size();
+        }
+        tokens.emplace_back(normalized, start, end - start);
+        start = end + 1;
+    }
+    return tokens;
+}
+
+} // namespace colony
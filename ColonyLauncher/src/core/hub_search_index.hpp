@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace colony
+{
+
+// Word index over the localized text of the hub branches. Built once per language; a query
+// matches a branch when every query token occurs in one of its words, which is the same as a
+// substring match against the branch's normalized text because tokens never contain spaces.
+class HubSearchIndex
+{
+  public:
+    // Rebuilds the index; document i is matched as index i.
+    void Build(const std::vector<std::string>& documents);
+    void Clear() noexcept;
+
+    // Indices of the matching documents in ascending order; every document for an empty query.
+    [[nodiscard]] std::vector<std::size_t> Match(const std::vector<std::string>& tokens) const;
+
+    [[nodiscard]] std::size_t DocumentCount() const noexcept { return documentCount_; }
+    [[nodiscard]] std::size_t TermCount() const noexcept { return terms_.size(); }
+
+    // Lowercases ASCII letters and digits and folds every other run of bytes into one space.
+    [[nodiscard]] static std::string Normalize(std::string_view value);
+    [[nodiscard]] static std::vector<std::string> Tokenize(std::string_view value);
+
+  private:
+    struct Term
+    {
+        std::string text;
+        std::vector<std::uint32_t> documents;
+    };
+
+    void CollectMatches(std::string_view token, std::vector<std::uint8_t>& hits) const;
+
+    std::vector<Term> terms_;
+    std::size_t documentCount_ = 0;
+};
+
+} // namespace colony
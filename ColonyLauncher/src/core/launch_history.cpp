@@ -0,0 +1,294 @@
+#include "core/launch_history.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <system_error>
+
+namespace colony
+{
+namespace
+{
+constexpr std::size_t kCompactionMinLines = 64;
+constexpr std::size_t kCompactionLinesPerProgram = 4;
+
+// Weight of a launch at `timestampSeconds`, in the log domain relative to the Unix epoch.
+double LaunchWeight(std::int64_t timestampSeconds) noexcept
+{
+    return static_cast<double>(timestampSeconds) * (std::log(2.0) / LaunchHistory::kHalfLifeSeconds);
+}
+
+// log(exp(lhs) + exp(rhs)) without overflowing; the weights above are in the thousands.
+double AddWeights(double lhs, double rhs) noexcept
+{
+    const double high = std::max(lhs, rhs);
+    const double low = std::min(lhs, rhs);
+    return high + std::log1p(std::exp(low - high));
+}
+
+bool IsValidProgramId(std::string_view programId) noexcept
+{
+    return !programId.empty() && programId.find_first_of("\r\n") == std::string_view::npos;
+}
+
+// The program id is the rest of the line so that it may contain spaces.
+bool ReadProgramId(std::istringstream& stream, std::string& programId)
+{
+    if (stream.get() != ' ')
+    {
+        return false;
+    }
+    std::getline(stream, programId);
+    return !programId.empty();
+}
+} // namespace
+
+bool LaunchHistory::Load(const std::filesystem::path& path)
+{
+    std::lock_guard lock(mutex_);
+    path_ = path;
+    records_.clear();
+    ranking_.clear();
+    logLines_ = 0;
+    ++revision_;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec))
+    {
+        return true;
+    }
+
+    std::ifstream input(path);
+    if (!input)
+    {
+        std::cerr << "Unable to read launch history: " << path.string() << '\n';
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(input, line))
+    {
+        ++logLines_;
+        std::istringstream stream(line);
+        char tag = 0;
+        stream >> tag;
+
+        std::string programId;
+        switch (tag)
+        {
+        case 'L':
+        {
+            std::int64_t timestamp = 0;
+            if (stream >> timestamp && ReadProgramId(stream, programId))
+            {
+                ApplyLaunch(programId, timestamp);
+            }
+            break;
+        }
+        case 'S':
+        {
+            std::int64_t duration = 0;
+            if (stream >> duration && ReadProgramId(stream, programId))
+            {
+                ApplySession(programId, duration);
+            }
+            break;
+        }
+        case 'C':
+        {
+            LaunchStats stats;
+            double frecency = 0.0;
+            if (stream >> stats.launchCount >> stats.lastLaunchSeconds >> stats.totalDurationSeconds >> frecency
+                && ReadProgramId(stream, programId))
+            {
+                ApplySnapshot(programId, stats, frecency);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
+void LaunchHistory::RecordLaunch(std::string_view programId, std::int64_t timestampSeconds)
+{
+    if (!IsValidProgramId(programId))
+    {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+    const std::string id{programId};
+    ApplyLaunch(id, timestampSeconds);
+    AppendLine("L " + std::to_string(timestampSeconds) + ' ' + id);
+}
+
+void LaunchHistory::RecordSession(std::string_view programId, std::int64_t durationSeconds)
+{
+    if (!IsValidProgramId(programId) || durationSeconds < 0)
+    {
+        return;
+    }
+
+    std::lock_guard lock(mutex_);
+    const std::string id{programId};
+    ApplySession(id, durationSeconds);
+    AppendLine("S " + std::to_string(durationSeconds) + ' ' + id);
+}
+
+std::optional<LaunchStats> LaunchHistory::Find(std::string_view programId) const
+{
+    std::lock_guard lock(mutex_);
+    const auto it = records_.find(std::string{programId});
+    if (it == records_.end())
+    {
+        return std::nullopt;
+    }
+    return it->second.stats;
+}
+
+std::vector<std::string> LaunchHistory::RankedProgramIds() const
+{
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> programIds;
+    programIds.reserve(ranking_.size());
+    for (const auto& key : ranking_)
+    {
+        programIds.push_back(key.programId);
+    }
+    return programIds;
+}
+
+std::uint64_t LaunchHistory::Revision() const
+{
+    std::lock_guard lock(mutex_);
+    return revision_;
+}
+
+bool LaunchHistory::Compact()
+{
+    std::lock_guard lock(mutex_);
+    return CompactLocked();
+}
+
+void LaunchHistory::ApplyLaunch(const std::string& programId, std::int64_t timestampSeconds)
+{
+    const double weight = LaunchWeight(timestampSeconds);
+    auto [it, inserted] = records_.try_emplace(programId);
+    Record& record = it->second;
+    if (inserted)
+    {
+        record.frecency = weight;
+    }
+    else
+    {
+        ranking_.erase(RankKey{record.frecency, programId});
+        record.frecency = AddWeights(record.frecency, weight);
+    }
+
+    ++record.stats.launchCount;
+    record.stats.lastLaunchSeconds = std::max(record.stats.lastLaunchSeconds, timestampSeconds);
+    ranking_.insert(RankKey{record.frecency, programId});
+    ++revision_;
+}
+
+void LaunchHistory::ApplySnapshot(const std::string& programId, const LaunchStats& stats, double frecency)
+{
+    auto [it, inserted] = records_.try_emplace(programId);
+    if (!inserted)
+    {
+        ranking_.erase(RankKey{it->second.frecency, programId});
+    }
+    it->second.stats = stats;
+    it->second.frecency = frecency;
+    ranking_.insert(RankKey{frecency, programId});
+    ++revision_;
+}
+
+void LaunchHistory::ApplySession(const std::string& programId, std::int64_t durationSeconds)
+{
+    const auto it = records_.find(programId);
+    if (it == records_.end())
+    {
+        return;
+    }
+    it->second.stats.totalDurationSeconds += durationSeconds;
+    ++revision_;
+}
+
+void LaunchHistory::AppendLine(const std::string& line)
+{
+    if (path_.empty())
+    {
+        return;
+    }
+
+    {
+        std::ofstream output(path_, std::ios::app);
+        if (!output)
+        {
+            std::cerr << "Unable to append to launch history: " << path_.string() << '\n';
+            return;
+        }
+        output << line << '\n';
+    }
+
+    ++logLines_;
+    if (logLines_ >= kCompactionMinLines && logLines_ >= kCompactionLinesPerProgram * records_.size())
+    {
+        CompactLocked();
+    }
+}
+
+bool LaunchHistory::CompactLocked()
+{
+    if (path_.empty())
+    {
+        return false;
+    }
+
+    std::filesystem::path temporaryPath = path_;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::trunc);
+        if (!output)
+        {
+            std::cerr << "Unable to write launch history: " << temporaryPath.string() << '\n';
+            return false;
+        }
+
+        output << std::setprecision(std::numeric_limits<double>::max_digits10);
+        for (const auto& key : ranking_)
+        {
+            const LaunchStats& stats = records_.at(key.programId).stats;
+            output << "C " << stats.launchCount << ' ' << stats.lastLaunchSeconds << ' ' << stats.totalDurationSeconds
+                   << ' ' << key.frecency << ' ' << key.programId << '\n';
+        }
+        if (!output)
+        {
+            std::cerr << "Unable to write launch history: " << temporaryPath.string() << '\n';
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, path_, ec);
+    if (ec)
+    {
+        std::cerr << "Unable to replace launch history: " << ec.message() << '\n';
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+
+    logLines_ = records_.size();
+    return true;
+}
+
+} // namespace colony
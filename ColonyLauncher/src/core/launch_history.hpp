@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+struct LaunchStats
+{
+    std::uint32_t launchCount = 0;
+    std::int64_t lastLaunchSeconds = 0;
+    std::int64_t totalDurationSeconds = 0;
+};
+
+// Per-program launch history backed by an append-only log. Every launch and finished session
+// appends one line; once the log holds many more lines than programs it is rewritten as one
+// snapshot line per program.
+//
+// Frecency is a sum of launches that each halve in weight every kHalfLifeSeconds. Every score
+// decays at the same rate, so the order never changes on its own: it is kept as the log of the
+// sum relative to the Unix epoch, and a launch moves one entry in an ordered set.
+//
+// Sessions may be reported from launcher threads, so every member locks.
+class LaunchHistory
+{
+  public:
+    static constexpr double kHalfLifeSeconds = 7.0 * 24.0 * 60.0 * 60.0;
+
+    // Replays the log at `path` and appends to it from then on. Returns false if an existing
+    // log could not be read; the history then starts empty but still writes to `path`.
+    bool Load(const std::filesystem::path& path);
+
+    void RecordLaunch(std::string_view programId, std::int64_t timestampSeconds);
+    void RecordSession(std::string_view programId, std::int64_t durationSeconds);
+
+    [[nodiscard]] std::optional<LaunchStats> Find(std::string_view programId) const;
+
+    // Launched programs, most frecent first.
+    [[nodiscard]] std::vector<std::string> RankedProgramIds() const;
+
+    // Bumped by every change; cheap to poll when deciding whether to re-sort.
+    [[nodiscard]] std::uint64_t Revision() const;
+
+    // Rewrites the log as one snapshot line per program.
+    bool Compact();
+
+  private:
+    struct Record
+    {
+        LaunchStats stats;
+        double frecency = 0.0;
+    };
+
+    struct RankKey
+    {
+        double frecency = 0.0;
+        std::string programId;
+
+        bool operator<(const RankKey& other) const noexcept
+        {
+            if (frecency != other.frecency)
+            {
+                return frecency > other.frecency;
+            }
+            return programId < other.programId;
+        }
+    };
+
+    void ApplyLaunch(const std::string& programId, std::int64_t timestampSeconds);
+    void ApplySnapshot(const std::string& programId, const LaunchStats& stats, double frecency);
+    void ApplySession(const std::string& programId, std::int64_t durationSeconds);
+    void AppendLine(const std::string& line);
+    bool CompactLocked();
+
+    mutable std::mutex mutex_;
+    std::filesystem::path path_;
+    std::unordered_map<std::string, Record> records_;
+    std::set<RankKey> ranking_;
+    std::size_t logLines_ = 0;
+    std::uint64_t revision_ = 0;
+};
+
+} // namespace colony
@@ -0,0 +1,709 @@
+#include "core/launch_prefetcher.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#if defined(__linux__)
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <fstream>
+#include <glob.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+#if defined(__linux__)
+
+// A launch rarely needs more than a few dozen libraries; the caps keep a pathological binary
+// or a huge data file from turning a hover into a disk-wide read.
+constexpr std::size_t kMaxFilesPerRequest = 256;
+constexpr std::uint64_t kMaxBytesPerFile = 64ull * 1024 * 1024;
+constexpr std::size_t kMaxDependencyDepth = 16;
+
+class FileDescriptor
+{
+  public:
+    explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    ~FileDescriptor()
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    [[nodiscard]] int Get() const noexcept { return fd_; }
+
+  private:
+    int fd_;
+};
+
+bool ReadExact(int fd, void* buffer, std::size_t size, std::uint64_t offset)
+{
+    auto* bytes = static_cast<char*>(buffer);
+    while (size > 0)
+    {
+        const ssize_t count = pread(fd, bytes, size, static_cast<off_t>(offset));
+        if (count <= 0)
+        {
+            return false;
+        }
+        bytes += count;
+        size -= static_cast<std::size_t>(count);
+        offset += static_cast<std::uint64_t>(count);
+    }
+    return true;
+}
+
+struct ElfInfo
+{
+    unsigned char elfClass = ELFCLASSNONE;
+    std::uint16_t machine = EM_NONE;
+    std::string interpreter;
+    std::vector<std::string> needed;
+    std::string rpath;
+    std::string runpath;
+};
+
+template <typename Ehdr, typename Phdr, typename Dyn>
+bool ReadDynamicSection(int fd, ElfInfo& info)
+{
+    Ehdr header{};
+    if (!ReadExact(fd, &header, sizeof(header), 0) || header.e_phentsize != sizeof(Phdr) || header.e_phnum == 0
+        || header.e_phnum > 512)
+    {
+        return false;
+    }
+    info.machine = header.e_machine;
+
+    std::vector<Phdr> segments(header.e_phnum);
+    if (!ReadExact(fd, segments.data(), segments.size() * sizeof(Phdr), header.e_phoff))
+    {
+        return false;
+    }
+
+    const Phdr* dynamic = nullptr;
+    for (const Phdr& segment : segments)
+    {
+        if (segment.p_type == PT_INTERP && segment.p_filesz > 1 && segment.p_filesz < 4096)
+        {
+            std::string interpreter(segment.p_filesz, '\0');
+            if (ReadExact(fd, interpreter.data(), interpreter.size(), segment.p_offset))
+            {
+                interpreter.resize(std::strlen(interpreter.c_str()));
+                info.interpreter = std::move(interpreter);
+            }
+        }
+        else if (segment.p_type == PT_DYNAMIC)
+        {
+            dynamic = &segment;
+        }
+    }
+    if (dynamic == nullptr)
+    {
+        // Statically linked.
+        return true;
+    }
+
+    const std::size_t count = std::min<std::size_t>(dynamic->p_filesz / sizeof(Dyn), 4096);
+    std::vector<Dyn> entries(count);
+    if (!ReadExact(fd, entries.data(), entries.size() * sizeof(Dyn), dynamic->p_offset))
+    {
+        return false;
+    }
+
+    std::uint64_t stringTable = 0;
+    std::uint64_t stringTableSize = 0;
+    std::vector<std::uint64_t> neededOffsets;
+    std::optional<std::uint64_t> rpathOffset;
+    std::optional<std::uint64_t> runpathOffset;
+    for (const Dyn& entry : entries)
+    {
+        if (entry.d_tag == DT_NULL)
+        {
+            break;
+        }
+        switch (entry.d_tag)
+        {
+        case DT_NEEDED:
+            neededOffsets.push_back(entry.d_un.d_val);
+            break;
+        case DT_STRTAB:
+            stringTable = entry.d_un.d_ptr;
+            break;
+        case DT_STRSZ:
+            stringTableSize = entry.d_un.d_val;
+            break;
+        case DT_RPATH:
+            rpathOffset = entry.d_un.d_val;
+            break;
+        case DT_RUNPATH:
+            runpathOffset = entry.d_un.d_val;
+            break;
+        default:
+            break;
+        }
+    }
+    if (stringTableSize == 0 || stringTableSize > 16 * 1024 * 1024)
+    {
+        return true;
+    }
+
+    // DT_STRTAB is an address; find the loaded segment that holds it to get a file offset.
+    std::optional<std::uint64_t> stringTableOffset;
+    for (const Phdr& segment : segments)
+    {
+        if (segment.p_type == PT_LOAD && stringTable >= segment.p_vaddr
+            && stringTable - segment.p_vaddr < segment.p_filesz)
+        {
+            stringTableOffset = stringTable - segment.p_vaddr + segment.p_offset;
+            break;
+        }
+    }
+    if (!stringTableOffset)
+    {
+        return true;
+    }
+
+    std::string strings(stringTableSize, '\0');
+    if (!ReadExact(fd, strings.data(), strings.size(), *stringTableOffset))
+    {
+        return true;
+    }
+    const auto stringAt = [&strings](std::uint64_t offset) {
+        if (offset >= strings.size())
+        {
+            return std::string{};
+        }
+        const char* start = strings.data() + offset;
+        return std::string(start, strnlen(start, strings.size() - offset));
+    };
+
+    for (const std::uint64_t offset : neededOffsets)
+    {
+        if (std::string name = stringAt(offset); !name.empty())
+        {
+            info.needed.push_back(std::move(name));
+        }
+    }
+    if (rpathOffset)
+    {
+        info.rpath = stringAt(*rpathOffset);
+    }
+    if (runpathOffset)
+    {
+        info.runpath = stringAt(*runpathOffset);
+    }
+    return true;
+}
+
+// Reads the identity of an ELF file, and its dynamic section when `withDynamic` is set.
+std::optional<ElfInfo> ReadElf(const std::filesystem::path& path, bool withDynamic)
+{
+    const FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.Get() < 0)
+    {
+        return std::nullopt;
+    }
+
+    unsigned char ident[EI_NIDENT]{};
+    if (!ReadExact(fd.Get(), ident, sizeof(ident), 0) || std::memcmp(ident, ELFMAG, SELFMAG) != 0)
+    {
+        return std::nullopt;
+    }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    constexpr unsigned char kHostData = ELFDATA2LSB;
+#else
+    constexpr unsigned char kHostData = ELFDATA2MSB;
+#endif
+    if (ident[EI_DATA] != kHostData)
+    {
+        return std::nullopt;
+    }
+
+    ElfInfo info;
+    info.elfClass = ident[EI_CLASS];
+    if (!withDynamic)
+    {
+        std::uint16_t header[2]{};
+        if (!ReadExact(fd.Get(), header, sizeof(header), EI_NIDENT))
+        {
+            return std::nullopt;
+        }
+        // e_type, then e_machine.
+        info.machine = header[1];
+        return info;
+    }
+
+    bool parsed = false;
+    if (info.elfClass == ELFCLASS64)
+    {
+        parsed = ReadDynamicSection<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(fd.Get(), info);
+    }
+    else if (info.elfClass == ELFCLASS32)
+    {
+        parsed = ReadDynamicSection<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(fd.Get(), info);
+    }
+    if (!parsed)
+    {
+        return std::nullopt;
+    }
+    return info;
+}
+
+std::vector<std::string> SplitSearchPath(std::string_view list, const std::filesystem::path& origin)
+{
+    std::vector<std::string> directories;
+    while (!list.empty())
+    {
+        const std::size_t separator = list.find_first_of(":;");
+        std::string directory{list.substr(0, separator)};
+        list = separator == std::string_view::npos ? std::string_view{} : list.substr(separator + 1);
+        for (const std::string_view token : {std::string_view{"${ORIGIN}"}, std::string_view{"$ORIGIN"}})
+        {
+            for (std::size_t at = directory.find(token); at != std::string::npos; at = directory.find(token, at))
+            {
+                directory.replace(at, token.size(), origin.string());
+                at += origin.string().size();
+            }
+        }
+        if (!directory.empty())
+        {
+            directories.push_back(std::move(directory));
+        }
+    }
+    return directories;
+}
+
+void ReadLoaderConfig(const std::filesystem::path& file, std::vector<std::string>& directories, int depth)
+{
+    std::ifstream input{file};
+    for (std::string line; depth < 8 && std::getline(input, line);)
+    {
+        line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+        const auto begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos)
+        {
+            continue;
+        }
+        const auto end = line.find_last_not_of(" \t\r");
+        std::string_view entry{line.data() + begin, end - begin + 1};
+
+        if (entry.rfind("include", 0) == 0 && entry.size() > 7 && (entry[7] == ' ' || entry[7] == '\t'))
+        {
+            std::string pattern{entry.substr(entry.find_first_not_of(" \t", 7))};
+            if (!pattern.empty() && pattern.front() != '/')
+            {
+                pattern = (file.parent_path() / pattern).string();
+            }
+            glob_t matches{};
+            if (glob(pattern.c_str(), 0, nullptr, &matches) == 0)
+            {
+                for (std::size_t i = 0; i < matches.gl_pathc; ++i)
+                {
+                    ReadLoaderConfig(matches.gl_pathv[i], directories, depth + 1);
+                }
+            }
+            globfree(&matches);
+        }
+        else if (entry.rfind("hwcap", 0) != 0)
+        {
+            directories.emplace_back(entry.substr(0, entry.find_first_of(" \t=")));
+        }
+    }
+}
+
+// What the loader searches after an object's own paths. ld.so.cache is built from the same
+// ld.so.conf, so reading that is enough to find what the cache would.
+const std::vector<std::string>& SystemLibraryDirectories()
+{
+    static const std::vector<std::string> directories = []() {
+        std::vector<std::string> result;
+        ReadLoaderConfig("/etc/ld.so.conf", result, 0);
+        for (const char* trusted : {"/lib64", "/usr/lib64", "/lib", "/usr/lib"})
+        {
+            result.emplace_back(trusted);
+        }
+        std::vector<std::string> unique;
+        for (auto& directory : result)
+        {
+            if (std::find(unique.begin(), unique.end(), directory) == unique.end())
+            {
+                unique.push_back(std::move(directory));
+            }
+        }
+        return unique;
+    }();
+    return directories;
+}
+
+std::optional<std::filesystem::path> FindLibrary(
+    const std::string& name,
+    const ElfInfo& object,
+    const std::filesystem::path& objectPath)
+{
+    if (name.find('/') != std::string::npos)
+    {
+        return std::filesystem::path{name};
+    }
+
+    const std::filesystem::path origin = objectPath.parent_path();
+    std::vector<std::string> directories;
+    const auto append = [&directories](std::vector<std::string> more) {
+        directories.insert(directories.end(), std::make_move_iterator(more.begin()), std::make_move_iterator(more.end()));
+    };
+    if (object.runpath.empty())
+    {
+        append(SplitSearchPath(object.rpath, origin));
+    }
+    if (const char* libraryPath = std::getenv("LD_LIBRARY_PATH"); libraryPath != nullptr)
+    {
+        append(SplitSearchPath(libraryPath, origin));
+    }
+    append(SplitSearchPath(object.runpath, origin));
+    const auto& system = SystemLibraryDirectories();
+    directories.insert(directories.end(), system.begin(), system.end());
+
+    for (const auto& directory : directories)
+    {
+        std::filesystem::path candidate = std::filesystem::path{directory} / name;
+        // A 32-bit library of the same name can sit earlier on the path; the loader skips it.
+        const auto candidateInfo = ReadElf(candidate, false);
+        if (candidateInfo && candidateInfo->elfClass == object.elfClass && candidateInfo->machine == object.machine)
+        {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::filesystem::path> FindOnPath(const std::filesystem::path& program)
+{
+    if (program.has_parent_path())
+    {
+        return program;
+    }
+    const char* path = std::getenv("PATH");
+    for (const auto& directory : SplitSearchPath(path != nullptr ? path : "/usr/bin:/bin", {}))
+    {
+        std::filesystem::path candidate = std::filesystem::path{directory} / program;
+        if (access(candidate.c_str(), X_OK) == 0)
+        {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+// The interpreter a "#!" line names; "/usr/bin/env python3" means python3 on PATH.
+std::optional<std::filesystem::path> ScriptInterpreter(const std::filesystem::path& script)
+{
+    std::ifstream input{script, std::ios::binary};
+    char magic[2]{};
+    if (!input.read(magic, 2) || magic[0] != '#' || magic[1] != '!')
+    {
+        return std::nullopt;
+    }
+    std::string line;
+    std::getline(input, line);
+    std::vector<std::string> words;
+    for (std::size_t at = line.find_first_not_of(" \t\r"); at != std::string::npos;
+         at = line.find_first_not_of(" \t\r", at))
+    {
+        const std::size_t end = line.find_first_of(" \t\r", at);
+        words.push_back(line.substr(at, end - at));
+        at = end;
+    }
+    if (words.empty())
+    {
+        return std::nullopt;
+    }
+    if (std::filesystem::path{words.front()}.filename() == "env")
+    {
+        const auto program = std::find_if(words.begin() + 1, words.end(), [](const std::string& word) {
+            return !word.empty() && word.front() != '-' && word.find('=') == std::string::npos;
+        });
+        return program != words.end() ? FindOnPath(*program) : std::nullopt;
+    }
+    return std::filesystem::path{words.front()};
+}
+
+// Breadth-first over the executables and scripts in `files`, each followed by what it loads.
+std::vector<std::filesystem::path> ExpandLaunchFiles(
+    const std::vector<std::filesystem::path>& files,
+    const std::atomic<bool>* cancelled)
+{
+    std::vector<std::filesystem::path> ordered;
+    std::unordered_set<std::string> seen;
+    std::vector<std::pair<std::filesystem::path, std::size_t>> queue;
+    for (const auto& file : files)
+    {
+        if (auto resolved = FindOnPath(file))
+        {
+            queue.emplace_back(std::move(*resolved), 0);
+        }
+    }
+
+    for (std::size_t next = 0; next < queue.size() && ordered.size() < kMaxFilesPerRequest; ++next)
+    {
+        if (cancelled != nullptr && cancelled->load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        auto [path, depth] = queue[next];
+        std::error_code ec;
+        const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+        if (!ec)
+        {
+            path = canonical;
+        }
+        if (!seen.insert(path.string()).second)
+        {
+            continue;
+        }
+        ordered.push_back(path);
+        if (depth >= kMaxDependencyDepth)
+        {
+            continue;
+        }
+
+        if (const auto info = ReadElf(path, true))
+        {
+            if (!info->interpreter.empty())
+            {
+                queue.emplace_back(info->interpreter, depth + 1);
+            }
+            for (const auto& name : info->needed)
+            {
+                if (auto library = FindLibrary(name, *info, path))
+                {
+                    queue.emplace_back(std::move(*library), depth + 1);
+                }
+            }
+        }
+        else if (const auto interpreter = ScriptInterpreter(path))
+        {
+            queue.emplace_back(*interpreter, depth + 1);
+        }
+    }
+    return ordered;
+}
+
+struct FilePrefetch
+{
+    std::uint64_t residentPages = 0;
+    std::uint64_t missingPages = 0;
+    std::uint64_t bytesRequested = 0;
+};
+
+// Counts which pages of `path` are cached with mincore and asks for the rest to be read, one
+// readahead per run of missing pages; without mincore the whole file counts as missing.
+std::optional<FilePrefetch> PrefetchFile(const std::filesystem::path& path)
+{
+    const FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    struct stat status{};
+    if (fd.Get() < 0 || fstat(fd.Get(), &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= 0)
+    {
+        return std::nullopt;
+    }
+
+    const auto size = std::min<std::uint64_t>(static_cast<std::uint64_t>(status.st_size), kMaxBytesPerFile);
+    const auto pageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    const std::uint64_t pages = (size + pageSize - 1) / pageSize;
+
+    std::vector<unsigned char> resident(pages, 0);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.Get(), 0);
+    if (mapping != MAP_FAILED)
+    {
+        if (mincore(mapping, size, resident.data()) != 0)
+        {
+            std::fill(resident.begin(), resident.end(), 0);
+        }
+        munmap(mapping, size);
+    }
+
+    FilePrefetch result;
+    for (std::uint64_t page = 0; page < pages;)
+    {
+        if ((resident[page] & 1) != 0)
+        {
+            ++result.residentPages;
+            ++page;
+            continue;
+        }
+
+        std::uint64_t end = page + 1;
+        while (end < pages && (resident[end] & 1) == 0)
+        {
+            ++end;
+        }
+        const std::uint64_t offset = page * pageSize;
+        const std::uint64_t length = std::min(end * pageSize, size) - offset;
+        if (readahead(fd.Get(), static_cast<off64_t>(offset), length) != 0)
+        {
+            [[maybe_unused]] const int advised = posix_fadvise(
+                fd.Get(), static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+        }
+        result.missingPages += end - page;
+        result.bytesRequested += length;
+        page = end;
+    }
+    return result;
+}
+
+#endif
+} // namespace
+
+std::vector<std::filesystem::path> ResolveElfDependencies(const std::filesystem::path& executable)
+{
+#if defined(__linux__)
+    if (!ReadElf(executable, false))
+    {
+        return {};
+    }
+    auto files = ExpandLaunchFiles({executable}, nullptr);
+    if (!files.empty())
+    {
+        files.erase(files.begin());
+    }
+    return files;
+#else
+    (void)executable;
+    return {};
+#endif
+}
+
+LaunchPrefetcher::LaunchPrefetcher(std::chrono::steady_clock::duration cooldown)
+    : cooldown_(cooldown)
+{}
+
+LaunchPrefetcher::~LaunchPrefetcher()
+{
+    Cancel();
+}
+
+void LaunchPrefetcher::Prefetch(std::string key, std::vector<std::filesystem::path> files)
+{
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard lock(state_->mutex);
+        ++state_->stats.requests;
+        if (files.empty())
+        {
+            return;
+        }
+        const auto last = state_->lastPrefetched.find(key);
+        if (last != state_->lastPrefetched.end() && now - last->second < cooldown_)
+        {
+            ++state_->stats.rateLimited;
+            return;
+        }
+        state_->lastPrefetched[key] = now;
+        if (state_->pending)
+        {
+            ++state_->stats.superseded;
+            state_->lastPrefetched.erase(state_->pending->key);
+        }
+        state_->pending = Request{std::move(key), std::move(files)};
+        state_->cancelled.store(false, std::memory_order_relaxed);
+        if (state_->running)
+        {
+            return;
+        }
+        state_->running = true;
+    }
+
+    std::thread worker([state = state_]() { Run(state); });
+    worker.detach();
+}
+
+void LaunchPrefetcher::Cancel()
+{
+    std::lock_guard lock(state_->mutex);
+    state_->cancelled.store(true, std::memory_order_relaxed);
+    state_->pending.reset();
+}
+
+LaunchPrefetchStats LaunchPrefetcher::Stats() const
+{
+    std::lock_guard lock(state_->mutex);
+    return state_->stats;
+}
+
+bool LaunchPrefetcher::IsIdle() const
+{
+    std::lock_guard lock(state_->mutex);
+    return !state_->running;
+}
+
+void LaunchPrefetcher::Run(const std::shared_ptr<State>& state)
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::lock_guard lock(state->mutex);
+            if (!state->pending || state->cancelled.load(std::memory_order_relaxed))
+            {
+                state->pending.reset();
+                state->running = false;
+                return;
+            }
+            request = std::move(*state->pending);
+            state->pending.reset();
+        }
+
+        try
+        {
+            PrefetchFiles(*state, request.files);
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "Launch prefetch for '" << request.key << "' failed: " << ex.what() << '\n';
+        }
+    }
+}
+
+void LaunchPrefetcher::PrefetchFiles(State& state, const std::vector<std::filesystem::path>& files)
+{
+#if defined(__linux__)
+    for (const auto& path : ExpandLaunchFiles(files, &state.cancelled))
+    {
+        if (state.cancelled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        const auto prefetched = PrefetchFile(path);
+        if (!prefetched)
+        {
+            continue;
+        }
+
+        std::lock_guard lock(state.mutex);
+        auto& stats = state.stats;
+        ++(prefetched->missingPages == 0 ? stats.fileHits : stats.fileMisses);
+        stats.pageHits += prefetched->residentPages;
+        stats.pageMisses += prefetched->missingPages;
+        stats.bytesRequested += prefetched->bytesRequested;
+    }
+#else
+    (void)state;
+    (void)files;
+#endif
+}
+
+} // namespace colony
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+struct LaunchPrefetchStats
+{
+    std::uint64_t requests = 0;
+    // Dropped because the same program was prefetched less than the cooldown ago.
+    std::uint64_t rateLimited = 0;
+    // Replaced by a newer request before the worker got to them.
+    std::uint64_t superseded = 0;
+    // Files whose pages were all resident already, and files that needed reading.
+    std::uint64_t fileHits = 0;
+    std::uint64_t fileMisses = 0;
+    std::uint64_t pageHits = 0;
+    std::uint64_t pageMisses = 0;
+    // Bytes of the missing pages, the only ones asked to be read.
+    std::uint64_t bytesRequested = 0;
+};
+
+// The ELF interpreter of `executable` and every shared library it needs, transitively, found
+// the way the dynamic loader would: RPATH, LD_LIBRARY_PATH, RUNPATH, then the ld.so.conf
+// directories. Libraries that cannot be found are left out. Empty for anything but an ELF
+// file of the host's byte order.
+[[nodiscard]] std::vector<std::filesystem::path> ResolveElfDependencies(const std::filesystem::path& executable);
+
+// Warms the page cache before a launch: given the files a program will start with, it adds
+// their ELF dependencies and script interpreters and asks the kernel to read whatever is not
+// resident yet, so a cold launch does not stall on one page fault after another.
+//
+// Prefetches run one at a time on a detached worker; a request that arrives while one runs
+// replaces any request still waiting, so sweeping the pointer over a row of tiles costs at most
+// two. The same key is not prefetched again within the cooldown. Only Linux has a backend;
+// elsewhere requests are counted and dropped.
+class LaunchPrefetcher
+{
+  public:
+    static constexpr std::chrono::seconds kDefaultCooldown{30};
+
+    explicit LaunchPrefetcher(std::chrono::steady_clock::duration cooldown = kDefaultCooldown);
+    LaunchPrefetcher(const LaunchPrefetcher&) = delete;
+    LaunchPrefetcher& operator=(const LaunchPrefetcher&) = delete;
+    ~LaunchPrefetcher();
+
+    // `files` are executables or scripts, in the order they are started; a name without a
+    // directory part is looked up on PATH. `key` identifies the program for rate limiting.
+    void Prefetch(std::string key, std::vector<std::filesystem::path> files);
+    void Cancel();
+
+    [[nodiscard]] LaunchPrefetchStats Stats() const;
+    [[nodiscard]] bool IsIdle() const;
+
+  private:
+    struct Request
+    {
+        std::string key;
+        std::vector<std::filesystem::path> files;
+    };
+
+    struct State
+    {
+        mutable std::mutex mutex;
+        std::optional<Request> pending;
+        bool running = false;
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> lastPrefetched;
+        LaunchPrefetchStats stats;
+        std::atomic<bool> cancelled{false};
+    };
+
+    static void Run(const std::shared_ptr<State>& state);
+    static void PrefetchFiles(State& state, const std::vector<std::filesystem::path>& files);
+
+    std::chrono::steady_clock::duration cooldown_;
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+};
+
+} // namespace colony
@@ -0,0 +1,310 @@
+#include "core/launch_telemetry.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+namespace colony
+{
+namespace
+{
+constexpr std::string_view kTelemetryHeader = "colony-launch-telemetry 1";
+
+bool IsStorableProgramId(std::string_view programId) noexcept
+{
+    return !programId.empty() && programId.find_first_of("\t\r\n") == std::string_view::npos;
+}
+
+std::vector<std::string_view> SplitFields(std::string_view line, char separator)
+{
+    std::vector<std::string_view> fields;
+    std::size_t start = 0;
+    while (true)
+    {
+        const std::size_t end = line.find(separator, start);
+        fields.push_back(line.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+        if (end == std::string_view::npos)
+        {
+            return fields;
+        }
+        start = end + 1;
+    }
+}
+
+template <typename Integer>
+bool ParseInteger(std::string_view text, Integer& value) noexcept
+{
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+bool ParseOptionalMs(std::string_view text, std::optional<std::chrono::milliseconds>& value) noexcept
+{
+    std::int64_t milliseconds = 0;
+    if (!ParseInteger(text, milliseconds))
+    {
+        return false;
+    }
+    value = milliseconds < 0 ? std::nullopt : std::optional{std::chrono::milliseconds{milliseconds}};
+    return true;
+}
+
+bool ParseHistogram(std::string_view text, LatencyHistogram& histogram) noexcept
+{
+    const auto fields = SplitFields(text, ',');
+    if (fields.size() != LatencyHistogram::kBucketCount)
+    {
+        return false;
+    }
+    std::array<std::uint64_t, LatencyHistogram::kBucketCount> buckets{};
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        if (!ParseInteger(fields[i], buckets[i]))
+        {
+            return false;
+        }
+    }
+    histogram.SetBuckets(buckets);
+    return true;
+}
+
+void WriteHistogram(std::ostream& output, const LatencyHistogram& histogram)
+{
+    const auto& buckets = histogram.Buckets();
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        output << (i == 0 ? "" : ",") << buckets[i];
+    }
+}
+
+std::int64_t StoredMs(const std::optional<std::chrono::milliseconds>& value) noexcept
+{
+    return value ? value->count() : -1;
+}
+
+std::string FormatMs(std::chrono::milliseconds duration)
+{
+    if (duration.count() < 1000)
+    {
+        return std::to_string(duration.count()) + " ms";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f s", static_cast<double>(duration.count()) / 1000.0);
+    return buffer;
+}
+} // namespace
+
+void LatencyHistogram::Record(std::chrono::milliseconds duration) noexcept
+{
+    const auto milliseconds = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+    const auto bound = std::lower_bound(kBucketBoundsMs.begin(), kBucketBoundsMs.end(), milliseconds);
+    ++buckets_[static_cast<std::size_t>(bound - kBucketBoundsMs.begin())];
+}
+
+std::uint64_t LatencyHistogram::Count() const noexcept
+{
+    std::uint64_t count = 0;
+    for (const std::uint64_t bucket : buckets_)
+    {
+        count += bucket;
+    }
+    return count;
+}
+
+std::optional<std::chrono::milliseconds> LatencyHistogram::Quantile(double fraction) const noexcept
+{
+    const std::uint64_t count = Count();
+    if (count == 0)
+    {
+        return std::nullopt;
+    }
+
+    // Rank of the quantile, 1-based, so the median of two samples is the first.
+    const auto rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::clamp(fraction, 0.0, 1.0) * static_cast<double>(count) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketBoundsMs.size(); ++i)
+    {
+        seen += buckets_[i];
+        if (seen >= rank)
+        {
+            return std::chrono::milliseconds{kBucketBoundsMs[i]};
+        }
+    }
+    return std::chrono::milliseconds{kBucketBoundsMs.back()};
+}
+
+LaunchTelemetry::LaunchTelemetry(std::chrono::seconds crashWindow)
+    : crashWindow_(crashWindow)
+{}
+
+bool LaunchTelemetry::Load(const std::filesystem::path& path)
+{
+    programs_.clear();
+    dirty_ = false;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec))
+    {
+        return true;
+    }
+
+    std::ifstream input(path);
+    std::string line;
+    if (!input || !std::getline(input, line) || line != kTelemetryHeader)
+    {
+        std::cerr << "Ignoring unreadable launch telemetry: " << path.string() << '\n';
+        return false;
+    }
+
+    while (std::getline(input, line))
+    {
+        const auto fields = SplitFields(line, '\t');
+        if (fields.size() != 9 || fields[0] != "P" || !IsStorableProgramId(fields[8]))
+        {
+            continue;
+        }
+
+        LaunchTelemetryStats stats;
+        if (ParseInteger(fields[1], stats.launches) && ParseInteger(fields[2], stats.crashes)
+            && ParseInteger(fields[3], stats.quickExits) && ParseOptionalMs(fields[4], stats.lastSpawnLatency)
+            && ParseOptionalMs(fields[5], stats.lastFirstWindowLatency) && ParseHistogram(fields[6], stats.spawnLatency)
+            && ParseHistogram(fields[7], stats.firstWindowLatency))
+        {
+            programs_.insert_or_assign(std::string{fields[8]}, std::move(stats));
+        }
+    }
+
+    return true;
+}
+
+bool LaunchTelemetry::Save(const std::filesystem::path& path)
+{
+    if (!dirty_)
+    {
+        return true;
+    }
+
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::trunc);
+        if (!output)
+        {
+            std::cerr << "Unable to write launch telemetry: " << temporaryPath.string() << '\n';
+            return false;
+        }
+
+        output << kTelemetryHeader << '\n';
+        for (const auto& [programId, stats] : programs_)
+        {
+            output << "P\t" << stats.launches << '\t' << stats.crashes << '\t' << stats.quickExits << '\t'
+                   << StoredMs(stats.lastSpawnLatency) << '\t' << StoredMs(stats.lastFirstWindowLatency) << '\t';
+            WriteHistogram(output, stats.spawnLatency);
+            output << '\t';
+            WriteHistogram(output, stats.firstWindowLatency);
+            output << '\t' << programId << '\n';
+        }
+        if (!output)
+        {
+            std::cerr << "Unable to write launch telemetry: " << temporaryPath.string() << '\n';
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec)
+    {
+        std::cerr << "Unable to replace launch telemetry: " << ec.message() << '\n';
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+
+    dirty_ = false;
+    return true;
+}
+
+void LaunchTelemetry::RecordSpawn(std::string_view programId, std::chrono::milliseconds clickToSpawn)
+{
+    if (!IsStorableProgramId(programId))
+    {
+        return;
+    }
+
+    auto& stats = programs_[std::string{programId}];
+    ++stats.launches;
+    stats.spawnLatency.Record(clickToSpawn);
+    stats.lastSpawnLatency = clickToSpawn;
+    // A window from the previous launch says nothing about this one.
+    stats.lastFirstWindowLatency.reset();
+    dirty_ = true;
+}
+
+void LaunchTelemetry::RecordFirstWindow(std::string_view programId, std::chrono::milliseconds spawnToWindow)
+{
+    const auto it = programs_.find(std::string{programId});
+    if (it == programs_.end())
+    {
+        return;
+    }
+
+    it->second.firstWindowLatency.Record(spawnToWindow);
+    it->second.lastFirstWindowLatency = spawnToWindow;
+    dirty_ = true;
+}
+
+void LaunchTelemetry::RecordExit(std::string_view programId, std::chrono::steady_clock::duration runtime, bool failed)
+{
+    const auto it = programs_.find(std::string{programId});
+    if (it == programs_.end() || runtime >= crashWindow_)
+    {
+        return;
+    }
+
+    ++(failed ? it->second.crashes : it->second.quickExits);
+    dirty_ = true;
+}
+
+const LaunchTelemetryStats* LaunchTelemetry::Find(std::string_view programId) const
+{
+    const auto it = programs_.find(std::string{programId});
+    return it != programs_.end() ? &it->second : nullptr;
+}
+
+std::string FormatLaunchTelemetry(const LaunchTelemetryStats& stats)
+{
+    std::string text;
+    const auto append = [&text](const std::string& part) {
+        if (!text.empty())
+        {
+            text.append(" • ");
+        }
+        text.append(part);
+    };
+
+    if (stats.lastSpawnLatency)
+    {
+        append("Start " + FormatMs(*stats.lastSpawnLatency));
+    }
+    if (stats.lastFirstWindowLatency)
+    {
+        std::string window = "Window " + FormatMs(*stats.lastFirstWindowLatency);
+        if (stats.firstWindowLatency.Count() > 1)
+        {
+            window += " (p50 " + FormatMs(*stats.firstWindowLatency.Quantile(0.5)) + ")";
+        }
+        append(window);
+    }
+    if (stats.crashes > 0)
+    {
+        append(std::to_string(stats.crashes) + (stats.crashes == 1 ? " crash" : " crashes"));
+    }
+    return text;
+}
+
+} // namespace colony
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace colony
+{
+
+// Counts of durations in fixed, roughly logarithmic millisecond buckets, so percentiles stay
+// cheap to store and compare however many launches are recorded.
+class LatencyHistogram
+{
+  public:
+    // Upper bounds of every bucket but the last, which holds everything slower.
+    static constexpr std::array<std::uint32_t, 15> kBucketBoundsMs{
+        1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 60000};
+    static constexpr std::size_t kBucketCount = kBucketBoundsMs.size() + 1;
+
+    void Record(std::chrono::milliseconds duration) noexcept;
+
+    [[nodiscard]] std::uint64_t Count() const noexcept;
+    // Upper bound of the bucket the `fraction` quantile falls in; nullopt while empty.
+    [[nodiscard]] std::optional<std::chrono::milliseconds> Quantile(double fraction) const noexcept;
+
+    [[nodiscard]] const std::array<std::uint64_t, kBucketCount>& Buckets() const noexcept { return buckets_; }
+    void SetBuckets(const std::array<std::uint64_t, kBucketCount>& buckets) noexcept { buckets_ = buckets; }
+
+    bool operator==(const LatencyHistogram&) const = default;
+
+  private:
+    std::array<std::uint64_t, kBucketCount> buckets_{};
+};
+
+struct LaunchTelemetryStats
+{
+    std::uint64_t launches = 0;
+    // Click to the spawned process, and spawn to its first top-level window.
+    LatencyHistogram spawnLatency;
+    LatencyHistogram firstWindowLatency;
+    std::optional<std::chrono::milliseconds> lastSpawnLatency;
+    std::optional<std::chrono::milliseconds> lastFirstWindowLatency;
+    // Exits within the crash window: failures count as crashes, clean exits as quick exits.
+    std::uint64_t crashes = 0;
+    std::uint64_t quickExits = 0;
+
+    bool operator==(const LaunchTelemetryStats&) const = default;
+};
+
+// Per-program launch latencies and early exits, kept across runs in a small text file in the
+// pref directory so a title that starts slower or crashes after an update stands out.
+//
+// Only the UI thread records; nothing here locks.
+class LaunchTelemetry
+{
+  public:
+    static constexpr std::chrono::seconds kDefaultCrashWindow{10};
+
+    explicit LaunchTelemetry(std::chrono::seconds crashWindow = kDefaultCrashWindow);
+
+    // Returns false if an existing file could not be read; telemetry then starts empty.
+    bool Load(const std::filesystem::path& path);
+    // Writes the file if anything was recorded since the last Load or Save.
+    bool Save(const std::filesystem::path& path);
+
+    void RecordSpawn(std::string_view programId, std::chrono::milliseconds clickToSpawn);
+    void RecordFirstWindow(std::string_view programId, std::chrono::milliseconds spawnToWindow);
+    // Counts the exit if the process ran for less than the crash window.
+    void RecordExit(std::string_view programId, std::chrono::steady_clock::duration runtime, bool failed);
+
+    [[nodiscard]] const LaunchTelemetryStats* Find(std::string_view programId) const;
+    [[nodiscard]] std::chrono::seconds CrashWindow() const noexcept { return crashWindow_; }
+
+  private:
+    std::chrono::seconds crashWindow_;
+    std::unordered_map<std::string, LaunchTelemetryStats> programs_;
+    bool dirty_ = false;
+};
+
+// One line for the hero panel, e.g. "Start 12 ms • Window 840 ms (p50 790 ms) • 1 crash".
+[[nodiscard]] std::string FormatLaunchTelemetry(const LaunchTelemetryStats& stats);
+
+} // namespace colony
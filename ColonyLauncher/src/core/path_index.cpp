@@ -0,0 +1,676 @@
+#include "core/path_index.hpp"
+
+#include "core/directory_walker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+
+struct PathIndex::Record
+{
+    std::uint32_t parent;
+    // One past the last record of this entry's subtree.
+    std::uint32_t end;
+    std::uint32_t nameOffset;
+    std::uint16_t nameLength;
+    std::uint8_t flags;
+    std::uint8_t reserved;
+    // Directories only, in file_clock ticks; lets a rebuild reuse an unchanged listing.
+    std::int64_t mtime;
+};
+
+namespace
+{
+constexpr std::array<char, 8> kMagic{'C', 'L', 'N', 'Y', 'P', 'I', 'D', 'X'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kNoParent = std::numeric_limits<std::uint32_t>::max();
+constexpr std::uint8_t kDirectoryFlag = 0x1;
+constexpr std::uint8_t kSymlinkFlag = 0x2;
+constexpr std::uint8_t kNoMatch = std::numeric_limits<std::uint8_t>::max();
+constexpr std::int64_t kUnknownMtime = std::numeric_limits<std::int64_t>::min();
+
+// Header, root path padded to 8 bytes, records, names, lower-cased names. Names are
+// NUL-terminated so a search hit can never span two of them.
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t recordCount;
+    std::uint64_t namesBytes;
+    std::int64_t builtAt;
+    std::int64_t rootMtime;
+    std::uint32_t rootBytes;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(FileHeader) == 48);
+
+constexpr std::size_t PadTo8(std::size_t bytes) noexcept
+{
+    return (bytes + 7) & ~std::size_t{7};
+}
+
+std::string ToLower(std::string_view text)
+{
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char ch) {
+        return static_cast<char>(std::tolower(ch));
+    });
+    return lower;
+}
+
+bool IsCancelled(const std::atomic<bool>* cancelled) noexcept
+{
+    return cancelled != nullptr && cancelled->load(std::memory_order_relaxed);
+}
+
+std::int64_t DirectoryMtime(const std::filesystem::path& directory)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(directory, ec);
+    return ec ? kUnknownMtime : static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+#if defined(__linux__)
+// Like updatedb's PRUNEFS: pseudo filesystems, network mounts (slow, can hang, and sshfs or
+// rclone expose a whole remote machine) and removable or optical media.
+bool IsPrunedFilesystemType(std::string_view type)
+{
+    static constexpr std::array<std::string_view, 31> kPrunedTypes{
+        "9p",         "afs",      "autofs",   "binfmt_misc", "bpf",     "ceph",    "cgroup",   "cgroup2",
+        "cifs",       "coda",     "configfs", "debugfs",     "devpts",  "devtmpfs", "hugetlbfs", "iso9660",
+        "lustre",     "mqueue",   "ncpfs",    "nfs",         "nfs4",    "proc",    "pstore",   "rpc_pipefs",
+        "securityfs", "smb3",     "smbfs",    "sysfs",       "tmpfs",   "tracefs", "udf"};
+    // Every FUSE mount, fuseblk included: that is how NTFS and exFAT drives are usually mounted.
+    return type.starts_with("fuse") || std::find(kPrunedTypes.begin(), kPrunedTypes.end(), type) != kPrunedTypes.end();
+}
+
+// mountinfo escapes spaces, tabs, newlines and backslashes in paths as octal.
+std::string UnescapeMountPath(std::string_view escaped)
+{
+    std::string path;
+    path.reserve(escaped.size());
+    for (std::size_t i = 0; i < escaped.size(); ++i)
+    {
+        if (escaped[i] == '\\' && i + 3 < escaped.size() && std::isdigit(static_cast<unsigned char>(escaped[i + 1])))
+        {
+            path.push_back(static_cast<char>(
+                (escaped[i + 1] - '0') * 64 + (escaped[i + 2] - '0') * 8 + (escaped[i + 3] - '0')));
+            i += 3;
+            continue;
+        }
+        path.push_back(escaped[i]);
+    }
+    return path;
+}
+#endif
+
+// Mount points of pruned filesystems, read from the mount table once per build. Nothing under
+// them is touched, so a dead network mount cannot stall the walk.
+std::unordered_set<std::string> PrunedMountPoints()
+{
+    std::unordered_set<std::string> mountPoints;
+#if defined(__linux__)
+    // "36 35 98:0 /root /mount/point options optional-fields - type source super-options".
+    std::ifstream input{"/proc/self/mountinfo"};
+    for (std::string line; std::getline(input, line);)
+    {
+        const std::size_t separator = line.find(" - ");
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+        const std::string_view fields{line};
+        const std::string_view type = fields.substr(separator + 3, fields.find(' ', separator + 3) - (separator + 3));
+        if (!IsPrunedFilesystemType(type))
+        {
+            continue;
+        }
+
+        std::size_t start = 0;
+        for (int field = 0; field < 4 && start != std::string_view::npos; ++field)
+        {
+            start = fields.find(' ', start);
+            start = start == std::string_view::npos ? start : start + 1;
+        }
+        if (start == std::string_view::npos || start >= separator)
+        {
+            continue;
+        }
+        mountPoints.insert(UnescapeMountPath(fields.substr(start, fields.find(' ', start) - start)));
+    }
+#endif
+    return mountPoints;
+}
+
+bool IsPruned(const std::filesystem::path& directory, const std::unordered_set<std::string>& prunedMountPoints)
+{
+#if defined(__linux__)
+    // Kernel and runtime pseudo filesystems: huge, constantly changing and never an app. They
+    // are listed even when the mount table is unreadable. Desktops mount removable drives
+    // under /media or /run/media, whatever their filesystem.
+    static constexpr std::array<std::string_view, 5> kPrunedPaths{"/proc", "/sys", "/dev", "/run", "/media"};
+    return std::find(kPrunedPaths.begin(), kPrunedPaths.end(), std::string_view{directory.native()}) != kPrunedPaths.end()
+        || prunedMountPoints.contains(directory.native());
+#else
+    (void)directory;
+    (void)prunedMountPoints;
+    return false;
+#endif
+}
+
+void AppendSeparator(std::string& path)
+{
+    constexpr char kSeparator = static_cast<char>(std::filesystem::path::preferred_separator);
+    if (path.empty() || path.back() != kSeparator)
+    {
+        path.push_back(kSeparator);
+    }
+}
+} // namespace
+
+struct PathIndex::BuildState
+{
+    struct Child
+    {
+        std::string name;
+        std::uint8_t flags = 0;
+    };
+
+    const PathIndex* previous = nullptr;
+    const std::atomic<bool>* cancelled = nullptr;
+    std::unordered_map<std::string, std::uint32_t> previousDirectories;
+    std::unordered_set<std::string> prunedMountPoints;
+    std::vector<Record> records;
+    std::string names;
+    std::string lowerNames;
+
+    void IndexPreviousDirectories()
+    {
+        std::vector<std::pair<std::uint32_t, std::filesystem::path>> ancestors;
+        for (std::uint32_t index = 0; index < previous->recordCount_; ++index)
+        {
+            const Record& record = previous->records_[index];
+            while (!ancestors.empty() && ancestors.back().first != record.parent)
+            {
+                ancestors.pop_back();
+            }
+            if ((record.flags & kDirectoryFlag) == 0 || (record.flags & kSymlinkFlag) != 0)
+            {
+                continue;
+            }
+
+            const std::filesystem::path& base = ancestors.empty() ? previous->root_ : ancestors.back().second;
+            std::filesystem::path path = base / std::string{previous->Name(index)};
+            previousDirectories.emplace(path.string(), index);
+            ancestors.emplace_back(index, std::move(path));
+        }
+    }
+
+    // `previousRecord` is the directory's record in the previous index, kNoParent for its root.
+    std::vector<Child> ListChildren(
+        const std::filesystem::path& directory,
+        std::int64_t mtime,
+        std::optional<std::uint32_t> previousRecord) const
+    {
+        std::vector<Child> children;
+        if (previousRecord && mtime != kUnknownMtime)
+        {
+            const bool isRoot = *previousRecord == kNoParent;
+            const std::int64_t previousMtime = isRoot ? previous->rootMtime_ : previous->records_[*previousRecord].mtime;
+            if (previousMtime == mtime)
+            {
+                const std::uint32_t first = isRoot ? 0 : *previousRecord + 1;
+                const std::uint32_t last = isRoot ? previous->recordCount_ : previous->records_[*previousRecord].end;
+                for (std::uint32_t index = first; index < last; index = previous->records_[index].end)
+                {
+                    children.push_back(Child{std::string{previous->Name(index)}, previous->records_[index].flags});
+                }
+                return children;
+            }
+        }
+
+        std::error_code ec;
+        for (auto& info : ListDirectory(directory, DirectoryWalkOptions{}, ec))
+        {
+            std::uint8_t flags = 0;
+            if (info.type == DirectoryEntryType::Directory)
+            {
+                flags |= kDirectoryFlag;
+            }
+            if (info.isSymlink)
+            {
+                flags |= kSymlinkFlag;
+            }
+            children.push_back(Child{std::move(info.name), flags});
+        }
+        return children;
+    }
+
+    bool AddChildren(
+        const std::filesystem::path& directory,
+        std::uint32_t parent,
+        std::int64_t mtime,
+        std::optional<std::uint32_t> previousRecord)
+    {
+        for (auto& child : ListChildren(directory, mtime, previousRecord))
+        {
+            if (IsCancelled(cancelled))
+            {
+                return false;
+            }
+            if (records.size() + 1 >= kNoParent || names.size() + child.name.size() + 1 > kNoParent
+                || child.name.size() > std::numeric_limits<std::uint16_t>::max())
+            {
+                continue;
+            }
+
+            const auto index = static_cast<std::uint32_t>(records.size());
+            records.push_back(Record{
+                parent,
+                index + 1,
+                static_cast<std::uint32_t>(names.size()),
+                static_cast<std::uint16_t>(child.name.size()),
+                child.flags,
+                0,
+                kUnknownMtime});
+            names.append(child.name).push_back('\0');
+            lowerNames.append(ToLower(child.name)).push_back('\0');
+
+            if ((child.flags & kDirectoryFlag) == 0 || (child.flags & kSymlinkFlag) != 0)
+            {
+                continue;
+            }
+
+            const std::filesystem::path childPath = directory / child.name;
+            if (IsPruned(childPath, prunedMountPoints))
+            {
+                continue;
+            }
+
+            const std::int64_t childMtime = DirectoryMtime(childPath);
+            records[index].mtime = childMtime;
+            std::optional<std::uint32_t> previousChild;
+            if (previous != nullptr)
+            {
+                if (const auto it = previousDirectories.find(childPath.string()); it != previousDirectories.end())
+                {
+                    previousChild = it->second;
+                }
+            }
+            if (!AddChildren(childPath, index, childMtime, previousChild))
+            {
+                return false;
+            }
+            records[index].end = static_cast<std::uint32_t>(records.size());
+        }
+        return true;
+    }
+};
+
+PathIndex::~PathIndex()
+{
+    Close();
+}
+
+void PathIndex::Close() noexcept
+{
+#if !defined(_WIN32)
+    if (mapping_ != nullptr)
+    {
+        munmap(mapping_, mappingSize_);
+    }
+#endif
+    mapping_ = nullptr;
+    mappingSize_ = 0;
+    buffer_.clear();
+    records_ = nullptr;
+    recordCount_ = 0;
+    names_ = nullptr;
+    lowerNames_ = nullptr;
+    namesBytes_ = 0;
+    root_.clear();
+}
+
+bool PathIndex::Open(const std::filesystem::path& file)
+{
+    Close();
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+#if !defined(_WIN32)
+    const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(FileHeader))
+    {
+        close(fd);
+        return false;
+    }
+    size = static_cast<std::size_t>(status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    mapping_ = mapping;
+    mappingSize_ = size;
+    data = static_cast<const char*>(mapping);
+#else
+    std::ifstream input(file, std::ios::binary);
+    if (!input)
+    {
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    data = buffer_.data();
+    size = buffer_.size();
+#endif
+
+    FileHeader header{};
+    if (size < sizeof(header))
+    {
+        Close();
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion)
+    {
+        Close();
+        return false;
+    }
+
+    const std::uint64_t recordsStart = sizeof(header) + PadTo8(header.rootBytes);
+    const std::uint64_t namesStart = recordsStart + std::uint64_t{header.recordCount} * sizeof(Record);
+    if (header.namesBytes > size || namesStart > size || size - namesStart < 2 * header.namesBytes)
+    {
+        Close();
+        return false;
+    }
+
+    const auto* records = reinterpret_cast<const Record*>(data + recordsStart);
+    for (std::uint32_t index = 0; index < header.recordCount; ++index)
+    {
+        const Record& record = records[index];
+        const bool nameInBounds = std::uint64_t{record.nameOffset} + record.nameLength < header.namesBytes;
+        const bool parentBefore = record.parent == kNoParent || record.parent < index;
+        if (!nameInBounds || !parentBefore || record.end <= index || record.end > header.recordCount)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    root_ = std::filesystem::path{std::string(data + sizeof(header), header.rootBytes)};
+    builtAt_ = std::chrono::system_clock::time_point{std::chrono::seconds{header.builtAt}};
+    rootMtime_ = header.rootMtime;
+    records_ = records;
+    recordCount_ = header.recordCount;
+    names_ = data + namesStart;
+    lowerNames_ = names_ + header.namesBytes;
+    namesBytes_ = static_cast<std::size_t>(header.namesBytes);
+    return true;
+}
+
+bool PathIndex::Build(
+    const std::filesystem::path& root,
+    const std::filesystem::path& file,
+    const PathIndex* previous,
+    const std::atomic<bool>* cancelled)
+{
+    BuildState state;
+    state.cancelled = cancelled;
+    state.prunedMountPoints = PrunedMountPoints();
+    if (previous != nullptr && previous->recordCount_ > 0 && previous->root_ == root)
+    {
+        state.previous = previous;
+        state.IndexPreviousDirectories();
+    }
+
+    const std::int64_t rootMtime = DirectoryMtime(root);
+    const auto previousRoot = state.previous != nullptr ? std::optional<std::uint32_t>{kNoParent} : std::nullopt;
+    if (!state.AddChildren(root, kNoParent, rootMtime, previousRoot) || IsCancelled(cancelled))
+    {
+        return false;
+    }
+
+    const std::string rootText = root.string();
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.recordCount = static_cast<std::uint32_t>(state.records.size());
+    header.namesBytes = state.names.size();
+    header.builtAt = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.rootMtime = rootMtime;
+    header.rootBytes = static_cast<std::uint32_t>(rootText.size());
+
+    std::filesystem::path temporaryPath = file;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!output)
+        {
+            std::cerr << "Unable to write path index: " << temporaryPath.string() << '\n';
+            return false;
+        }
+
+        const std::array<char, 8> padding{};
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(rootText.data(), static_cast<std::streamsize>(rootText.size()));
+        output.write(padding.data(), static_cast<std::streamsize>(PadTo8(rootText.size()) - rootText.size()));
+        output.write(
+            reinterpret_cast<const char*>(state.records.data()),
+            static_cast<std::streamsize>(state.records.size() * sizeof(Record)));
+        output.write(state.names.data(), static_cast<std::streamsize>(state.names.size()));
+        output.write(state.lowerNames.data(), static_cast<std::streamsize>(state.lowerNames.size()));
+        if (!output)
+        {
+            std::cerr << "Unable to write path index: " << temporaryPath.string() << '\n';
+            output.close();
+            std::error_code ec;
+            std::filesystem::remove(temporaryPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporaryPath, file, ec);
+    if (ec)
+    {
+        std::cerr << "Unable to replace path index: " << ec.message() << '\n';
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string_view PathIndex::Name(std::uint32_t record) const noexcept
+{
+    return std::string_view{names_ + records_[record].nameOffset, records_[record].nameLength};
+}
+
+std::string_view PathIndex::LowerName(std::uint32_t record) const noexcept
+{
+    return std::string_view{lowerNames_ + records_[record].nameOffset, records_[record].nameLength};
+}
+
+std::vector<PathIndexMatch> PathIndex::Search(std::string_view needle, const std::atomic<bool>* cancelled) const
+{
+    if (needle.empty() || recordCount_ == 0)
+    {
+        return {};
+    }
+    if (needle.find_first_of("/\\") != std::string_view::npos)
+    {
+        return SearchPaths(needle, cancelled);
+    }
+
+    // Without a separator, a path contains the needle exactly when one of its components does:
+    // find the names that contain it, then let each matching directory claim its subtree.
+    std::vector<std::uint8_t> ranks(recordCount_, kNoMatch);
+    if (ToLower(root_.string()).find(needle) != std::string::npos)
+    {
+        std::fill(ranks.begin(), ranks.end(), kRankPathContains);
+    }
+
+    const std::string_view blob{lowerNames_, namesBytes_};
+    const std::boyer_moore_horspool_searcher searcher(needle.begin(), needle.end());
+    std::vector<std::uint32_t> matchedDirectories;
+    for (auto hit = std::search(blob.begin(), blob.end(), searcher); hit != blob.end();
+         hit = std::search(hit, blob.end(), searcher))
+    {
+        if (IsCancelled(cancelled))
+        {
+            return {};
+        }
+
+        const auto offset = static_cast<std::uint32_t>(hit - blob.begin());
+        const Record* owner = std::upper_bound(records_, records_ + recordCount_, offset, [](std::uint32_t value, const Record& record) {
+            return value < record.nameOffset;
+        }) - 1;
+        const auto index = static_cast<std::uint32_t>(owner - records_);
+
+        // The first hit in a name is its earliest, so it decides the rank.
+        if (offset != owner->nameOffset)
+        {
+            ranks[index] = kRankNameContains;
+        }
+        else
+        {
+            ranks[index] = needle.size() == owner->nameLength ? kRankExactName : kRankNamePrefix;
+        }
+        if (owner->end > index + 1)
+        {
+            matchedDirectories.push_back(index);
+        }
+
+        hit = blob.begin() + owner->nameOffset + owner->nameLength;
+    }
+
+    std::uint32_t coveredUntil = 0;
+    for (const std::uint32_t directory : matchedDirectories)
+    {
+        const std::uint32_t end = records_[directory].end;
+        for (std::uint32_t index = std::max(directory + 1, coveredUntil); index < end; ++index)
+        {
+            ranks[index] = std::min(ranks[index], kRankPathContains);
+        }
+        coveredUntil = std::max(coveredUntil, end);
+    }
+
+    return CollectMatches(ranks, cancelled);
+}
+
+std::vector<PathIndexMatch> PathIndex::SearchPaths(std::string_view needle, const std::atomic<bool>* cancelled) const
+{
+    std::vector<std::uint8_t> ranks(recordCount_, kNoMatch);
+    const std::string lowerRoot = ToLower(root_.string());
+    std::vector<std::pair<std::uint32_t, std::string>> ancestors;
+    for (std::uint32_t index = 0; index < recordCount_; ++index)
+    {
+        if ((index & 0xFFFF) == 0 && IsCancelled(cancelled))
+        {
+            return {};
+        }
+
+        const Record& record = records_[index];
+        while (!ancestors.empty() && ancestors.back().first != record.parent)
+        {
+            ancestors.pop_back();
+        }
+
+        std::string path = ancestors.empty() ? lowerRoot : ancestors.back().second;
+        AppendSeparator(path);
+        path.append(LowerName(index));
+        if (path.find(needle) != std::string::npos)
+        {
+            ranks[index] = path.ends_with(needle) ? kRankNameContains : kRankPathContains;
+        }
+        if (record.end > index + 1)
+        {
+            ancestors.emplace_back(index, std::move(path));
+        }
+    }
+
+    return CollectMatches(ranks, cancelled);
+}
+
+std::vector<PathIndexMatch> PathIndex::CollectMatches(
+    const std::vector<std::uint8_t>& ranks,
+    const std::atomic<bool>* cancelled) const
+{
+    // Only directories that lead to a match get their path built, once, as plain strings:
+    // std::filesystem::path's operator/ costs more than the search itself on big result sets.
+    const std::string rootText = root_.string();
+    std::unordered_map<std::uint32_t, std::string> directoryPaths;
+    const std::function<const std::string&(std::uint32_t)> directoryPath = [&](std::uint32_t directory) -> const std::string& {
+        if (directory == kNoParent)
+        {
+            return rootText;
+        }
+        if (const auto it = directoryPaths.find(directory); it != directoryPaths.end())
+        {
+            return it->second;
+        }
+        std::string path = directoryPath(records_[directory].parent);
+        AppendSeparator(path);
+        path.append(Name(directory));
+        return directoryPaths.emplace(directory, std::move(path)).first->second;
+    };
+
+    std::vector<PathIndexMatch> matches;
+    matches.reserve(static_cast<std::size_t>(std::count_if(ranks.begin(), ranks.end(), [](std::uint8_t rank) {
+        return rank != kNoMatch;
+    })));
+    for (std::uint32_t index = 0; index < recordCount_; ++index)
+    {
+        if (ranks[index] == kNoMatch)
+        {
+            continue;
+        }
+        if ((matches.size() & 0xFFF) == 0 && IsCancelled(cancelled))
+        {
+            return {};
+        }
+
+        const Record& record = records_[index];
+        PathIndexMatch match;
+        match.rank = ranks[index];
+        match.isDirectory = (record.flags & kDirectoryFlag) != 0;
+        match.isSymlink = (record.flags & kSymlinkFlag) != 0;
+        std::string path = directoryPath(record.parent);
+        AppendSeparator(path);
+        path.append(Name(index));
+        match.path = std::move(path);
+        matches.push_back(std::move(match));
+    }
+    return matches;
+}
+
+} // namespace colony
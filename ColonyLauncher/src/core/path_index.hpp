@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace colony
+{
+
+struct PathIndexMatch
+{
+    // Lower is better; see PathIndex::kRank*.
+    std::uint8_t rank = 0;
+    bool isDirectory = false;
+    bool isSymlink = false;
+    std::filesystem::path path;
+};
+
+// Every path below a root, in a single file that is memory-mapped read-only, like the locate
+// database. Entries are stored in pre-order with their names in one blob and a lower-cased
+// copy in another, so a search is one substring scan over the lower-cased names; a directory's
+// descendants form a contiguous run, so a matching directory matches its whole subtree without
+// building a single path string.
+//
+// An opened index never changes; share it freely between threads.
+class PathIndex
+{
+  public:
+    static constexpr std::uint8_t kRankExactName = 0;
+    static constexpr std::uint8_t kRankNamePrefix = 1;
+    static constexpr std::uint8_t kRankNameContains = 2;
+    static constexpr std::uint8_t kRankPathContains = 3;
+
+    PathIndex() = default;
+    PathIndex(const PathIndex&) = delete;
+    PathIndex& operator=(const PathIndex&) = delete;
+    ~PathIndex();
+
+    // Maps an index written by Build. Returns false if it is missing, truncated or from
+    // another version.
+    bool Open(const std::filesystem::path& file);
+
+    // Walks `root` and writes a new index to `file`, replacing it atomically. Directories whose
+    // mtime matches `previous` reuse its listing instead of being read again. Like updatedb,
+    // mounts of pseudo, network, FUSE and removable filesystems below `root` are skipped
+    // without being touched. Returns false if cancelled or unwritable.
+    static bool Build(
+        const std::filesystem::path& root,
+        const std::filesystem::path& file,
+        const PathIndex* previous,
+        const std::atomic<bool>* cancelled);
+
+    [[nodiscard]] const std::filesystem::path& Root() const noexcept { return root_; }
+    [[nodiscard]] std::chrono::system_clock::time_point BuiltAt() const noexcept { return builtAt_; }
+    [[nodiscard]] std::size_t Size() const noexcept { return recordCount_; }
+
+    // Paths containing `needle`, which must be lower-case, in index order. A needle with a
+    // separator is matched against whole paths, which is slower.
+    [[nodiscard]] std::vector<PathIndexMatch> Search(
+        std::string_view needle,
+        const std::atomic<bool>* cancelled = nullptr) const;
+
+  private:
+    struct Record;
+    struct BuildState;
+
+    void Close() noexcept;
+    [[nodiscard]] std::string_view Name(std::uint32_t record) const noexcept;
+    [[nodiscard]] std::string_view LowerName(std::uint32_t record) const noexcept;
+    [[nodiscard]] std::vector<PathIndexMatch> SearchPaths(
+        std::string_view needle,
+        const std::atomic<bool>* cancelled) const;
+    [[nodiscard]] std::vector<PathIndexMatch> CollectMatches(
+        const std::vector<std::uint8_t>& ranks,
+        const std::atomic<bool>* cancelled) const;
+
+    std::filesystem::path root_;
+    std::chrono::system_clock::time_point builtAt_{};
+    std::int64_t rootMtime_ = 0;
+    const Record* records_ = nullptr;
+    std::uint32_t recordCount_ = 0;
+    const char* names_ = nullptr;
+    const char* lowerNames_ = nullptr;
+    std::size_t namesBytes_ = 0;
+
+    void* mapping_ = nullptr;
+    std::size_t mappingSize_ = 0;
+    std::vector<char> buffer_;
+};
+
+} // namespace colony
@@ -0,0 +1,141 @@
+#include "core/path_index_updater.hpp"
+
+#include <exception>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+// A full rebuild reads every directory on the disk; keep it out of the way of anything the
+// user is doing, including the app they just launched.
+void LowerCurrentThreadPriority()
+{
+#if defined(__linux__)
+    const auto threadId = static_cast<id_t>(syscall(SYS_gettid));
+    [[maybe_unused]] const int niced = setpriority(PRIO_PROCESS, threadId, 19);
+    constexpr int kIoprioWhoProcess = 1;
+    constexpr int kIoprioClassIdle = 3;
+    constexpr int kIoprioClassShift = 13;
+    [[maybe_unused]] const long ioniced = syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprioClassIdle << kIoprioClassShift);
+#endif
+}
+} // namespace
+
+PathIndexUpdater::~PathIndexUpdater()
+{
+    Cancel();
+}
+
+void PathIndexUpdater::Load(std::filesystem::path file)
+{
+    file_ = std::move(file);
+
+    auto index = std::make_shared<PathIndex>();
+    if (!index->Open(file_))
+    {
+        return;
+    }
+
+    std::lock_guard lock(state_->mutex);
+    state_->current = std::move(index);
+}
+
+void PathIndexUpdater::RefreshIfStale(const std::filesystem::path& root, std::chrono::seconds maxAge)
+{
+    if (file_.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard lock(state_->mutex);
+        if (state_->refreshing)
+        {
+            return;
+        }
+        const auto& current = state_->current;
+        if (current && current->Root() == root && std::chrono::system_clock::now() - current->BuiltAt() < maxAge)
+        {
+            return;
+        }
+        state_->refreshing = true;
+        state_->cancelled.store(false, std::memory_order_relaxed);
+    }
+
+    std::thread worker([state = state_, root, file = file_]() { RunRefresh(state, root, file); });
+    worker.detach();
+}
+
+void PathIndexUpdater::Cancel()
+{
+    // The cancelled worker keeps `refreshing` set until it exits, so a later refresh cannot start
+    // a second worker writing the same file.
+    std::lock_guard lock(state_->mutex);
+    if (state_->refreshing)
+    {
+        state_->cancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<const PathIndex> PathIndexUpdater::Current() const
+{
+    std::lock_guard lock(state_->mutex);
+    return state_->current;
+}
+
+bool PathIndexUpdater::IsRefreshing() const
+{
+    std::lock_guard lock(state_->mutex);
+    return state_->refreshing;
+}
+
+void PathIndexUpdater::RunRefresh(
+    const std::shared_ptr<State>& state,
+    const std::filesystem::path& root,
+    const std::filesystem::path& file)
+{
+    LowerCurrentThreadPriority();
+
+    std::shared_ptr<const PathIndex> previous;
+    {
+        std::lock_guard lock(state->mutex);
+        previous = state->current;
+    }
+
+    std::shared_ptr<PathIndex> index;
+    try
+    {
+        if (PathIndex::Build(root, file, previous.get(), &state->cancelled))
+        {
+            index = std::make_shared<PathIndex>();
+            if (!index->Open(file))
+            {
+                std::cerr << "Unable to open rebuilt path index: " << file.string() << '\n';
+                index.reset();
+            }
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Path index rebuild failed: " << ex.what() << '\n';
+        index.reset();
+    }
+
+    std::lock_guard lock(state->mutex);
+    state->refreshing = false;
+    if (index && !state->cancelled.load(std::memory_order_relaxed))
+    {
+        state->current = std::move(index);
+    }
+}
+
+} // namespace colony
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/path_index.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace colony
+{
+
+// Owns the current PathIndex and rebuilds it on a background thread at idle priority; searches
+// keep using the previous index until the new one has been written and mapped.
+//
+// The worker is detached so shutting down never waits on a slow disk; once Cancel returns its
+// result is dropped, and until it exits IsRefreshing stays true and no other rebuild starts.
+class PathIndexUpdater
+{
+  public:
+    PathIndexUpdater() = default;
+    PathIndexUpdater(const PathIndexUpdater&) = delete;
+    PathIndexUpdater& operator=(const PathIndexUpdater&) = delete;
+    ~PathIndexUpdater();
+
+    // Maps the index a previous run left in `file`, if any, and rebuilds into it from now on.
+    void Load(std::filesystem::path file);
+    // Rebuilds the index of `root` unless a rebuild is running or the current index of that
+    // root is younger than `maxAge`.
+    void RefreshIfStale(const std::filesystem::path& root, std::chrono::seconds maxAge);
+    void Cancel();
+
+    [[nodiscard]] std::shared_ptr<const PathIndex> Current() const;
+    [[nodiscard]] bool IsRefreshing() const;
+
+  private:
+    struct State
+    {
+        mutable std::mutex mutex;
+        std::shared_ptr<const PathIndex> current;
+        bool refreshing = false;
+        std::atomic<bool> cancelled{false};
+    };
+
+    static void RunRefresh(const std::shared_ptr<State>& state, const std::filesystem::path& root, const std::filesystem::path& file);
+
+    std::filesystem::path file_;
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+};
+
+} // namespace colony
@@ -0,0 +1,522 @@
+#include "core/process_launcher.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+#else
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <filesystem>
+#include <fstream>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+
+#if !defined(_WIN32)
+extern char** environ;
+#endif
+
+// posix_spawn_file_actions_addclosefrom_np arrived in glibc 2.34.
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 34)
+#define COLONY_SPAWN_HAS_CLOSEFROM 1
+#endif
+#endif
+#if !defined(COLONY_SPAWN_HAS_CLOSEFROM)
+#define COLONY_SPAWN_HAS_CLOSEFROM 0
+#endif
+
+namespace colony
+{
+namespace
+{
+#if defined(_WIN32)
+
+// _spawnvp joins argv with spaces, so anything with whitespace or quotes has to be quoted the
+// way the C runtime of the child will split it again.
+std::string QuoteWindowsArgument(const std::string& argument)
+{
+    if (!argument.empty() && argument.find_first_of(" \t\"") == std::string::npos)
+    {
+        return argument;
+    }
+
+    std::string quoted{"\""};
+    std::size_t backslashes = 0;
+    for (const char ch : argument)
+    {
+        if (ch == '\\')
+        {
+            ++backslashes;
+            continue;
+        }
+        quoted.append(ch == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+        backslashes = 0;
+        quoted.push_back(ch);
+    }
+    quoted.append(backslashes * 2, '\\');
+    quoted.push_back('"');
+    return quoted;
+}
+
+ProcessExit Reap(std::intptr_t handle)
+{
+    ProcessExit exit;
+    const HANDLE process = reinterpret_cast<HANDLE>(handle);
+    DWORD status = 0;
+    if (WaitForSingleObject(process, INFINITE) != WAIT_OBJECT_0 || !GetExitCodeProcess(process, &status))
+    {
+        exit.statusKnown = false;
+    }
+    else
+    {
+        exit.exitCode = static_cast<int>(status);
+    }
+    CloseHandle(process);
+    return exit;
+}
+
+#else
+
+ProcessExit Reap(std::int64_t pid)
+{
+    ProcessExit exit;
+    int status = 0;
+    pid_t reaped = -1;
+    do
+    {
+        reaped = waitpid(static_cast<pid_t>(pid), &status, 0);
+    } while (reaped < 0 && errno == EINTR);
+
+    if (reaped != static_cast<pid_t>(pid))
+    {
+        exit.statusKnown = false;
+    }
+    else if (WIFEXITED(status))
+    {
+        exit.exitCode = WEXITSTATUS(status);
+    }
+    else if (WIFSIGNALED(status))
+    {
+        exit.signal = WTERMSIG(status);
+    }
+    return exit;
+}
+
+// Descriptors Colony opened without O_CLOEXEC, such as ones a library opened, would otherwise
+// stay open in every program it starts.
+void CloseInheritedDescriptors(posix_spawn_file_actions_t& actions)
+{
+#if COLONY_SPAWN_HAS_CLOSEFROM
+    posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1);
+#else
+    // Only descriptors that would survive the exec need closing; naming every open one would
+    // fail the spawn if another thread closed it in between.
+    const auto addIfInherited = [&actions](int descriptor) {
+        const int flags = fcntl(descriptor, F_GETFD);
+        if (descriptor > STDERR_FILENO && flags >= 0 && (flags & FD_CLOEXEC) == 0)
+        {
+            posix_spawn_file_actions_addclose(&actions, descriptor);
+        }
+    };
+#if defined(__linux__)
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it("/proc/self/fd", ec), end; !ec && it != end; it.increment(ec))
+    {
+        const std::string name = it->path().filename().string();
+        int descriptor = -1;
+        const auto [last, error] = std::from_chars(name.data(), name.data() + name.size(), descriptor);
+        if (error == std::errc{} && last == name.data() + name.size())
+        {
+            addIfInherited(descriptor);
+        }
+    }
+#else
+    constexpr long kMaxScannedDescriptors = 4096;
+    const long limit = std::min(sysconf(_SC_OPEN_MAX), kMaxScannedDescriptors);
+    for (int descriptor = STDERR_FILENO + 1; descriptor < limit; ++descriptor)
+    {
+        addIfInherited(descriptor);
+    }
+#endif
+#endif
+}
+
+#endif
+} // namespace
+
+std::vector<std::string> SplitCommandLine(std::string_view command)
+{
+    std::vector<std::string> words;
+    std::string word;
+    bool inWord = false;
+    bool inQuotes = false;
+    for (const char ch : command)
+    {
+        if (ch == '"')
+        {
+            inQuotes = !inQuotes;
+            inWord = true;
+        }
+        else if (!inQuotes && std::isspace(static_cast<unsigned char>(ch)))
+        {
+            if (inWord)
+            {
+                words.push_back(std::move(word));
+                word.clear();
+                inWord = false;
+            }
+        }
+        else
+        {
+            word.push_back(ch);
+            inWord = true;
+        }
+    }
+    if (inWord)
+    {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+std::vector<std::int64_t> ProcessTree(std::int64_t pid)
+{
+    std::vector<std::int64_t> pids{pid};
+#if defined(__linux__)
+    constexpr std::size_t kMaxProcesses = 4096;
+    for (std::size_t next = 0; next < pids.size() && pids.size() < kMaxProcesses; ++next)
+    {
+        const std::filesystem::path tasks = "/proc/" + std::to_string(pids[next]) + "/task";
+        std::error_code ec;
+        for (std::filesystem::directory_iterator task(tasks, ec), end; !ec && task != end; task.increment(ec))
+        {
+            std::ifstream children{task->path() / "children"};
+            for (std::int64_t child = 0; children >> child;)
+            {
+                pids.push_back(child);
+            }
+        }
+    }
+#endif
+    return pids;
+}
+
+ProcessLauncher::~ProcessLauncher()
+{
+    Stop();
+}
+
+void ProcessLauncher::SetNotify(Notify notify)
+{
+    std::lock_guard lock(state_->mutex);
+    state_->notify = std::move(notify);
+}
+
+std::int64_t ProcessLauncher::Spawn(const std::vector<std::string>& argv, std::string tag, std::error_code& ec)
+{
+    ec.clear();
+    if (argv.empty() || argv.front().empty())
+    {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return 0;
+    }
+
+    Child child;
+    child.tag = std::move(tag);
+
+#if defined(_WIN32)
+    std::vector<std::string> quoted;
+    quoted.reserve(argv.size());
+    for (const auto& argument : argv)
+    {
+        quoted.push_back(QuoteWindowsArgument(argument));
+    }
+    std::vector<const char*> arguments;
+    arguments.reserve(quoted.size() + 1);
+    for (const auto& argument : quoted)
+    {
+        arguments.push_back(argument.c_str());
+    }
+    arguments.push_back(nullptr);
+
+    child.startTime = std::chrono::steady_clock::now();
+    const intptr_t handle = _spawnvp(_P_NOWAIT, argv.front().c_str(), arguments.data());
+    if (handle == -1)
+    {
+        ec.assign(errno, std::generic_category());
+        return 0;
+    }
+    child.handle = handle;
+    child.pid = static_cast<std::int64_t>(GetProcessId(reinterpret_cast<HANDLE>(handle)));
+    const std::int64_t pid = child.pid;
+#else
+    std::vector<char*> arguments;
+    arguments.reserve(argv.size() + 1);
+    for (const auto& argument : argv)
+    {
+        arguments.push_back(const_cast<char*>(argument.c_str()));
+    }
+    arguments.push_back(nullptr);
+
+    // The child starts with no blocked signals, default dispositions for the ones SDL or a
+    // terminal may have changed, and its own session so Ctrl+C in Colony's terminal or
+    // Colony exiting leaves it alone.
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#if defined(POSIX_SPAWN_SETSID)
+    flags |= POSIX_SPAWN_SETSID;
+#else
+    flags |= POSIX_SPAWN_SETPGROUP;
+    posix_spawnattr_setpgroup(&attributes, 0);
+#endif
+    posix_spawnattr_setflags(&attributes, flags);
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+    for (const int number : {SIGPIPE, SIGCHLD, SIGINT, SIGTERM, SIGHUP, SIGQUIT})
+    {
+        sigaddset(&signals, number);
+    }
+    posix_spawnattr_setsigdefault(&attributes, &signals);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    CloseInheritedDescriptors(actions);
+
+    child.startTime = std::chrono::steady_clock::now();
+    pid_t spawned = 0;
+    const int result = posix_spawnp(&spawned, arguments.front(), &actions, &attributes, arguments.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    if (result != 0)
+    {
+        ec.assign(result, std::generic_category());
+        return 0;
+    }
+    child.pid = static_cast<std::int64_t>(spawned);
+    const std::int64_t pid = child.pid;
+#endif
+
+    {
+        std::lock_guard lock(state_->mutex);
+        ++state_->running;
+    }
+
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    if (StartReaper())
+    {
+        const int pidfd = static_cast<int>(syscall(SYS_pidfd_open, static_cast<pid_t>(pid), 0));
+        if (pidfd >= 0)
+        {
+            {
+                std::lock_guard lock(state_->mutex);
+                watched_.emplace(pidfd, child);
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = pidfd;
+            if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, pidfd, &event) == 0)
+            {
+                return pid;
+            }
+            std::lock_guard lock(state_->mutex);
+            watched_.erase(pidfd);
+            close(pidfd);
+        }
+    }
+#endif
+
+    // No pidfd support (kernels before 5.3, other platforms): wait on a thread of its own.
+    WaitDetached(state_, std::move(child));
+    return pid;
+}
+
+void ProcessLauncher::Stop()
+{
+    {
+        std::lock_guard lock(state_->mutex);
+        state_->stopped = true;
+        state_->notify = nullptr;
+    }
+
+#if defined(__linux__)
+    if (reaper_.joinable())
+    {
+        const std::uint64_t value = 1;
+        [[maybe_unused]] const auto written = write(stopFd_, &value, sizeof(value));
+        reaper_.join();
+    }
+    for (const auto& [pidfd, child] : watched_)
+    {
+        close(pidfd);
+    }
+    watched_.clear();
+    if (epollFd_ >= 0)
+    {
+        close(epollFd_);
+        epollFd_ = -1;
+    }
+    if (stopFd_ >= 0)
+    {
+        close(stopFd_);
+        stopFd_ = -1;
+    }
+#endif
+}
+
+std::vector<ProcessExit> ProcessLauncher::TakeExits()
+{
+    std::lock_guard lock(state_->mutex);
+    return std::exchange(state_->exits, {});
+}
+
+std::size_t ProcessLauncher::RunningCount() const
+{
+    std::lock_guard lock(state_->mutex);
+    return state_->running;
+}
+
+void ProcessLauncher::Report(State& state, const Child& child, ProcessExit exit)
+{
+    exit.tag = child.tag;
+    exit.pid = child.pid;
+    exit.runtime = std::chrono::steady_clock::now() - child.startTime;
+
+    std::lock_guard lock(state.mutex);
+    --state.running;
+    if (state.stopped)
+    {
+        return;
+    }
+    const bool wasEmpty = state.exits.empty();
+    state.exits.push_back(std::move(exit));
+    if (wasEmpty && state.notify)
+    {
+        state.notify();
+    }
+}
+
+void ProcessLauncher::WaitDetached(const std::shared_ptr<State>& state, Child child)
+{
+    std::thread waiter([state, child = std::move(child)]() {
+#if defined(_WIN32)
+        Report(*state, child, Reap(child.handle));
+#else
+        Report(*state, child, Reap(child.pid));
+#endif
+    });
+    waiter.detach();
+}
+
+#if defined(__linux__)
+
+bool ProcessLauncher::StartReaper()
+{
+    if (reaper_.joinable())
+    {
+        return true;
+    }
+    {
+        std::lock_guard lock(state_->mutex);
+        if (state_->stopped)
+        {
+            return false;
+        }
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    stopFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = stopFd_;
+    if (epollFd_ < 0 || stopFd_ < 0 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, stopFd_, &event) != 0)
+    {
+        if (epollFd_ >= 0)
+        {
+            close(epollFd_);
+            epollFd_ = -1;
+        }
+        if (stopFd_ >= 0)
+        {
+            close(stopFd_);
+            stopFd_ = -1;
+        }
+        return false;
+    }
+
+    reaper_ = std::thread([this]() { RunReaper(); });
+    return true;
+}
+
+void ProcessLauncher::RunReaper()
+{
+    epoll_event events[16];
+    while (true)
+    {
+        const int ready = epoll_wait(epollFd_, events, 16, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == stopFd_)
+            {
+                return;
+            }
+
+            Child child;
+            {
+                std::lock_guard lock(state_->mutex);
+                const auto it = watched_.find(fd);
+                if (it == watched_.end())
+                {
+                    continue;
+                }
+                child = std::move(it->second);
+                watched_.erase(it);
+            }
+            epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+            close(fd);
+
+            // A readable pidfd means the child has exited, so this does not block.
+            Report(*state_, child, Reap(child.pid));
+        }
+    }
+}
+
+#else
+
+bool ProcessLauncher::StartReaper()
+{
+    return false;
+}
+
+void ProcessLauncher::RunReaper() {}
+
+#endif
+
+} // namespace colony
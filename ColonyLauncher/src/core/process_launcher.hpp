@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+struct ProcessExit
+{
+    // Whatever the caller passed to Spawn, typically the program id.
+    std::string tag;
+    std::int64_t pid = 0;
+    // False when the status was lost, e.g. because SIGCHLD is ignored and the kernel reaped
+    // the child itself; exitCode and signal are then meaningless.
+    bool statusKnown = true;
+    int exitCode = 0;
+    // Non-zero if the process was killed by a signal.
+    int signal = 0;
+    std::chrono::steady_clock::duration runtime{};
+};
+
+// Splits a command such as the configured Python interpreter ("py -3") into argv words.
+// Whitespace separates words unless it is inside double quotes.
+[[nodiscard]] std::vector<std::string> SplitCommandLine(std::string_view command);
+
+// `pid` followed by every living descendant, from /proc/<pid>/task/*/children. Descendants that
+// were reparented away, like daemons, are not found. Only `pid` outside Linux.
+[[nodiscard]] std::vector<std::int64_t> ProcessTree(std::int64_t pid);
+
+// Starts programs directly from an argv vector, without a shell, and reports how they ended.
+// On Linux every child gets a pidfd that one reaper thread waits on with epoll; elsewhere each
+// child has a small waiter thread. Children inherit nothing but stdio and leave Colony's
+// session, so they outlive it like the old detached shell commands did.
+//
+// Exits queue up until the owner takes them; `notify` runs on the reaper when the queue stops
+// being empty.
+class ProcessLauncher
+{
+  public:
+    using Notify = std::function<void()>;
+
+    ProcessLauncher() = default;
+    ProcessLauncher(const ProcessLauncher&) = delete;
+    ProcessLauncher& operator=(const ProcessLauncher&) = delete;
+    ~ProcessLauncher();
+
+    void SetNotify(Notify notify);
+
+    // Starts argv[0], looked up on PATH when it has no directory part. Returns the pid, or 0
+    // with `ec` set when the program could not be started (missing, not executable, ...).
+    std::int64_t Spawn(const std::vector<std::string>& argv, std::string tag, std::error_code& ec);
+
+    // Stops watching. Running children keep running; their exits are no longer reported.
+    void Stop();
+
+    [[nodiscard]] std::vector<ProcessExit> TakeExits();
+    [[nodiscard]] std::size_t RunningCount() const;
+
+  private:
+    struct Child
+    {
+        std::int64_t pid = 0;
+        // Windows only: the handle _spawnvp returned, which is what gets waited on.
+        std::intptr_t handle = 0;
+        std::string tag;
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    struct State
+    {
+        mutable std::mutex mutex;
+        std::vector<ProcessExit> exits;
+        std::size_t running = 0;
+        bool stopped = false;
+        Notify notify;
+    };
+
+    static void Report(State& state, const Child& child, ProcessExit exit);
+    static void WaitDetached(const std::shared_ptr<State>& state, Child child);
+
+    bool StartReaper();
+    void RunReaper();
+
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+    std::thread reaper_;
+    int epollFd_ = -1;
+    int stopFd_ = -1;
+    // pidfd -> child; shared with the reaper under state_->mutex.
+    std::unordered_map<int, Child> watched_;
+};
+
+} // namespace colony
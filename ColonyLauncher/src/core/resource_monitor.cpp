@@ -0,0 +1,337 @@
+#include "core/resource_monitor.hpp"
+
+#include "core/process_launcher.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <unordered_set>
+#include <utility>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+#if defined(__linux__)
+
+std::string ReadSmallFile(const std::string& path)
+{
+    std::ifstream input{path};
+    std::string contents;
+    std::getline(input, contents);
+    return contents;
+}
+
+// Resident pages are the second field of /proc/<pid>/statm.
+std::optional<std::uint64_t> ParseResidentPages(std::string_view statm)
+{
+    const std::size_t space = statm.find(' ');
+    if (space == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+    const std::string_view rest = statm.substr(space + 1);
+    std::uint64_t pages = 0;
+    const auto [end, error] = std::from_chars(rest.data(), rest.data() + rest.size(), pages);
+    if (error != std::errc{} || (end != rest.data() + rest.size() && *end != ' '))
+    {
+        return std::nullopt;
+    }
+    return pages;
+}
+
+#endif
+} // namespace
+
+std::optional<ProcessStat> ParseProcessStat(std::string_view line)
+{
+    // "pid (comm) state ppid ...": the name ends at the last ')', field 3 onwards follow it.
+    const std::size_t nameEnd = line.rfind(')');
+    if (nameEnd == std::string_view::npos)
+    {
+        return std::nullopt;
+    }
+
+    // Indexes from field 3 (state): utime is field 14, stime 15, num_threads 20, starttime 22.
+    constexpr std::size_t kUtime = 11;
+    constexpr std::size_t kStime = 12;
+    constexpr std::size_t kThreads = 17;
+    constexpr std::size_t kStartTime = 19;
+
+    std::uint64_t utime = 0;
+    std::uint64_t stime = 0;
+    std::uint64_t threads = 0;
+    std::uint64_t startTime = 0;
+    std::size_t index = 0;
+    std::size_t position = nameEnd + 1;
+    while (index <= kStartTime)
+    {
+        position = line.find_first_not_of(' ', position);
+        if (position == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        const std::size_t fieldEnd = std::min(line.find(' ', position), line.size());
+        const std::string_view field = line.substr(position, fieldEnd - position);
+
+        std::uint64_t* target = index == kUtime ? &utime
+            : index == kStime                   ? &stime
+            : index == kThreads                 ? &threads
+            : index == kStartTime               ? &startTime
+                                                : nullptr;
+        if (target != nullptr)
+        {
+            const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), *target);
+            if (error != std::errc{} || end != field.data() + field.size())
+            {
+                return std::nullopt;
+            }
+        }
+
+        position = fieldEnd;
+        ++index;
+    }
+
+    return ProcessStat{utime + stime, startTime, static_cast<std::uint32_t>(threads)};
+}
+
+std::string FormatResourceUsage(const ResourceUsage& usage)
+{
+    char cpu[32];
+    std::snprintf(cpu, sizeof(cpu), usage.cpuPercent < 10.0 ? "CPU %.1f%%" : "CPU %.0f%%", usage.cpuPercent);
+
+    constexpr double kMiB = 1024.0 * 1024.0;
+    const double mebibytes = static_cast<double>(usage.residentBytes) / kMiB;
+    char memory[32];
+    if (mebibytes < 1024.0)
+    {
+        std::snprintf(memory, sizeof(memory), "%.0f MB", mebibytes);
+    }
+    else
+    {
+        std::snprintf(memory, sizeof(memory), "%.1f GB", mebibytes / 1024.0);
+    }
+
+    std::string text = std::string{cpu} + " • " + memory + " • " + std::to_string(usage.threads)
+        + (usage.threads == 1 ? " thread" : " threads");
+    if (usage.processes > 1)
+    {
+        text += " • " + std::to_string(usage.processes) + " processes";
+    }
+    return text;
+}
+
+ResourceMonitor::ResourceMonitor(std::chrono::milliseconds interval)
+    : interval_(interval)
+{}
+
+ResourceMonitor::~ResourceMonitor()
+{
+    Stop();
+}
+
+void ResourceMonitor::SetNotify(Notify notify)
+{
+    std::lock_guard lock(mutex_);
+    notify_ = std::move(notify);
+}
+
+void ResourceMonitor::SetInterval(std::chrono::milliseconds interval)
+{
+    {
+        std::lock_guard lock(mutex_);
+        interval_ = std::max(interval, std::chrono::milliseconds::zero());
+        ++intervalGeneration_;
+    }
+    wake_.notify_one();
+}
+
+void ResourceMonitor::Watch(std::int64_t pid, std::string tag)
+{
+#if defined(__linux__)
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_)
+        {
+            return;
+        }
+        watched_.push_back(Watched{pid, std::move(tag)});
+    }
+    if (!thread_.joinable())
+    {
+        thread_ = std::thread([this]() { Run(); });
+    }
+    wake_.notify_one();
+#else
+    (void)pid;
+    (void)tag;
+#endif
+}
+
+bool ResourceMonitor::Forget(std::int64_t pid)
+{
+    std::lock_guard lock(mutex_);
+    const auto forgotten = std::find_if(watched_.begin(), watched_.end(), [pid](const Watched& watched) {
+        return watched.pid == pid;
+    });
+    if (forgotten == watched_.end())
+    {
+        return false;
+    }
+
+    const std::string tag = forgotten->tag;
+    watched_.erase(forgotten);
+    if (std::any_of(watched_.begin(), watched_.end(), [&tag](const Watched& watched) { return watched.tag == tag; }))
+    {
+        return true;
+    }
+
+    // Usage taken before the exit would otherwise overwrite what the owner shows for it.
+    std::erase_if(usage_, [&tag](const ResourceUsage& usage) { return usage.tag == tag; });
+    return false;
+}
+
+void ResourceMonitor::Stop()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        notify_ = nullptr;
+    }
+    wake_.notify_one();
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+std::vector<ResourceUsage> ResourceMonitor::TakeUsage()
+{
+    std::lock_guard lock(mutex_);
+    return std::exchange(usage_, {});
+}
+
+void ResourceMonitor::Run()
+{
+#if defined(__linux__)
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [this]() { return stopping_ || (!watched_.empty() && interval_.count() > 0); });
+        if (stopping_)
+        {
+            return;
+        }
+
+        const std::vector<Watched> snapshot = watched_;
+        const auto interval = interval_;
+        const auto intervalGeneration = intervalGeneration_;
+        lock.unlock();
+
+        auto sampled = Sample(snapshot);
+
+        lock.lock();
+        // Anything forgotten while sampling has exited; its usage is no longer wanted.
+        std::vector<ResourceUsage> batch;
+        for (auto& [tag, usage] : sampled)
+        {
+            const bool stillWatched = std::any_of(watched_.begin(), watched_.end(), [&tag](const Watched& watched) {
+                return watched.tag == tag;
+            });
+            if (stillWatched)
+            {
+                batch.push_back(std::move(usage));
+            }
+        }
+        if (!batch.empty())
+        {
+            usage_ = std::move(batch);
+            if (notify_)
+            {
+                notify_();
+            }
+        }
+
+        // A new interval takes effect now rather than after the old one runs out; a pause
+        // then waits at the top of the loop.
+        const auto deadline = std::chrono::steady_clock::now() + interval;
+        wake_.wait_until(lock, deadline, [this, intervalGeneration]() {
+            return stopping_ || intervalGeneration_ != intervalGeneration;
+        });
+        if (watched_.empty())
+        {
+            // Nothing left to compare against once every program exited.
+            previous_.clear();
+        }
+    }
+#endif
+}
+
+std::unordered_map<std::string, ResourceUsage> ResourceMonitor::Sample(const std::vector<Watched>& watched)
+{
+    std::unordered_map<std::string, ResourceUsage> usage;
+#if defined(__linux__)
+    static const long clockTicks = sysconf(_SC_CLK_TCK);
+    static const long pageSize = sysconf(_SC_PAGESIZE);
+
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsedSeconds = std::chrono::duration<double>(now - previousTick_).count();
+    previousTick_ = now;
+
+    std::unordered_map<std::int64_t, Previous> current;
+    std::unordered_set<std::int64_t> counted;
+    for (const auto& root : watched)
+    {
+        auto& entry = usage[root.tag];
+        entry.tag = root.tag;
+
+        for (const std::int64_t pid : ProcessTree(root.pid))
+        {
+            // Two launches of one program can share descendants only through reparenting, but
+            // nothing is counted twice either way.
+            if (!counted.insert(pid).second)
+            {
+                continue;
+            }
+
+            const std::string directory = "/proc/" + std::to_string(pid);
+            const auto stat = ParseProcessStat(ReadSmallFile(directory + "/stat"));
+            if (!stat)
+            {
+                continue;
+            }
+
+            ++entry.processes;
+            entry.threads += stat->threads;
+            if (const auto pages = ParseResidentPages(ReadSmallFile(directory + "/statm")))
+            {
+                entry.residentBytes += *pages * static_cast<std::uint64_t>(std::max(pageSize, 1L));
+            }
+
+            // A process first seen this tick has no baseline yet and counts as idle.
+            const auto previous = previous_.find(pid);
+            if (previous != previous_.end() && previous->second.startTime == stat->startTime
+                && stat->cpuTicks >= previous->second.cpuTicks && clockTicks > 0 && elapsedSeconds > 0.0)
+            {
+                const auto ticks = static_cast<double>(stat->cpuTicks - previous->second.cpuTicks);
+                entry.cpuPercent += ticks / static_cast<double>(clockTicks) / elapsedSeconds * 100.0;
+            }
+            current.insert_or_assign(pid, Previous{stat->startTime, stat->cpuTicks});
+        }
+    }
+    previous_ = std::move(current);
+
+    // A watched process that vanished before its exit was reported has nothing to show.
+    std::erase_if(usage, [](const auto& item) { return item.second.processes == 0; });
+#else
+    (void)watched;
+#endif
+    return usage;
+}
+
+} // namespace colony
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+// The fields of /proc/<pid>/stat the monitor needs.
+struct ProcessStat
+{
+    // utime + stime, in clock ticks.
+    std::uint64_t cpuTicks = 0;
+    // Start time since boot, in clock ticks; tells a reused pid apart from the process before.
+    std::uint64_t startTime = 0;
+    std::uint32_t threads = 0;
+};
+
+// Parses one /proc/<pid>/stat line. The command name may hold spaces and parentheses.
+[[nodiscard]] std::optional<ProcessStat> ParseProcessStat(std::string_view line);
+
+// What one program uses, summed over every launched instance and its descendants.
+struct ResourceUsage
+{
+    std::string tag;
+    std::size_t processes = 0;
+    // Percent of one core over the last interval, so a busy multithreaded program can pass 100.
+    double cpuPercent = 0.0;
+    std::uint64_t residentBytes = 0;
+    std::uint32_t threads = 0;
+};
+
+// One line for the hero panel and status bar, e.g. "CPU 12% • 340 MB • 18 threads".
+[[nodiscard]] std::string FormatResourceUsage(const ResourceUsage& usage);
+
+// Samples CPU, resident memory and thread counts of launched programs from /proc.
+//
+// While something is watched, a thread reads /proc/<pid>/stat and statm for each watched
+// process and its descendants once per interval. Each tick replaces the previous batch with one
+// ResourceUsage per tag and runs `notify` once, so the owner redraws at most once per interval.
+// Nothing is sampled outside Linux.
+class ResourceMonitor
+{
+  public:
+    using Notify = std::function<void()>;
+
+    static constexpr std::chrono::milliseconds kDefaultInterval{1000};
+
+    explicit ResourceMonitor(std::chrono::milliseconds interval = kDefaultInterval);
+    ResourceMonitor(const ResourceMonitor&) = delete;
+    ResourceMonitor& operator=(const ResourceMonitor&) = delete;
+    ~ResourceMonitor();
+
+    void SetNotify(Notify notify);
+    // Takes effect at once, waking a sleeping tick. A zero interval pauses sampling.
+    void SetInterval(std::chrono::milliseconds interval);
+    void Watch(std::int64_t pid, std::string tag);
+    // Stops sampling a process that exited. Returns whether another watched process still has its
+    // tag; if none does, usage already taken for the tag is dropped too.
+    bool Forget(std::int64_t pid);
+    void Stop();
+
+    // The latest batch, one entry per tag still watched; empty until the next tick after that.
+    [[nodiscard]] std::vector<ResourceUsage> TakeUsage();
+
+  private:
+    struct Watched
+    {
+        std::int64_t pid = 0;
+        std::string tag;
+    };
+
+    struct Previous
+    {
+        std::uint64_t startTime = 0;
+        std::uint64_t cpuTicks = 0;
+    };
+
+    void Run();
+    // Runs on the monitor thread only.
+    std::unordered_map<std::string, ResourceUsage> Sample(const std::vector<Watched>& watched);
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::chrono::milliseconds interval_;
+    // Bumped by SetInterval so a sleeping tick wakes up for it.
+    std::uint64_t intervalGeneration_ = 0;
+    std::vector<Watched> watched_;
+    std::vector<ResourceUsage> usage_;
+    Notify notify_;
+    bool stopping_ = false;
+    std::thread thread_;
+
+    // Monitor thread state: per-process CPU ticks at the previous tick.
+    std::unordered_map<std::int64_t, Previous> previous_;
+    std::chrono::steady_clock::time_point previousTick_;
+};
+
+} // namespace colony
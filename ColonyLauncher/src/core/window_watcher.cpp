@@ -0,0 +1,383 @@
+#include "core/window_watcher.hpp"
+
+#include "core/process_launcher.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#if defined(__linux__)
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#endif
+
+namespace colony
+{
+namespace
+{
+#if defined(__linux__)
+
+// The parts of <xcb/xcb.h> and <xcb/xproto.h> used here, so the headers are not needed to
+// build. Layouts are fixed by the X protocol.
+struct XcbConnection;
+struct XcbSetup;
+struct XcbGenericError;
+struct XcbGetPropertyReply;
+
+struct XcbCookie
+{
+    unsigned int sequence;
+};
+
+struct XcbScreen
+{
+    std::uint32_t root;
+};
+
+struct XcbScreenIterator
+{
+    XcbScreen* data;
+    int rem;
+    int index;
+};
+
+struct XcbInternAtomReply
+{
+    std::uint8_t responseType;
+    std::uint8_t pad0;
+    std::uint16_t sequence;
+    std::uint32_t length;
+    std::uint32_t atom;
+};
+
+constexpr std::uint32_t kAtomWindow = 33;
+constexpr std::uint32_t kAtomCardinal = 6;
+constexpr std::uint32_t kMaxClientWindows = 4096;
+
+class XcbClient
+{
+  public:
+    XcbClient(const XcbClient&) = delete;
+    XcbClient& operator=(const XcbClient&) = delete;
+
+    ~XcbClient()
+    {
+        if (connection_ != nullptr)
+        {
+            disconnect_(connection_);
+        }
+        if (library_ != nullptr)
+        {
+            dlclose(library_);
+        }
+    }
+
+    static std::unique_ptr<XcbClient> Connect()
+    {
+        const char* display = std::getenv("DISPLAY");
+        if (display == nullptr || display[0] == '\0')
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<XcbClient> client{new XcbClient()};
+        client->library_ = dlopen("libxcb.so.1", RTLD_LAZY | RTLD_LOCAL);
+        if (client->library_ == nullptr || !client->LoadFunctions())
+        {
+            return nullptr;
+        }
+
+        int screenNumber = 0;
+        client->connection_ = client->connect_(nullptr, &screenNumber);
+        if (client->connection_ == nullptr || client->connectionHasError_(client->connection_) != 0)
+        {
+            return nullptr;
+        }
+
+        XcbScreenIterator screens = client->setupRootsIterator_(client->getSetup_(client->connection_));
+        for (int i = 0; i < screenNumber && screens.rem > 0; ++i)
+        {
+            client->screenNext_(&screens);
+        }
+        if (screens.data == nullptr)
+        {
+            return nullptr;
+        }
+        client->root_ = screens.data->root;
+
+        client->clientListAtom_ = client->InternAtom("_NET_CLIENT_LIST");
+        client->pidAtom_ = client->InternAtom("_NET_WM_PID");
+        if (client->clientListAtom_ == 0 || client->pidAtom_ == 0)
+        {
+            return nullptr;
+        }
+        return client;
+    }
+
+    // Pids owning the current top-level client windows; nullopt once the connection broke.
+    std::optional<std::unordered_set<std::int64_t>> WindowPids()
+    {
+        if (connectionHasError_(connection_) != 0)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<std::uint32_t> windows;
+        if (auto* reply = GetProperty(root_, clientListAtom_, kAtomWindow, kMaxClientWindows))
+        {
+            const auto bytes = static_cast<std::size_t>(std::max(0, getPropertyValueLength_(reply)));
+            windows.resize(bytes / sizeof(std::uint32_t));
+            std::memcpy(windows.data(), getPropertyValue_(reply), windows.size() * sizeof(std::uint32_t));
+            std::free(reply);
+        }
+
+        // Only windows not seen before are asked for their pid, all requests before any reply.
+        std::unordered_map<std::uint32_t, std::int64_t> current;
+        std::vector<std::pair<std::uint32_t, XcbCookie>> pending;
+        for (const std::uint32_t window : windows)
+        {
+            if (const auto known = windowPids_.find(window); known != windowPids_.end())
+            {
+                current.insert(*known);
+            }
+            else
+            {
+                pending.emplace_back(window, getProperty_(connection_, 0, window, pidAtom_, kAtomCardinal, 0, 1));
+            }
+        }
+        for (const auto& [window, cookie] : pending)
+        {
+            std::int64_t pid = 0;
+            XcbGenericError* error = nullptr;
+            if (auto* reply = getPropertyReply_(connection_, cookie, &error))
+            {
+                if (getPropertyValueLength_(reply) >= static_cast<int>(sizeof(std::uint32_t)))
+                {
+                    std::uint32_t value = 0;
+                    std::memcpy(&value, getPropertyValue_(reply), sizeof(value));
+                    pid = value;
+                }
+                std::free(reply);
+            }
+            std::free(error);
+            // Clients often set the pid just after the window appears; ask again next time.
+            if (pid > 0)
+            {
+                current.emplace(window, pid);
+            }
+        }
+        windowPids_ = std::move(current);
+
+        std::unordered_set<std::int64_t> pids;
+        for (const auto& [window, pid] : windowPids_)
+        {
+            pids.insert(pid);
+        }
+        return pids;
+    }
+
+  private:
+    XcbClient() = default;
+
+    template <typename Function>
+    bool Load(Function& function, const char* name)
+    {
+        function = reinterpret_cast<Function>(dlsym(library_, name));
+        return function != nullptr;
+    }
+
+    bool LoadFunctions()
+    {
+        return Load(connect_, "xcb_connect") && Load(disconnect_, "xcb_disconnect")
+            && Load(connectionHasError_, "xcb_connection_has_error") && Load(getSetup_, "xcb_get_setup")
+            && Load(setupRootsIterator_, "xcb_setup_roots_iterator") && Load(screenNext_, "xcb_screen_next")
+            && Load(internAtom_, "xcb_intern_atom") && Load(internAtomReply_, "xcb_intern_atom_reply")
+            && Load(getProperty_, "xcb_get_property") && Load(getPropertyReply_, "xcb_get_property_reply")
+            && Load(getPropertyValue_, "xcb_get_property_value")
+            && Load(getPropertyValueLength_, "xcb_get_property_value_length");
+    }
+
+    std::uint32_t InternAtom(const char* name)
+    {
+        XcbGenericError* error = nullptr;
+        const XcbCookie cookie = internAtom_(connection_, 1, static_cast<std::uint16_t>(std::strlen(name)), name);
+        auto* reply = internAtomReply_(connection_, cookie, &error);
+        std::free(error);
+        const std::uint32_t atom = reply != nullptr ? reply->atom : 0;
+        std::free(reply);
+        return atom;
+    }
+
+    XcbGetPropertyReply* GetProperty(std::uint32_t window, std::uint32_t property, std::uint32_t type, std::uint32_t length)
+    {
+        XcbGenericError* error = nullptr;
+        auto* reply = getPropertyReply_(connection_, getProperty_(connection_, 0, window, property, type, 0, length), &error);
+        std::free(error);
+        return reply;
+    }
+
+    void* library_ = nullptr;
+    XcbConnection* connection_ = nullptr;
+    std::uint32_t root_ = 0;
+    std::uint32_t clientListAtom_ = 0;
+    std::uint32_t pidAtom_ = 0;
+    std::unordered_map<std::uint32_t, std::int64_t> windowPids_;
+
+    XcbConnection* (*connect_)(const char*, int*) = nullptr;
+    void (*disconnect_)(XcbConnection*) = nullptr;
+    int (*connectionHasError_)(XcbConnection*) = nullptr;
+    const XcbSetup* (*getSetup_)(XcbConnection*) = nullptr;
+    XcbScreenIterator (*setupRootsIterator_)(const XcbSetup*) = nullptr;
+    void (*screenNext_)(XcbScreenIterator*) = nullptr;
+    XcbCookie (*internAtom_)(XcbConnection*, std::uint8_t, std::uint16_t, const char*) = nullptr;
+    XcbInternAtomReply* (*internAtomReply_)(XcbConnection*, XcbCookie, XcbGenericError**) = nullptr;
+    XcbCookie (*getProperty_)(XcbConnection*, std::uint8_t, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t) =
+        nullptr;
+    XcbGetPropertyReply* (*getPropertyReply_)(XcbConnection*, XcbCookie, XcbGenericError**) = nullptr;
+    void* (*getPropertyValue_)(const XcbGetPropertyReply*) = nullptr;
+    int (*getPropertyValueLength_)(const XcbGetPropertyReply*) = nullptr;
+};
+
+#endif
+} // namespace
+
+FirstWindowWatcher::~FirstWindowWatcher()
+{
+    Stop();
+}
+
+void FirstWindowWatcher::SetNotify(Notify notify)
+{
+    std::lock_guard lock(mutex_);
+    notify_ = std::move(notify);
+}
+
+void FirstWindowWatcher::Watch(std::int64_t pid, std::string tag, std::chrono::steady_clock::time_point spawnTime)
+{
+#if defined(__linux__)
+    {
+        std::lock_guard lock(mutex_);
+        if (stopping_)
+        {
+            return;
+        }
+        watched_.push_back(Watched{pid, std::move(tag), spawnTime});
+    }
+    if (!thread_.joinable())
+    {
+        thread_ = std::thread([this]() { Run(); });
+    }
+    wake_.notify_one();
+#else
+    (void)pid;
+    (void)tag;
+    (void)spawnTime;
+#endif
+}
+
+void FirstWindowWatcher::Forget(std::int64_t pid)
+{
+    std::lock_guard lock(mutex_);
+    std::erase_if(watched_, [pid](const Watched& watched) { return watched.pid == pid; });
+}
+
+void FirstWindowWatcher::Stop()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+        notify_ = nullptr;
+    }
+    wake_.notify_one();
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+std::vector<FirstWindowEvent> FirstWindowWatcher::TakeEvents()
+{
+    std::lock_guard lock(mutex_);
+    return std::exchange(events_, {});
+}
+
+void FirstWindowWatcher::Run()
+{
+#if defined(__linux__)
+    std::unique_ptr<XcbClient> display;
+    bool connectAttempted = false;
+
+    std::unique_lock lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [this]() { return stopping_ || !watched_.empty(); });
+        if (stopping_)
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        std::erase_if(watched_, [now](const Watched& watched) { return now - watched.spawnTime > kTimeout; });
+        const std::vector<Watched> snapshot = watched_;
+        lock.unlock();
+
+        if (!connectAttempted)
+        {
+            // Connect only once something is watched, and keep the connection for the session.
+            connectAttempted = true;
+            display = XcbClient::Connect();
+        }
+
+        std::vector<FirstWindowEvent> found;
+        std::optional<std::unordered_set<std::int64_t>> windowPids;
+        if (display)
+        {
+            windowPids = display->WindowPids();
+        }
+        if (windowPids)
+        {
+            for (const auto& watched : snapshot)
+            {
+                const auto tree = ProcessTree(watched.pid);
+                if (std::any_of(tree.begin(), tree.end(), [&](std::int64_t pid) { return windowPids->contains(pid); }))
+                {
+                    found.push_back(FirstWindowEvent{
+                        watched.tag,
+                        watched.pid,
+                        std::chrono::duration_cast<std::chrono::milliseconds>(now - watched.spawnTime)});
+                }
+            }
+        }
+
+        lock.lock();
+        if (!windowPids)
+        {
+            // No X server to ask, or it went away: nothing watched can ever be answered.
+            display.reset();
+            watched_.clear();
+            continue;
+        }
+        if (!found.empty())
+        {
+            std::erase_if(watched_, [&found](const Watched& watched) {
+                return std::any_of(found.begin(), found.end(), [&](const FirstWindowEvent& event) {
+                    return event.pid == watched.pid;
+                });
+            });
+            std::move(found.begin(), found.end(), std::back_inserter(events_));
+            if (notify_)
+            {
+                notify_();
+            }
+        }
+        wake_.wait_for(lock, kPollInterval, [this]() { return stopping_; });
+    }
+#endif
+}
+
+} // namespace colony
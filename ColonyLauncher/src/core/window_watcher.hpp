@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace colony
+{
+
+struct FirstWindowEvent
+{
+    std::string tag;
+    std::int64_t pid = 0;
+    std::chrono::milliseconds elapsed{};
+};
+
+// Reports when a launched process, or anything it started, maps its first top-level window.
+//
+// While something is being watched, a thread polls the X server's _NET_CLIENT_LIST every
+// kPollInterval and matches each new window's _NET_WM_PID against the process tree. It talks
+// to the server through libxcb, loaded at runtime so Colony neither links against X nor needs
+// it. Wayland offers no way to see other clients' windows, so without an X server (or
+// XWayland) nothing is ever reported; neither is anything outside Linux.
+//
+// Events queue up until the owner takes them; `notify` runs on the watcher thread after each
+// batch.
+class FirstWindowWatcher
+{
+  public:
+    using Notify = std::function<void()>;
+
+    static constexpr std::chrono::milliseconds kPollInterval{100};
+    // Past this a program is assumed to have no window of its own.
+    static constexpr std::chrono::seconds kTimeout{60};
+
+    FirstWindowWatcher() = default;
+    FirstWindowWatcher(const FirstWindowWatcher&) = delete;
+    FirstWindowWatcher& operator=(const FirstWindowWatcher&) = delete;
+    ~FirstWindowWatcher();
+
+    void SetNotify(Notify notify);
+    void Watch(std::int64_t pid, std::string tag, std::chrono::steady_clock::time_point spawnTime);
+    // Stops watching a process that exited before showing a window.
+    void Forget(std::int64_t pid);
+    void Stop();
+
+    [[nodiscard]] std::vector<FirstWindowEvent> TakeEvents();
+
+  private:
+    struct Watched
+    {
+        std::int64_t pid = 0;
+        std::string tag;
+        std::chrono::steady_clock::time_point spawnTime;
+    };
+
+    void Run();
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Watched> watched_;
+    std::vector<FirstWindowEvent> events_;
+    Notify notify_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace colony
@@ -1,13 +1,13 @@
 #include "frontend/components/badge.hpp"
 
 #include "ui/layout.hpp"
-#include "utils/drawing.hpp"
+#include "utils/text_texture_cache.hpp"
 
 namespace colony::frontend::components
 {
 
 void RenderBadge(
-    SDL_Renderer* renderer,
+    colony::DrawList& drawList,
     const colony::ui::ThemeColors& theme,
     const SDL_Rect& bounds,
     std::string_view label,
@@ -16,24 +16,24 @@ void RenderBadge(
     SDL_Color textColor)
 {
     const int radius = colony::ui::Scale(12);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, fillColor.r, fillColor.g, fillColor.b, fillColor.a);
-    colony::drawing::RenderFilledRoundedRect(renderer, bounds, radius);
+    drawList.SetBlendMode(SDL_BLENDMODE_BLEND);
+    drawList.FillRoundedRect(bounds, radius, fillColor);
 
     if (!font || label.empty())
     {
         return;
     }
 
-    colony::TextTexture textTexture = colony::CreateTextTexture(renderer, font, label, textColor);
-    if (textTexture.texture)
+    const colony::TextTexture* textTexture =
+        colony::SharedTextTextureCache().Acquire(drawList.Renderer(), font, label, textColor);
+    if (textTexture != nullptr)
     {
         SDL_Rect textRect{
-            bounds.x + (bounds.w - textTexture.width) / 2,
-            bounds.y + (bounds.h - textTexture.height) / 2,
-            textTexture.width,
-            textTexture.height};
-        colony::RenderTexture(renderer, textTexture, textRect);
+            bounds.x + (bounds.w - textTexture->width) / 2,
+            bounds.y + (bounds.h - textTexture->height) / 2,
+            textTexture->width,
+            textTexture->height};
+        drawList.DrawText(*textTexture, textRect);
     }
 }
 
@@ -4,7 +4,6 @@
 #include "frontend/components/buttons.hpp"
 #include "ui/layout.hpp"
 #include "utils/color.hpp"
-#include "utils/drawing.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -20,11 +19,21 @@ void BrandCard::Build(
     TTF_Font* labelFont,
     const colony::ui::ThemeColors& theme)
 {
-    content_ = content;
-    titleTexture_ = colony::CreateTextTexture(renderer, titleFont, content.title, theme.heroTitle);
-    subtitleTexture_ = colony::CreateTextTexture(renderer, subtitleFont, content.subtitle, theme.muted);
-    categoryTexture_ = colony::CreateTextTexture(renderer, labelFont, content.category, theme.navTextMuted);
-    metricTexture_ = colony::CreateTextTexture(renderer, labelFont, content.metric, theme.statusBarText);
+    // Texts that did not change keep their textures, so a recycled card only rasterizes what
+    // differs from the program it showed before.
+    const auto rebuild = [&](colony::TextTexture& texture, const std::string& previous, const std::string& text,
+                             TTF_Font* font, SDL_Color color) {
+        if (text != previous || !built_)
+        {
+            texture = colony::CreateTextTexture(renderer, font, text, color);
+        }
+    };
+    rebuild(titleTexture_, content_.title, content.title, titleFont, theme.heroTitle);
+    rebuild(subtitleTexture_, content_.subtitle, content.subtitle, subtitleFont, theme.muted);
+    rebuild(categoryTexture_, content_.category, content.category, labelFont, theme.navTextMuted);
+    rebuild(metricTexture_, content_.metric, content.metric, labelFont, theme.statusBarText);
+
+    std::vector<HighlightChip> previousChips = std::move(highlightChips_);
     highlightChips_.clear();
     highlightChips_.reserve(content.highlights.size());
     if (labelFont != nullptr)
@@ -38,17 +47,30 @@ void BrandCard::Build(
 
             HighlightChip chip;
             chip.label = highlight;
-            chip.texture = colony::CreateTextTexture(renderer, labelFont, highlight, theme.navText);
+            const auto previous = std::find_if(
+                previousChips.begin(),
+                previousChips.end(),
+                [&](const HighlightChip& old) { return old.label == highlight && old.texture.texture; });
+            if (built_ && previous != previousChips.end())
+            {
+                chip.texture = std::move(previous->texture);
+            }
+            else
+            {
+                chip.texture = colony::CreateTextTexture(renderer, labelFont, highlight, theme.navText);
+            }
             if (chip.texture.texture)
             {
                 highlightChips_.push_back(std::move(chip));
             }
         }
     }
+    content_ = content;
+    built_ = true;
 }
 
 SDL_Rect BrandCard::Render(
-    SDL_Renderer* renderer,
+    colony::DrawList& drawList,
     const colony::ui::ThemeColors& theme,
     const colony::ui::InteractionColors& interactions,
     const SDL_Rect& bounds,
@@ -71,11 +93,12 @@ SDL_Rect BrandCard::Render(
         baseFill = colony::color::Mix(theme.cardActive, baseFill, 0.7f);
     }
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, baseFill.r, baseFill.g, baseFill.b, 240);
-    colony::drawing::RenderFilledRoundedRect(renderer, cardRect, radius);
-    SDL_SetRenderDrawColor(renderer, theme.divider.r, theme.divider.g, theme.divider.b, 180);
-    colony::drawing::RenderRoundedRect(renderer, cardRect, radius);
+    baseFill.a = 240;
+    SDL_Color cardOutline = theme.divider;
+    cardOutline.a = 180;
+    drawList.SetBlendMode(SDL_BLENDMODE_BLEND);
+    drawList.FillRoundedRect(cardRect, radius, baseFill);
+    drawList.DrawRoundedRect(cardRect, radius, cardOutline);
 
     const int padding = colony::ui::Scale(22);
     int cursorX = cardRect.x + padding;
@@ -83,24 +106,26 @@ SDL_Rect BrandCard::Render(
 
     const int avatarSize = colony::ui::Scale(48);
     SDL_Rect avatarRect{cursorX, cursorY, avatarSize, avatarSize};
-    SDL_SetRenderDrawColor(renderer, content_.accent.r, content_.accent.g, content_.accent.b, SDL_ALPHA_OPAQUE);
-    colony::drawing::RenderFilledRoundedRect(renderer, avatarRect, avatarSize / 2);
-    SDL_SetRenderDrawColor(renderer, theme.border.r, theme.border.g, theme.border.b, 180);
-    colony::drawing::RenderRoundedRect(renderer, avatarRect, avatarSize / 2);
+    SDL_Color avatarFill = content_.accent;
+    avatarFill.a = SDL_ALPHA_OPAQUE;
+    SDL_Color avatarOutline = theme.border;
+    avatarOutline.a = 180;
+    drawList.FillRoundedRect(avatarRect, avatarSize / 2, avatarFill);
+    drawList.DrawRoundedRect(avatarRect, avatarSize / 2, avatarOutline);
 
     cursorX += avatarSize + colony::ui::Scale(18);
 
     if (titleTexture_.texture)
     {
         SDL_Rect titleRect{cursorX, cursorY, titleTexture_.width, titleTexture_.height};
-        colony::RenderTexture(renderer, titleTexture_, titleRect);
+        drawList.DrawText(titleTexture_, titleRect);
         cursorY += titleRect.h + colony::ui::Scale(4);
     }
 
     if (subtitleTexture_.texture)
     {
         SDL_Rect subtitleRect{cursorX, cursorY, subtitleTexture_.width, subtitleTexture_.height};
-        colony::RenderTexture(renderer, subtitleTexture_, subtitleRect);
+        drawList.DrawText(subtitleTexture_, subtitleRect);
         cursorY += subtitleRect.h + colony::ui::Scale(10);
     }
 
@@ -112,7 +137,7 @@ SDL_Rect BrandCard::Render(
         SDL_Color badgeFill = content_.ready ? colony::color::Mix(theme.success, content_.accent, 0.35f)
                                              : colony::color::Mix(theme.warning, content_.accent, 0.25f);
         SDL_Color badgeText = theme.heroTitle;
-        RenderBadge(renderer, theme, badgeRect, content_.statusLabel, labelFont, badgeFill, badgeText);
+        RenderBadge(drawList, theme, badgeRect, content_.statusLabel, labelFont, badgeFill, badgeText);
 
         cursorY += badgeRect.h + colony::ui::Scale(12);
     }
@@ -120,7 +145,7 @@ SDL_Rect BrandCard::Render(
     if (categoryTexture_.texture)
     {
         SDL_Rect categoryRect{cursorX, cursorY, categoryTexture_.width, categoryTexture_.height};
-        colony::RenderTexture(renderer, categoryTexture_, categoryRect);
+        drawList.DrawText(categoryTexture_, categoryRect);
         cursorY += categoryRect.h + colony::ui::Scale(6);
     }
 
@@ -153,17 +178,16 @@ SDL_Rect BrandCard::Render(
             SDL_Color chipFill = colony::color::Mix(content_.accent, theme.buttonGhost, 0.55f);
             chipFill.a = 220;
             SDL_Color chipOutline = colony::color::Mix(theme.border, chipFill, 0.35f);
-            SDL_SetRenderDrawColor(renderer, chipFill.r, chipFill.g, chipFill.b, chipFill.a);
-            colony::drawing::RenderFilledRoundedRect(renderer, chipRect, chipHeight / 2);
-            SDL_SetRenderDrawColor(renderer, chipOutline.r, chipOutline.g, chipOutline.b, 200);
-            colony::drawing::RenderRoundedRect(renderer, chipRect, chipHeight / 2);
+            chipOutline.a = 200;
+            drawList.FillRoundedRect(chipRect, chipHeight / 2, chipFill);
+            drawList.DrawRoundedRect(chipRect, chipHeight / 2, chipOutline);
 
             SDL_Rect chipTextRect{
                 chipRect.x + chipPadX,
                 chipRect.y + chipPadY,
                 chip.texture.width,
                 chip.texture.height};
-            colony::RenderTexture(renderer, chip.texture, chipTextRect);
+            drawList.DrawText(chip.texture, chipTextRect);
 
             chipX += chipWidth + chipSpacing;
             cursorY = std::max(cursorY, chipRect.y + chipRect.h);
@@ -177,7 +201,7 @@ SDL_Rect BrandCard::Render(
     if (metricTexture_.texture)
     {
         SDL_Rect metricRect{cursorX, cursorY, metricTexture_.width, metricTexture_.height};
-        colony::RenderTexture(renderer, metricTexture_, metricRect);
+        drawList.DrawText(metricTexture_, metricRect);
     }
 
     const int buttonHeight = colony::ui::Scale(36);
@@ -189,14 +213,14 @@ SDL_Rect BrandCard::Render(
     if (!content_.primaryActionLabel.empty())
     {
         SDL_Rect primaryButtonRect{buttonX, buttonY, buttonWidth, buttonHeight};
-        RenderPrimaryButton(renderer, theme, primaryButtonRect, content_.primaryActionLabel, buttonFont, hovered, active);
+        RenderPrimaryButton(drawList, theme, primaryButtonRect, content_.primaryActionLabel, buttonFont, hovered, active);
         buttonX += buttonWidth + buttonSpacing;
     }
 
     if (!content_.secondaryActionLabel.empty())
     {
         SDL_Rect secondaryButtonRect{buttonX, buttonY, buttonWidth, buttonHeight};
-        RenderSecondaryButton(renderer, theme, secondaryButtonRect, content_.secondaryActionLabel, buttonFont, hovered, false);
+        RenderSecondaryButton(drawList, theme, secondaryButtonRect, content_.secondaryActionLabel, buttonFont, hovered, false);
     }
 
     if (!content_.metricBadgeLabel.empty())
@@ -207,7 +231,7 @@ SDL_Rect BrandCard::Render(
             colony::ui::Scale(88),
             buttonHeight};
         SDL_Color metricFill = colony::color::Mix(theme.info, content_.accent, 0.25f);
-        RenderBadge(renderer, theme, metricBadgeRect, content_.metricBadgeLabel, labelFont, metricFill, theme.heroTitle);
+        RenderBadge(drawList, theme, metricBadgeRect, content_.metricBadgeLabel, labelFont, metricFill, theme.heroTitle);
     }
 
     if (hovered)
@@ -219,7 +243,7 @@ SDL_Rect BrandCard::Render(
         halo.y -= colony::ui::Scale(6);
         halo.w += colony::ui::Scale(12);
         halo.h += colony::ui::Scale(12);
-        colony::drawing::RenderRoundedRect(renderer, halo, radius + colony::ui::Scale(4));
+        drawList.DrawRoundedRect(halo, radius + colony::ui::Scale(4), glow);
     }
 
     if (active)
@@ -231,8 +255,8 @@ SDL_Rect BrandCard::Render(
         halo.y -= colony::ui::Scale(8);
         halo.w += colony::ui::Scale(16);
         halo.h += colony::ui::Scale(16);
-        SDL_SetRenderDrawColor(renderer, activeGlow.r, activeGlow.g, activeGlow.b, static_cast<Uint8>(90 + 60 * pulse));
-        colony::drawing::RenderRoundedRect(renderer, halo, radius + colony::ui::Scale(6));
+        activeGlow.a = static_cast<Uint8>(90 + 60 * pulse);
+        drawList.DrawRoundedRect(halo, radius + colony::ui::Scale(6), activeGlow);
     }
 
     return cardRect;
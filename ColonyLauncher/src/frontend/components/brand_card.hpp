@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ui/theme.hpp"
+#include "utils/draw_list.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
@@ -32,6 +33,8 @@ class BrandCard
         bool ready = false;
     };
 
+    // Rebuilding keeps the textures of unchanged texts; fonts and theme must stay the same for
+    // the card's lifetime, so use a fresh card when they change.
     void Build(
         SDL_Renderer* renderer,
         const Content& content,
@@ -41,7 +44,7 @@ class BrandCard
         const colony::ui::ThemeColors& theme);
 
     SDL_Rect Render(
-        SDL_Renderer* renderer,
+        colony::DrawList& drawList,
         const colony::ui::ThemeColors& theme,
         const colony::ui::InteractionColors& interactions,
         const SDL_Rect& bounds,
@@ -66,6 +69,7 @@ class BrandCard
     colony::TextTexture categoryTexture_;
     colony::TextTexture metricTexture_;
     std::vector<HighlightChip> highlightChips_;
+    bool built_ = false;
 };
 
 } // namespace colony::frontend::components
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ui/theme.hpp"
+#include "utils/draw_list.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
@@ -12,7 +13,7 @@ namespace colony::frontend::components
 {
 
 void RenderPrimaryButton(
-    SDL_Renderer* renderer,
+    colony::DrawList& drawList,
     const colony::ui::ThemeColors& theme,
     const SDL_Rect& bounds,
     std::string_view label,
@@ -21,7 +22,7 @@ void RenderPrimaryButton(
     bool pressed);
 
 void RenderSecondaryButton(
-    SDL_Renderer* renderer,
+    colony::DrawList& drawList,
     const colony::ui::ThemeColors& theme,
     const SDL_Rect& bounds,
     std::string_view label,
@@ -4,6 +4,7 @@
 #include "utils/color.hpp"
 #include "utils/drawing.hpp"
 #include "utils/text.hpp"
+#include "utils/text_texture_cache.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -84,27 +85,29 @@ void RenderEmptyStateCard(
     const int textWidth = bounds.x + bounds.w - textStartX - colony::ui::Scale(32);
     const int textTop = iconRect.y + colony::ui::Scale(4);
 
-    colony::TextTexture titleTexture = colony::CreateTextTexture(renderer, titleFont, title, theme.heroTitle);
-    colony::TextTexture messageTexture = colony::CreateTextTexture(renderer, bodyFont, message, theme.muted);
+    auto& textCache = colony::SharedTextTextureCache();
+    const colony::TextTexture* titleTexture = textCache.Acquire(renderer, titleFont, title, theme.heroTitle);
+    const colony::TextTexture* messageTexture = textCache.Acquire(renderer, bodyFont, message, theme.muted);
 
-    if (titleTexture.texture)
+    const int titleHeight = titleTexture != nullptr ? titleTexture->height : 0;
+    if (titleTexture != nullptr)
     {
         SDL_Rect titleRect{
             textStartX,
             textTop,
-            std::min(titleTexture.width, textWidth),
-            titleTexture.height};
-        colony::RenderTexture(renderer, titleTexture, titleRect);
+            std::min(titleTexture->width, textWidth),
+            titleTexture->height};
+        colony::RenderTexture(renderer, *titleTexture, titleRect);
     }
 
-    if (messageTexture.texture)
+    if (messageTexture != nullptr)
     {
         SDL_Rect messageRect{
             textStartX,
-            textTop + titleTexture.height + colony::ui::Scale(12),
-            std::min(messageTexture.width, textWidth),
-            messageTexture.height};
-        colony::RenderTexture(renderer, messageTexture, messageRect);
+            textTop + titleHeight + colony::ui::Scale(12),
+            std::min(messageTexture->width, textWidth),
+            messageTexture->height};
+        colony::RenderTexture(renderer, *messageTexture, messageRect);
     }
 }
 
@@ -30,10 +30,10 @@ SDL_Rect SidebarItem::Render(
     const SDL_Rect& bounds,
     SDL_Color accent,
     bool active,
-    bool hovered,
-    double timeSeconds) const
+    bool hovered) const
 {
     (void)typography;
+    (void)interactions;
     SDL_Rect itemRect = bounds;
     const int radius = colony::ui::Scale(18);
 
@@ -109,26 +109,31 @@ SDL_Rect SidebarItem::Render(
         SDL_SetTextureColorMod(renderLabel.texture.get(), 255, 255, 255);
     }
 
-    SDL_Color glow = interactions.subtleGlow;
-    if (active)
-    {
-        glow = colony::color::Mix(accent, theme.heroTitle, 0.35f);
-        glow.a = 90;
-    }
-    const float pulse = active ? static_cast<float>(std::sin(timeSeconds * 2.2) * 0.5 + 0.5) : 0.0f;
+    return itemRect;
+}
+
+void SidebarItem::RenderActivePulse(
+    SDL_Renderer* renderer,
+    const colony::ui::ThemeColors& theme,
+    const SDL_Rect& bounds,
+    SDL_Color accent,
+    double timeSeconds) const
+{
+    SDL_Color glow = colony::color::Mix(accent, theme.heroTitle, 0.35f);
+    glow.a = 90;
+    const float pulse = static_cast<float>(std::sin(timeSeconds * 2.2) * 0.5 + 0.5);
     if (pulse > 0.01f)
     {
         SDL_Color halo = colony::color::Mix(glow, theme.navRail, 0.4f);
-        SDL_Rect haloRect = itemRect;
+        SDL_Rect haloRect = bounds;
         haloRect.x -= colony::ui::Scale(6);
         haloRect.w += colony::ui::Scale(12);
         haloRect.y -= colony::ui::Scale(4);
         haloRect.h += colony::ui::Scale(8);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_SetRenderDrawColor(renderer, halo.r, halo.g, halo.b, static_cast<Uint8>(80 + pulse * 60.0f));
-        colony::drawing::RenderFilledRoundedRect(renderer, haloRect, radius + colony::ui::Scale(6));
+        colony::drawing::RenderFilledRoundedRect(renderer, haloRect, colony::ui::Scale(18) + colony::ui::Scale(6));
     }
-
-    return itemRect;
 }
 
 } // namespace colony::frontend::components
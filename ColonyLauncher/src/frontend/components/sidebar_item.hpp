@@ -31,7 +31,14 @@ class SidebarItem
         const SDL_Rect& bounds,
         SDL_Color accent,
         bool active,
-        bool hovered,
+        bool hovered) const;
+
+    // Pulsing halo around the active item, kept out of Render so the item itself stays static.
+    void RenderActivePulse(
+        SDL_Renderer* renderer,
+        const colony::ui::ThemeColors& theme,
+        const SDL_Rect& bounds,
+        SDL_Color accent,
         double timeSeconds) const;
 
     [[nodiscard]] std::string_view Id() const noexcept { return id_; }
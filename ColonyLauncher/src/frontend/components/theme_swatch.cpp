@@ -4,6 +4,7 @@
 #include "utils/color.hpp"
 #include "utils/drawing.hpp"
 #include "utils/text.hpp"
+#include "utils/text_texture_cache.hpp"
 #include "utils/text_wrapping.hpp"
 
 #include <algorithm>
@@ -120,13 +121,14 @@ void RenderThemeSwatch(
                 break;
             }
 
-            colony::TextTexture texture = colony::CreateTextTexture(renderer, font, lines[i], color);
-            if (!texture.texture)
+            const colony::TextTexture* texture =
+                colony::SharedTextTextureCache().Acquire(renderer, font, lines[i], color);
+            if (texture == nullptr)
             {
                 continue;
             }
 
-            if (textCursorY + texture.height > textAreaBottom)
+            if (textCursorY + texture->height > textAreaBottom)
             {
                 break;
             }
@@ -134,11 +136,11 @@ void RenderThemeSwatch(
             SDL_Rect drawRect{
                 sampleHeadingRect.x,
                 textCursorY,
-                std::min(texture.width, textAreaWidth),
-                texture.height};
-            colony::RenderTexture(renderer, texture, drawRect);
+                std::min(texture->width, textAreaWidth),
+                texture->height};
+            colony::RenderTexture(renderer, *texture, drawRect);
 
-            textCursorY += texture.height;
+            textCursorY += texture->height;
             if (i + 1 < lines.size())
             {
                 textCursorY += lineSpacing;
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <numeric>
+#include <unordered_map>
 
 namespace colony::frontend::models
 {
@@ -51,6 +53,13 @@ LibrarySortOption LibraryViewModel::SortOption() const noexcept
     return sortOption_;
 }
 
+void LibraryViewModel::SetLaunchHistory(const colony::LaunchHistory* history) noexcept
+{
+    launchHistory_ = history;
+    recentOrderValid_ = false;
+    matchesValid_ = false;
+}
+
 std::vector<LibrarySortChip> LibraryViewModel::BuildSortChips(
     const std::function<std::string(std::string_view)>& localize) const
 {
@@ -79,92 +88,186 @@ std::vector<LibrarySortChip> LibraryViewModel::BuildSortChips(
     return chips;
 }
 
-std::vector<LibraryProgramEntry> LibraryViewModel::BuildProgramList(
+const std::vector<LibraryProgramEntry>& LibraryViewModel::BuildProgramList(
     const colony::AppContent& content,
     int activeChannelIndex,
     const std::vector<int>& channelSelections) const
 {
-    std::vector<LibraryProgramEntry> entries;
+    if (activeChannelIndex < 0 || activeChannelIndex >= static_cast<int>(content.channels.size())
+        || content.channels[static_cast<std::size_t>(activeChannelIndex)].programs.empty())
+    {
+        indexedChannel_ = -1;
+        indexedPrograms_.clear();
+        alphabeticalOrder_.clear();
+        recentOrderValid_ = false;
+        matchesValid_ = false;
+        entriesValid_ = false;
+        entries_.clear();
+        return entries_;
+    }
 
-    if (activeChannelIndex < 0 || activeChannelIndex >= static_cast<int>(content.channels.size()))
+    EnsureIndex(content, activeChannelIndex);
+    if (sortOption_ == LibrarySortOption::RecentlyPlayed)
     {
-        return entries;
+        EnsureRecentOrder();
     }
+    EnsureMatches();
 
-    const auto& channel = content.channels[activeChannelIndex];
-    if (channel.programs.empty())
+    const auto& channel = content.channels[static_cast<std::size_t>(activeChannelIndex)];
+    std::string_view selectedProgramId;
+    if (activeChannelIndex < static_cast<int>(channelSelections.size()))
     {
-        return entries;
+        const int selectionIndex = std::clamp(
+            channelSelections[static_cast<std::size_t>(activeChannelIndex)],
+            0,
+            static_cast<int>(channel.programs.size()) - 1);
+        selectedProgramId = channel.programs[static_cast<std::size_t>(selectionIndex)];
     }
 
-    std::vector<std::string> workingPrograms = channel.programs;
-    if (sortOption_ == LibrarySortOption::Alphabetical)
+    if (entriesValid_ && selectedProgramId == entriesSelectedProgramId_)
     {
-        auto makeSortKey = [&](const std::string& programId) {
-            auto viewIt = content.views.find(programId);
-            if (viewIt != content.views.end())
-            {
-                return ToLower(viewIt->second.heading);
-            }
-            return ToLower(programId);
-        };
+        return entries_;
+    }
 
-        std::sort(workingPrograms.begin(), workingPrograms.end(), [&](const std::string& lhs, const std::string& rhs) {
-            return makeSortKey(lhs) < makeSortKey(rhs);
-        });
+    entriesSelectedProgramId_ = std::string{selectedProgramId};
+    entries_.clear();
+    entries_.reserve(matchingPrograms_.size());
+    for (const std::size_t index : matchingPrograms_)
+    {
+        const auto& programId = indexedPrograms_[index].programId;
+        entries_.push_back(LibraryProgramEntry{programId, programId == selectedProgramId});
     }
+    entriesValid_ = true;
+    return entries_;
+}
+
+bool LibraryViewModel::HasActiveFilter() const noexcept
+{
+    return !normalizedFilter_.empty();
+}
 
-    std::string selectedProgramId;
-    if (activeChannelIndex >= 0 && activeChannelIndex < static_cast<int>(channelSelections.size()))
+void LibraryViewModel::EnsureIndex(const colony::AppContent& content, int channelIndex) const
+{
+    if (indexedContent_ == &content && indexedGeneration_ == content.generation && indexedChannel_ == channelIndex)
     {
-        const int selectionIndex = std::clamp(
-            channelSelections[activeChannelIndex],
-            0,
-            static_cast<int>(channel.programs.size()) - 1);
-        if (selectionIndex >= 0 && selectionIndex < static_cast<int>(channel.programs.size()))
-        {
-            selectedProgramId = channel.programs[selectionIndex];
-        }
+        return;
     }
 
-    entries.reserve(workingPrograms.size());
-    for (const auto& programId : workingPrograms)
+    indexedContent_ = &content;
+    indexedGeneration_ = content.generation;
+    indexedChannel_ = channelIndex;
+    recentOrderValid_ = false;
+    matchesValid_ = false;
+    entriesValid_ = false;
+
+    const auto& channel = content.channels[static_cast<std::size_t>(channelIndex)];
+    indexedPrograms_.clear();
+    indexedPrograms_.reserve(channel.programs.size());
+    for (const auto& programId : channel.programs)
     {
-        if (!normalizedFilter_.empty())
+        const auto viewIt = content.views.find(programId);
+        if (viewIt == content.views.end())
         {
-            auto viewIt = content.views.find(programId);
-            bool matches = MatchesFilter(programId);
-            if (viewIt != content.views.end())
-            {
-                matches = matches || MatchesFilter(viewIt->second.heading) || MatchesFilter(viewIt->second.tagline);
-            }
-            if (!matches)
-            {
-                continue;
-            }
+            continue;
         }
+        indexedPrograms_.push_back(IndexedProgram{
+            programId,
+            ToLower(programId),
+            ToLower(viewIt->second.heading),
+            ToLower(viewIt->second.tagline)});
+    }
 
-        entries.push_back(LibraryProgramEntry{programId, programId == selectedProgramId});
+    alphabeticalOrder_.resize(indexedPrograms_.size());
+    std::iota(alphabeticalOrder_.begin(), alphabeticalOrder_.end(), std::size_t{0});
+    std::stable_sort(alphabeticalOrder_.begin(), alphabeticalOrder_.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return indexedPrograms_[lhs].lowerHeading < indexedPrograms_[rhs].lowerHeading;
+    });
+}
+
+void LibraryViewModel::EnsureRecentOrder() const
+{
+    const std::uint64_t revision = launchHistory_ != nullptr ? launchHistory_->Revision() : 0;
+    if (recentOrderValid_ && recentOrderRevision_ == revision)
+    {
+        return;
     }
 
-    return entries;
+    recentOrderValid_ = true;
+    recentOrderRevision_ = revision;
+    matchesValid_ = false;
+
+    recentOrder_.resize(indexedPrograms_.size());
+    std::iota(recentOrder_.begin(), recentOrder_.end(), std::size_t{0});
+    if (launchHistory_ == nullptr)
+    {
+        return;
+    }
+
+    std::unordered_map<std::string_view, std::size_t> rankById;
+    const std::vector<std::string> ranked = launchHistory_->RankedProgramIds();
+    rankById.reserve(ranked.size());
+    for (std::size_t rank = 0; rank < ranked.size(); ++rank)
+    {
+        rankById.emplace(ranked[rank], rank);
+    }
+
+    const auto rankOf = [&](std::size_t index) {
+        const auto it = rankById.find(indexedPrograms_[index].programId);
+        return it != rankById.end() ? it->second : ranked.size();
+    };
+    std::stable_sort(recentOrder_.begin(), recentOrder_.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return rankOf(lhs) < rankOf(rhs);
+    });
 }
 
-bool LibraryViewModel::HasActiveFilter() const noexcept
+void LibraryViewModel::EnsureMatches() const
 {
-    return !normalizedFilter_.empty();
+    if (matchesValid_ && matchedSortOption_ == sortOption_ && matchedFilter_ == normalizedFilter_)
+    {
+        return;
+    }
+
+    // A filter that contains the previous one can only narrow the result, so typing another
+    // character re-checks the current matches instead of the whole channel.
+    const bool narrowing = matchesValid_ && matchedSortOption_ == sortOption_ && !matchedFilter_.empty()
+        && normalizedFilter_.find(matchedFilter_) != std::string::npos;
+
+    std::vector<std::size_t> candidates;
+    if (narrowing)
+    {
+        candidates = std::move(matchingPrograms_);
+    }
+    else if (sortOption_ == LibrarySortOption::Alphabetical)
+    {
+        candidates = alphabeticalOrder_;
+    }
+    else
+    {
+        candidates = recentOrder_;
+    }
+
+    if (!normalizedFilter_.empty())
+    {
+        std::erase_if(candidates, [this](std::size_t index) { return !MatchesFilter(indexedPrograms_[index]); });
+    }
+
+    matchingPrograms_ = std::move(candidates);
+    matchedFilter_ = normalizedFilter_;
+    matchedSortOption_ = sortOption_;
+    matchesValid_ = true;
+    entriesValid_ = false;
 }
 
-bool LibraryViewModel::MatchesFilter(std::string_view value) const
+bool LibraryViewModel::MatchesFilter(const IndexedProgram& program) const
 {
     if (normalizedFilter_.empty())
     {
         return true;
     }
 
-    std::string candidate{value};
-    candidate = ToLower(candidate);
-    return candidate.find(normalizedFilter_) != std::string::npos;
+    return program.lowerId.find(normalizedFilter_) != std::string::npos
+        || program.lowerHeading.find(normalizedFilter_) != std::string::npos
+        || program.lowerTagline.find(normalizedFilter_) != std::string::npos;
 }
 
 } // namespace colony::frontend::models
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "core/content.hpp"
+#include "core/launch_history.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <string_view>
@@ -38,10 +41,16 @@ class LibraryViewModel
     void SetSortOption(LibrarySortOption option) noexcept;
     [[nodiscard]] LibrarySortOption SortOption() const noexcept;
 
+    // Source of the RecentlyPlayed order; without one, that sort keeps the channel order.
+    void SetLaunchHistory(const colony::LaunchHistory* history) noexcept;
+
     [[nodiscard]] std::vector<LibrarySortChip> BuildSortChips(
         const std::function<std::string(std::string_view)>& localize) const;
 
-    [[nodiscard]] std::vector<LibraryProgramEntry> BuildProgramList(
+    // The result is memoized on (content generation, channel, filter, sort option, launch
+    // history revision, selection), so calling this every frame is free while nothing changes.
+    // The reference stays valid until the next call.
+    [[nodiscard]] const std::vector<LibraryProgramEntry>& BuildProgramList(
         const colony::AppContent& content,
         int activeChannelIndex,
         const std::vector<int>& channelSelections) const;
@@ -49,11 +58,44 @@ class LibraryViewModel
     [[nodiscard]] bool HasActiveFilter() const noexcept;
 
   private:
-    [[nodiscard]] bool MatchesFilter(std::string_view value) const;
+    // Lowercased once per content generation instead of on every comparison and filter check.
+    struct IndexedProgram
+    {
+        std::string programId;
+        std::string lowerId;
+        std::string lowerHeading;
+        std::string lowerTagline;
+    };
+
+    void EnsureIndex(const colony::AppContent& content, int channelIndex) const;
+    void EnsureRecentOrder() const;
+    void EnsureMatches() const;
+    [[nodiscard]] bool MatchesFilter(const IndexedProgram& program) const;
 
     std::string filter_;
     std::string normalizedFilter_;
     LibrarySortOption sortOption_ = LibrarySortOption::RecentlyPlayed;
+    const colony::LaunchHistory* launchHistory_ = nullptr;
+
+    mutable const colony::AppContent* indexedContent_ = nullptr;
+    mutable std::uint64_t indexedGeneration_ = 0;
+    mutable int indexedChannel_ = -1;
+    mutable std::vector<IndexedProgram> indexedPrograms_;
+    mutable std::vector<std::size_t> alphabeticalOrder_;
+
+    // Launched programs by frecency, then the rest in channel order.
+    mutable bool recentOrderValid_ = false;
+    mutable std::uint64_t recentOrderRevision_ = 0;
+    mutable std::vector<std::size_t> recentOrder_;
+
+    mutable bool matchesValid_ = false;
+    mutable std::string matchedFilter_;
+    mutable LibrarySortOption matchedSortOption_ = LibrarySortOption::RecentlyPlayed;
+    mutable std::vector<std::size_t> matchingPrograms_;
+
+    mutable bool entriesValid_ = false;
+    mutable std::string entriesSelectedProgramId_;
+    mutable std::vector<LibraryProgramEntry> entries_;
 };
 
 } // namespace colony::frontend::models
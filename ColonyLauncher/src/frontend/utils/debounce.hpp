@@ -59,6 +59,17 @@ class Debouncer
         return pending_;
     }
 
+    [[nodiscard]] double SecondsUntilDue(double nowSeconds) const noexcept
+    {
+        if (!pending_)
+        {
+            return 0.0;
+        }
+
+        const double remaining = delaySeconds_ - (nowSeconds - scheduledAtSeconds_);
+        return remaining > 0.0 ? remaining : 0.0;
+    }
+
   private:
     double delaySeconds_ = 0.0;
     double scheduledAtSeconds_ = 0.0;
@@ -41,6 +41,95 @@ float ComputeCustomizationSliderValue(const SDL_Rect& rect, int mouseX)
 namespace colony::input
 {
 
+CommandPaletteInputHandler::CommandPaletteInputHandler(Application& app) : app_(app) {}
+
+void CommandPaletteInputHandler::Register(InputRouter& router)
+{
+    router.RegisterHandler(SDL_MOUSEBUTTONDOWN, [this](const SDL_Event& event, bool& running) {
+        return HandleMouseButtonDown(event, running);
+    });
+    router.RegisterHandler(SDL_MOUSEMOTION, [this](const SDL_Event& event, bool& running) {
+        return HandleMouseMotion(event, running);
+    });
+    router.RegisterHandler(SDL_MOUSEWHEEL, [this](const SDL_Event& event, bool& running) {
+        return HandleMouseWheel(event, running);
+    });
+    router.RegisterHandler(SDL_KEYDOWN, [this](const SDL_Event& event, bool& running) {
+        return HandleKeyDown(event, running);
+    });
+    router.RegisterHandler(SDL_TEXTINPUT, [this](const SDL_Event& event, bool& running) {
+        return HandleTextInput(event, running);
+    });
+}
+
+bool CommandPaletteInputHandler::HandleMouseButtonDown(const SDL_Event& event, bool& running)
+{
+    (void)running;
+    if (!app_.commandPalette_.visible)
+    {
+        return false;
+    }
+
+    if (event.button.button == SDL_BUTTON_LEFT)
+    {
+        app_.HandleCommandPaletteMouseClick(event.button.x, event.button.y);
+    }
+    return true;
+}
+
+bool CommandPaletteInputHandler::HandleMouseMotion(const SDL_Event& event, bool& running)
+{
+    // Hover effects underneath, such as prefetching the hovered program, stay off while open.
+    (void)event;
+    (void)running;
+    return app_.commandPalette_.visible;
+}
+
+bool CommandPaletteInputHandler::HandleMouseWheel(const SDL_Event& event, bool& running)
+{
+    (void)event;
+    (void)running;
+    return app_.commandPalette_.visible;
+}
+
+bool CommandPaletteInputHandler::HandleKeyDown(const SDL_Event& event, bool& running)
+{
+    (void)running;
+    const SDL_Keycode key = event.key.keysym.sym;
+    if (key == SDLK_k && (event.key.keysym.mod & KMOD_CTRL) != 0)
+    {
+        if (app_.commandPalette_.visible)
+        {
+            app_.HideCommandPalette();
+        }
+        else
+        {
+            app_.ShowCommandPalette();
+        }
+        return true;
+    }
+
+    if (!app_.commandPalette_.visible)
+    {
+        return false;
+    }
+
+    app_.HandleCommandPaletteKey(key);
+    return true;
+}
+
+bool CommandPaletteInputHandler::HandleTextInput(const SDL_Event& event, bool& running)
+{
+    (void)running;
+    if (!app_.commandPalette_.visible)
+    {
+        return false;
+    }
+
+    app_.HandleCommandPaletteText(event.text);
+    return true;
+}
+
 HubInputHandler::HubInputHandler(Application& app) : app_(app) {}
 
 void HubInputHandler::Register(InputRouter& router)
@@ -131,7 +220,7 @@ bool HubInputHandler::HandleTextInput(const SDL_Event& event, bool& running)
         {
             app_.hubSearchQuery_.append(event.text.text, std::min(incomingLength, kMaxSearchLength - currentLength));
             app_.hubScrollOffset_ = 0;
-            app_.BuildHubPanel();
+            app_.UpdateHubSearchResults();
         }
         return true;
     }
@@ -427,9 +516,11 @@ bool NavigationInputHandler::HandleKeyDown(const SDL_Event& event, bool& running
     {
     case SDLK_UP:
         app_.ActivateProgramInChannel(app_.channelSelections_[app_.activeChannelIndex_] - 1);
+        app_.libraryRevealSelection_ = true;
         return true;
     case SDLK_DOWN:
         app_.ActivateProgramInChannel(app_.channelSelections_[app_.activeChannelIndex_] + 1);
+        app_.libraryRevealSelection_ = true;
         return true;
     case SDLK_LEFT:
         app_.navigationController_.Activate(app_.activeChannelIndex_ - 1);
@@ -679,7 +770,9 @@ bool LibraryInputHandler::HandleMouseButtonDown(const SDL_Event& event, bool& ru
         else if (const auto appIt = app_.userApplications_.find(app_.activeProgramId_);
                  appIt != app_.userApplications_.end())
         {
-            app_.LaunchUserApp(appIt->second, app_.activeProgramId_);
+            // Event timestamps are SDL ticks; count the time the click spent queued as well.
+            const auto queued = std::chrono::milliseconds{SDL_GetTicks() - event.button.timestamp};
+            app_.LaunchUserApp(appIt->second, app_.activeProgramId_, std::chrono::steady_clock::now() - queued);
         }
         return true;
     }
@@ -714,6 +807,24 @@ bool LibraryInputHandler::HandleMouseMotion(const SDL_Event& event, bool& runnin
         }
     }
 
+    std::string hoveredProgramId;
+    for (std::size_t i = 0; i < app_.programTileRects_.size() && i < app_.programTileProgramIds_.size(); ++i)
+    {
+        if (app_.PointInRect(app_.programTileRects_[i], event.motion.x, event.motion.y))
+        {
+            hoveredProgramId = app_.programTileProgramIds_[i];
+            break;
+        }
+    }
+    if (hoveredProgramId != app_.hoveredProgramTileId_)
+    {
+        app_.hoveredProgramTileId_ = hoveredProgramId;
+        if (!hoveredProgramId.empty())
+        {
+            app_.PrefetchProgram(hoveredProgramId);
+        }
+    }
+
     if (app_.resizeState_.target == Application::ResizeState::Target::None)
     {
         return true;
@@ -762,6 +873,31 @@ bool LibraryInputHandler::HandleMouseWheel(const SDL_Event& event, bool& running
         }
     }
 
+    if (const SDL_Rect& viewport = app_.libraryGridViewport_; viewport.w > 0 && viewport.h > 0)
+    {
+        int mouseX = 0;
+        int mouseY = 0;
+        SDL_GetMouseState(&mouseX, &mouseY);
+        if (app_.PointInRect(viewport, mouseX, mouseY))
+        {
+            int wheelY = event.wheel.y;
+            if (event.wheel.direction == SDL_MOUSEWHEEL_FLIPPED)
+            {
+                wheelY = -wheelY;
+            }
+
+            const int maxScroll = std::max(0, app_.libraryContentHeight_ - viewport.h);
+            if (wheelY == 0 || maxScroll <= 0)
+            {
+                return true;
+            }
+
+            const int delta = -wheelY * ui::Scale(60);
+            app_.libraryScrollOffset_ = std::clamp(app_.libraryScrollOffset_ + delta, 0, maxScroll);
+            return true;
+        }
+    }
+
     auto visualsIt = app_.programVisuals_.find(app_.activeProgramId_);
     if (visualsIt == app_.programVisuals_.end())
     {
@@ -12,6 +12,24 @@ class Application;
 namespace colony::input
 {
 
+// Registered ahead of every other handler: Ctrl+K toggles the palette, and while it is open it
+// consumes keyboard, text and pointer input so nothing underneath reacts.
+class CommandPaletteInputHandler
+{
+  public:
+    explicit CommandPaletteInputHandler(Application& app);
+    void Register(InputRouter& router);
+
+  private:
+    bool HandleMouseButtonDown(const SDL_Event& event, bool& running);
+    bool HandleMouseMotion(const SDL_Event& event, bool& running);
+    bool HandleMouseWheel(const SDL_Event& event, bool& running);
+    bool HandleKeyDown(const SDL_Event& event, bool& running);
+    bool HandleTextInput(const SDL_Event& event, bool& running);
+
+    Application& app_;
+};
+
 class HubInputHandler
 {
   public:
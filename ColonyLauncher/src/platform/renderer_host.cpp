@@ -89,4 +89,19 @@ RendererDimensions RendererHost::OutputSize() const noexcept
     return dimensions;
 }
 
+bool RendererHost::SetVSyncEnabled(bool enabled)
+{
+    if (!renderer_)
+    {
+        return false;
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    return SDLCallSucceeded(SDL_RenderSetVSync(renderer_.get(), enabled ? 1 : 0));
+#else
+    (void)enabled;
+    return false;
+#endif
+}
+
 } // namespace colony::platform
@@ -27,6 +27,7 @@ class RendererHost
     [[nodiscard]] SDL_Renderer* Renderer() const noexcept { return renderer_.get(); }
     [[nodiscard]] SDL_Window* Window() const noexcept { return window_.get(); }
     [[nodiscard]] RendererDimensions OutputSize() const noexcept;
+    bool SetVSyncEnabled(bool enabled);
 
   private:
     bool initialized_ = false;
@@ -100,6 +100,18 @@ std::string SettingsService::ResolvedPythonInterpreter() const
     return DefaultPythonInterpreter();
 }
 
+void SettingsService::SetTargetFrameRate(int framesPerSecond)
+{
+    targetFrameRate_ = std::clamp(framesPerSecond, 0, kMaxTargetFrameRate);
+}
+
+void SettingsService::SetResourceSampleIntervalMs(int milliseconds)
+{
+    resourceSampleIntervalMs_ = milliseconds <= 0
+        ? 0
+        : std::clamp(milliseconds, kMinResourceSampleIntervalMs, kMaxResourceSampleIntervalMs);
+}
+
 void SettingsService::Load(const std::filesystem::path& settingsPath, ui::ThemeManager& themeManager)
 {
     if (settingsPath.empty())
@@ -217,6 +229,16 @@ void SettingsService::Load(const std::filesystem::path& settingsPath, ui::ThemeM
         {
             pythonInterpreterPath_ = DefaultPythonInterpreter();
         }
+
+        if (document.contains("targetFrameRate") && document["targetFrameRate"].is_number_integer())
+        {
+            SetTargetFrameRate(document["targetFrameRate"].get<int>());
+        }
+
+        if (document.contains("resourceSampleIntervalMs") && document["resourceSampleIntervalMs"].is_number_integer())
+        {
+            SetResourceSampleIntervalMs(document["resourceSampleIntervalMs"].get<int>());
+        }
     }
     catch (const std::exception& ex)
     {
@@ -261,6 +283,8 @@ void SettingsService::Save(const std::filesystem::path& settingsPath, const ui::
     document["appearance"] = std::move(appearance);
 
     document["pythonInterpreter"] = pythonInterpreterPath_;
+    document["targetFrameRate"] = targetFrameRate_;
+    document["resourceSampleIntervalMs"] = resourceSampleIntervalMs_;
 
     nlohmann::json customThemes = nlohmann::json::array();
     for (const auto& scheme : themeManager.Schemes())
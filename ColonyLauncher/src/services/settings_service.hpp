@@ -33,16 +33,31 @@ class SettingsService
     void SetPythonInterpreterPath(std::string interpreter);
     [[nodiscard]] std::string ResolvedPythonInterpreter() const;
 
+    [[nodiscard]] int TargetFrameRate() const noexcept { return targetFrameRate_; }
+    void SetTargetFrameRate(int framesPerSecond);
+
+    // How often launched programs are sampled for CPU and memory; 0 turns sampling off.
+    [[nodiscard]] int ResourceSampleIntervalMs() const noexcept { return resourceSampleIntervalMs_; }
+    void SetResourceSampleIntervalMs(int milliseconds);
+
     void Load(const std::filesystem::path& settingsPath, ui::ThemeManager& themeManager);
     void Save(const std::filesystem::path& settingsPath, const ui::ThemeManager& themeManager) const;
 
   private:
     static std::string DefaultPythonInterpreter();
 
+    static constexpr int kDefaultTargetFrameRate = 60;
+    static constexpr int kMaxTargetFrameRate = 480;
+    static constexpr int kDefaultResourceSampleIntervalMs = 1000;
+    static constexpr int kMinResourceSampleIntervalMs = 100;
+    static constexpr int kMaxResourceSampleIntervalMs = 60000;
+
     std::string activeLanguageId_ = "en";
     std::unordered_map<std::string, bool> basicToggleStates_;
     std::unordered_map<std::string, float> appearanceCustomizationValues_;
     std::string pythonInterpreterPath_;
+    int targetFrameRate_ = kDefaultTargetFrameRate;
+    int resourceSampleIntervalMs_ = kDefaultResourceSampleIntervalMs;
 };
 
 } // namespace colony::services
@@ -280,6 +280,8 @@ HeroRenderResult HeroPanel::RenderHero(
     drawMetaChip(visuals.version);
     drawMetaChip(visuals.installState);
     drawMetaChip(visuals.lastLaunched);
+    drawMetaChip(visuals.launchMetrics);
+    drawMetaChip(visuals.resourceUsage);
 
     if (hasColumnClip)
     {
@@ -523,14 +525,14 @@ void HeroPanel::RenderStatusBar(
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     }
 
-    if (visuals != nullptr && visuals->statusBar.texture)
+    if (visuals != nullptr && !visuals->statusBar.Empty())
     {
         SDL_Rect textRect{
             statusRect.x + Scale(18),
             statusRect.y + (statusRect.h - visuals->statusBar.height) / 2,
             visuals->statusBar.width,
             visuals->statusBar.height};
-        colony::RenderTexture(renderer, visuals->statusBar, textRect);
+        colony::RenderGlyphText(visuals->statusBar, textRect);
     }
 }
 
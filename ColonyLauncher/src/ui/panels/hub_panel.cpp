@@ -3,13 +3,16 @@
 #include "ui/layout.hpp"
 
 #include "utils/color.hpp"
+#include "utils/draw_list.hpp"
 #include "utils/drawing.hpp"
+#include "utils/text_texture_cache.hpp"
 #include "utils/text_wrapping.hpp"
 
 #include <algorithm>
 #include <cctype>
 #include <cmath>
 #include <numbers>
+#include <numeric>
 
 namespace colony::ui::panels
 {
@@ -19,10 +22,17 @@ SDL_Color MixWithBackground(SDL_Color foreground, SDL_Color background, float fa
 {
     return colony::color::Mix(foreground, background, std::clamp(factor, 0.0f, 1.0f));
 }
+
+SDL_Color WithAlpha(SDL_Color color, Uint8 alpha)
+{
+    color.a = alpha;
+    return color;
+}
 } // namespace
 
 void HubPanel::Build(
     SDL_Renderer* renderer,
+    colony::GlyphAtlasCache& glyphAtlases,
     const HubContent& content,
     TTF_Font* headlineFont,
     TTF_Font* heroBodyFont,
@@ -30,6 +40,8 @@ void HubPanel::Build(
     TTF_Font* tileBodyFont,
     const ThemeColors& theme)
 {
+    heroLayer_.Invalidate();
+    glyphAtlases_ = &glyphAtlases;
     heroBodyFont_ = heroBodyFont;
     tileBodyFont_ = tileBodyFont;
 
@@ -45,7 +57,7 @@ void HubPanel::Build(
 
     search_.placeholder = content.searchPlaceholder;
     search_.lastQuery.clear();
-    search_.queryTexture = {};
+    search_.queryText = {};
     if (tileBodyFont_ != nullptr && !search_.placeholder.empty())
     {
         search_.placeholderTexture =
@@ -140,6 +152,9 @@ void HubPanel::Build(
         }
         branches_.emplace_back(std::move(branch));
     }
+    visibleBranches_.resize(branches_.size());
+    std::iota(visibleBranches_.begin(), visibleBranches_.end(), std::size_t{0});
+    resultSummary_.clear();
 
     widgets_.clear();
     widgets_.reserve(content.widgets.size());
@@ -159,6 +174,13 @@ void HubPanel::Build(
     }
 }
 
+void HubPanel::SetVisibleBranches(std::vector<std::size_t> branchIndices, std::string resultSummary)
+{
+    std::erase_if(branchIndices, [this](std::size_t index) { return index >= branches_.size(); });
+    visibleBranches_ = std::move(branchIndices);
+    resultSummary_ = std::move(resultSummary);
+}
+
 HubRenderResult HubPanel::Render(
     SDL_Renderer* renderer,
     const ThemeColors& theme,
@@ -194,7 +216,12 @@ HubRenderResult HubPanel::Render(
     }
     result.widgetPageCount = widgetPageCount;
 
-    if (detailBranchIndex < 0 || detailBranchIndex >= static_cast<int>(branches_.size()))
+    const auto visibleBranch = [this](int index) -> BranchChrome& {
+        return branches_[visibleBranches_[static_cast<std::size_t>(index)]];
+    };
+    const int visibleBranchCount = static_cast<int>(visibleBranches_.size());
+
+    if (detailBranchIndex < 0 || detailBranchIndex >= visibleBranchCount)
     {
         detailBranchIndex = activeBranchIndex;
     }
@@ -218,10 +245,11 @@ HubRenderResult HubPanel::Render(
 
     SDL_Color gradientStart = theme.heroGradientFallbackStart;
     SDL_Color gradientEnd = theme.heroGradientFallbackEnd;
-    SDL_SetRenderDrawColor(renderer, gradientEnd.r, gradientEnd.g, gradientEnd.b, gradientEnd.a);
-    SDL_RenderFillRect(renderer, &heroRect);
+    colony::DrawList heroDrawList{renderer};
+    heroDrawList.SetBlendMode(SDL_BLENDMODE_NONE);
+    heroDrawList.FillRect(heroRect, gradientEnd);
 
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    heroDrawList.SetBlendMode(SDL_BLENDMODE_BLEND);
     for (int layer = 0; layer < 4; ++layer)
     {
         const float t = static_cast<float>(layer + 1) / 4.0f;
@@ -236,8 +264,7 @@ HubRenderResult HubPanel::Render(
         }
         SDL_Color layerColor = colony::color::Mix(gradientStart, gradientEnd, t * 0.7f);
         const Uint8 alpha = static_cast<Uint8>(100 - layer * 18);
-        SDL_SetRenderDrawColor(renderer, layerColor.r, layerColor.g, layerColor.b, alpha);
-        SDL_RenderFillRect(renderer, &layerRect);
+        heroDrawList.FillRect(layerRect, WithAlpha(layerColor, alpha));
     }
 
     const auto resolveAccent = [&](const BranchChrome& branch) {
@@ -248,7 +275,7 @@ HubRenderResult HubPanel::Render(
         return branch.accent;
     };
 
-    SDL_Color accentColor = branches_.empty() ? theme.channelBadge : resolveAccent(branches_.front());
+    SDL_Color accentColor = visibleBranches_.empty() ? theme.channelBadge : resolveAccent(visibleBranch(0));
     const float orbit = static_cast<float>(std::sin(timeSeconds * 0.7));
     const int accentDiameter = Scale(240);
     SDL_Rect accentDisc{heroRect.x + heroRect.w - accentDiameter - Scale(80),
@@ -256,17 +283,15 @@ HubRenderResult HubPanel::Render(
                         accentDiameter,
                         accentDiameter};
     SDL_Color accentFill = colony::color::Mix(accentColor, gradientEnd, 0.35f);
-    SDL_SetRenderDrawColor(renderer, accentFill.r, accentFill.g, accentFill.b, 72);
-    colony::drawing::RenderFilledRoundedRect(renderer, accentDisc, accentDiameter / 2);
+    heroDrawList.FillRoundedRect(accentDisc, accentDiameter / 2, WithAlpha(accentFill, 72));
 
     SDL_Rect accentDiscSmall = accentDisc;
     accentDiscSmall.x -= Scale(40);
     accentDiscSmall.y += Scale(60);
     accentDiscSmall.w = accentDiscSmall.h = accentDiameter / 2;
     SDL_Color accentFillSmall = colony::color::Mix(accentColor, theme.heroTitle, 0.2f);
-    SDL_SetRenderDrawColor(renderer, accentFillSmall.r, accentFillSmall.g, accentFillSmall.b, 64);
-    colony::drawing::RenderFilledRoundedRect(renderer, accentDiscSmall, accentDiscSmall.w / 2);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+    heroDrawList.FillRoundedRect(accentDiscSmall, accentDiscSmall.w / 2, WithAlpha(accentFillSmall, 64));
+    heroDrawList.SetBlendMode(SDL_BLENDMODE_ADD);
     const int particleCount = 6;
     for (int i = 0; i < particleCount; ++i)
     {
@@ -286,9 +311,9 @@ HubRenderResult HubPanel::Render(
             particleSize};
         SDL_Color particleColor = colony::color::Mix(accentColor, gradientStart, 0.4f);
         const Uint8 particleAlpha = static_cast<Uint8>(120 * (0.5f + 0.5f * std::sin(theta + timeSeconds * 1.2)));
-        SDL_SetRenderDrawColor(renderer, particleColor.r, particleColor.g, particleColor.b, particleAlpha);
-        colony::drawing::RenderFilledRoundedRect(renderer, particleRect, particleSize / 2);
+        heroDrawList.FillRoundedRect(particleRect, particleSize / 2, WithAlpha(particleColor, particleAlpha));
     }
+    heroDrawList.Flush();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     const int heroPadding = Scale(heroCollapsed ? 32 : 48);
@@ -298,18 +323,30 @@ HubRenderResult HubPanel::Render(
     const int heroTextWidth = heroRect.w >= Scale(900) ? heroContentWidth / 2 : heroContentWidth;
 
     RebuildHeroDescription(renderer, heroTextWidth, theme.heroBody);
+    RebuildHeroActionDescription(renderer, heroTextWidth, theme.statusBarText);
+
+    // Headline, copy and the collapse toggle sit in a cached layer over the animated backdrop;
+    // the shimmering chips and the pulsing action button are drawn straight through. Layout
+    // still runs every frame because the animated parts are positioned below the copy.
+    colony::RenderLayerKey heroKey;
+    heroKey.Add(heroRect).Add(heroCollapsed).Add(heroTextWidth).Add(accentColor).Add(resultSummary_);
+    const bool drawHeroStatic =
+        heroLayer_.Begin(renderer, heroRect, heroKey.Value()) != colony::RenderLayer::Pass::Reuse;
 
     if (hero_.headline.texture)
     {
-        SDL_Rect accentRule{heroContentX, heroCursorY - Scale(18), Scale(54), Scale(6)};
-        SDL_Color accentRuleColor = colony::color::Mix(accentColor, theme.heroTitle, 0.35f);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, accentRuleColor.r, accentRuleColor.g, accentRuleColor.b, 140);
-        colony::drawing::RenderFilledRoundedRect(renderer, accentRule, accentRule.h / 2);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-
         SDL_Rect headlineRect{heroContentX, heroCursorY, hero_.headline.width, hero_.headline.height};
-        colony::RenderTexture(renderer, hero_.headline, headlineRect);
+        if (drawHeroStatic)
+        {
+            SDL_Rect accentRule{heroContentX, heroCursorY - Scale(18), Scale(54), Scale(6)};
+            SDL_Color accentRuleColor = colony::color::Mix(accentColor, theme.heroTitle, 0.35f);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, accentRuleColor.r, accentRuleColor.g, accentRuleColor.b, 140);
+            colony::drawing::RenderFilledRoundedRect(renderer, accentRule, accentRule.h / 2);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+            colony::RenderTexture(renderer, hero_.headline, headlineRect);
+        }
         heroCursorY += headlineRect.h + Scale(heroCollapsed ? 8 : 20);
     }
 
@@ -319,8 +356,11 @@ HubRenderResult HubPanel::Render(
         for (std::size_t i = 0; i < hero_.descriptionLines.size(); ++i)
         {
             const auto& lineTexture = hero_.descriptionLines[i];
-            SDL_Rect lineRect{heroContentX, heroCursorY, lineTexture.width, lineTexture.height};
-            colony::RenderTexture(renderer, lineTexture, lineRect);
+            if (drawHeroStatic)
+            {
+                SDL_Rect lineRect{heroContentX, heroCursorY, lineTexture.width, lineTexture.height};
+                colony::RenderTexture(renderer, lineTexture, lineRect);
+            }
             heroCursorY += lineTexture.height;
             if (heroLineSkip > 0 && i + 1 < hero_.descriptionLines.size())
             {
@@ -334,7 +374,24 @@ HubRenderResult HubPanel::Render(
 
         heroCursorY += Scale(18);
 
-        if (!hero_.highlightChips.empty())
+        heroLayer_.Suspend();
+        std::vector<const colony::TextTexture*> chips;
+        chips.reserve(hero_.highlightChips.size() + 1);
+        for (const auto& chip : hero_.highlightChips)
+        {
+            chips.push_back(&chip);
+        }
+        if (!resultSummary_.empty() && heroBodyFont_ != nullptr)
+        {
+            if (const colony::TextTexture* summary = colony::SharedTextTextureCache().Acquire(
+                    renderer, heroBodyFont_, resultSummary_, theme.statusBarText);
+                summary != nullptr && summary->texture)
+            {
+                chips.push_back(summary);
+            }
+        }
+
+        if (!chips.empty())
         {
             const int chipPaddingX = Scale(16);
             const int chipPaddingY = Scale(10);
@@ -343,9 +400,9 @@ HubRenderResult HubPanel::Render(
             int chipCursorX = heroContentX;
             int chipCursorY = heroCursorY;
             int chipLineHeight = 0;
-            for (std::size_t i = 0; i < hero_.highlightChips.size(); ++i)
+            for (std::size_t i = 0; i < chips.size(); ++i)
             {
-                const auto& chipTexture = hero_.highlightChips[i];
+                const auto& chipTexture = *chips[i];
                 const int chipWidth = chipTexture.width + chipPaddingX * 2;
                 const int chipHeight = chipTexture.height + chipPaddingY * 2;
                 if (chipCursorX > heroContentX && chipCursorX + chipWidth > heroContentX + chipMaxWidth)
@@ -432,16 +489,19 @@ HubRenderResult HubPanel::Render(
 
         heroCursorY = buttonRect.y + buttonRect.h + Scale(18);
     }
+    heroLayer_.Resume();
 
-    RebuildHeroActionDescription(renderer, heroTextWidth, theme.statusBarText);
     if (!heroCollapsed && !hero_.actionDescriptionLines.empty())
     {
         const int actionLineSkip = heroBodyFont_ ? TTF_FontLineSkip(heroBodyFont_) : 0;
         for (std::size_t i = 0; i < hero_.actionDescriptionLines.size(); ++i)
         {
             const auto& lineTexture = hero_.actionDescriptionLines[i];
-            SDL_Rect lineRect{heroContentX, heroCursorY, lineTexture.width, lineTexture.height};
-            colony::RenderTexture(renderer, lineTexture, lineRect);
+            if (drawHeroStatic)
+            {
+                SDL_Rect lineRect{heroContentX, heroCursorY, lineTexture.width, lineTexture.height};
+                colony::RenderTexture(renderer, lineTexture, lineRect);
+            }
             heroCursorY += lineTexture.height;
             if (i + 1 < hero_.actionDescriptionLines.size())
             {
@@ -458,7 +518,7 @@ HubRenderResult HubPanel::Render(
         heroCursorY += Scale(16);
     }
 
-    if (!heroCollapsed)
+    if (!heroCollapsed && drawHeroStatic)
     {
         SDL_Rect heroBottomGlow{heroContentX, heroCursorY, heroTextWidth, Scale(6)};
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
@@ -476,15 +536,18 @@ HubRenderResult HubPanel::Render(
         toggleWidth,
         toggleHeight};
     result.heroToggleRect = toggleRect;
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_Color toggleFill = MixWithBackground(accentColor, theme.heroTitle, heroCollapsed ? 0.18f : 0.32f);
-    SDL_Color toggleOutline = colony::color::Mix(accentColor, theme.heroTitle, 0.5f);
-    SDL_SetRenderDrawColor(renderer, toggleFill.r, toggleFill.g, toggleFill.b, 200);
-    colony::drawing::RenderFilledRoundedRect(renderer, toggleRect, toggleRect.h / 2);
-    SDL_SetRenderDrawColor(renderer, toggleOutline.r, toggleOutline.g, toggleOutline.b, 220);
-    colony::drawing::RenderRoundedRect(renderer, toggleRect, toggleRect.h / 2);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-    if (tileBodyFont_)
+    if (drawHeroStatic)
+    {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        SDL_Color toggleFill = MixWithBackground(accentColor, theme.heroTitle, heroCollapsed ? 0.18f : 0.32f);
+        SDL_Color toggleOutline = colony::color::Mix(accentColor, theme.heroTitle, 0.5f);
+        SDL_SetRenderDrawColor(renderer, toggleFill.r, toggleFill.g, toggleFill.b, 200);
+        colony::drawing::RenderFilledRoundedRect(renderer, toggleRect, toggleRect.h / 2);
+        SDL_SetRenderDrawColor(renderer, toggleOutline.r, toggleOutline.g, toggleOutline.b, 220);
+        colony::drawing::RenderRoundedRect(renderer, toggleRect, toggleRect.h / 2);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+    if (drawHeroStatic && tileBodyFont_)
     {
         const char* toggleLabel = heroCollapsed ? "Expand hero" : "Collapse hero";
         colony::TextTexture toggleTexture =
@@ -496,6 +559,7 @@ HubRenderResult HubPanel::Render(
             toggleTexture.height};
         colony::RenderTexture(renderer, toggleTexture, toggleLabelRect);
     }
+    heroLayer_.End();
 
     const int searchBarWidth = std::min(heroContentWidth, Scale(420));
     const int searchBarHeight = Scale(54);
@@ -518,14 +582,14 @@ HubRenderResult HubPanel::Render(
     if (search_.lastQuery != searchQuery)
     {
         search_.lastQuery = std::string(searchQuery);
-        if (tileBodyFont_ != nullptr && !search_.lastQuery.empty())
+        if (glyphAtlases_ != nullptr && tileBodyFont_ != nullptr && !search_.lastQuery.empty())
         {
-            search_.queryTexture =
-                colony::CreateTextTexture(renderer, tileBodyFont_, search_.lastQuery, theme.heroTitle);
+            search_.queryText =
+                colony::CreateGlyphText(*glyphAtlases_, renderer, tileBodyFont_, search_.lastQuery, theme.heroTitle);
         }
         else
         {
-            search_.queryTexture = {};
+            search_.queryText = {};
         }
     }
 
@@ -537,7 +601,7 @@ HubRenderResult HubPanel::Render(
         searchRect.w - searchPaddingX * 2,
         searchRect.h - searchPaddingY * 2};
 
-    if (!search_.queryTexture.texture && search_.placeholderTexture.texture)
+    if (search_.queryText.Empty() && search_.placeholderTexture.texture)
     {
         SDL_Rect placeholderRect{
             searchTextRect.x,
@@ -546,14 +610,14 @@ HubRenderResult HubPanel::Render(
             search_.placeholderTexture.height};
         colony::RenderTexture(renderer, search_.placeholderTexture, placeholderRect);
     }
-    else if (search_.queryTexture.texture)
+    else if (!search_.queryText.Empty())
     {
         SDL_Rect queryRect{
             searchTextRect.x,
-            searchTextRect.y + searchTextRect.h / 2 - search_.queryTexture.height / 2,
-            search_.queryTexture.width,
-            search_.queryTexture.height};
-        colony::RenderTexture(renderer, search_.queryTexture, queryRect);
+            searchTextRect.y + searchTextRect.h / 2 - search_.queryText.height / 2,
+            search_.queryText.width,
+            search_.queryText.height};
+        colony::RenderGlyphText(search_.queryText, queryRect);
         if (searchFocused)
         {
             const double blink = std::fmod(timeSeconds, 1.0);
@@ -576,7 +640,7 @@ HubRenderResult HubPanel::Render(
         }
     }
 
-    if (!search_.queryTexture.texture)
+    if (search_.queryText.Empty())
     {
         result.searchClearRect = SDL_Rect{0, 0, 0, 0};
     }
@@ -673,7 +737,7 @@ HubRenderResult HubPanel::Render(
     }
 
     result.branchHitboxes.clear();
-    result.branchHitboxes.reserve(branches_.size());
+    result.branchHitboxes.reserve(visibleBranches_.size());
 
     const int tilePadding = Scale(28);
     const int iconSize = Scale(60);
@@ -682,7 +746,8 @@ HubRenderResult HubPanel::Render(
     const int tagPaddingY = Scale(8);
     const int tagGap = Scale(8);
 
-    for (std::size_t index = 0; index < branches_.size(); ++index)
+    colony::DrawList tileDrawList{renderer};
+    for (std::size_t index = 0; index < visibleBranches_.size(); ++index)
     {
         const int columnCandidate = branchColumns[static_cast<std::size_t>(index % branchColumns.size())];
         int bestColumn = columnCandidate;
@@ -694,7 +759,7 @@ HubRenderResult HubPanel::Render(
             }
         }
 
-        BranchChrome& branch = branches_[index];
+        BranchChrome& branch = visibleBranch(static_cast<int>(index));
         const int textWidth = std::max(0, tileWidth - tilePadding * 2 - iconSize - iconSpacing);
         RebuildBranchDescription(renderer, branch, textWidth, theme.heroBody);
 
@@ -769,39 +834,33 @@ HubRenderResult HubPanel::Render(
         SDL_Rect shadowRect = drawRect;
         shadowRect.x += Scale(4);
         shadowRect.y += Scale(8);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, theme.border.r, theme.border.g, theme.border.b, 42);
-        colony::drawing::RenderFilledRoundedRect(renderer, shadowRect, Scale(26));
+        tileDrawList.SetBlendMode(SDL_BLENDMODE_BLEND);
+        tileDrawList.FillRoundedRect(shadowRect, Scale(26), WithAlpha(theme.border, 42));
 
         SDL_Color branchAccent = resolveAccent(branch);
         SDL_Color baseFill = MixWithBackground(branchAccent, theme.libraryCard, isActive ? 0.5f : (isHovered ? 0.34f : 0.24f));
         SDL_Color outline = colony::color::Mix(branchAccent, theme.heroTitle, isActive ? 0.55f : 0.32f);
         SDL_Color hoverGlow = colony::color::Mix(branchAccent, theme.heroTitle, 0.4f);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-        SDL_SetRenderDrawColor(renderer, baseFill.r, baseFill.g, baseFill.b, baseFill.a);
-        colony::drawing::RenderFilledRoundedRect(renderer, drawRect, Scale(26));
-        SDL_SetRenderDrawColor(renderer, outline.r, outline.g, outline.b, outline.a);
-        colony::drawing::RenderRoundedRect(renderer, drawRect, Scale(26));
+        tileDrawList.SetBlendMode(SDL_BLENDMODE_NONE);
+        tileDrawList.FillRoundedRect(drawRect, Scale(26), baseFill);
+        tileDrawList.DrawRoundedRect(drawRect, Scale(26), outline);
 
         SDL_Rect glowRect = drawRect;
         glowRect.h = drawRect.h / 2;
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
-        SDL_SetRenderDrawColor(renderer, hoverGlow.r, hoverGlow.g, hoverGlow.b, static_cast<Uint8>(isHovered ? 110 : 70));
-        colony::drawing::RenderFilledRoundedRect(renderer, glowRect, Scale(26));
+        const SDL_Color glowColor = WithAlpha(hoverGlow, isHovered ? 110 : 70);
+        tileDrawList.SetBlendMode(SDL_BLENDMODE_ADD);
+        tileDrawList.FillRoundedRect(glowRect, Scale(26), glowColor);
         if (isActive)
         {
-            colony::drawing::RenderRoundedRect(renderer, drawRect, Scale(28));
+            tileDrawList.DrawRoundedRect(drawRect, Scale(28), glowColor);
         }
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
         SDL_Rect iconRect{drawRect.x + tilePadding, drawRect.y + tilePadding, iconSize, iconSize};
         SDL_Color iconFill = MixWithBackground(branchAccent, theme.heroTitle, 0.28f);
         SDL_Color iconOutline = colony::color::Mix(branchAccent, theme.heroTitle, 0.52f);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        colony::drawing::RenderFilledRoundedRect(renderer, iconRect, iconRect.w / 2);
-        SDL_SetRenderDrawColor(renderer, iconOutline.r, iconOutline.g, iconOutline.b, 220);
-        colony::drawing::RenderRoundedRect(renderer, iconRect, iconRect.w / 2);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        tileDrawList.SetBlendMode(SDL_BLENDMODE_BLEND);
+        tileDrawList.FillRoundedRect(iconRect, iconRect.w / 2, iconFill);
+        tileDrawList.DrawRoundedRect(iconRect, iconRect.w / 2, WithAlpha(iconOutline, 220));
         if (branch.iconGlyph.texture)
         {
             SDL_Rect glyphRect{
@@ -809,7 +868,7 @@ HubRenderResult HubPanel::Render(
                 iconRect.y + iconRect.h / 2 - branch.iconGlyph.height / 2,
                 branch.iconGlyph.width,
                 branch.iconGlyph.height};
-            colony::RenderTexture(renderer, branch.iconGlyph, glyphRect);
+            tileDrawList.DrawText(branch.iconGlyph, glyphRect);
         }
 
         const int textStartX = iconRect.x + iconRect.w + iconSpacing;
@@ -817,15 +876,12 @@ HubRenderResult HubPanel::Render(
 
         SDL_Rect tileAccentBar{textStartX, textCursorY - Scale(14), Scale(48), Scale(6)};
         SDL_Color barColor = colony::color::Mix(branchAccent, theme.heroTitle, 0.45f);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, barColor.r, barColor.g, barColor.b, 160);
-        colony::drawing::RenderFilledRoundedRect(renderer, tileAccentBar, tileAccentBar.h / 2);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        tileDrawList.FillRoundedRect(tileAccentBar, tileAccentBar.h / 2, WithAlpha(barColor, 160));
 
         if (branch.title.texture)
         {
             SDL_Rect titleRect{textStartX, textCursorY, branch.title.width, branch.title.height};
-            colony::RenderTexture(renderer, branch.title, titleRect);
+            tileDrawList.DrawText(branch.title, titleRect);
             textCursorY += branch.title.height;
         }
 
@@ -851,15 +907,11 @@ HubRenderResult HubPanel::Render(
                 SDL_Rect chipRect{chipCursorX, chipCursorY, chipWidth, chipHeight};
                 SDL_Color chipFill = MixWithBackground(branchAccent, theme.heroTitle, 0.22f);
                 SDL_Color chipOutline = colony::color::Mix(branchAccent, theme.heroTitle, 0.38f);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-                SDL_SetRenderDrawColor(renderer, chipFill.r, chipFill.g, chipFill.b, 200);
-                colony::drawing::RenderFilledRoundedRect(renderer, chipRect, chipRect.h / 2);
-                SDL_SetRenderDrawColor(renderer, chipOutline.r, chipOutline.g, chipOutline.b, 210);
-                colony::drawing::RenderRoundedRect(renderer, chipRect, chipRect.h / 2);
-                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+                tileDrawList.FillRoundedRect(chipRect, chipRect.h / 2, WithAlpha(chipFill, 200));
+                tileDrawList.DrawRoundedRect(chipRect, chipRect.h / 2, WithAlpha(chipOutline, 210));
 
                 SDL_Rect chipTextRect{chipRect.x + tagPaddingX, chipRect.y + tagPaddingY, chip.width, chip.height};
-                colony::RenderTexture(renderer, chip, chipTextRect);
+                tileDrawList.DrawText(chip, chipTextRect);
 
                 chipCursorX += chipWidth + tagGap;
                 chipLineHeight = std::max(chipLineHeight, chipHeight);
@@ -876,7 +928,7 @@ HubRenderResult HubPanel::Render(
         for (const auto& lineTexture : branch.bodyLines)
         {
             SDL_Rect bodyRect{textStartX, textCursorY, lineTexture.width, lineTexture.height};
-            colony::RenderTexture(renderer, lineTexture, bodyRect);
+            tileDrawList.DrawText(lineTexture, bodyRect);
             textCursorY += lineTexture.height;
             if (&lineTexture != &branch.bodyLines.back())
             {
@@ -896,7 +948,7 @@ HubRenderResult HubPanel::Render(
         {
             textCursorY += Scale(18);
             SDL_Rect metricsRect{textStartX, textCursorY, branch.metricsLabel.width, branch.metricsLabel.height};
-            colony::RenderTexture(renderer, branch.metricsLabel, metricsRect);
+            tileDrawList.DrawText(branch.metricsLabel, metricsRect);
             textCursorY += branch.metricsLabel.height;
         }
 
@@ -910,13 +962,10 @@ HubRenderResult HubPanel::Render(
                 - tilePadding,
             branch.actionLabel.texture ? branch.actionLabel.width + buttonPaddingX * 2 + buttonIconSize + Scale(12) : Scale(180),
             branch.actionLabel.texture ? branch.actionLabel.height + buttonPaddingY * 2 : Scale(42)};
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
         SDL_Color buttonFill = MixWithBackground(branchAccent, theme.heroTitle, 0.32f);
         SDL_Color buttonOutline = colony::color::Mix(branchAccent, theme.heroTitle, 0.5f);
-        colony::drawing::RenderFilledRoundedRect(renderer, actionRect, actionRect.h / 2);
-        SDL_SetRenderDrawColor(renderer, buttonOutline.r, buttonOutline.g, buttonOutline.b, 220);
-        colony::drawing::RenderRoundedRect(renderer, actionRect, actionRect.h / 2);
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        tileDrawList.FillRoundedRect(actionRect, actionRect.h / 2, buttonFill);
+        tileDrawList.DrawRoundedRect(actionRect, actionRect.h / 2, WithAlpha(buttonOutline, 220));
 
         if (branch.actionLabel.texture)
         {
@@ -925,7 +974,7 @@ HubRenderResult HubPanel::Render(
                 actionRect.y + buttonPaddingY,
                 branch.actionLabel.width,
                 branch.actionLabel.height};
-            colony::RenderTexture(renderer, branch.actionLabel, actionLabelRect);
+            tileDrawList.DrawText(branch.actionLabel, actionLabelRect);
         }
 
         SDL_Rect buttonArrowRect{
@@ -933,28 +982,27 @@ HubRenderResult HubPanel::Render(
             actionRect.y + actionRect.h / 2 - buttonIconSize / 2,
             buttonIconSize,
             buttonIconSize};
-        SDL_SetRenderDrawColor(renderer, buttonOutline.r, buttonOutline.g, buttonOutline.b, SDL_ALPHA_OPAQUE);
-        SDL_RenderDrawLine(renderer, buttonArrowRect.x, buttonArrowRect.y + buttonArrowRect.h / 2, buttonArrowRect.x + buttonArrowRect.w, buttonArrowRect.y + buttonArrowRect.h / 2);
-        SDL_RenderDrawLine(
-            renderer,
+        const SDL_Color arrowColor = WithAlpha(buttonOutline, SDL_ALPHA_OPAQUE);
+        tileDrawList.SetBlendMode(SDL_BLENDMODE_NONE);
+        tileDrawList.DrawLine(buttonArrowRect.x, buttonArrowRect.y + buttonArrowRect.h / 2, buttonArrowRect.x + buttonArrowRect.w, buttonArrowRect.y + buttonArrowRect.h / 2, arrowColor);
+        tileDrawList.DrawLine(
             buttonArrowRect.x + buttonArrowRect.w / 2,
             buttonArrowRect.y,
             buttonArrowRect.x + buttonArrowRect.w,
-            buttonArrowRect.y + buttonArrowRect.h / 2);
-        SDL_RenderDrawLine(
-            renderer,
+            buttonArrowRect.y + buttonArrowRect.h / 2,
+            arrowColor);
+        tileDrawList.DrawLine(
             buttonArrowRect.x + buttonArrowRect.w / 2,
             buttonArrowRect.y + buttonArrowRect.h,
             buttonArrowRect.x + buttonArrowRect.w,
-            buttonArrowRect.y + buttonArrowRect.h / 2);
+            buttonArrowRect.y + buttonArrowRect.h / 2,
+            arrowColor);
 
         if (isHovered)
         {
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
             SDL_Color haloColor = colony::color::Mix(branchAccent, theme.heroTitle, 0.42f);
-            SDL_SetRenderDrawColor(renderer, haloColor.r, haloColor.g, haloColor.b, 120);
-            colony::drawing::RenderRoundedRect(renderer, drawRect, Scale(30));
-            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            tileDrawList.SetBlendMode(SDL_BLENDMODE_ADD);
+            tileDrawList.DrawRoundedRect(drawRect, Scale(30), WithAlpha(haloColor, 120));
         }
 
         SDL_Rect screenRect = drawRect;
@@ -963,8 +1011,9 @@ HubRenderResult HubPanel::Render(
             result.branchHitboxes.push_back(HubRenderResult::BranchHitbox{branch.id, screenRect, static_cast<int>(index)});
         }
     }
+    tileDrawList.Flush();
 
-    if (branches_.empty() && tileBodyFont_ != nullptr)
+    if (visibleBranches_.empty() && tileBodyFont_ != nullptr)
     {
         const char* emptyMessage = searchQuery.empty() ? "Aucune destination disponible" : "Aucun résultat";
         colony::TextTexture emptyText = colony::CreateTextTexture(renderer, tileBodyFont_, emptyMessage, theme.statusBarText);
@@ -1087,9 +1136,9 @@ HubRenderResult HubPanel::Render(
         const int sideWidth = tileWidth;
         int cursorY = sideColumnCursor;
 
-        if (detailBranchIndex >= 0 && detailBranchIndex < static_cast<int>(branches_.size()))
+        if (detailBranchIndex >= 0 && detailBranchIndex < visibleBranchCount)
         {
-            BranchChrome& detailBranch = branches_[static_cast<std::size_t>(detailBranchIndex)];
+            BranchChrome& detailBranch = visibleBranch(detailBranchIndex);
             const int detailPadding = Scale(28);
             const int detailTextWidth = std::max(0, sideWidth - detailPadding * 2);
             RebuildBranchDetailDescription(renderer, detailBranch, detailTextWidth, theme.heroBody);
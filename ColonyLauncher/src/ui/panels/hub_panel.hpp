@@ -2,11 +2,14 @@
 
 #include "ui/theme.hpp"
 
+#include "utils/glyph_atlas.hpp"
+#include "utils/render_layer.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -91,6 +94,7 @@ class HubPanel
   public:
     void Build(
         SDL_Renderer* renderer,
+        colony::GlyphAtlasCache& glyphAtlases,
         const HubContent& content,
         TTF_Font* headlineFont,
         TTF_Font* heroBodyFont,
@@ -113,6 +117,12 @@ class HubPanel
         int widgetPage,
         int widgetsPerPage) const;
 
+    // Shows only the given branches, in order, without rebuilding any branch textures. Branch
+    // indices passed to Render and reported in hitboxes refer to positions in this list.
+    // A non-empty summary is shown as an extra hero chip, e.g. the result count.
+    void SetVisibleBranches(std::vector<std::size_t> branchIndices, std::string resultSummary);
+    [[nodiscard]] std::size_t VisibleBranchCount() const noexcept { return visibleBranches_.size(); }
+
     bool OnClick(int /*x*/, int /*y*/) const { return false; }
     bool OnWheel(const SDL_MouseWheelEvent& /*wheel*/) const { return false; }
     bool OnKey(SDL_Keycode /*key*/) const { return false; }
@@ -172,7 +182,7 @@ class HubPanel
         std::string placeholder;
         mutable colony::TextTexture placeholderTexture;
         mutable std::string lastQuery;
-        mutable colony::TextTexture queryTexture;
+        mutable colony::GlyphText queryText;
     };
 
     void RebuildHeroDescription(SDL_Renderer* renderer, int maxWidth, SDL_Color color) const;
@@ -184,9 +194,13 @@ class HubPanel
 
     mutable HeroChrome hero_;
     mutable std::vector<BranchChrome> branches_;
+    std::vector<std::size_t> visibleBranches_;
+    std::string resultSummary_;
     mutable std::vector<WidgetChrome> widgets_;
     mutable SearchChrome search_{};
+    mutable colony::RenderLayer heroLayer_;
 
+    colony::GlyphAtlasCache* glyphAtlases_ = nullptr;
     TTF_Font* heroBodyFont_ = nullptr;
     TTF_Font* tileBodyFont_ = nullptr;
 };
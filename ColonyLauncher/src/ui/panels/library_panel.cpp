@@ -6,10 +6,12 @@
 #include "ui/layout.hpp"
 
 #include "utils/color.hpp"
-#include "utils/drawing.hpp"
+#include "utils/draw_list.hpp"
+#include "utils/text_texture_cache.hpp"
 
 #include <algorithm>
 #include <cctype>
+#include <iterator>
 
 namespace colony::ui::panels
 {
@@ -44,6 +46,40 @@ SDL_Color ResolveAccentColor(
 }
 }
 
+LibraryGridWindow ComputeLibraryGridWindow(
+    int itemCount,
+    int columns,
+    int rowStride,
+    int viewportHeight,
+    int scrollOffset,
+    int bottomPadding,
+    int revealIndex)
+{
+    LibraryGridWindow window;
+    columns = std::max(1, columns);
+    if (itemCount <= 0 || rowStride <= 0)
+    {
+        return window;
+    }
+
+    const int rows = (itemCount + columns - 1) / columns;
+    window.contentHeight = rows * rowStride + std::max(0, bottomPadding);
+    const int maxScroll = std::max(0, window.contentHeight - std::max(0, viewportHeight));
+    if (revealIndex >= 0 && revealIndex < itemCount)
+    {
+        const int rowTop = (revealIndex / columns) * rowStride;
+        scrollOffset = std::min(scrollOffset, rowTop);
+        scrollOffset = std::max(scrollOffset, rowTop + rowStride - std::max(0, viewportHeight));
+    }
+    window.scrollOffset = std::clamp(scrollOffset, 0, maxScroll);
+
+    const int firstRow = window.scrollOffset / rowStride;
+    const int lastRow = (window.scrollOffset + std::max(0, viewportHeight)) / rowStride;
+    window.firstIndex = std::min(itemCount, firstRow * columns);
+    window.lastIndex = std::min(itemCount, (lastRow + 1) * columns);
+    return window;
+}
+
 void LibraryPanel::Build(
     SDL_Renderer* renderer,
     TTF_Font* bodyFont,
@@ -54,6 +90,121 @@ void LibraryPanel::Build(
     (void)bodyFont;
     (void)theme;
     (void)localize;
+    cards_.clear();
+    recycledCards_.clear();
+}
+
+LibraryPanel::RetainedCard& LibraryPanel::AcquireCard(
+    SDL_Renderer* renderer,
+    const ThemeColors& theme,
+    const colony::ViewContent& view,
+    const std::string& programId,
+    const std::unordered_map<std::string, ProgramVisuals>& programVisuals,
+    TTF_Font* titleFont,
+    TTF_Font* bodyFont) const
+{
+    if (titleFont != cardTitleFont_ || bodyFont != cardBodyFont_ || GetUiScale() != cardUiScale_)
+    {
+        cards_.clear();
+        recycledCards_.clear();
+        cardTitleFont_ = titleFont;
+        cardBodyFont_ = bodyFont;
+        cardUiScale_ = GetUiScale();
+    }
+
+    auto it = cards_.find(programId);
+    if (it == cards_.end())
+    {
+        // A card that scrolled away and back finds its own node again; otherwise any pooled card
+        // is reused, and Build keeps whichever of its textures show the same text.
+        auto recycled = std::find_if(recycledCards_.begin(), recycledCards_.end(), [&](const CardMap::node_type& node) {
+            return node.key() == programId;
+        });
+        if (recycled == recycledCards_.end() && !recycledCards_.empty())
+        {
+            recycled = std::prev(recycledCards_.end());
+        }
+
+        if (recycled != recycledCards_.end())
+        {
+            auto node = std::move(*recycled);
+            recycledCards_.erase(recycled);
+            node.key() = programId;
+            it = cards_.insert(std::move(node)).position;
+        }
+        else
+        {
+            it = cards_.try_emplace(programId).first;
+        }
+    }
+
+    RetainedCard& retained = it->second;
+    if (retained.card.Id() == programId && retained.revision == view.revision)
+    {
+        return retained;
+    }
+
+    frontend::components::BrandCard::Content cardContent;
+    cardContent.id = programId;
+    cardContent.title = view.heading.empty() ? programId : view.heading;
+    cardContent.subtitle = view.tagline;
+    cardContent.category = view.installState.empty() ? view.availability : view.installState;
+    cardContent.metric = view.lastLaunched.empty() ? view.version : view.lastLaunched;
+    cardContent.statusLabel = view.availability.empty() ? view.installState : view.availability;
+    cardContent.metricBadgeLabel = view.version;
+    cardContent.primaryActionLabel = view.primaryActionLabel.empty()
+        ? (view.installState == "Installed" ? "Launch" : "Preview")
+        : view.primaryActionLabel;
+    cardContent.secondaryActionLabel = view.installState == "Installed" ? "Manage" : "Install";
+    cardContent.highlights.assign(view.heroHighlights.begin(), view.heroHighlights.end());
+    cardContent.ready = IsReadyState(cardContent.statusLabel);
+    cardContent.accent = ResolveAccentColor(programVisuals, view, programId);
+
+    retained.card.Build(renderer, cardContent, titleFont, bodyFont, bodyFont, theme);
+    retained.revision = view.revision;
+    return retained;
+}
+
+void LibraryPanel::RecycleCards(int visibleCount) const
+{
+    const std::size_t retainLimit = static_cast<std::size_t>(std::max(visibleCount, 0)) * 2 + kRetainedCardSlack;
+    for (auto it = cards_.begin(); it != cards_.end() && cards_.size() > retainLimit;)
+    {
+        if (it->second.lastUsedFrame == renderFrame_)
+        {
+            ++it;
+            continue;
+        }
+
+        auto next = std::next(it);
+        auto node = cards_.extract(it);
+        if (recycledCards_.size() < kRecycledCardPoolSize)
+        {
+            recycledCards_.push_back(std::move(node));
+        }
+        it = next;
+    }
+}
+
+void LibraryPanel::PruneCards(const colony::AppContent& content) const
+{
+    if (content.generation == cardsContentGeneration_)
+    {
+        return;
+    }
+
+    cardsContentGeneration_ = content.generation;
+    for (auto it = cards_.begin(); it != cards_.end();)
+    {
+        if (content.views.find(it->first) == content.views.end())
+        {
+            it = cards_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
 LibraryRenderResult LibraryPanel::Render(
@@ -72,7 +223,9 @@ LibraryRenderResult LibraryPanel::Render(
     std::string_view filterText,
     bool filterFocused,
     const std::vector<colony::frontend::models::LibraryProgramEntry>& programs,
-    const std::vector<colony::frontend::models::LibrarySortChip>& sortChips) const
+    const std::vector<colony::frontend::models::LibrarySortChip>& sortChips,
+    int scrollOffset,
+    bool revealSelection) const
 {
     (void)deltaSeconds;
     (void)filterText;
@@ -93,94 +246,122 @@ LibraryRenderResult LibraryPanel::Render(
     if (activeChannelIndex >= 0 && activeChannelIndex < static_cast<int>(content.channels.size()))
     {
         const auto& channel = content.channels[activeChannelIndex];
-        colony::TextTexture channelTitle = colony::CreateTextTexture(renderer, channelFont, channel.label, theme.heroTitle);
-        if (channelTitle.texture)
+        const colony::TextTexture* channelTitle =
+            colony::SharedTextTextureCache().Acquire(renderer, channelFont, channel.label, theme.heroTitle);
+        if (channelTitle != nullptr)
         {
-            SDL_Rect titleRect{libraryRect.x + padding, cursorY, channelTitle.width, channelTitle.height};
-            colony::RenderTexture(renderer, channelTitle, titleRect);
+            SDL_Rect titleRect{libraryRect.x + padding, cursorY, channelTitle->width, channelTitle->height};
+            colony::RenderTexture(renderer, *channelTitle, titleRect);
             cursorY += titleRect.h + padding;
         }
     }
 
+    PruneCards(content);
+
     const int cardWidth = Scale(320);
     const int cardHeight = Scale(220);
     const int gutter = Scale(20);
     const int availableWidth = libraryRect.w - 2 * padding;
     const int columns = std::max(1, availableWidth / (cardWidth + gutter));
 
-    int row = 0;
-    int column = 0;
-
-    for (const auto& entry : programs)
+    const SDL_Rect gridViewport{
+        libraryRect.x,
+        cursorY,
+        libraryRect.w,
+        std::max(0, libraryRect.y + libraryRect.h - cursorY)};
+    const int itemCount = static_cast<int>(programs.size()) + (showAddButton ? 1 : 0);
+    int revealIndex = -1;
+    if (revealSelection)
     {
-        if (content.views.find(entry.programId) == content.views.end())
+        const auto selected =
+            std::find_if(programs.begin(), programs.end(), [](const auto& entry) { return entry.selected; });
+        if (selected != programs.end())
         {
-            continue;
+            revealIndex = static_cast<int>(selected - programs.begin());
         }
-        const auto& view = content.views.at(entry.programId);
-        frontend::components::BrandCard::Content cardContent;
-        cardContent.id = entry.programId;
-        cardContent.title = view.heading.empty() ? entry.programId : view.heading;
-        cardContent.subtitle = view.tagline;
-        cardContent.category = view.installState.empty() ? view.availability : view.installState;
-        cardContent.metric = view.lastLaunched.empty() ? view.version : view.lastLaunched;
-        cardContent.statusLabel = view.availability.empty() ? view.installState : view.availability;
-        cardContent.metricBadgeLabel = view.version;
-        cardContent.primaryActionLabel = view.primaryActionLabel.empty()
-            ? (view.installState == "Installed" ? "Launch" : "Preview")
-            : view.primaryActionLabel;
-        cardContent.secondaryActionLabel = view.installState == "Installed" ? "Manage" : "Install";
-        cardContent.highlights.assign(view.heroHighlights.begin(), view.heroHighlights.end());
-        cardContent.ready = IsReadyState(cardContent.statusLabel);
-        cardContent.accent = ResolveAccentColor(programVisuals, view, entry.programId);
-
-        frontend::components::BrandCard card;
-        card.Build(renderer, cardContent, channelFont, bodyFont, bodyFont, theme);
-
-        SDL_Rect cardRect{
-            libraryRect.x + padding + column * (cardWidth + gutter),
-            cursorY + row * (cardHeight + gutter),
+    }
+    const LibraryGridWindow window = ComputeLibraryGridWindow(
+        itemCount, columns, cardHeight + gutter, gridViewport.h, scrollOffset, padding, revealIndex);
+    result.gridViewport = gridViewport;
+    result.contentHeight = window.contentHeight;
+    result.scrollOffset = window.scrollOffset;
+
+    const auto cellRect = [&](int index) {
+        return SDL_Rect{
+            libraryRect.x + padding + (index % columns) * (cardWidth + gutter),
+            cursorY - window.scrollOffset + (index / columns) * (cardHeight + gutter),
             cardWidth,
             cardHeight};
+    };
+
+    SDL_Rect previousClip{0, 0, 0, 0};
+    const bool hadClip = SDL_RenderIsClipEnabled(renderer) == SDL_TRUE;
+    if (hadClip)
+    {
+        SDL_RenderGetClipRect(renderer, &previousClip);
+    }
+    SDL_RenderSetClipRect(renderer, &gridViewport);
+
+    colony::DrawList drawList{renderer};
+    ++renderFrame_;
+    const int lastProgramIndex = std::min(window.lastIndex, static_cast<int>(programs.size()));
+    for (int index = window.firstIndex; index < lastProgramIndex; ++index)
+    {
+        const auto& entry = programs[static_cast<std::size_t>(index)];
+        const auto viewIt = content.views.find(entry.programId);
+        if (viewIt == content.views.end())
+        {
+            continue;
+        }
+        RetainedCard& retained =
+            AcquireCard(renderer, theme, viewIt->second, entry.programId, programVisuals, channelFont, bodyFont);
+        retained.lastUsedFrame = renderFrame_;
 
-        cardRect.h = card.Render(renderer, theme, interactions, cardRect, bodyFont, bodyFont, false, entry.selected, timeSeconds).h;
-        result.tileRects.push_back(cardRect);
-        result.programIds.push_back(entry.programId);
+        SDL_Rect cardRect = cellRect(index);
+        cardRect.h = retained.card.Render(drawList, theme, interactions, cardRect, bodyFont, bodyFont, false, entry.selected, timeSeconds).h;
 
-        ++column;
-        if (column >= columns)
+        SDL_Rect visibleRect{0, 0, 0, 0};
+        if (SDL_IntersectRect(&cardRect, &gridViewport, &visibleRect) == SDL_TRUE)
         {
-            column = 0;
-            ++row;
+            result.tileRects.push_back(visibleRect);
+            result.programIds.push_back(entry.programId);
         }
     }
+    RecycleCards(std::max(0, lastProgramIndex - window.firstIndex));
 
-    if (showAddButton)
+    const int addButtonIndex = static_cast<int>(programs.size());
+    if (showAddButton && addButtonIndex >= window.firstIndex && addButtonIndex < window.lastIndex)
     {
-        SDL_Rect addRect{
-            libraryRect.x + padding + column * (cardWidth + gutter),
-            cursorY + row * (cardHeight + gutter),
-            cardWidth,
-            cardHeight};
-        SDL_SetRenderDrawColor(renderer, theme.card.r, theme.card.g, theme.card.b, 200);
-        colony::drawing::RenderFilledRoundedRect(renderer, addRect, Scale(18));
-        SDL_SetRenderDrawColor(renderer, theme.border.r, theme.border.g, theme.border.b, 160);
-        colony::drawing::RenderRoundedRect(renderer, addRect, Scale(18));
-        SDL_RenderDrawLine(
-            renderer,
+        const SDL_Rect addRect = cellRect(addButtonIndex);
+        SDL_Color addFill = theme.card;
+        addFill.a = 200;
+        SDL_Color addOutline = theme.border;
+        addOutline.a = 160;
+        drawList.SetBlendMode(SDL_BLENDMODE_BLEND);
+        drawList.FillRoundedRect(addRect, Scale(18), addFill);
+        drawList.DrawRoundedRect(addRect, Scale(18), addOutline);
+        drawList.DrawLine(
             addRect.x + addRect.w / 2 - Scale(20),
             addRect.y + addRect.h / 2,
             addRect.x + addRect.w / 2 + Scale(20),
-            addRect.y + addRect.h / 2);
-        SDL_RenderDrawLine(
-            renderer,
+            addRect.y + addRect.h / 2,
+            addOutline);
+        drawList.DrawLine(
             addRect.x + addRect.w / 2,
             addRect.y + addRect.h / 2 - Scale(20),
             addRect.x + addRect.w / 2,
-            addRect.y + addRect.h / 2 + Scale(20));
-        result.addButtonRect = addRect;
+            addRect.y + addRect.h / 2 + Scale(20),
+            addOutline);
+
+        SDL_Rect visibleRect{0, 0, 0, 0};
+        if (SDL_IntersectRect(&addRect, &gridViewport, &visibleRect) == SDL_TRUE)
+        {
+            result.addButtonRect = visibleRect;
+        }
     }
 
+    drawList.Flush();
+    SDL_RenderSetClipRect(renderer, hadClip ? &previousClip : nullptr);
     return result;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/content.hpp"
+#include "frontend/components/brand_card.hpp"
 #include "frontend/models/library_view_model.hpp"
 #include "ui/program_visuals.hpp"
 #include "ui/theme.hpp"
@@ -9,6 +10,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -31,8 +33,29 @@ struct LibraryRenderResult
         colony::frontend::models::LibrarySortOption option = colony::frontend::models::LibrarySortOption::RecentlyPlayed;
     };
     std::vector<SortChipHitbox> sortChipHitboxes;
+    SDL_Rect gridViewport{0, 0, 0, 0};
+    int contentHeight = 0;
+    int scrollOffset = 0;
 };
 
+struct LibraryGridWindow
+{
+    int firstIndex = 0;
+    int lastIndex = 0;
+    int contentHeight = 0;
+    int scrollOffset = 0;
+};
+
+// `revealIndex`, when not negative, moves the scroll offset just enough to show that item's row.
+[[nodiscard]] LibraryGridWindow ComputeLibraryGridWindow(
+    int itemCount,
+    int columns,
+    int rowStride,
+    int viewportHeight,
+    int scrollOffset,
+    int bottomPadding,
+    int revealIndex = -1);
+
 class LibraryPanel
 {
   public:
@@ -58,18 +81,45 @@ class LibraryPanel
         std::string_view filterText,
         bool filterFocused,
         const std::vector<colony::frontend::models::LibraryProgramEntry>& programs,
-        const std::vector<colony::frontend::models::LibrarySortChip>& sortChips) const;
+        const std::vector<colony::frontend::models::LibrarySortChip>& sortChips,
+        int scrollOffset,
+        bool revealSelection) const;
 
     bool OnClick(int /*x*/, int /*y*/) const { return false; }
     bool OnWheel(const SDL_MouseWheelEvent& /*wheel*/) const { return false; }
     bool OnKey(SDL_Keycode /*key*/) const { return false; }
 
   private:
-    struct LibraryChrome
+    struct RetainedCard
     {
+        colony::frontend::components::BrandCard card;
+        std::uint64_t revision = 0;
+        std::uint64_t lastUsedFrame = 0;
     };
 
-    LibraryChrome chrome_;
+    using CardMap = std::unordered_map<std::string, RetainedCard>;
+
+    static constexpr std::size_t kRetainedCardSlack = 32;
+    static constexpr std::size_t kRecycledCardPoolSize = 64;
+
+    RetainedCard& AcquireCard(
+        SDL_Renderer* renderer,
+        const ThemeColors& theme,
+        const colony::ViewContent& view,
+        const std::string& programId,
+        const std::unordered_map<std::string, ProgramVisuals>& programVisuals,
+        TTF_Font* titleFont,
+        TTF_Font* bodyFont) const;
+    void RecycleCards(int visibleCount) const;
+    void PruneCards(const colony::AppContent& content) const;
+
+    mutable CardMap cards_;
+    mutable std::vector<CardMap::node_type> recycledCards_;
+    mutable std::uint64_t renderFrame_ = 0;
+    mutable std::uint64_t cardsContentGeneration_ = 0;
+    mutable TTF_Font* cardTitleFont_ = nullptr;
+    mutable TTF_Font* cardBodyFont_ = nullptr;
+    mutable float cardUiScale_ = 0.0f;
 };
 
 } // namespace colony::ui::panels
@@ -20,6 +20,7 @@ void NavigationRailPanel::Build(
     const ThemeColors& theme,
     const Typography& typography)
 {
+    layer_.Invalidate();
     chrome_.brand = colony::CreateTextTexture(renderer, brandFont, content.brandName, theme.heroTitle);
     chrome_.items.clear();
     chrome_.items.reserve(content.channels.size());
@@ -57,14 +58,9 @@ NavigationRenderResult NavigationRailPanel::Render(
     result.channelButtonRects.resize(content.channels.size());
 
     const int navPadding = Scale(24);
+    SDL_Rect brandRect{navRailRect.x + Scale(22), navPadding, chrome_.brand.width, chrome_.brand.height};
     if (chrome_.brand.texture)
     {
-        SDL_Rect brandRect{
-            navRailRect.x + Scale(22),
-            navPadding,
-            chrome_.brand.width,
-            chrome_.brand.height};
-        colony::RenderTexture(renderer, chrome_.brand, brandRect);
         result.hubButtonRect = brandRect;
     }
     else
@@ -97,21 +93,68 @@ NavigationRenderResult NavigationRailPanel::Render(
     SDL_Point mousePosition{0, 0};
     SDL_GetMouseState(&mousePosition.x, &mousePosition.y);
 
-    for (std::size_t index = 0; index < chrome_.items.size() && index < result.channelButtonRects.size(); ++index)
+    const std::size_t itemCount = std::min(chrome_.items.size(), result.channelButtonRects.size());
+    std::vector<SDL_Color> accents(itemCount);
+    int hoveredIndex = -1;
+    for (std::size_t index = 0; index < itemCount; ++index)
     {
         SDL_Rect itemRect{
             navRailRect.x + Scale(12),
             channelStartY,
             itemWidth,
             itemHeight};
-        const bool isActive = static_cast<int>(index) == activeChannelIndex;
-        const bool isHovered = SDL_PointInRect(&mousePosition, &itemRect) != 0;
-        SDL_Color accent = channelAccentColor(static_cast<int>(index));
-        chrome_.items[index].Render(renderer, theme, typography, interactions, itemRect, accent, isActive, isHovered, timeSeconds);
+        if (hoveredIndex < 0 && SDL_PointInRect(&mousePosition, &itemRect) != 0)
+        {
+            hoveredIndex = static_cast<int>(index);
+        }
+        accents[index] = channelAccentColor(static_cast<int>(index));
         result.channelButtonRects[index] = itemRect;
         channelStartY += itemHeight + itemSpacing;
     }
 
+    // The rail only changes on hover, selection and layout; the active item's pulse is drawn on
+    // top of the cached layer each frame.
+    colony::RenderLayerKey key;
+    key.Add(navRailRect).Add(statusBarHeight).Add(activeChannelIndex).Add(hoveredIndex);
+    for (const SDL_Color& accent : accents)
+    {
+        key.Add(accent);
+    }
+
+    if (layer_.Begin(renderer, navRailRect, key.Value()) != colony::RenderLayer::Pass::Reuse)
+    {
+        if (chrome_.brand.texture)
+        {
+            colony::RenderTexture(renderer, chrome_.brand, brandRect);
+        }
+        for (std::size_t index = 0; index < itemCount; ++index)
+        {
+            const bool isActive = static_cast<int>(index) == activeChannelIndex;
+            const bool isHovered = static_cast<int>(index) == hoveredIndex;
+            chrome_.items[index].Render(
+                renderer,
+                theme,
+                typography,
+                interactions,
+                result.channelButtonRects[index],
+                accents[index],
+                isActive,
+                isHovered);
+        }
+    }
+    layer_.End();
+
+    if (activeChannelIndex >= 0 && static_cast<std::size_t>(activeChannelIndex) < itemCount)
+    {
+        const auto index = static_cast<std::size_t>(activeChannelIndex);
+        chrome_.items[index].RenderActivePulse(
+            renderer,
+            theme,
+            result.channelButtonRects[index],
+            accents[index],
+            timeSeconds);
+    }
+
     return result;
 }
 
@@ -4,6 +4,7 @@
 #include "frontend/components/sidebar_item.hpp"
 #include "ui/program_visuals.hpp"
 #include "ui/theme.hpp"
+#include "utils/render_layer.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
@@ -59,6 +60,7 @@ class NavigationRailPanel
 
     NavigationChrome chrome_;
     NavigationRenderResult lastRender_{};
+    mutable colony::RenderLayer layer_;
 };
 
 } // namespace colony::ui::panels
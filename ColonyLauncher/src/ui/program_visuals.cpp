@@ -12,6 +12,7 @@ namespace colony::ui
 ProgramVisuals BuildProgramVisuals(
     const colony::ViewContent& content,
     SDL_Renderer* renderer,
+    colony::GlyphAtlasCache& glyphAtlases,
     TTF_Font* heroTitleFont,
     TTF_Font* heroSubtitleFont,
     TTF_Font* heroBodyFont,
@@ -53,6 +54,11 @@ ProgramVisuals BuildProgramVisuals(
     {
         visuals.lastLaunched = colony::CreateTextTexture(renderer, tileMetaFont, content.lastLaunched, mutedColor);
     }
+    if (!content.launchMetrics.empty())
+    {
+        visuals.launchMetrics = colony::CreateTextTexture(renderer, tileMetaFont, content.launchMetrics, mutedColor);
+    }
+    RebuildResourceUsage(visuals, renderer, tileMetaFont, mutedColor);
     visuals.actionLabel = colony::CreateTextTexture(renderer, buttonFont, content.primaryActionLabel, heroTitleColor);
     visuals.tileTitle = colony::CreateTextTexture(renderer, tileTitleFont, content.heading, heroTitleColor);
 
@@ -83,7 +89,8 @@ ProgramVisuals BuildProgramVisuals(
 
     if (!content.statusMessage.empty())
     {
-        visuals.statusBar = colony::CreateTextTexture(renderer, statusFont, content.statusMessage, statusBarTextColor);
+        visuals.statusBar =
+            colony::CreateGlyphText(glyphAtlases, renderer, statusFont, content.statusMessage, statusBarTextColor);
     }
 
     visuals.accent = colony::color::ParseHexColor(content.accentColor, SDL_Color{91, 150, 255, SDL_ALPHA_OPAQUE});
@@ -101,6 +108,12 @@ ProgramVisuals BuildProgramVisuals(
     return visuals;
 }
 
+void RebuildResourceUsage(ProgramVisuals& visuals, SDL_Renderer* renderer, TTF_Font* font, SDL_Color textColor)
+{
+    const std::string& usage = visuals.content->resourceUsage;
+    visuals.resourceUsage = usage.empty() ? colony::TextTexture{} : colony::CreateTextTexture(renderer, font, usage, textColor);
+}
+
 void RebuildDescription(
     ProgramVisuals& visuals,
     SDL_Renderer* renderer,
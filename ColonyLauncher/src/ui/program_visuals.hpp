@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/content.hpp"
+#include "utils/glyph_atlas.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
@@ -27,8 +28,10 @@ struct ProgramVisuals
     colony::TextTexture version;
     colony::TextTexture installState;
     colony::TextTexture lastLaunched;
+    colony::TextTexture launchMetrics;
+    colony::TextTexture resourceUsage;
     colony::TextTexture actionLabel;
-    colony::TextTexture statusBar;
+    colony::GlyphText statusBar;
 
     colony::TextTexture tileTitle;
     colony::TextTexture tileSubtitle;
@@ -61,6 +64,7 @@ struct ProgramVisuals
 ProgramVisuals BuildProgramVisuals(
     const colony::ViewContent& content,
     SDL_Renderer* renderer,
+    colony::GlyphAtlasCache& glyphAtlases,
     TTF_Font* heroTitleFont,
     TTF_Font* heroSubtitleFont,
     TTF_Font* heroBodyFont,
@@ -79,6 +83,9 @@ ProgramVisuals BuildProgramVisuals(
     SDL_Color gradientFallbackStart,
     SDL_Color gradientFallbackEnd);
 
+// Only the resource usage chip; it changes every sampling tick while the rest stays put.
+void RebuildResourceUsage(ProgramVisuals& visuals, SDL_Renderer* renderer, TTF_Font* font, SDL_Color textColor);
+
 void RebuildDescription(
     ProgramVisuals& visuals,
     SDL_Renderer* renderer,
@@ -25,6 +25,7 @@ void SettingsPanel::Build(
     const std::function<std::string(std::string_view)>& localize,
     const std::function<TTF_Font*(std::string_view)>& nativeFontResolver)
 {
+    layer_.Invalidate();
     themeOptions_.clear();
     languages_.clear();
     toggles_.clear();
@@ -135,6 +136,59 @@ SettingsPanel::RenderResult SettingsPanel::Render(
     const SectionStates& sectionStates,
     const std::unordered_map<std::string, bool>& toggleStates,
     const std::unordered_map<std::string, float>& customizationValues) const
+{
+    // Settings only change through input, so everything that affects the output goes into the
+    // key and the drawn sections are replayed from the layer until one of them changes.
+    colony::RenderLayerKey key;
+    key.Add(bounds)
+        .Add(std::max(0, scrollOffset))
+        .Add(activeSchemeId)
+        .Add(activeLanguageId)
+        .Add(sectionStates.appearanceExpanded)
+        .Add(sectionStates.languageExpanded)
+        .Add(sectionStates.generalExpanded);
+    std::uint64_t toggleHash = 0;
+    for (const auto& [id, enabled] : toggleStates)
+    {
+        toggleHash += colony::RenderLayerKey{}.Add(id).Add(enabled).Value();
+    }
+    std::uint64_t customizationHash = 0;
+    for (const auto& [id, value] : customizationValues)
+    {
+        customizationHash += colony::RenderLayerKey{}.Add(id).Add(value).Value();
+    }
+    key.Add(toggleHash).Add(customizationHash);
+
+    if (layer_.Begin(renderer, bounds, key.Value()) == colony::RenderLayer::Pass::Reuse)
+    {
+        layer_.End();
+        return cachedResult_;
+    }
+
+    cachedResult_ = RenderSections(
+        renderer,
+        bounds,
+        scrollOffset,
+        theme,
+        activeSchemeId,
+        activeLanguageId,
+        sectionStates,
+        toggleStates,
+        customizationValues);
+    layer_.End();
+    return cachedResult_;
+}
+
+SettingsPanel::RenderResult SettingsPanel::RenderSections(
+    SDL_Renderer* renderer,
+    const SDL_Rect& bounds,
+    int scrollOffset,
+    const ThemeColors& theme,
+    std::string_view activeSchemeId,
+    std::string_view activeLanguageId,
+    const SectionStates& sectionStates,
+    const std::unordered_map<std::string, bool>& toggleStates,
+    const std::unordered_map<std::string, float>& customizationValues) const
 {
     SettingsPanel::RenderResult result;
     result.viewport = bounds;
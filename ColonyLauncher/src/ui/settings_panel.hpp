@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ui/theme.hpp"
+#include "utils/render_layer.hpp"
 #include "utils/text.hpp"
 
 #include <SDL2/SDL.h>
@@ -85,6 +86,17 @@ class SettingsPanel
         const std::unordered_map<std::string, float>& customizationValues) const;
 
   private:
+    RenderResult RenderSections(
+        SDL_Renderer* renderer,
+        const SDL_Rect& bounds,
+        int scrollOffset,
+        const ThemeColors& theme,
+        std::string_view activeSchemeId,
+        std::string_view activeLanguageId,
+        const SectionStates& sectionStates,
+        const std::unordered_map<std::string, bool>& toggleStates,
+        const std::unordered_map<std::string, float>& customizationValues) const;
+
     struct ThemeOption
     {
         std::string id;
@@ -129,6 +141,9 @@ class SettingsPanel
     std::vector<LanguageOption> languages_;
     std::vector<ToggleOption> toggles_;
     std::vector<CustomizationOption> appearanceCustomizations_;
+
+    mutable colony::RenderLayer layer_;
+    mutable RenderResult cachedResult_;
 };
 
 } // namespace colony::ui
@@ -1,10 +1,12 @@
 #include "utils/color.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace colony::color
 {
@@ -118,22 +120,123 @@ SDL_Color Mix(const SDL_Color& a, const SDL_Color& b, float t)
     return SDL_Color{blend(a.r, b.r), blend(a.g, b.g), blend(a.b, b.b), blend(a.a, b.a)};
 }
 
-void RenderVerticalGradient(SDL_Renderer* renderer, const SDL_Rect& area, SDL_Color top, SDL_Color bottom)
+void RenderGradient(
+    SDL_Renderer* renderer,
+    const SDL_Rect& area,
+    std::span<const GradientStop> stops,
+    GradientDirection direction)
 {
-    if (renderer == nullptr || area.h <= 0 || area.w <= 0)
+    if (renderer == nullptr || area.h <= 0 || area.w <= 0 || stops.empty())
+    {
+        return;
+    }
+
+    const bool vertical = direction == GradientDirection::Vertical;
+    const auto colorAt = [&](float t) {
+        if (t <= stops.front().position)
+        {
+            return stops.front().color;
+        }
+        for (std::size_t index = 1; index < stops.size(); ++index)
+        {
+            const GradientStop& previous = stops[index - 1];
+            const GradientStop& next = stops[index];
+            if (t <= next.position)
+            {
+                const float range = next.position - previous.position;
+                return range > 0.0f ? Mix(previous.color, next.color, (t - previous.position) / range) : next.color;
+            }
+        }
+        return stops.back().color;
+    };
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Each stop inside (0, 1) adds one edge to the strip; the area's own edges are always emitted.
+    std::vector<float> edges;
+    edges.reserve(stops.size() + 2);
+    edges.push_back(0.0f);
+    for (const GradientStop& stop : stops)
+    {
+        const float position = std::clamp(stop.position, 0.0f, 1.0f);
+        if (position > edges.back() && position < 1.0f)
+        {
+            edges.push_back(position);
+        }
+    }
+    edges.push_back(1.0f);
+
+    const float x = static_cast<float>(area.x);
+    const float y = static_cast<float>(area.y);
+    const float w = static_cast<float>(area.w);
+    const float h = static_cast<float>(area.h);
+
+    std::vector<SDL_Vertex> vertices;
+    vertices.reserve(edges.size() * 2);
+    for (const float edge : edges)
+    {
+        const SDL_Color color = colorAt(edge);
+        if (vertical)
+        {
+            vertices.push_back(SDL_Vertex{{x, y + h * edge}, color, {0.0f, 0.0f}});
+            vertices.push_back(SDL_Vertex{{x + w, y + h * edge}, color, {0.0f, 0.0f}});
+        }
+        else
+        {
+            vertices.push_back(SDL_Vertex{{x + w * edge, y}, color, {0.0f, 0.0f}});
+            vertices.push_back(SDL_Vertex{{x + w * edge, y + h}, color, {0.0f, 0.0f}});
+        }
+    }
+
+    std::vector<int> indices;
+    indices.reserve((edges.size() - 1) * 6);
+    for (int segment = 0; segment + 1 < static_cast<int>(edges.size()); ++segment)
+    {
+        const int base = segment * 2;
+        indices.insert(indices.end(), {base, base + 1, base + 3, base, base + 3, base + 2});
+    }
+
+    if (SDL_RenderGeometry(
+            renderer,
+            nullptr,
+            vertices.data(),
+            static_cast<int>(vertices.size()),
+            indices.data(),
+            static_cast<int>(indices.size()))
+        == 0)
     {
         return;
     }
+#endif
 
-    for (int offset = 0; offset < area.h; ++offset)
+    const int extent = vertical ? area.h : area.w;
+    for (int offset = 0; offset < extent; ++offset)
     {
-        const float t = area.h > 1 ? static_cast<float>(offset) / static_cast<float>(area.h - 1) : 0.0f;
-        const SDL_Color color = Mix(top, bottom, t);
+        const float t = extent > 1 ? static_cast<float>(offset) / static_cast<float>(extent - 1) : 0.0f;
+        const SDL_Color color = colorAt(t);
         SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        SDL_RenderDrawLine(renderer, area.x, area.y + offset, area.x + area.w - 1, area.y + offset);
+        if (vertical)
+        {
+            SDL_RenderDrawLine(renderer, area.x, area.y + offset, area.x + area.w - 1, area.y + offset);
+        }
+        else
+        {
+            SDL_RenderDrawLine(renderer, area.x + offset, area.y, area.x + offset, area.y + area.h - 1);
+        }
     }
 }
 
+void RenderVerticalGradient(SDL_Renderer* renderer, const SDL_Rect& area, SDL_Color top, SDL_Color bottom)
+{
+    const std::array<GradientStop, 2> stops{{{0.0f, top}, {1.0f, bottom}}};
+    RenderGradient(renderer, area, stops, GradientDirection::Vertical);
+}
+
+void RenderHorizontalGradient(SDL_Renderer* renderer, const SDL_Rect& area, SDL_Color left, SDL_Color right)
+{
+    const std::array<GradientStop, 2> stops{{{0.0f, left}, {1.0f, right}}};
+    RenderGradient(renderer, area, stops, GradientDirection::Horizontal);
+}
+
 std::string ToHexString(const SDL_Color& color)
 {
     std::ostringstream stream;
@@ -2,6 +2,7 @@
 
 #include <SDL2/SDL.h>
 
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -12,8 +13,30 @@ SDL_Color ParseHexColor(std::string_view hex, SDL_Color fallback = {255, 255, 25
 
 SDL_Color Mix(const SDL_Color& a, const SDL_Color& b, float t);
 
+struct GradientStop
+{
+    float position = 0.0f;
+    SDL_Color color{0, 0, 0, SDL_ALPHA_OPAQUE};
+};
+
+enum class GradientDirection
+{
+    Vertical,
+    Horizontal
+};
+
+// Draws the stops (positions in [0, 1], ascending) as one vertex-colored strip, so the cost
+// does not depend on the size of the area or on how often the colors change.
+void RenderGradient(
+    SDL_Renderer* renderer,
+    const SDL_Rect& area,
+    std::span<const GradientStop> stops,
+    GradientDirection direction = GradientDirection::Vertical);
+
 void RenderVerticalGradient(SDL_Renderer* renderer, const SDL_Rect& area, SDL_Color top, SDL_Color bottom);
 
+void RenderHorizontalGradient(SDL_Renderer* renderer, const SDL_Rect& area, SDL_Color left, SDL_Color right);
+
 std::string ToHexString(const SDL_Color& color);
 
 } // namespace colony::color
@@ -0,0 +1,698 @@
+#include "utils/draw_list.hpp"
+
+#include "utils/sdl_wrappers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace colony
+{
+namespace
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+constexpr bool kHasRenderGeometry = true;
+#else
+constexpr bool kHasRenderGeometry = false;
+#endif
+
+constexpr int kAtlasSize = 1024;
+constexpr int kAtlasPadding = 1;
+constexpr int kSolidRegionSize = 4;
+constexpr int kMaxAtlasCornerRadius = 160;
+constexpr std::size_t kMaxBatchLookback = 16;
+
+// Solid fills sample the white block in the atlas corner; corner masks are shelf-packed after it.
+struct ShapeAtlas
+{
+    sdl::TextureHandle texture;
+    int cursorX = kSolidRegionSize + kAtlasPadding;
+    int cursorY = 0;
+    int shelfHeight = kSolidRegionSize;
+    std::unordered_map<int, SDL_Rect> corners;
+};
+
+std::unordered_map<SDL_Renderer*, ShapeAtlas>& ShapeAtlases()
+{
+    static std::unordered_map<SDL_Renderer*, ShapeAtlas> atlases;
+    return atlases;
+}
+
+DrawListStats& FrameStatsStorage() noexcept
+{
+    static DrawListStats stats;
+    return stats;
+}
+
+ShapeAtlas* AcquireAtlas(SDL_Renderer* renderer)
+{
+    if (!kHasRenderGeometry || renderer == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto& atlases = ShapeAtlases();
+    auto [it, inserted] = atlases.try_emplace(renderer);
+    ShapeAtlas& atlas = it->second;
+    if (inserted)
+    {
+        atlas.texture.reset(
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, kAtlasSize, kAtlasSize));
+        if (atlas.texture)
+        {
+            const std::vector<Uint32> white(kSolidRegionSize * kSolidRegionSize, 0xFFFFFFFFu);
+            const SDL_Rect solidRegion{0, 0, kSolidRegionSize, kSolidRegionSize};
+            if (SDL_UpdateTexture(atlas.texture.get(), &solidRegion, white.data(), kSolidRegionSize * 4) != 0)
+            {
+                atlas.texture.reset();
+            }
+        }
+    }
+    return atlas.texture ? &atlas : nullptr;
+}
+
+const SDL_Rect* AcquireCornerRegion(ShapeAtlas& atlas, int radius, bool filled)
+{
+    if (radius <= 0 || radius > kMaxAtlasCornerRadius)
+    {
+        return nullptr;
+    }
+
+    const int key = radius * 2 + (filled ? 1 : 0);
+    if (const auto it = atlas.corners.find(key); it != atlas.corners.end())
+    {
+        return it->second.w > 0 ? &it->second : nullptr;
+    }
+
+    SDL_Rect region{0, 0, 0, 0};
+    if (atlas.cursorX + radius > kAtlasSize)
+    {
+        atlas.cursorX = 0;
+        atlas.cursorY += atlas.shelfHeight + kAtlasPadding;
+        atlas.shelfHeight = 0;
+    }
+    if (atlas.cursorY + radius <= kAtlasSize)
+    {
+        region = SDL_Rect{atlas.cursorX, atlas.cursorY, radius, radius};
+        const std::vector<Uint32> pixels = drawing::RasterizeCornerCoverage(radius, filled);
+        if (SDL_UpdateTexture(atlas.texture.get(), &region, pixels.data(), radius * 4) == 0)
+        {
+            atlas.cursorX += radius + kAtlasPadding;
+            atlas.shelfHeight = std::max(atlas.shelfHeight, radius);
+        }
+        else
+        {
+            region = SDL_Rect{0, 0, 0, 0};
+        }
+    }
+
+    // A zero-sized region remembers that this corner does not fit, so it is drawn immediately.
+    const auto inserted = atlas.corners.emplace(key, region).first;
+    return inserted->second.w > 0 ? &inserted->second : nullptr;
+}
+
+int ClampRadius(const SDL_Rect& rect, int radius)
+{
+    const int maxRadius = std::min(rect.w, rect.h) / 2;
+    if (maxRadius <= 0)
+    {
+        return 0;
+    }
+    return std::clamp(radius, 0, maxRadius);
+}
+
+SDL_Rect UnionRect(const SDL_Rect& lhs, const SDL_Rect& rhs)
+{
+    if (lhs.w <= 0 || lhs.h <= 0)
+    {
+        return rhs;
+    }
+    SDL_Rect result{0, 0, 0, 0};
+    SDL_UnionRect(&lhs, &rhs, &result);
+    return result;
+}
+
+SDL_Rect CommandBounds(const SDL_Rect& rect, const SDL_Point& lineEnd, bool isLine)
+{
+    if (!isLine)
+    {
+        return rect;
+    }
+    const int left = std::min(rect.x, lineEnd.x);
+    const int top = std::min(rect.y, lineEnd.y);
+    return SDL_Rect{left, top, std::abs(lineEnd.x - rect.x) + 1, std::abs(lineEnd.y - rect.y) + 1};
+}
+
+// What SDL_RenderCopy and SDL_RenderGeometry take from a texture besides its pixels.
+struct TextureState
+{
+    SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+    SDL_Color mod{255, 255, 255, SDL_ALPHA_OPAQUE};
+};
+
+TextureState ReadTextureState(SDL_Texture* texture)
+{
+    TextureState state;
+    SDL_GetTextureBlendMode(texture, &state.blendMode);
+    SDL_GetTextureColorMod(texture, &state.mod.r, &state.mod.g, &state.mod.b);
+    SDL_GetTextureAlphaMod(texture, &state.mod.a);
+    return state;
+}
+
+void ApplyTextureState(SDL_Texture* texture, const TextureState& state)
+{
+    SDL_SetTextureBlendMode(texture, state.blendMode);
+    SDL_SetTextureColorMod(texture, state.mod.r, state.mod.g, state.mod.b);
+    SDL_SetTextureAlphaMod(texture, state.mod.a);
+}
+
+void AppendQuad(
+    std::vector<SDL_Vertex>& vertices,
+    std::vector<int>& indices,
+    float left,
+    float top,
+    float right,
+    float bottom,
+    SDL_Color color,
+    SDL_FPoint uvTopLeft,
+    SDL_FPoint uvBottomRight)
+{
+    const int base = static_cast<int>(vertices.size());
+    vertices.push_back(SDL_Vertex{{left, top}, color, {uvTopLeft.x, uvTopLeft.y}});
+    vertices.push_back(SDL_Vertex{{right, top}, color, {uvBottomRight.x, uvTopLeft.y}});
+    vertices.push_back(SDL_Vertex{{right, bottom}, color, {uvBottomRight.x, uvBottomRight.y}});
+    vertices.push_back(SDL_Vertex{{left, bottom}, color, {uvTopLeft.x, uvBottomRight.y}});
+    indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+}
+} // namespace
+
+DrawList::DrawList(SDL_Renderer* renderer) noexcept
+    : renderer_(renderer)
+{
+}
+
+DrawList::~DrawList()
+{
+    Flush();
+}
+
+void DrawList::FillRect(const SDL_Rect& rect, SDL_Color color)
+{
+    if (rect.w <= 0 || rect.h <= 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::FillRect;
+    command.rect = rect;
+    command.color = color;
+    Record(command);
+}
+
+void DrawList::DrawRect(const SDL_Rect& rect, SDL_Color color)
+{
+    if (rect.w <= 0 || rect.h <= 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::DrawRect;
+    command.rect = rect;
+    command.color = color;
+    Record(command);
+}
+
+void DrawList::DrawLine(int x1, int y1, int x2, int y2, SDL_Color color)
+{
+    Command command;
+    command.type = CommandType::DrawLine;
+    command.rect = SDL_Rect{x1, y1, 0, 0};
+    command.lineEnd = SDL_Point{x2, y2};
+    command.color = color;
+    Record(command);
+}
+
+void DrawList::FillRoundedRect(const SDL_Rect& rect, int radius, SDL_Color color, int cornerMask)
+{
+    if (rect.w <= 0 || rect.h <= 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::FillRoundedRect;
+    command.rect = rect;
+    command.radius = ClampRadius(rect, radius);
+    command.cornerMask = cornerMask;
+    command.color = color;
+    Record(command);
+}
+
+void DrawList::DrawRoundedRect(const SDL_Rect& rect, int radius, SDL_Color color, int cornerMask)
+{
+    if (rect.w <= 0 || rect.h <= 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::DrawRoundedRect;
+    command.rect = rect;
+    command.radius = ClampRadius(rect, radius);
+    command.cornerMask = cornerMask;
+    command.color = color;
+    Record(command);
+}
+
+void DrawList::DrawTexture(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect& destination)
+{
+    if (texture == nullptr || destination.w <= 0 || destination.h <= 0)
+    {
+        return;
+    }
+    Command command;
+    command.type = CommandType::Texture;
+    command.rect = destination;
+    command.texture = texture;
+    if (source != nullptr)
+    {
+        command.source = *source;
+        command.hasSource = true;
+    }
+    const TextureState state = ReadTextureState(texture);
+    command.blendMode = state.blendMode;
+    command.color = state.mod;
+    commands_.push_back(command);
+}
+
+void DrawList::DrawText(const TextTexture& text, const SDL_Rect& destination)
+{
+    DrawTexture(text.texture.get(), nullptr, destination);
+}
+
+void DrawList::Record(Command command)
+{
+    command.blendMode = blendMode_;
+    const bool rounded =
+        command.type == CommandType::FillRoundedRect || command.type == CommandType::DrawRoundedRect;
+    if (rounded && command.blendMode == SDL_BLENDMODE_NONE)
+    {
+        // Corner coverage lives in alpha, which NONE ignores; an opaque blended draw matches
+        // what the unblended draw would have put on screen.
+        command.blendMode = SDL_BLENDMODE_BLEND;
+        command.color.a = SDL_ALPHA_OPAQUE;
+    }
+    commands_.push_back(command);
+}
+
+DrawList::Batch& DrawList::BatchFor(const Command& command, SDL_Texture* texture, bool immediate)
+{
+    const SDL_Rect bounds =
+        CommandBounds(command.rect, command.lineEnd, command.type == CommandType::DrawLine);
+
+    std::size_t lookback = 0;
+    for (std::size_t index = activeBatches_; index-- > 0 && lookback < kMaxBatchLookback; ++lookback)
+    {
+        Batch& batch = batches_[index];
+        if (!immediate && !batch.immediate && batch.texture == texture && batch.blendMode == command.blendMode)
+        {
+            batch.bounds = UnionRect(batch.bounds, bounds);
+            return batch;
+        }
+        if (SDL_HasIntersection(&batch.bounds, &bounds) == SDL_TRUE)
+        {
+            break;
+        }
+    }
+
+    if (activeBatches_ == batches_.size())
+    {
+        batches_.emplace_back();
+    }
+    Batch& batch = batches_[activeBatches_++];
+    batch.texture = texture;
+    batch.blendMode = command.blendMode;
+    batch.immediate = immediate;
+    batch.bounds = bounds;
+    batch.commands.clear();
+    batch.vertices.clear();
+    batch.indices.clear();
+    return batch;
+}
+
+void DrawList::AppendGeometry(Batch& batch, const Command& command)
+{
+    auto& vertices = batch.vertices;
+    auto& indices = batch.indices;
+
+    if (command.type == CommandType::Texture)
+    {
+        int textureWidth = 0;
+        int textureHeight = 0;
+        SDL_QueryTexture(command.texture, nullptr, nullptr, &textureWidth, &textureHeight);
+        SDL_FPoint uvTopLeft{0.0f, 0.0f};
+        SDL_FPoint uvBottomRight{1.0f, 1.0f};
+        if (command.hasSource && textureWidth > 0 && textureHeight > 0)
+        {
+            uvTopLeft = SDL_FPoint{
+                static_cast<float>(command.source.x) / static_cast<float>(textureWidth),
+                static_cast<float>(command.source.y) / static_cast<float>(textureHeight)};
+            uvBottomRight = SDL_FPoint{
+                static_cast<float>(command.source.x + command.source.w) / static_cast<float>(textureWidth),
+                static_cast<float>(command.source.y + command.source.h) / static_cast<float>(textureHeight)};
+        }
+        const SDL_Rect& rect = command.rect;
+        AppendQuad(
+            vertices,
+            indices,
+            static_cast<float>(rect.x),
+            static_cast<float>(rect.y),
+            static_cast<float>(rect.x + rect.w),
+            static_cast<float>(rect.y + rect.h),
+            command.color,
+            uvTopLeft,
+            uvBottomRight);
+        return;
+    }
+
+    constexpr float kSolidUv = (static_cast<float>(kSolidRegionSize) * 0.5f) / static_cast<float>(kAtlasSize);
+    const SDL_Color color = command.color;
+    const auto solid = [&](int x, int y, int w, int h) {
+        if (w <= 0 || h <= 0)
+        {
+            return;
+        }
+        AppendQuad(
+            vertices,
+            indices,
+            static_cast<float>(x),
+            static_cast<float>(y),
+            static_cast<float>(x + w),
+            static_cast<float>(y + h),
+            color,
+            SDL_FPoint{kSolidUv, kSolidUv},
+            SDL_FPoint{kSolidUv, kSolidUv});
+    };
+
+    const SDL_Rect& rect = command.rect;
+    switch (command.type)
+    {
+    case CommandType::FillRect:
+        solid(rect.x, rect.y, rect.w, rect.h);
+        return;
+    case CommandType::DrawRect:
+        solid(rect.x, rect.y, rect.w, 1);
+        if (rect.h > 1)
+        {
+            solid(rect.x, rect.y + rect.h - 1, rect.w, 1);
+        }
+        solid(rect.x, rect.y + 1, 1, rect.h - 2);
+        if (rect.w > 1)
+        {
+            solid(rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2);
+        }
+        return;
+    case CommandType::DrawLine:
+    {
+        const int x1 = rect.x;
+        const int y1 = rect.y;
+        const int x2 = command.lineEnd.x;
+        const int y2 = command.lineEnd.y;
+        if (x1 == x2 || y1 == y2)
+        {
+            const SDL_Rect bounds = CommandBounds(rect, command.lineEnd, true);
+            solid(bounds.x, bounds.y, bounds.w, bounds.h);
+            return;
+        }
+
+        // Diagonal lines become a one pixel wide quad through the pixel centres of both endpoints.
+        const float dx = static_cast<float>(x2 - x1);
+        const float dy = static_cast<float>(y2 - y1);
+        const float length = std::sqrt(dx * dx + dy * dy);
+        const float ux = dx / length * 0.5f;
+        const float uy = dy / length * 0.5f;
+        const float sx = static_cast<float>(x1) + 0.5f - ux;
+        const float sy = static_cast<float>(y1) + 0.5f - uy;
+        const float ex = static_cast<float>(x2) + 0.5f + ux;
+        const float ey = static_cast<float>(y2) + 0.5f + uy;
+        const SDL_FPoint uv{kSolidUv, kSolidUv};
+        const int base = static_cast<int>(vertices.size());
+        vertices.push_back(SDL_Vertex{{sx - uy, sy + ux}, color, uv});
+        vertices.push_back(SDL_Vertex{{ex - uy, ey + ux}, color, uv});
+        vertices.push_back(SDL_Vertex{{ex + uy, ey - ux}, color, uv});
+        vertices.push_back(SDL_Vertex{{sx + uy, sy - ux}, color, uv});
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        return;
+    }
+    default:
+        break;
+    }
+
+    const bool filled = command.type == CommandType::FillRoundedRect;
+    const int radius = command.cornerMask == drawing::CornerNone ? 0 : command.radius;
+    const int radiusTopLeft = (command.cornerMask & drawing::CornerTopLeft) != 0 ? radius : 0;
+    const int radiusTopRight = (command.cornerMask & drawing::CornerTopRight) != 0 ? radius : 0;
+    const int radiusBottomLeft = (command.cornerMask & drawing::CornerBottomLeft) != 0 ? radius : 0;
+    const int radiusBottomRight = (command.cornerMask & drawing::CornerBottomRight) != 0 ? radius : 0;
+
+    if (filled)
+    {
+        const int leftRadius = std::max(radiusTopLeft, radiusBottomLeft);
+        const int rightRadius = std::max(radiusTopRight, radiusBottomRight);
+        const int topRadius = std::max(radiusTopLeft, radiusTopRight);
+        const int bottomRadius = std::max(radiusBottomLeft, radiusBottomRight);
+
+        solid(rect.x + leftRadius, rect.y + topRadius, rect.w - leftRadius - rightRadius, rect.h - topRadius - bottomRadius);
+        if (topRadius > 0)
+        {
+            solid(rect.x + radiusTopLeft, rect.y, rect.w - radiusTopLeft - radiusTopRight, topRadius);
+        }
+        if (bottomRadius > 0)
+        {
+            solid(rect.x + radiusBottomLeft, rect.y + rect.h - bottomRadius, rect.w - radiusBottomLeft - radiusBottomRight, bottomRadius);
+        }
+        if (leftRadius > 0)
+        {
+            solid(rect.x, rect.y + radiusTopLeft, leftRadius, rect.h - radiusTopLeft - radiusBottomLeft);
+        }
+        if (rightRadius > 0)
+        {
+            solid(rect.x + rect.w - rightRadius, rect.y + radiusTopRight, rightRadius, rect.h - radiusTopRight - radiusBottomRight);
+        }
+    }
+    else
+    {
+        solid(rect.x + radiusTopLeft, rect.y, rect.w - radiusTopLeft - radiusTopRight, 1);
+        solid(rect.x + radiusBottomLeft, rect.y + rect.h - 1, rect.w - radiusBottomLeft - radiusBottomRight, 1);
+        solid(rect.x, rect.y + radiusTopLeft, 1, rect.h - radiusTopLeft - radiusBottomLeft);
+        solid(rect.x + rect.w - 1, rect.y + radiusTopRight, 1, rect.h - radiusTopRight - radiusBottomRight);
+    }
+
+    if (radius <= 0)
+    {
+        return;
+    }
+
+    ShapeAtlas* atlas = AcquireAtlas(renderer_);
+    const SDL_Rect* region = atlas != nullptr ? AcquireCornerRegion(*atlas, radius, filled) : nullptr;
+    if (region == nullptr)
+    {
+        return;
+    }
+
+    const float scale = 1.0f / static_cast<float>(kAtlasSize);
+    const float u0 = static_cast<float>(region->x) * scale;
+    const float v0 = static_cast<float>(region->y) * scale;
+    const float u1 = static_cast<float>(region->x + region->w) * scale;
+    const float v1 = static_cast<float>(region->y + region->h) * scale;
+    const float size = static_cast<float>(radius);
+    const float left = static_cast<float>(rect.x);
+    const float top = static_cast<float>(rect.y);
+    const float right = static_cast<float>(rect.x + rect.w) - size;
+    const float bottom = static_cast<float>(rect.y + rect.h) - size;
+
+    if (radiusTopLeft > 0)
+    {
+        AppendQuad(vertices, indices, left, top, left + size, top + size, color, {u0, v0}, {u1, v1});
+    }
+    if (radiusTopRight > 0)
+    {
+        AppendQuad(vertices, indices, right, top, right + size, top + size, color, {u1, v0}, {u0, v1});
+    }
+    if (radiusBottomLeft > 0)
+    {
+        AppendQuad(vertices, indices, left, bottom, left + size, bottom + size, color, {u0, v1}, {u1, v0});
+    }
+    if (radiusBottomRight > 0)
+    {
+        AppendQuad(vertices, indices, right, bottom, right + size, bottom + size, color, {u1, v1}, {u0, v0});
+    }
+}
+
+void DrawList::ReplayImmediate(const Command& command) const
+{
+    if (command.type == CommandType::Texture)
+    {
+        const TextureState current = ReadTextureState(command.texture);
+        ApplyTextureState(command.texture, TextureState{command.blendMode, command.color});
+        SDL_RenderCopy(renderer_, command.texture, command.hasSource ? &command.source : nullptr, &command.rect);
+        ApplyTextureState(command.texture, current);
+        return;
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer_, command.blendMode);
+    SDL_SetRenderDrawColor(renderer_, command.color.r, command.color.g, command.color.b, command.color.a);
+    switch (command.type)
+    {
+    case CommandType::FillRect:
+        SDL_RenderFillRect(renderer_, &command.rect);
+        break;
+    case CommandType::DrawRect:
+        SDL_RenderDrawRect(renderer_, &command.rect);
+        break;
+    case CommandType::DrawLine:
+        SDL_RenderDrawLine(renderer_, command.rect.x, command.rect.y, command.lineEnd.x, command.lineEnd.y);
+        break;
+    case CommandType::FillRoundedRect:
+        drawing::RenderFilledRoundedRect(renderer_, command.rect, command.radius, command.cornerMask);
+        break;
+    case CommandType::DrawRoundedRect:
+        drawing::RenderRoundedRect(renderer_, command.rect, command.radius, command.cornerMask);
+        break;
+    default:
+        break;
+    }
+}
+
+void DrawList::FlushImmediate()
+{
+    for (const Command& command : commands_)
+    {
+        ReplayImmediate(command);
+        ++stats_.drawCalls;
+    }
+    stats_.batches += commands_.size();
+}
+
+void DrawList::Flush()
+{
+    if (renderer_ == nullptr || commands_.empty())
+    {
+        commands_.clear();
+        return;
+    }
+
+    const DrawListStats before = stats_;
+    stats_.commands += commands_.size();
+
+    Uint8 r = 0;
+    Uint8 g = 0;
+    Uint8 b = 0;
+    Uint8 a = 0;
+    SDL_BlendMode previousBlendMode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawColor(renderer_, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(renderer_, &previousBlendMode);
+
+    ShapeAtlas* atlas = AcquireAtlas(renderer_);
+    if (atlas == nullptr)
+    {
+        FlushImmediate();
+    }
+    else
+    {
+        activeBatches_ = 0;
+        for (std::size_t index = 0; index < commands_.size(); ++index)
+        {
+            const Command& command = commands_[index];
+            const bool rounded = command.type == CommandType::FillRoundedRect
+                || command.type == CommandType::DrawRoundedRect;
+            const bool immediate = rounded && command.radius > 0 && command.cornerMask != drawing::CornerNone
+                && AcquireCornerRegion(*atlas, command.radius, command.type == CommandType::FillRoundedRect) == nullptr;
+            SDL_Texture* texture = command.type == CommandType::Texture ? command.texture : atlas->texture.get();
+
+            Batch& batch = BatchFor(command, texture, immediate);
+            batch.commands.push_back(index);
+            if (!immediate)
+            {
+                AppendGeometry(batch, command);
+            }
+        }
+
+        for (std::size_t index = 0; index < activeBatches_; ++index)
+        {
+            const Batch& batch = batches_[index];
+            if (batch.immediate)
+            {
+                for (const std::size_t commandIndex : batch.commands)
+                {
+                    ReplayImmediate(commands_[commandIndex]);
+                    ++stats_.drawCalls;
+                }
+                continue;
+            }
+            if (batch.vertices.empty())
+            {
+                continue;
+            }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+            // Recorded mods are in the vertex colors. The texture's own mod is held at white for
+            // the draw, so backends that also apply it to geometry do not apply it twice.
+            std::optional<TextureState> current;
+            if (batch.texture == atlas->texture.get())
+            {
+                SDL_SetTextureBlendMode(batch.texture, batch.blendMode);
+            }
+            else
+            {
+                current = ReadTextureState(batch.texture);
+                ApplyTextureState(batch.texture, TextureState{batch.blendMode});
+            }
+            SDL_RenderGeometry(
+                renderer_,
+                batch.texture,
+                batch.vertices.data(),
+                static_cast<int>(batch.vertices.size()),
+                batch.indices.data(),
+                static_cast<int>(batch.indices.size()));
+            if (current)
+            {
+                ApplyTextureState(batch.texture, *current);
+            }
+#endif
+            ++stats_.drawCalls;
+            stats_.vertices += batch.vertices.size();
+        }
+        stats_.batches += activeBatches_;
+        activeBatches_ = 0;
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer_, previousBlendMode);
+    SDL_SetRenderDrawColor(renderer_, r, g, b, a);
+    commands_.clear();
+
+    DrawListStats flushed;
+    flushed.commands = stats_.commands - before.commands;
+    flushed.batches = stats_.batches - before.batches;
+    flushed.drawCalls = stats_.drawCalls - before.drawCalls;
+    flushed.vertices = stats_.vertices - before.vertices;
+    FrameStatsStorage() += flushed;
+}
+
+DrawListStats DrawList::TakeFrameStats() noexcept
+{
+    return std::exchange(FrameStatsStorage(), DrawListStats{});
+}
+
+void DrawList::ReleaseSharedResources(SDL_Renderer* renderer)
+{
+    auto& atlases = ShapeAtlases();
+    if (renderer == nullptr)
+    {
+        atlases.clear();
+        return;
+    }
+    atlases.erase(renderer);
+}
+
+} // namespace colony
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "utils/drawing.hpp"
+#include "utils/text.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace colony
+{
+
+struct DrawListStats
+{
+    std::uint64_t commands = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t drawCalls = 0;
+    std::uint64_t vertices = 0;
+
+    DrawListStats& operator+=(const DrawListStats& other) noexcept
+    {
+        commands += other.commands;
+        batches += other.batches;
+        drawCalls += other.drawCalls;
+        vertices += other.vertices;
+        return *this;
+    }
+};
+
+// Records fills, outlines, rounded rectangles and textured quads for one renderer and submits
+// them on Flush as a handful of SDL_RenderGeometry batches. Untextured shapes and anti-aliased
+// corners share one atlas texture, so they batch together. A command may move into an earlier
+// batch with the same texture and blend mode only if it overlaps nothing drawn in between, so
+// the output matches painter's order. Flush restores the renderer's draw color and blend mode.
+//
+// DrawTexture takes the texture's blend mode and color/alpha mod as they are when it is called;
+// changing them before Flush does not affect draws already recorded, and Flush leaves them as
+// it found them.
+class DrawList
+{
+  public:
+    explicit DrawList(SDL_Renderer* renderer) noexcept;
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+    ~DrawList();
+
+    [[nodiscard]] SDL_Renderer* Renderer() const noexcept { return renderer_; }
+
+    void SetBlendMode(SDL_BlendMode blendMode) noexcept { blendMode_ = blendMode; }
+    [[nodiscard]] SDL_BlendMode BlendMode() const noexcept { return blendMode_; }
+
+    void FillRect(const SDL_Rect& rect, SDL_Color color);
+    void DrawRect(const SDL_Rect& rect, SDL_Color color);
+    void DrawLine(int x1, int y1, int x2, int y2, SDL_Color color);
+    void FillRoundedRect(const SDL_Rect& rect, int radius, SDL_Color color, int cornerMask = drawing::CornerAll);
+    void DrawRoundedRect(const SDL_Rect& rect, int radius, SDL_Color color, int cornerMask = drawing::CornerAll);
+    void DrawTexture(SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect& destination);
+    void DrawText(const TextTexture& text, const SDL_Rect& destination);
+
+    void Flush();
+
+    [[nodiscard]] std::size_t PendingCommands() const noexcept { return commands_.size(); }
+    [[nodiscard]] const DrawListStats& Stats() const noexcept { return stats_; }
+    void ResetStats() noexcept { stats_ = {}; }
+
+    // Totals of every DrawList flushed since the last call, for per-frame reporting.
+    [[nodiscard]] static DrawListStats TakeFrameStats() noexcept;
+    // Releases the shared shape atlases; call before destroying a renderer.
+    static void ReleaseSharedResources(SDL_Renderer* renderer = nullptr);
+
+  private:
+    enum class CommandType
+    {
+        FillRect,
+        DrawRect,
+        DrawLine,
+        FillRoundedRect,
+        DrawRoundedRect,
+        Texture
+    };
+
+    struct Command
+    {
+        CommandType type = CommandType::FillRect;
+        SDL_Rect rect{0, 0, 0, 0};
+        SDL_Rect source{0, 0, 0, 0};
+        bool hasSource = false;
+        SDL_Point lineEnd{0, 0};
+        int radius = 0;
+        int cornerMask = drawing::CornerAll;
+        // For textures, the color and alpha mod.
+        SDL_Color color{255, 255, 255, SDL_ALPHA_OPAQUE};
+        SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+        SDL_Texture* texture = nullptr;
+    };
+
+    struct Batch
+    {
+        SDL_Texture* texture = nullptr;
+        SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+        bool immediate = false;
+        SDL_Rect bounds{0, 0, 0, 0};
+        std::vector<std::size_t> commands;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    void Record(Command command);
+    [[nodiscard]] Batch& BatchFor(const Command& command, SDL_Texture* texture, bool immediate);
+    void AppendGeometry(Batch& batch, const Command& command);
+    void ReplayImmediate(const Command& command) const;
+    void FlushImmediate();
+
+    SDL_Renderer* renderer_ = nullptr;
+    SDL_BlendMode blendMode_ = SDL_BLENDMODE_BLEND;
+    std::vector<Command> commands_;
+    std::vector<Batch> batches_;
+    std::size_t activeBatches_ = 0;
+    DrawListStats stats_{};
+};
+
+} // namespace colony
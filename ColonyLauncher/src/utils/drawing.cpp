@@ -1,7 +1,12 @@
 #include "utils/drawing.hpp"
 
+#include "utils/sdl_wrappers.hpp"
+
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace colony::drawing
 {
@@ -86,8 +91,164 @@ void DrawCornerPoints(SDL_Renderer* renderer, const SDL_Rect& rect, int radius,
     }
 }
 
+constexpr int kCoverageSamples = 4;
+
+struct CornerTextureKey
+{
+    SDL_Renderer* renderer = nullptr;
+    int radius = 0;
+    bool filled = false;
+
+    bool operator==(const CornerTextureKey& other) const noexcept
+    {
+        return renderer == other.renderer && radius == other.radius && filled == other.filled;
+    }
+};
+
+struct CornerTextureKeyHash
+{
+    std::size_t operator()(const CornerTextureKey& key) const noexcept
+    {
+        const auto packed = (static_cast<std::uint64_t>(key.radius) << 1) | (key.filled ? 1u : 0u);
+        return std::hash<const void*>{}(key.renderer) ^ (std::hash<std::uint64_t>{}(packed) << 1);
+    }
+};
+
+// An empty handle marks a (renderer, radius, style) whose upload failed, so we fall back
+// to per-pixel drawing without retrying every frame.
+using CornerTextureMap = std::unordered_map<CornerTextureKey, sdl::TextureHandle, CornerTextureKeyHash>;
+
+CornerTextureMap& CornerTextures()
+{
+    static CornerTextureMap textures;
+    return textures;
+}
+
+sdl::TextureHandle CreateCornerTexture(SDL_Renderer* renderer, int radius, bool filled)
+{
+    const std::vector<Uint32> pixels = RasterizeCornerCoverage(radius, filled);
+    sdl::TextureHandle texture{
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, radius, radius)};
+    if (!texture)
+    {
+        return {};
+    }
+    if (SDL_UpdateTexture(texture.get(), nullptr, pixels.data(), radius * static_cast<int>(sizeof(Uint32))) != 0)
+    {
+        return {};
+    }
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+SDL_Texture* AcquireCornerTexture(SDL_Renderer* renderer, int radius, bool filled)
+{
+    auto& textures = CornerTextures();
+    const CornerTextureKey key{renderer, radius, filled};
+    auto it = textures.find(key);
+    if (it == textures.end())
+    {
+        it = textures.emplace(key, CreateCornerTexture(renderer, radius, filled)).first;
+    }
+    return it->second.get();
+}
+
+void DrawCorners(SDL_Renderer* renderer, const SDL_Rect& rect, int radius, bool filled, int cornerMask)
+{
+    if (radius <= 0 || cornerMask == CornerNone)
+    {
+        return;
+    }
+
+    SDL_Texture* texture = AcquireCornerTexture(renderer, radius, filled);
+    if (texture == nullptr)
+    {
+        DrawCornerPoints(renderer, rect, radius, filled, cornerMask);
+        return;
+    }
+
+    Uint8 r = 0;
+    Uint8 g = 0;
+    Uint8 b = 0;
+    Uint8 a = 0;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetTextureColorMod(texture, r, g, b);
+    SDL_SetTextureAlphaMod(texture, a);
+
+    const int right = rect.x + rect.w - radius;
+    const int bottom = rect.y + rect.h - radius;
+    const auto copyCorner = [&](int corner, int x, int y, int flip) {
+        if ((cornerMask & corner) == 0)
+        {
+            return;
+        }
+        const SDL_Rect destination{x, y, radius, radius};
+        SDL_RenderCopyEx(renderer, texture, nullptr, &destination, 0.0, nullptr, static_cast<SDL_RendererFlip>(flip));
+    };
+
+    copyCorner(CornerTopLeft, rect.x, rect.y, SDL_FLIP_NONE);
+    copyCorner(CornerTopRight, right, rect.y, SDL_FLIP_HORIZONTAL);
+    copyCorner(CornerBottomLeft, rect.x, bottom, SDL_FLIP_VERTICAL);
+    copyCorner(CornerBottomRight, right, bottom, SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL);
+}
+
 } // namespace
 
+std::vector<Uint32> RasterizeCornerCoverage(int radius, bool filled)
+{
+    if (radius <= 0)
+    {
+        return {};
+    }
+
+    std::vector<Uint32> pixels(static_cast<std::size_t>(radius) * static_cast<std::size_t>(radius), 0u);
+    const float outer = static_cast<float>(radius);
+    const float inner = filled ? -1.0f : outer - 1.0f;
+    constexpr float kSampleStep = 1.0f / static_cast<float>(kCoverageSamples);
+    constexpr int kSampleCount = kCoverageSamples * kCoverageSamples;
+
+    for (int y = 0; y < radius; ++y)
+    {
+        for (int x = 0; x < radius; ++x)
+        {
+            int covered = 0;
+            for (int sy = 0; sy < kCoverageSamples; ++sy)
+            {
+                for (int sx = 0; sx < kCoverageSamples; ++sx)
+                {
+                    const float px = static_cast<float>(x) + (static_cast<float>(sx) + 0.5f) * kSampleStep;
+                    const float py = static_cast<float>(y) + (static_cast<float>(sy) + 0.5f) * kSampleStep;
+                    const float distance = std::hypot(px - outer, py - outer);
+                    if (distance <= outer && distance >= inner)
+                    {
+                        ++covered;
+                    }
+                }
+            }
+
+            const Uint32 alpha = static_cast<Uint32>((covered * 255 + kSampleCount / 2) / kSampleCount);
+            pixels[static_cast<std::size_t>(y) * static_cast<std::size_t>(radius) + static_cast<std::size_t>(x)] =
+                (alpha << 24) | 0x00FFFFFFu;
+        }
+    }
+    return pixels;
+}
+
+void ReleaseCachedTextures(SDL_Renderer* renderer)
+{
+    auto& textures = CornerTextures();
+    if (renderer == nullptr)
+    {
+        textures.clear();
+        return;
+    }
+
+    for (auto it = textures.begin(); it != textures.end();)
+    {
+        it = it->first.renderer == renderer ? textures.erase(it) : std::next(it);
+    }
+}
+
 void RenderFilledRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int radius, int cornerMask)
 {
     if (renderer == nullptr || rect.w <= 0 || rect.h <= 0)
@@ -166,7 +327,7 @@ void RenderFilledRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int r
         }
     }
 
-    DrawCornerPoints(renderer, rect, radius, true, cornerMask);
+    DrawCorners(renderer, rect, radius, true, cornerMask);
 }
 
 void RenderRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int radius, int cornerMask)
@@ -221,7 +382,7 @@ void RenderRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int radius,
         SDL_RenderDrawLine(renderer, x2, rightStart, x2, rightEnd);
     }
 
-    DrawCornerPoints(renderer, rect, radius, false, cornerMask);
+    DrawCorners(renderer, rect, radius, false, cornerMask);
 }
 
 } // namespace colony::drawing
@@ -2,6 +2,8 @@
 
 #include <SDL2/SDL.h>
 
+#include <vector>
+
 namespace colony::drawing
 {
 
@@ -19,4 +21,12 @@ void RenderFilledRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int r
 
 void RenderRoundedRect(SDL_Renderer* renderer, const SDL_Rect& rect, int radius, int cornerMask = CornerAll);
 
+// ARGB8888 pixels of the top-left quarter circle: white with supersampled coverage in alpha.
+// Filled masks cover the whole disc, outline masks the outermost pixel ring.
+std::vector<Uint32> RasterizeCornerCoverage(int radius, bool filled);
+
+// Rounded corners are drawn from anti-aliased quarter-circle textures cached per renderer.
+// Call before destroying a renderer; nullptr releases the textures of every renderer.
+void ReleaseCachedTextures(SDL_Renderer* renderer = nullptr);
+
 } // namespace colony::drawing
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+
+namespace colony
+{
+
+// Tracks whether the next loop iteration has to present a frame. RequestFrame is for the
+// main thread; Invalidate may be called from any thread and wakes an idle event wait.
+class FrameInvalidator
+{
+  public:
+    void RegisterWakeEvent() noexcept
+    {
+        const Uint32 eventType = SDL_RegisterEvents(1);
+        wakeEventType_ = eventType == static_cast<Uint32>(-1) ? static_cast<Uint32>(SDL_USEREVENT) : eventType;
+    }
+
+    void RequestFrame() noexcept
+    {
+        requested_.store(true, std::memory_order_release);
+    }
+
+    void Invalidate() noexcept
+    {
+        if (requested_.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        SDL_Event event{};
+        event.type = wakeEventType_;
+        SDL_PushEvent(&event);
+    }
+
+    [[nodiscard]] bool IsRequested() const noexcept
+    {
+        return requested_.load(std::memory_order_acquire);
+    }
+
+    bool Consume() noexcept
+    {
+        return requested_.exchange(false, std::memory_order_acq_rel);
+    }
+
+    [[nodiscard]] Uint32 WakeEventType() const noexcept
+    {
+        return wakeEventType_;
+    }
+
+  private:
+    std::atomic<bool> requested_{true};
+    Uint32 wakeEventType_ = SDL_USEREVENT;
+};
+
+} // namespace colony
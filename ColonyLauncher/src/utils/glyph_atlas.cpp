@@ -0,0 +1,375 @@
+#include "utils/glyph_atlas.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#if SDL_VERSIONNUM(SDL_TTF_MAJOR_VERSION, SDL_TTF_MINOR_VERSION, SDL_TTF_PATCHLEVEL) >= SDL_VERSIONNUM(2, 0, 18)
+#define COLONY_TTF_HAS_GLYPH32 1
+#else
+#define COLONY_TTF_HAS_GLYPH32 0
+#endif
+
+namespace colony
+{
+namespace
+{
+constexpr SDL_Color kGlyphColor{255, 255, 255, SDL_ALPHA_OPAQUE};
+constexpr char32_t kReplacementCharacter = 0xFFFD;
+
+char32_t DecodeUtf8(std::string_view text, std::size_t& index)
+{
+    const auto lead = static_cast<unsigned char>(text[index]);
+    std::size_t length = 1;
+    char32_t codePoint = lead;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        length = 2;
+        codePoint = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        length = 3;
+        codePoint = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        length = 4;
+        codePoint = lead & 0x07;
+    }
+    else if ((lead & 0x80) != 0)
+    {
+        ++index;
+        return kReplacementCharacter;
+    }
+
+    if (index + length > text.size())
+    {
+        index = text.size();
+        return kReplacementCharacter;
+    }
+
+    for (std::size_t offset = 1; offset < length; ++offset)
+    {
+        const auto continuation = static_cast<unsigned char>(text[index + offset]);
+        if ((continuation & 0xC0) != 0x80)
+        {
+            index += offset;
+            return kReplacementCharacter;
+        }
+        codePoint = (codePoint << 6) | (continuation & 0x3F);
+    }
+
+    index += length;
+    return codePoint;
+}
+
+SDL_Surface* RenderGlyphSurface(TTF_Font* font, char32_t codePoint)
+{
+#if COLONY_TTF_HAS_GLYPH32
+    return TTF_RenderGlyph32_Blended(font, static_cast<Uint32>(codePoint), kGlyphColor);
+#else
+    const Uint16 glyph = codePoint > 0xFFFF ? static_cast<Uint16>('?') : static_cast<Uint16>(codePoint);
+    return TTF_RenderGlyph_Blended(font, glyph, kGlyphColor);
+#endif
+}
+
+bool QueryGlyphMetrics(TTF_Font* font, char32_t codePoint, int& minX, int& advance)
+{
+    int maxX = 0;
+    int minY = 0;
+    int maxY = 0;
+#if COLONY_TTF_HAS_GLYPH32
+    return TTF_GlyphMetrics32(font, static_cast<Uint32>(codePoint), &minX, &maxX, &minY, &maxY, &advance) == 0;
+#else
+    const Uint16 glyph = codePoint > 0xFFFF ? static_cast<Uint16>('?') : static_cast<Uint16>(codePoint);
+    return TTF_GlyphMetrics(font, glyph, &minX, &maxX, &minY, &maxY, &advance) == 0;
+#endif
+}
+} // namespace
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font)
+    : renderer_(renderer)
+    , font_(font)
+    , lineHeight_(font != nullptr ? TTF_FontHeight(font) : 0)
+{
+}
+
+SDL_Point GlyphAtlas::Measure(std::string_view text)
+{
+    SDL_Point extent{0, lineHeight_};
+    int penX = 0;
+    char32_t previous = 0;
+    for (std::size_t index = 0; index < text.size();)
+    {
+        const char32_t codePoint = DecodeUtf8(text, index);
+        const Glyph& glyph = FindOrPackGlyph(codePoint);
+        if (previous != 0)
+        {
+            penX += Kerning(previous, codePoint);
+        }
+        extent.x = std::max(extent.x, penX + glyph.offsetX + glyph.source.w);
+        penX += glyph.advance;
+        previous = codePoint;
+    }
+    extent.x = std::max(extent.x, penX);
+    return extent;
+}
+
+void GlyphAtlas::Draw(std::string_view text, int x, int y, SDL_Color color)
+{
+    if (renderer_ == nullptr || text.empty())
+    {
+        return;
+    }
+
+    for (auto& vertices : pageVertices_)
+    {
+        vertices.clear();
+    }
+    for (auto& indices : pageIndices_)
+    {
+        indices.clear();
+    }
+
+    const float pageSize = static_cast<float>(kPageSize);
+    int penX = x;
+    char32_t previous = 0;
+    for (std::size_t index = 0; index < text.size();)
+    {
+        const char32_t codePoint = DecodeUtf8(text, index);
+        const Glyph& glyph = FindOrPackGlyph(codePoint);
+        if (previous != 0)
+        {
+            penX += Kerning(previous, codePoint);
+        }
+        previous = codePoint;
+
+        if (glyph.page >= 0)
+        {
+            const float left = static_cast<float>(penX + glyph.offsetX);
+            const float top = static_cast<float>(y);
+            const float right = left + static_cast<float>(glyph.source.w);
+            const float bottom = top + static_cast<float>(glyph.source.h);
+            const float u0 = static_cast<float>(glyph.source.x) / pageSize;
+            const float v0 = static_cast<float>(glyph.source.y) / pageSize;
+            const float u1 = static_cast<float>(glyph.source.x + glyph.source.w) / pageSize;
+            const float v1 = static_cast<float>(glyph.source.y + glyph.source.h) / pageSize;
+
+            auto& vertices = pageVertices_[static_cast<std::size_t>(glyph.page)];
+            auto& indices = pageIndices_[static_cast<std::size_t>(glyph.page)];
+            const int base = static_cast<int>(vertices.size());
+            vertices.push_back(SDL_Vertex{{left, top}, color, {u0, v0}});
+            vertices.push_back(SDL_Vertex{{right, top}, color, {u1, v0}});
+            vertices.push_back(SDL_Vertex{{right, bottom}, color, {u1, v1}});
+            vertices.push_back(SDL_Vertex{{left, bottom}, color, {u0, v1}});
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+
+        penX += glyph.advance;
+    }
+
+    for (std::size_t pageIndex = 0; pageIndex < pages_.size(); ++pageIndex)
+    {
+        const auto& vertices = pageVertices_[pageIndex];
+        if (vertices.empty())
+        {
+            continue;
+        }
+
+        SDL_Texture* texture = pages_[pageIndex].texture.get();
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        const auto& indices = pageIndices_[pageIndex];
+        SDL_RenderGeometry(
+            renderer_,
+            texture,
+            vertices.data(),
+            static_cast<int>(vertices.size()),
+            indices.data(),
+            static_cast<int>(indices.size()));
+#else
+        SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+        SDL_SetTextureAlphaMod(texture, color.a);
+        for (std::size_t vertex = 0; vertex + 3 < vertices.size(); vertex += 4)
+        {
+            const SDL_Vertex& topLeft = vertices[vertex];
+            const SDL_Vertex& bottomRight = vertices[vertex + 2];
+            const SDL_Rect source{
+                static_cast<int>(topLeft.tex_coord.x * pageSize),
+                static_cast<int>(topLeft.tex_coord.y * pageSize),
+                static_cast<int>((bottomRight.tex_coord.x - topLeft.tex_coord.x) * pageSize),
+                static_cast<int>((bottomRight.tex_coord.y - topLeft.tex_coord.y) * pageSize)};
+            const SDL_Rect destination{
+                static_cast<int>(topLeft.position.x),
+                static_cast<int>(topLeft.position.y),
+                source.w,
+                source.h};
+            SDL_RenderCopy(renderer_, texture, &source, &destination);
+        }
+#endif
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::FindOrPackGlyph(char32_t codePoint)
+{
+    if (const auto it = glyphs_.find(codePoint); it != glyphs_.end())
+    {
+        return it->second;
+    }
+
+    Glyph glyph;
+    int minX = 0;
+    if (font_ != nullptr && QueryGlyphMetrics(font_, codePoint, minX, glyph.advance))
+    {
+        glyph.offsetX = std::min(minX, 0);
+        if (SDL_Surface* surface = RenderGlyphSurface(font_, codePoint); surface != nullptr)
+        {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            SDL_FreeSurface(surface);
+
+            int pageIndex = -1;
+            SDL_Rect region{0, 0, 0, 0};
+            if (converted != nullptr && AllocateRegion(converted->w, converted->h, pageIndex, region))
+            {
+                SDL_Texture* texture = pages_[static_cast<std::size_t>(pageIndex)].texture.get();
+                if (SDL_UpdateTexture(texture, &region, converted->pixels, converted->pitch) == 0)
+                {
+                    glyph.page = pageIndex;
+                    glyph.source = region;
+                }
+            }
+            SDL_FreeSurface(converted);
+        }
+    }
+
+    return glyphs_.emplace(codePoint, glyph).first->second;
+}
+
+bool GlyphAtlas::AllocateRegion(int width, int height, int& pageIndex, SDL_Rect& region)
+{
+    const int paddedWidth = width + kGlyphPadding;
+    const int paddedHeight = height + kGlyphPadding;
+    if (width <= 0 || height <= 0 || paddedWidth > kPageSize || paddedHeight > kPageSize)
+    {
+        return false;
+    }
+
+    if (pages_.empty() && !AddPage())
+    {
+        return false;
+    }
+
+    Page* page = &pages_.back();
+    if (page->cursorX + paddedWidth > kPageSize)
+    {
+        page->cursorX = 0;
+        page->cursorY += page->shelfHeight;
+        page->shelfHeight = 0;
+    }
+    if (page->cursorY + paddedHeight > kPageSize)
+    {
+        if (!AddPage())
+        {
+            return false;
+        }
+        page = &pages_.back();
+    }
+
+    pageIndex = static_cast<int>(pages_.size()) - 1;
+    region = SDL_Rect{page->cursorX, page->cursorY, width, height};
+    page->cursorX += paddedWidth;
+    page->shelfHeight = std::max(page->shelfHeight, paddedHeight);
+    return true;
+}
+
+bool GlyphAtlas::AddPage()
+{
+    sdl::TextureHandle texture{SDL_CreateTexture(
+        renderer_, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, kPageSize, kPageSize)};
+    if (!texture)
+    {
+        std::cerr << "Failed to allocate glyph atlas page: " << SDL_GetError() << '\n';
+        return false;
+    }
+
+    const std::vector<Uint32> clearPixels(static_cast<std::size_t>(kPageSize) * kPageSize, 0);
+    SDL_UpdateTexture(texture.get(), nullptr, clearPixels.data(), kPageSize * static_cast<int>(sizeof(Uint32)));
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+    Page page;
+    page.texture = std::move(texture);
+    pages_.emplace_back(std::move(page));
+    pageVertices_.resize(pages_.size());
+    pageIndices_.resize(pages_.size());
+    return true;
+}
+
+int GlyphAtlas::Kerning(char32_t previous, char32_t current) const
+{
+#if COLONY_TTF_HAS_GLYPH32
+    return TTF_GetFontKerningSizeGlyphs32(font_, static_cast<Uint32>(previous), static_cast<Uint32>(current));
+#else
+    if (previous > 0xFFFF || current > 0xFFFF)
+    {
+        return 0;
+    }
+    return TTF_GetFontKerningSizeGlyphs(font_, static_cast<Uint16>(previous), static_cast<Uint16>(current));
+#endif
+}
+
+std::shared_ptr<GlyphAtlas> GlyphAtlasCache::Acquire(SDL_Renderer* renderer, TTF_Font* font)
+{
+    if (renderer == nullptr || font == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto& atlas = atlases_[font];
+    if (!atlas)
+    {
+        atlas = std::make_shared<GlyphAtlas>(renderer, font);
+    }
+    return atlas;
+}
+
+void GlyphAtlasCache::Clear()
+{
+    for (auto& [font, atlas] : atlases_)
+    {
+        atlas->ReleaseFont();
+    }
+    atlases_.clear();
+}
+
+GlyphText CreateGlyphText(
+    GlyphAtlasCache& cache,
+    SDL_Renderer* renderer,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color)
+{
+    GlyphText result;
+    result.atlas = cache.Acquire(renderer, font);
+    if (!result.atlas || text.empty())
+    {
+        return result;
+    }
+
+    result.text = std::string{text};
+    result.color = color;
+    const SDL_Point extent = result.atlas->Measure(result.text);
+    result.width = extent.x;
+    result.height = extent.y;
+    return result;
+}
+
+void RenderGlyphText(const GlyphText& glyphText, const SDL_Rect& rect)
+{
+    if (glyphText.Empty())
+    {
+        return;
+    }
+
+    glyphText.atlas->Draw(glyphText.text, rect.x, rect.y, glyphText.color);
+}
+
+} // namespace colony
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "utils/sdl_wrappers.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace colony
+{
+
+// Glyphs of a single TTF_Font (and therefore a single point size) packed on demand into
+// shared atlas pages. Strings are drawn as one batch of textured quads per page.
+class GlyphAtlas
+{
+  public:
+    GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font);
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    [[nodiscard]] TTF_Font* Font() const noexcept { return font_; }
+    [[nodiscard]] int LineHeight() const noexcept { return lineHeight_; }
+    [[nodiscard]] std::size_t GlyphCount() const noexcept { return glyphs_.size(); }
+    [[nodiscard]] std::size_t PageCount() const noexcept { return pages_.size(); }
+
+    void ReleaseFont() noexcept { font_ = nullptr; }
+
+    [[nodiscard]] SDL_Point Measure(std::string_view text);
+    void Draw(std::string_view text, int x, int y, SDL_Color color);
+
+  private:
+    struct Glyph
+    {
+        int page = -1;
+        SDL_Rect source{0, 0, 0, 0};
+        int offsetX = 0;
+        int advance = 0;
+    };
+
+    struct Page
+    {
+        sdl::TextureHandle texture;
+        int cursorX = 0;
+        int cursorY = 0;
+        int shelfHeight = 0;
+    };
+
+    static constexpr int kPageSize = 512;
+    static constexpr int kGlyphPadding = 1;
+
+    const Glyph& FindOrPackGlyph(char32_t codePoint);
+    bool AllocateRegion(int width, int height, int& pageIndex, SDL_Rect& region);
+    bool AddPage();
+    [[nodiscard]] int Kerning(char32_t previous, char32_t current) const;
+
+    SDL_Renderer* renderer_ = nullptr;
+    TTF_Font* font_ = nullptr;
+    int lineHeight_ = 0;
+    std::vector<Page> pages_;
+    std::unordered_map<char32_t, Glyph> glyphs_;
+    std::vector<std::vector<SDL_Vertex>> pageVertices_;
+    std::vector<std::vector<int>> pageIndices_;
+};
+
+class GlyphAtlasCache
+{
+  public:
+    [[nodiscard]] std::shared_ptr<GlyphAtlas> Acquire(SDL_Renderer* renderer, TTF_Font* font);
+    void Clear();
+
+  private:
+    std::unordered_map<TTF_Font*, std::shared_ptr<GlyphAtlas>> atlases_;
+};
+
+struct GlyphText
+{
+    std::shared_ptr<GlyphAtlas> atlas;
+    std::string text;
+    SDL_Color color{0, 0, 0, SDL_ALPHA_OPAQUE};
+    int width{};
+    int height{};
+
+    [[nodiscard]] bool Empty() const noexcept { return atlas == nullptr || text.empty(); }
+};
+
+GlyphText CreateGlyphText(
+    GlyphAtlasCache& cache,
+    SDL_Renderer* renderer,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color);
+
+void RenderGlyphText(const GlyphText& glyphText, const SDL_Rect& rect);
+
+} // namespace colony
@@ -0,0 +1,195 @@
+#include "utils/render_layer.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace colony
+{
+namespace
+{
+std::uint64_t& LayerGeneration() noexcept
+{
+    static std::uint64_t generation = 1;
+    return generation;
+}
+
+SDL_BlendMode PremultipliedBlendMode() noexcept
+{
+    return SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE,
+        SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+        SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE,
+        SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+        SDL_BLENDOPERATION_ADD);
+}
+
+bool SameRect(const SDL_Rect& lhs, const SDL_Rect& rhs) noexcept
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.w == rhs.w && lhs.h == rhs.h;
+}
+} // namespace
+
+RenderLayerKey& RenderLayerKey::Add(std::uint64_t value) noexcept
+{
+    for (int byte = 0; byte < 8; ++byte)
+    {
+        hash_ ^= (value >> (byte * 8)) & 0xFFu;
+        hash_ *= 1099511628211ull;
+    }
+    return *this;
+}
+
+RenderLayerKey& RenderLayerKey::Add(float value) noexcept
+{
+    return Add(static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(value)));
+}
+
+RenderLayerKey& RenderLayerKey::Add(const SDL_Rect& rect) noexcept
+{
+    return Add(rect.x).Add(rect.y).Add(rect.w).Add(rect.h);
+}
+
+RenderLayerKey& RenderLayerKey::Add(SDL_Color color) noexcept
+{
+    return Add((static_cast<std::uint64_t>(color.r) << 24) | (static_cast<std::uint64_t>(color.g) << 16)
+        | (static_cast<std::uint64_t>(color.b) << 8) | static_cast<std::uint64_t>(color.a));
+}
+
+RenderLayerKey& RenderLayerKey::Add(std::string_view text) noexcept
+{
+    Add(static_cast<std::uint64_t>(text.size()));
+    for (const char ch : text)
+    {
+        hash_ ^= static_cast<unsigned char>(ch);
+        hash_ *= 1099511628211ull;
+    }
+    return *this;
+}
+
+RenderLayer::Pass RenderLayer::Begin(SDL_Renderer* renderer, const SDL_Rect& bounds, std::uint64_t key)
+{
+    pass_ = Pass::Direct;
+    suspended_ = false;
+    if (renderer != renderer_)
+    {
+        Release();
+        renderer_ = renderer;
+        unsupported_ = false;
+    }
+
+    if (renderer == nullptr || unsupported_ || bounds.w <= 0 || bounds.h <= 0 || bounds.x < 0 || bounds.y < 0)
+    {
+        return pass_;
+    }
+    if (SDL_RenderTargetSupported(renderer) == SDL_FALSE
+        || !EnsureTexture(renderer, bounds.x + bounds.w, bounds.y + bounds.h))
+    {
+        unsupported_ = true;
+        return pass_;
+    }
+
+    if (valid_ && key == key_ && generation_ == LayerGeneration() && SameRect(bounds, bounds_))
+    {
+        pass_ = Pass::Reuse;
+        return pass_;
+    }
+
+    previousTarget_ = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, texture_.get()) != 0)
+    {
+        return pass_;
+    }
+
+    Uint8 r = 0;
+    Uint8 g = 0;
+    Uint8 b = 0;
+    Uint8 a = 0;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_RenderSetClipRect(renderer, &bounds);
+
+    bounds_ = bounds;
+    key_ = key;
+    generation_ = LayerGeneration();
+    valid_ = false;
+    pass_ = Pass::Draw;
+    return pass_;
+}
+
+void RenderLayer::End()
+{
+    if (pass_ == Pass::Direct)
+    {
+        return;
+    }
+
+    if (pass_ == Pass::Draw)
+    {
+        if (!suspended_)
+        {
+            SDL_SetRenderTarget(renderer_, previousTarget_);
+        }
+        valid_ = true;
+    }
+
+    SDL_RenderCopy(renderer_, texture_.get(), &bounds_, &bounds_);
+    pass_ = Pass::Direct;
+    suspended_ = false;
+}
+
+void RenderLayer::Suspend()
+{
+    if (pass_ == Pass::Draw && !suspended_)
+    {
+        SDL_SetRenderTarget(renderer_, previousTarget_);
+        suspended_ = true;
+    }
+}
+
+void RenderLayer::Resume()
+{
+    if (pass_ == Pass::Draw && suspended_)
+    {
+        SDL_SetRenderTarget(renderer_, texture_.get());
+        SDL_RenderSetClipRect(renderer_, &bounds_);
+        suspended_ = false;
+    }
+}
+
+void RenderLayer::Release() noexcept
+{
+    texture_.reset();
+    textureWidth_ = 0;
+    textureHeight_ = 0;
+    valid_ = false;
+}
+
+void RenderLayer::InvalidateAll() noexcept
+{
+    ++LayerGeneration();
+}
+
+bool RenderLayer::EnsureTexture(SDL_Renderer* renderer, int width, int height)
+{
+    if (texture_ && textureWidth_ == width && textureHeight_ == height)
+    {
+        return true;
+    }
+
+    texture_.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height));
+    valid_ = false;
+    if (!texture_ || SDL_SetTextureBlendMode(texture_.get(), PremultipliedBlendMode()) != 0)
+    {
+        Release();
+        return false;
+    }
+
+    textureWidth_ = width;
+    textureHeight_ = height;
+    return true;
+}
+
+} // namespace colony
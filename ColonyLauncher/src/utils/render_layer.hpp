@@ -0,0 +1,84 @@
+#pragma once
+
+#include "utils/sdl_wrappers.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace colony
+{
+
+// FNV-1a over the inputs that decide what a layer looks like.
+class RenderLayerKey
+{
+  public:
+    RenderLayerKey& Add(std::uint64_t value) noexcept;
+    RenderLayerKey& Add(int value) noexcept { return Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+    RenderLayerKey& Add(bool value) noexcept { return Add(static_cast<std::uint64_t>(value ? 1u : 0u)); }
+    RenderLayerKey& Add(float value) noexcept;
+    RenderLayerKey& Add(const SDL_Rect& rect) noexcept;
+    RenderLayerKey& Add(SDL_Color color) noexcept;
+    RenderLayerKey& Add(std::string_view text) noexcept;
+    RenderLayerKey& Add(const char* text) noexcept { return Add(std::string_view{text}); }
+
+    [[nodiscard]] std::uint64_t Value() const noexcept { return hash_; }
+
+  private:
+    std::uint64_t hash_ = 14695981039346656037ull;
+};
+
+// Caches the drawing of a mostly static region in a render target texture. Begin reports
+// whether the caller has to draw (the layer target is bound), may skip drawing (the cached
+// texture is still valid), or must draw straight to the screen (targets or premultiplied
+// blending are unavailable). End composites the cached pixels back in every case but Direct.
+//
+// The texture spans from the output origin to the bottom-right of the bounds, so callers keep
+// drawing in screen coordinates. Content is rendered premultiplied, which also keeps additive
+// draws additive after compositing.
+class RenderLayer
+{
+  public:
+    enum class Pass
+    {
+        Draw,
+        Reuse,
+        Direct
+    };
+
+    RenderLayer() = default;
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    Pass Begin(SDL_Renderer* renderer, const SDL_Rect& bounds, std::uint64_t key);
+    void End();
+
+    // Temporarily draws to the previous target, e.g. for animated parts in the middle of a layer.
+    void Suspend();
+    void Resume();
+
+    void Invalidate() noexcept { valid_ = false; }
+    void Release() noexcept;
+
+    // Drops every layer's cached pixels, e.g. after a theme change or SDL_RENDER_TARGETS_RESET.
+    static void InvalidateAll() noexcept;
+
+  private:
+    bool EnsureTexture(SDL_Renderer* renderer, int width, int height);
+
+    sdl::TextureHandle texture_;
+    SDL_Renderer* renderer_ = nullptr;
+    SDL_Texture* previousTarget_ = nullptr;
+    SDL_Rect bounds_{0, 0, 0, 0};
+    int textureWidth_ = 0;
+    int textureHeight_ = 0;
+    std::uint64_t key_ = 0;
+    std::uint64_t generation_ = 0;
+    Pass pass_ = Pass::Direct;
+    bool valid_ = false;
+    bool unsupported_ = false;
+    bool suspended_ = false;
+};
+
+} // namespace colony
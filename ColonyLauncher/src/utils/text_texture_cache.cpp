@@ -0,0 +1,122 @@
+#include "utils/text_texture_cache.hpp"
+
+#include <functional>
+
+namespace colony
+{
+namespace
+{
+Uint32 PackColor(SDL_Color color) noexcept
+{
+    return (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16)
+        | (static_cast<Uint32>(color.b) << 8) | static_cast<Uint32>(color.a);
+}
+
+std::size_t HashKey(const TTF_Font* font, std::string_view text, Uint32 color) noexcept
+{
+    std::size_t seed = std::hash<std::string_view>{}(text);
+    seed ^= std::hash<const void*>{}(font) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<Uint32>{}(color) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    return seed;
+}
+} // namespace
+
+std::size_t TextTextureCache::KeyHash::operator()(const KeyView& key) const noexcept
+{
+    return HashKey(key.font, key.text, key.color);
+}
+
+std::size_t TextTextureCache::KeyHash::operator()(const Key& key) const noexcept
+{
+    return HashKey(key.font, key.text, key.color);
+}
+
+bool TextTextureCache::KeyEqual::operator()(const KeyView& lhs, const Key& rhs) const noexcept
+{
+    return lhs.font == rhs.font && lhs.color == rhs.color && lhs.text == rhs.text;
+}
+
+bool TextTextureCache::KeyEqual::operator()(const Key& lhs, const KeyView& rhs) const noexcept
+{
+    return (*this)(rhs, lhs);
+}
+
+bool TextTextureCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const noexcept
+{
+    return lhs.font == rhs.font && lhs.color == rhs.color && lhs.text == rhs.text;
+}
+
+TextTextureCache::TextTextureCache(std::size_t byteBudget) noexcept
+    : byteBudget_(byteBudget)
+{
+}
+
+const TextTexture* TextTextureCache::Acquire(
+    SDL_Renderer* renderer,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color)
+{
+    if (renderer == nullptr || font == nullptr || text.empty())
+    {
+        return nullptr;
+    }
+
+    const KeyView lookup{font, text, PackColor(color)};
+    if (const auto it = index_.find(lookup); it != index_.end())
+    {
+        ++stats_.hits;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second.texture.texture ? &it->second->second.texture : nullptr;
+    }
+
+    ++stats_.misses;
+    Entry entry;
+    entry.texture = CreateTextTexture(renderer, font, text, color);
+    entry.bytes = static_cast<std::size_t>(entry.texture.width) * static_cast<std::size_t>(entry.texture.height) * 4u;
+
+    Key key{font, std::string{text}, lookup.color};
+    entries_.emplace_front(key, std::move(entry));
+    index_.emplace(std::move(key), entries_.begin());
+    stats_.bytes += entries_.front().second.bytes;
+    stats_.entries = entries_.size();
+
+    const TextTexture& texture = entries_.front().second.texture;
+    return texture.texture ? &texture : nullptr;
+}
+
+void TextTextureCache::Trim()
+{
+    while (stats_.bytes > byteBudget_ && !entries_.empty())
+    {
+        auto& [key, entry] = entries_.back();
+        stats_.bytes -= entry.bytes;
+        index_.erase(key);
+        entries_.pop_back();
+        ++stats_.evictions;
+    }
+    stats_.entries = entries_.size();
+}
+
+void TextTextureCache::Clear()
+{
+    index_.clear();
+    entries_.clear();
+    stats_.bytes = 0;
+    stats_.entries = 0;
+}
+
+void TextTextureCache::ResetCounters() noexcept
+{
+    stats_.hits = 0;
+    stats_.misses = 0;
+    stats_.evictions = 0;
+}
+
+TextTextureCache& SharedTextTextureCache()
+{
+    static TextTextureCache cache;
+    return cache;
+}
+
+} // namespace colony
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "utils/text.hpp"
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace colony
+{
+
+struct TextTextureCacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+};
+
+// Rasterized labels keyed by (font, UTF-8 text, color). Acquire never evicts, so every
+// pointer handed out stays valid until the next Trim or Clear; Trim drops the least
+// recently used labels once the byte budget is exceeded.
+class TextTextureCache
+{
+  public:
+    static constexpr std::size_t kDefaultByteBudget = 16u * 1024u * 1024u;
+
+    explicit TextTextureCache(std::size_t byteBudget = kDefaultByteBudget) noexcept;
+    TextTextureCache(const TextTextureCache&) = delete;
+    TextTextureCache& operator=(const TextTextureCache&) = delete;
+
+    [[nodiscard]] const TextTexture* Acquire(
+        SDL_Renderer* renderer,
+        TTF_Font* font,
+        std::string_view text,
+        SDL_Color color);
+
+    void SetByteBudget(std::size_t byteBudget) noexcept { byteBudget_ = byteBudget; }
+    [[nodiscard]] std::size_t ByteBudget() const noexcept { return byteBudget_; }
+
+    void Trim();
+    void Clear();
+
+    [[nodiscard]] const TextTextureCacheStats& Stats() const noexcept { return stats_; }
+    void ResetCounters() noexcept;
+
+  private:
+    struct Key
+    {
+        TTF_Font* font = nullptr;
+        std::string text;
+        Uint32 color = 0;
+    };
+
+    struct KeyView
+    {
+        TTF_Font* font = nullptr;
+        std::string_view text;
+        Uint32 color = 0;
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(const KeyView& key) const noexcept;
+        std::size_t operator()(const Key& key) const noexcept;
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+        bool operator()(const KeyView& lhs, const Key& rhs) const noexcept;
+        bool operator()(const Key& lhs, const KeyView& rhs) const noexcept;
+        bool operator()(const Key& lhs, const Key& rhs) const noexcept;
+    };
+
+    struct Entry
+    {
+        TextTexture texture;
+        std::size_t bytes = 0;
+    };
+
+    using EntryList = std::list<std::pair<Key, Entry>>;
+
+    std::size_t byteBudget_ = kDefaultByteBudget;
+    EntryList entries_;
+    std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual> index_;
+    TextTextureCacheStats stats_{};
+};
+
+TextTextureCache& SharedTextTextureCache();
+
+} // namespace colony
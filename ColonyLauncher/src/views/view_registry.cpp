@@ -15,6 +15,25 @@ void ViewRegistry::Register(ViewPtr view)
     views_[id] = std::move(view);
 }
 
+void ViewRegistry::Unregister(std::string_view id)
+{
+    const auto it = views_.find(std::string{id});
+    if (it == views_.end())
+    {
+        return;
+    }
+    if (active_ == it->second.get())
+    {
+        DeactivateActive();
+    }
+    views_.erase(it);
+}
+
+bool ViewRegistry::Contains(std::string_view id) const
+{
+    return views_.find(std::string{id}) != views_.end();
+}
+
 void ViewRegistry::BindContent(const AppContent& content)
 {
     for (const auto& [id, viewContent] : content.views)
@@ -28,6 +47,14 @@ void ViewRegistry::BindContent(const AppContent& content)
     }
 }
 
+void ViewRegistry::BindContent(std::string_view id, const ViewContent& content)
+{
+    if (const auto it = views_.find(std::string{id}); it != views_.end())
+    {
+        it->second->BindContent(content);
+    }
+}
+
 View* ViewRegistry::Activate(std::string_view id, const RenderContext& context)
 {
     DeactivateActive();
@@ -14,7 +14,10 @@ class ViewRegistry
 {
   public:
     void Register(ViewPtr view);
+    void Unregister(std::string_view id);
+    [[nodiscard]] bool Contains(std::string_view id) const;
     void BindContent(const AppContent& content);
+    void BindContent(std::string_view id, const ViewContent& content);
 
     View* Activate(std::string_view id, const RenderContext& context);
     void DeactivateActive();
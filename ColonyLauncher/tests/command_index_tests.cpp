@@ -0,0 +1,97 @@
+#include "core/command_index.hpp"
+
+#include "doctest/doctest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+colony::CommandEntry MakeEntry(std::string title, std::string keywords = {})
+{
+    colony::CommandEntry entry;
+    entry.id = title;
+    entry.title = std::move(title);
+    entry.keywords = std::move(keywords);
+    return entry;
+}
+
+std::vector<std::string> Titles(const colony::CommandIndex& index, const std::vector<colony::CommandMatch>& matches)
+{
+    std::vector<std::string> titles;
+    for (const auto& match : matches)
+    {
+        titles.push_back(index.Entry(match.entryIndex).title);
+    }
+    return titles;
+}
+} // namespace
+
+TEST_CASE("ScoreFuzzyMatch prefers word starts and consecutive runs")
+{
+    CHECK(colony::ScoreFuzzyMatch("abc", "xaxbxc") != colony::kNoFuzzyMatch);
+    CHECK(colony::ScoreFuzzyMatch("abc", "acb") == colony::kNoFuzzyMatch);
+    CHECK(colony::ScoreFuzzyMatch("abcd", "abc") == colony::kNoFuzzyMatch);
+    CHECK(colony::ScoreFuzzyMatch("", "anything") == 0);
+
+    CHECK(colony::ScoreFuzzyMatch("term", "terminal") > colony::ScoreFuzzyMatch("term", "the rm tool"));
+    CHECK(colony::ScoreFuzzyMatch("ds", "dev studio") > colony::ScoreFuzzyMatch("ds", "fields"));
+    CHECK(colony::ScoreFuzzyMatch("set", "settings") > colony::ScoreFuzzyMatch("set", "asset store"));
+}
+
+TEST_CASE("CommandIndex ranks matches and narrows incrementally")
+{
+    colony::CommandIndex index;
+    index.Add(MakeEntry("Asset Store"));
+    index.Add(MakeEntry("Settings"));
+    index.Add(MakeEntry("Terminal", "dev shell"));
+    index.Add(MakeEntry("Sound Editor"));
+    CHECK(index.Size() == 4);
+
+    CHECK(Titles(index, index.Search("", 2)) == std::vector<std::string>{"Asset Store", "Settings"});
+    CHECK(Titles(index, index.Search("SET", 10)) == std::vector<std::string>{"Settings", "Sound Editor", "Asset Store"});
+    CHECK(Titles(index, index.Search("sett", 10)) == std::vector<std::string>{"Settings", "Asset Store"});
+    CHECK(Titles(index, index.Search("se", 10)).size() == 4);
+    CHECK(Titles(index, index.Search("s e", 1)).size() == 1);
+    CHECK(Titles(index, index.Search("shell", 10)) == std::vector<std::string>{"Terminal"});
+    CHECK(index.Search("zzz", 10).empty());
+
+    CHECK(index.Search("te", 10).size() == 2);
+    index.Add(MakeEntry("Text Tools"));
+    CHECK(Titles(index, index.Search("tex", 10)) == std::vector<std::string>{"Text Tools"});
+
+    index.Clear();
+    CHECK(index.Size() == 0);
+    CHECK(index.Search("set", 10).empty());
+}
+
+TEST_CASE("CommandIndex answers one-letter queries like a full scan")
+{
+    colony::CommandIndex index;
+    index.Add(MakeEntry("Sound Editor"));
+    index.Add(MakeEntry("Terminal", "dev shell"));
+    index.Add(MakeEntry("Asset Store"));
+    index.Add(MakeEntry("Text"));
+    index.Add(MakeEntry("x-ray 2"));
+
+    const auto matches = index.Search("T", 10);
+    CHECK(Titles(index, matches) == std::vector<std::string>{"Text", "Terminal", "Asset Store", "Sound Editor"});
+    CHECK(matches[0].score == colony::ScoreFuzzyMatch("t", "text"));
+    CHECK(matches[2].score == colony::ScoreFuzzyMatch("t", "asset store"));
+    CHECK(matches[3].score == colony::ScoreFuzzyMatch("t", "sound editor"));
+    CHECK(Titles(index, index.Search("t", 2)) == std::vector<std::string>{"Text", "Terminal"});
+
+    // Keyword-only matches rank below title matches; the result still narrows by the next letter.
+    CHECK(Titles(index, index.Search("h", 10)) == std::vector<std::string>{"Terminal"});
+    CHECK(index.Search("h", 10)[0].score < colony::ScoreFuzzyMatch("h", "dev shell"));
+    CHECK(Titles(index, index.Search("he", 10)) == std::vector<std::string>{"Terminal"});
+
+    CHECK(Titles(index, index.Search("2", 10)) == std::vector<std::string>{"x-ray 2"});
+    CHECK(Titles(index, index.Search("-", 10)) == std::vector<std::string>{"x-ray 2"});
+    CHECK(index.Search("q", 10).empty());
+
+    index.Clear();
+    index.Add(MakeEntry("Queue"));
+    CHECK(Titles(index, index.Search("t", 10)).empty());
+    CHECK(Titles(index, index.Search("q", 10)) == std::vector<std::string>{"Queue"});
+}
@@ -7,8 +7,10 @@
 #include "app/application.h"
 #undef private
 #include "utils/color.hpp"
+#include "utils/render_layer.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -295,6 +297,109 @@ TEST_CASE("RenderVerticalGradient draws within bounds")
     SDL_Quit();
 }
 
+TEST_CASE("RenderGradient supports horizontal multi-stop gradients")
+{
+    REQUIRE(SDL_Init(SDL_INIT_VIDEO) == 0);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 8, 2, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    const std::array<colony::color::GradientStop, 3> stops{{
+        {0.0f, SDL_Color{255, 0, 0, 255}},
+        {0.5f, SDL_Color{0, 255, 0, 255}},
+        {1.0f, SDL_Color{0, 0, 255, 255}},
+    }};
+    const SDL_Rect area{0, 0, 8, 2};
+    colony::color::RenderGradient(renderer, area, stops, colony::color::GradientDirection::Horizontal);
+    SDL_RenderPresent(renderer);
+
+    auto getColor = [&](int x, int y) {
+        Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+        const int pitch = surface->pitch / static_cast<int>(sizeof(Uint32));
+        SDL_Color color{};
+        SDL_GetRGBA(pixels[y * pitch + x], surface->format, &color.r, &color.g, &color.b, &color.a);
+        return color;
+    };
+
+    const SDL_Color left = getColor(0, 1);
+    const SDL_Color middle = getColor(4, 1);
+    const SDL_Color right = getColor(7, 1);
+    CHECK(left.r > left.b);
+    CHECK(middle.g > middle.r);
+    CHECK(middle.g > middle.b);
+    CHECK(right.b > right.r);
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+}
+
+TEST_CASE("RenderLayer keys and fallback drawing")
+{
+    const SDL_Rect bounds{0, 0, 8, 8};
+    const auto keyFor = [&](int hovered, std::string_view language) {
+        colony::RenderLayerKey key;
+        key.Add(bounds).Add(hovered).Add(language).Add(SDL_Color{10, 20, 30, 255});
+        return key.Value();
+    };
+    CHECK(keyFor(1, "en") == keyFor(1, "en"));
+    CHECK(keyFor(1, "en") != keyFor(2, "en"));
+    CHECK(keyFor(1, "en") != keyFor(1, "fr"));
+    CHECK(colony::RenderLayerKey{}.Add(1).Add(2).Value() != colony::RenderLayerKey{}.Add(2).Add(1).Value());
+
+    REQUIRE(SDL_Init(SDL_INIT_VIDEO) == 0);
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 8, 8, 32, SDL_PIXELFORMAT_RGBA32);
+    REQUIRE(surface != nullptr);
+
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    REQUIRE(renderer != nullptr);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(renderer);
+
+    // Whatever the renderer supports, a first pass draws and the output reaches the surface.
+    colony::RenderLayer layer;
+    const auto pass = layer.Begin(renderer, bounds, keyFor(0, "en"));
+    REQUIRE(pass != colony::RenderLayer::Pass::Reuse);
+    SDL_SetRenderDrawColor(renderer, 0, 200, 0, SDL_ALPHA_OPAQUE);
+    const SDL_Rect fill{2, 2, 4, 4};
+    SDL_RenderFillRect(renderer, &fill);
+    layer.End();
+    SDL_RenderPresent(renderer);
+
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    const int pitch = surface->pitch / static_cast<int>(sizeof(Uint32));
+    SDL_Color inside{};
+    SDL_GetRGBA(pixels[3 * pitch + 3], surface->format, &inside.r, &inside.g, &inside.b, &inside.a);
+    SDL_Color outside{};
+    SDL_GetRGBA(pixels[0], surface->format, &outside.r, &outside.g, &outside.b, &outside.a);
+    CHECK(inside.g == 200);
+    CHECK(outside.g == 0);
+
+    if (pass == colony::RenderLayer::Pass::Draw)
+    {
+        CHECK(layer.Begin(renderer, bounds, keyFor(0, "en")) == colony::RenderLayer::Pass::Reuse);
+        layer.End();
+        CHECK(layer.Begin(renderer, bounds, keyFor(1, "en")) == colony::RenderLayer::Pass::Draw);
+        layer.End();
+        colony::RenderLayer::InvalidateAll();
+        CHECK(layer.Begin(renderer, bounds, keyFor(1, "en")) == colony::RenderLayer::Pass::Draw);
+        layer.End();
+    }
+
+    layer.Release();
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+}
+
 TEST_CASE("LoadContentFromFile validates user section")
 {
     SUBCASE("user field must be an object")
@@ -739,6 +844,10 @@ TEST_CASE("LoadContentFromFile validates channels")
             colony::LoadContentFromFile(path.string()),
             doctest::Contains("Content file must declare at least one channel."),
             std::runtime_error);
+
+        const auto content = colony::LoadContentFromFile(path.string(), true);
+        CHECK(content.channels.empty());
+        CHECK(content.views.contains("PROGRAM"));
     }
 
     SUBCASE("channels may not reference unknown program ids")
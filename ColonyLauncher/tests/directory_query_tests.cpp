@@ -0,0 +1,174 @@
+#include "core/directory_query.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+using colony::test::WriteFile;
+
+colony::DirectoryQuery MakeQuery(const std::filesystem::path& directory, std::string search, colony::DirectoryQuerySort sort)
+{
+    colony::DirectoryQuery query;
+    query.directory = directory;
+    query.search = std::move(search);
+    query.sort = sort;
+    return query;
+}
+
+// Collects a query's results the way the dialog does, a bounded batch at a time.
+colony::DirectoryQueryResults WaitForResults(colony::AsyncDirectoryQuery& query)
+{
+    colony::DirectoryQueryResults collected;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        auto batch = query.TakeResults(2);
+        for (auto& entry : batch.entries)
+        {
+            collected.entries.push_back(std::move(entry));
+        }
+        if (batch.finished)
+        {
+            collected.finished = true;
+            collected.error = batch.error;
+            collected.enumeratedAny = batch.enumeratedAny;
+            collected.filtered = batch.filtered;
+            return collected;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return collected;
+}
+
+std::vector<std::string> Labels(const colony::DirectoryQueryResults& results)
+{
+    std::vector<std::string> labels;
+    for (const auto& entry : results.entries)
+    {
+        labels.push_back(entry.label);
+    }
+    return labels;
+}
+} // namespace
+
+TEST_CASE("AsyncDirectoryQuery lists directories first in the requested order")
+{
+    const auto root = GenerateUniqueTempPath("colony-query");
+    std::filesystem::create_directories(root / "Beta");
+    std::filesystem::create_directories(root / "alpha");
+    WriteFile(root / "b.sh");
+    WriteFile(root / "A.py");
+    WriteFile(root / "c.txt");
+
+    colony::AsyncDirectoryQuery query;
+    query.Start(MakeQuery(root, "", colony::DirectoryQuerySort::NameAscending), nullptr);
+    auto results = WaitForResults(query);
+    REQUIRE(results.finished);
+    CHECK(results.error == colony::DirectoryQueryResults::Error::None);
+    CHECK(results.enumeratedAny);
+    CHECK_FALSE(results.filtered);
+    CHECK(Labels(results) == std::vector<std::string>{"alpha/", "Beta/", "A.py", "b.sh", "c.txt"});
+    CHECK_FALSE(query.IsActive());
+
+    query.Start(MakeQuery(root, "", colony::DirectoryQuerySort::NameDescending), nullptr);
+    results = WaitForResults(query);
+    CHECK(Labels(results) == std::vector<std::string>{"Beta/", "alpha/", "c.txt", "b.sh", "A.py"});
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("AsyncDirectoryQuery applies the search text and type filter")
+{
+    const auto root = GenerateUniqueTempPath("colony-query");
+    std::filesystem::create_directories(root / "scripts");
+    WriteFile(root / "Setup.SH");
+    WriteFile(root / "setup.txt");
+    WriteFile(root / "other.sh");
+
+    colony::DirectoryQuery request = MakeQuery(root, "SET", colony::DirectoryQuerySort::NameAscending);
+    request.typeFilter.extensions = {".sh"};
+    request.typeFilter.includeDirectories = false;
+
+    colony::AsyncDirectoryQuery query;
+    query.Start(request, nullptr);
+    auto results = WaitForResults(query);
+    REQUIRE(results.finished);
+    CHECK(results.filtered);
+    CHECK(Labels(results) == std::vector<std::string>{"Setup.SH"});
+
+    request.search = "missing";
+    query.Start(request, nullptr);
+    results = WaitForResults(query);
+    REQUIRE(results.finished);
+    CHECK(results.entries.empty());
+    CHECK(results.enumeratedAny);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("AsyncDirectoryQuery reports a missing directory")
+{
+    colony::AsyncDirectoryQuery query;
+    query.Start(MakeQuery(GenerateUniqueTempPath("colony-query"), "", colony::DirectoryQuerySort::NameAscending), nullptr);
+    const auto results = WaitForResults(query);
+    REQUIRE(results.finished);
+    CHECK(results.error == colony::DirectoryQueryResults::Error::DirectoryUnavailable);
+    CHECK(results.entries.empty());
+}
+
+TEST_CASE("AsyncDirectoryQuery drops the results of a replaced query")
+{
+    const auto first = GenerateUniqueTempPath("colony-query");
+    const auto second = GenerateUniqueTempPath("colony-query");
+    std::filesystem::create_directories(first);
+    std::filesystem::create_directories(second);
+    for (int index = 0; index < 200; ++index)
+    {
+        WriteFile(first / ("old-" + std::to_string(index)));
+    }
+    WriteFile(second / "new");
+
+    colony::AsyncDirectoryQuery query;
+    query.Start(MakeQuery(first, "", colony::DirectoryQuerySort::NameAscending), nullptr);
+    query.Start(MakeQuery(second, "", colony::DirectoryQuerySort::NameAscending), nullptr);
+    const auto results = WaitForResults(query);
+    REQUIRE(results.finished);
+    CHECK(Labels(results) == std::vector<std::string>{"new"});
+
+    query.Cancel();
+    CHECK_FALSE(query.IsActive());
+    CHECK(query.TakeResults(16).entries.empty());
+
+    std::filesystem::remove_all(first);
+    std::filesystem::remove_all(second);
+}
+
+TEST_CASE("DirectoryQueryLess orders by rank, then write time, keeping untimed entries together")
+{
+    using Key = colony::DirectoryQuerySortKey;
+    const auto now = std::filesystem::file_time_type::clock::now();
+    const Key older{0, false, "a", "a", now - std::chrono::hours{1}};
+    const Key newer{0, false, "b", "b", now};
+    const Key untimed{0, false, "c", "c", std::nullopt};
+    const Key folder{0, true, "z", "z", std::nullopt};
+
+    CHECK(colony::DirectoryQueryLess(newer, older, colony::DirectoryQuerySort::NewestFirst));
+    CHECK(colony::DirectoryQueryLess(older, newer, colony::DirectoryQuerySort::OldestFirst));
+    CHECK(colony::DirectoryQueryLess(newer, untimed, colony::DirectoryQuerySort::NewestFirst));
+    CHECK(colony::DirectoryQueryLess(untimed, older, colony::DirectoryQuerySort::OldestFirst));
+    CHECK(colony::DirectoryQueryLess(folder, newer, colony::DirectoryQuerySort::NewestFirst));
+    CHECK(colony::DirectoryQueryLess(older, newer, colony::DirectoryQuerySort::NameAscending));
+
+    const Key ranked{colony::PathIndex::kRankExactName, false, "y", "y", std::nullopt};
+    const Key unranked{colony::PathIndex::kRankPathContains, true, "a", "a", std::nullopt};
+    CHECK(colony::DirectoryQueryLess(ranked, unranked, colony::DirectoryQuerySort::NameAscending));
+}
@@ -0,0 +1,89 @@
+#include "core/directory_walker.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+using colony::test::WriteExecutableFile;
+using colony::test::WriteFile;
+
+const colony::DirectoryEntryInfo* FindEntry(const std::vector<colony::DirectoryEntryInfo>& entries, std::string_view name)
+{
+    const auto it = std::find_if(entries.begin(), entries.end(), [&](const auto& entry) { return entry.name == name; });
+    return it != entries.end() ? &*it : nullptr;
+}
+} // namespace
+
+TEST_CASE("ListDirectory reports types, executables and write times")
+{
+    const auto root = GenerateUniqueTempPath("colony-walker");
+    std::filesystem::create_directories(root / "nested");
+    WriteExecutableFile(root / "run.sh");
+    WriteFile(root / "notes.txt");
+
+    std::error_code ec;
+    const auto typesOnly = colony::ListDirectory(root, colony::DirectoryWalkOptions{}, ec);
+    REQUIRE_FALSE(ec);
+    REQUIRE(typesOnly.size() == 3);
+    REQUIRE(FindEntry(typesOnly, "nested") != nullptr);
+    CHECK(FindEntry(typesOnly, "nested")->type == colony::DirectoryEntryType::Directory);
+    CHECK(FindEntry(typesOnly, "run.sh")->type == colony::DirectoryEntryType::Regular);
+    CHECK_FALSE(FindEntry(typesOnly, "run.sh")->hasLastWriteTime);
+
+    const auto detailed = colony::ListDirectory(root, {.executable = true, .lastWriteTime = true}, ec);
+    REQUIRE_FALSE(ec);
+    const auto* script = FindEntry(detailed, "run.sh");
+    REQUIRE(script != nullptr);
+    CHECK(script->isExecutable);
+    CHECK_FALSE(FindEntry(detailed, "notes.txt")->isExecutable);
+    CHECK(script->hasLastWriteTime);
+    CHECK(script->lastWriteTime == std::filesystem::last_write_time(root / "run.sh"));
+
+    colony::ListDirectory(root / "missing", colony::DirectoryWalkOptions{}, ec);
+    CHECK(ec);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("WalkDirectoryTree visits nested entries without following directory links")
+{
+    const auto root = GenerateUniqueTempPath("colony-walker");
+    std::filesystem::create_directories(root / "a" / "b");
+    WriteExecutableFile(root / "a" / "b" / "deep.sh");
+    std::filesystem::create_directory_symlink(root / "a", root / "loop");
+
+    std::vector<std::filesystem::path> visited;
+    colony::WalkDirectoryTree(root, colony::DirectoryWalkOptions{}, [&](const auto& parent, auto& entry) {
+        visited.push_back(parent / entry.name);
+        if (entry.name == "deep.sh")
+        {
+            colony::ResolveEntryMetadata(parent, {.executable = true}, entry);
+            CHECK(entry.isExecutable);
+        }
+        if (entry.name == "loop")
+        {
+            CHECK(entry.isSymlink);
+            CHECK(entry.type == colony::DirectoryEntryType::Directory);
+        }
+        return true;
+    });
+
+    std::sort(visited.begin(), visited.end());
+    const std::vector<std::filesystem::path> expected{
+        root / "a", root / "a" / "b", root / "a" / "b" / "deep.sh", root / "loop"};
+    CHECK(visited == expected);
+
+    int count = 0;
+    colony::WalkDirectoryTree(root, colony::DirectoryWalkOptions{}, [&](const auto&, auto&) { return ++count < 2; });
+    CHECK(count == 2);
+
+    std::filesystem::remove_all(root);
+}
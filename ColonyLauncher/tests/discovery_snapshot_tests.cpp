@@ -0,0 +1,94 @@
+#include "core/discovery_snapshot.hpp"
+#include "core/filesystem_discovery.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+using colony::test::WriteFile;
+
+const colony::FolderChannelSpec kGamesSpec{"games", "Games", "Games"};
+} // namespace
+
+TEST_CASE("DiscoverySnapshot round-trips through its file")
+{
+    const auto root = GenerateUniqueTempPath("colony-snapshot");
+    std::filesystem::create_directories(root);
+    const auto snapshotPath = root / "discovery_snapshot.txt";
+
+    colony::DiscoverySnapshot snapshot;
+    CHECK(snapshot.Load(snapshotPath));
+    snapshot.Store(
+        "/modules/Games",
+        colony::SnapshotChannelFolder{42, {{"orbit racer", 7, "race.py", true}, {"tab\tname", 9, "", false}}});
+    REQUIRE(snapshot.Save(snapshotPath));
+
+    colony::DiscoverySnapshot reloaded;
+    REQUIRE(reloaded.Load(snapshotPath));
+    const auto channel = reloaded.Find("/modules/Games");
+    REQUIRE(channel.has_value());
+    CHECK(channel->mtime == 42);
+    REQUIRE(channel->programs.size() == 1);
+    CHECK(channel->programs.front().folderName == "orbit racer");
+    CHECK(channel->programs.front().mtime == 7);
+    CHECK(channel->programs.front().launchTarget == "race.py");
+    CHECK(channel->programs.front().isPythonScript);
+    CHECK_FALSE(reloaded.Find("/modules/Apps").has_value());
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("Discovery reuses snapshot entries only while folder mtimes match")
+{
+    const auto root = GenerateUniqueTempPath("colony-snapshot");
+    const auto modulesRoot = root / "Modules";
+    const auto programFolder = modulesRoot / "Games" / "orbit";
+    std::filesystem::create_directories(programFolder);
+    WriteFile(programFolder / "run.sh");
+
+    colony::DiscoverySnapshot snapshot;
+    const auto cold = colony::DiscoverChannelFromFilesystem(
+        modulesRoot, kGamesSpec, std::chrono::steady_clock::time_point::max(), nullptr, &snapshot);
+    REQUIRE(cold.programs.size() == 1);
+    CHECK(cold.programs.front().launchTarget.filename() == "run.sh");
+
+    // Rewrite the recorded launch target; a warm scan that trusts the snapshot reports it
+    // without listing the program folder.
+    auto recorded = snapshot.Find(modulesRoot / "Games");
+    REQUIRE(recorded.has_value());
+    REQUIRE(recorded->programs.size() == 1);
+    recorded->programs.front().launchTarget = "cached.sh";
+    snapshot.Store(modulesRoot / "Games", *recorded);
+
+    const auto warm = colony::DiscoverChannelFromFilesystem(
+        modulesRoot, kGamesSpec, std::chrono::steady_clock::time_point::max(), nullptr, &snapshot);
+    REQUIRE(warm.programs.size() == 1);
+    CHECK(warm.programs.front().launchTarget == programFolder / "cached.sh");
+    CHECK(warm.programs.front().programId == cold.programs.front().programId);
+    CHECK(warm.programs.front().view.heading == cold.programs.front().view.heading);
+
+    // A changed folder mtime means the recorded target can no longer be trusted.
+    std::filesystem::last_write_time(
+        programFolder, std::filesystem::last_write_time(programFolder) + std::chrono::seconds{5});
+    const auto rescanned = colony::DiscoverChannelFromFilesystem(
+        modulesRoot, kGamesSpec, std::chrono::steady_clock::time_point::max(), nullptr, &snapshot);
+    REQUIRE(rescanned.programs.size() == 1);
+    CHECK(rescanned.programs.front().launchTarget.filename() == "run.sh");
+
+    // A new program folder changes the channel folder mtime, so the channel is listed again.
+    std::filesystem::create_directories(modulesRoot / "Games" / "nova");
+    std::filesystem::last_write_time(
+        modulesRoot / "Games", std::filesystem::last_write_time(modulesRoot / "Games") + std::chrono::seconds{5});
+    const auto grown = colony::DiscoverChannelFromFilesystem(
+        modulesRoot, kGamesSpec, std::chrono::steady_clock::time_point::max(), nullptr, &snapshot);
+    CHECK(grown.programs.size() == 2);
+
+    std::filesystem::remove_all(root);
+}
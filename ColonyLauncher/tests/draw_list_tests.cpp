@@ -0,0 +1,199 @@
+#include "utils/draw_list.hpp"
+
+#include "doctest/doctest.h"
+#include "utils/sdl_wrappers.hpp"
+
+#include <SDL2/SDL.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+constexpr int kCanvasWidth = 64;
+constexpr int kCanvasHeight = 32;
+
+constexpr SDL_Color kBlack{0, 0, 0, SDL_ALPHA_OPAQUE};
+constexpr SDL_Color kRed{255, 0, 0, SDL_ALPHA_OPAQUE};
+constexpr SDL_Color kGreen{0, 255, 0, SDL_ALPHA_OPAQUE};
+constexpr SDL_Color kBlue{0, 0, 255, SDL_ALPHA_OPAQUE};
+
+// An ARGB8888 surface behind a software renderer, read back one pixel at a time.
+class SoftwareCanvas
+{
+  public:
+    SoftwareCanvas()
+        : surface_(SDL_CreateRGBSurfaceWithFormat(0, kCanvasWidth, kCanvasHeight, 32, SDL_PIXELFORMAT_ARGB8888))
+    {
+        if (surface_ != nullptr)
+        {
+            renderer_.reset(SDL_CreateSoftwareRenderer(surface_));
+        }
+    }
+
+    SoftwareCanvas(const SoftwareCanvas&) = delete;
+    SoftwareCanvas& operator=(const SoftwareCanvas&) = delete;
+
+    ~SoftwareCanvas()
+    {
+        colony::DrawList::ReleaseSharedResources(renderer_.get());
+        renderer_.reset();
+        SDL_FreeSurface(surface_);
+    }
+
+    [[nodiscard]] SDL_Renderer* Renderer() const noexcept { return renderer_.get(); }
+
+    void Clear(SDL_Color color)
+    {
+        SDL_SetRenderDrawColor(renderer_.get(), color.r, color.g, color.b, color.a);
+        SDL_RenderClear(renderer_.get());
+    }
+
+    // 0xAARRGGBB.
+    [[nodiscard]] std::uint32_t Pixel(int x, int y) const
+    {
+        const SDL_Rect rect{x, y, 1, 1};
+        Uint32 pixel = 0;
+        SDL_RenderReadPixels(renderer_.get(), &rect, SDL_PIXELFORMAT_ARGB8888, &pixel, sizeof(pixel));
+        return pixel;
+    }
+
+  private:
+    SDL_Surface* surface_ = nullptr;
+    colony::sdl::RendererHandle renderer_;
+};
+
+// Blitters round modulation and blending differently; allow a couple of steps per channel.
+bool IsNear(std::uint32_t pixel, SDL_Color expected)
+{
+    const auto channel = [pixel](int shift) { return static_cast<int>((pixel >> shift) & 0xFF); };
+    return std::abs(channel(16) - expected.r) <= 2 && std::abs(channel(8) - expected.g) <= 2
+        && std::abs(channel(0) - expected.b) <= 2 && std::abs(channel(24) - expected.a) <= 2;
+}
+} // namespace
+
+TEST_CASE("DrawList merges across blend-mode changes only past nothing it overlaps")
+{
+    SoftwareCanvas canvas;
+    REQUIRE(canvas.Renderer() != nullptr);
+    canvas.Clear(kBlack);
+    SDL_SetRenderDrawBlendMode(canvas.Renderer(), SDL_BLENDMODE_NONE);
+
+    colony::DrawList list{canvas.Renderer()};
+    list.FillRect(SDL_Rect{0, 0, 8, 8}, kRed);
+    list.SetBlendMode(SDL_BLENDMODE_ADD);
+    list.FillRect(SDL_Rect{16, 0, 8, 8}, kGreen);
+    list.SetBlendMode(SDL_BLENDMODE_BLEND);
+    // Clear of the additive fill, so it joins the first batch.
+    list.FillRect(SDL_Rect{32, 0, 8, 8}, kBlue);
+    list.Flush();
+
+    CHECK(list.Stats().commands == 3);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    CHECK(list.Stats().batches == 2);
+    CHECK(list.Stats().drawCalls == 2);
+#endif
+    CHECK(IsNear(canvas.Pixel(4, 4), kRed));
+    CHECK(IsNear(canvas.Pixel(20, 4), kGreen));
+    CHECK(IsNear(canvas.Pixel(36, 4), kBlue));
+
+    SDL_BlendMode restored = SDL_BLENDMODE_BLEND;
+    SDL_GetRenderDrawBlendMode(canvas.Renderer(), &restored);
+    CHECK(restored == SDL_BLENDMODE_NONE);
+
+    // Overlapping the additive fill, the last fill has to come after it.
+    list.ResetStats();
+    list.FillRect(SDL_Rect{0, 16, 8, 8}, kRed);
+    list.SetBlendMode(SDL_BLENDMODE_ADD);
+    list.FillRect(SDL_Rect{4, 16, 8, 8}, kGreen);
+    list.SetBlendMode(SDL_BLENDMODE_BLEND);
+    list.FillRect(SDL_Rect{8, 16, 8, 8}, kBlue);
+    list.Flush();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    CHECK(list.Stats().batches == 3);
+#endif
+    CHECK(IsNear(canvas.Pixel(2, 20), kRed));
+    CHECK(IsNear(canvas.Pixel(5, 20), SDL_Color{255, 255, 0, SDL_ALPHA_OPAQUE}));
+    CHECK(IsNear(canvas.Pixel(9, 20), kBlue));
+    CHECK(IsNear(canvas.Pixel(13, 20), kBlue));
+}
+
+TEST_CASE("DrawList draws rounded rects opaque under SDL_BLENDMODE_NONE")
+{
+    SoftwareCanvas canvas;
+    REQUIRE(canvas.Renderer() != nullptr);
+    canvas.Clear(kRed);
+
+    colony::DrawList list{canvas.Renderer()};
+    list.SetBlendMode(SDL_BLENDMODE_NONE);
+    list.FillRoundedRect(SDL_Rect{0, 0, 32, 32}, 8, SDL_Color{0, 0, 255, 128});
+    list.DrawRoundedRect(SDL_Rect{32, 0, 32, 32}, 8, kBlue);
+    list.Flush();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // Straight parts and anti-aliased corners come from the same atlas, so one batch.
+    CHECK(list.Stats().batches == 1);
+#endif
+    CHECK(list.BlendMode() == SDL_BLENDMODE_NONE);
+
+    // The fill replaces what was there, at full alpha; corners outside the arc are untouched.
+    CHECK(IsNear(canvas.Pixel(16, 16), kBlue));
+    CHECK(IsNear(canvas.Pixel(0, 16), kBlue));
+    CHECK(IsNear(canvas.Pixel(16, 31), kBlue));
+    CHECK(IsNear(canvas.Pixel(0, 0), kRed));
+    CHECK(IsNear(canvas.Pixel(31, 31), kRed));
+
+    // The outline leaves its inside alone.
+    CHECK(IsNear(canvas.Pixel(32, 16), kBlue));
+    CHECK(IsNear(canvas.Pixel(48, 0), kBlue));
+    CHECK(IsNear(canvas.Pixel(48, 16), kRed));
+    CHECK(IsNear(canvas.Pixel(32, 0), kRed));
+}
+
+TEST_CASE("DrawList draws textures with the mods they had when recorded")
+{
+    SoftwareCanvas canvas;
+    REQUIRE(canvas.Renderer() != nullptr);
+    canvas.Clear(kBlack);
+
+    colony::sdl::TextureHandle texture{
+        SDL_CreateTexture(canvas.Renderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 2, 2)};
+    REQUIRE(texture);
+    const Uint32 white[4] = {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu};
+    REQUIRE(SDL_UpdateTexture(texture.get(), nullptr, white, 2 * sizeof(Uint32)) == 0);
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+    colony::DrawList list{canvas.Renderer()};
+    SDL_SetTextureColorMod(texture.get(), 0, 255, 0);
+    list.DrawTexture(texture.get(), nullptr, SDL_Rect{0, 0, 8, 8});
+    SDL_SetTextureColorMod(texture.get(), 255, 0, 0);
+    SDL_SetTextureAlphaMod(texture.get(), 128);
+    list.DrawTexture(texture.get(), nullptr, SDL_Rect{16, 0, 8, 8});
+
+    // Changed after recording: neither draw sees it, and Flush leaves it in place.
+    SDL_SetTextureColorMod(texture.get(), 0, 0, 255);
+    SDL_SetTextureAlphaMod(texture.get(), 255);
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_ADD);
+    list.Flush();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    CHECK(list.Stats().batches == 1);
+#endif
+    CHECK(IsNear(canvas.Pixel(4, 4), kGreen));
+    CHECK(IsNear(canvas.Pixel(20, 4), SDL_Color{128, 0, 0, SDL_ALPHA_OPAQUE}));
+
+    Uint8 r = 0;
+    Uint8 g = 0;
+    Uint8 b = 0;
+    Uint8 a = 0;
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetTextureColorMod(texture.get(), &r, &g, &b);
+    SDL_GetTextureAlphaMod(texture.get(), &a);
+    SDL_GetTextureBlendMode(texture.get(), &blendMode);
+    CHECK(r == 0);
+    CHECK(g == 0);
+    CHECK(b == 255);
+    CHECK(a == 255);
+    CHECK(blendMode == SDL_BLENDMODE_ADD);
+}
@@ -1,12 +1,18 @@
+#include "core/async_channel_discovery.hpp"
+#include "core/discovery_watcher.hpp"
 #include "core/filesystem_discovery.hpp"
 
 #include "doctest/doctest.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <stdexcept>
 #include <random>
 #include <string_view>
+#include <thread>
 
 namespace
 {
@@ -114,3 +120,162 @@ TEST_CASE("Folders outside Nexus Modules are ignored")
     CHECK(channels.front().programs.front().programId == "PROGRAMS_DELTA");
 }
 
+
+TEST_CASE("Channel discovery stops at its deadline and reports a partial channel")
+{
+    const auto root = GenerateUniqueTempPath("colony-fs-root");
+    const auto modulesRoot = root / "Modules";
+    const auto appFolder = modulesRoot / "Applications" / "slow-mount";
+    std::filesystem::create_directories(appFolder);
+    WriteExecutableFile(appFolder / "launch.sh");
+
+    const colony::FolderChannelSpec spec{"applications", "Applications", "Applications"};
+
+    const auto expired = colony::DiscoverChannelFromFilesystem(
+        modulesRoot, spec, std::chrono::steady_clock::now() - std::chrono::seconds{1});
+    CHECK(expired.id == "applications");
+    CHECK_FALSE(expired.complete);
+    CHECK(expired.programs.empty());
+
+    const std::atomic<bool> cancelled{true};
+    const auto cancelledChannel =
+        colony::DiscoverChannelFromFilesystem(modulesRoot, spec, std::chrono::steady_clock::time_point::max(), &cancelled);
+    CHECK_FALSE(cancelledChannel.complete);
+
+    const auto finished = colony::DiscoverChannelFromFilesystem(modulesRoot, spec);
+    CHECK(finished.complete);
+    CHECK(finished.programs.size() == 1);
+}
+
+TEST_CASE("AsyncChannelDiscovery delivers every channel and notifies per result")
+{
+    const auto root = GenerateUniqueTempPath("colony-fs-root");
+    const auto modulesRoot = root / "Modules";
+    std::filesystem::create_directories(modulesRoot / "Applications" / "alpha");
+    std::filesystem::create_directories(modulesRoot / "Games" / "beta");
+    WriteExecutableFile(modulesRoot / "Applications" / "alpha" / "run.sh");
+    WriteExecutableFile(modulesRoot / "Games" / "beta" / "run.sh");
+
+    std::atomic<int> notifications{0};
+    colony::AsyncChannelDiscovery discovery;
+    discovery.Start(
+        modulesRoot,
+        {{"applications", "Applications", "Applications"}, {"games", "Games", "Games"}, {"addons", "Addons", "Addons"}},
+        std::chrono::seconds{10},
+        [&notifications]() { ++notifications; });
+
+    std::vector<colony::DiscoveredChannel> channels;
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (channels.size() < 3 && std::chrono::steady_clock::now() < giveUp)
+    {
+        for (auto& channel : discovery.TakeResults())
+        {
+            channels.push_back(std::move(channel));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    REQUIRE(channels.size() == 3);
+    CHECK(notifications.load() == 3);
+    CHECK_FALSE(discovery.IsRunning());
+
+    std::sort(channels.begin(), channels.end(), [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+    CHECK(channels[0].id == "addons");
+    CHECK(channels[0].programs.empty());
+    CHECK(channels[1].id == "applications");
+    CHECK(channels[1].programs.size() == 1);
+    CHECK(channels[2].id == "games");
+    CHECK(channels[2].complete);
+
+    discovery.Cancel();
+    CHECK(discovery.TakeResults().empty());
+}
+
+#if defined(__linux__)
+TEST_CASE("DiscoveryWatcher reports programs added to and removed from a channel folder")
+{
+    const auto root = GenerateUniqueTempPath("colony-fs-root");
+    const auto modulesRoot = root / "Modules";
+    const auto gamesFolder = modulesRoot / "Games";
+    std::filesystem::create_directories(gamesFolder);
+
+    std::atomic<int> notifications{0};
+    colony::DiscoveryWatcher watcher;
+    REQUIRE(watcher.Start(modulesRoot, {{"games", "Games", "Games"}}, [&notifications]() { ++notifications; }));
+
+    const auto waitForChanges = [&watcher]() {
+        std::vector<colony::DiscoveryChange> changes;
+        const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (changes.empty() && std::chrono::steady_clock::now() < giveUp)
+        {
+            changes = watcher.TakeChanges();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        return changes;
+    };
+
+    // The watcher lists the channel folders on its own thread; give it a moment before the
+    // first change so the new folder is seen through an event rather than the initial listing.
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    const auto programFolder = gamesFolder / "orbit-racer";
+    std::filesystem::create_directories(programFolder);
+    WriteExecutableFile(programFolder / "race.sh");
+
+    auto changes = waitForChanges();
+    REQUIRE_FALSE(changes.empty());
+    const auto& added = changes.back();
+    CHECK(added.kind == colony::DiscoveryChange::Kind::Upsert);
+    CHECK(added.channelId == "games");
+    CHECK(added.programId == "GAMES_ORBIT_RACER");
+    CHECK(added.program.launchTarget.filename() == "race.sh");
+    CHECK(notifications.load() >= 1);
+
+    std::filesystem::remove_all(programFolder);
+    changes = waitForChanges();
+    REQUIRE_FALSE(changes.empty());
+    CHECK(changes.back().kind == colony::DiscoveryChange::Kind::Remove);
+    CHECK(changes.back().programId == "GAMES_ORBIT_RACER");
+
+    watcher.Stop();
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("DiscoveryWatcher picks up a channel folder that appears after Start")
+{
+    const auto root = GenerateUniqueTempPath("colony-fs-root");
+    const auto modulesRoot = root / "Modules";
+    std::filesystem::create_directories(modulesRoot);
+
+    std::atomic<int> notifications{0};
+    colony::DiscoveryWatcher watcher;
+    REQUIRE(watcher.Start(modulesRoot, {{"games", "Games", "Games"}}, [&notifications]() { ++notifications; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    // A channel folder moved in whole already holds its programs; none of them raise events.
+    const auto staging = root / "staging";
+    std::filesystem::create_directories(staging / "orbit-racer");
+    WriteExecutableFile(staging / "orbit-racer" / "race.sh");
+    std::filesystem::rename(staging, modulesRoot / "Games");
+
+    std::vector<colony::DiscoveryChange> changes;
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (changes.empty() && std::chrono::steady_clock::now() < giveUp)
+    {
+        changes = watcher.TakeChanges();
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    REQUIRE(changes.size() == 1);
+    CHECK(changes.front().kind == colony::DiscoveryChange::Kind::Upsert);
+    CHECK(changes.front().programId == "GAMES_ORBIT_RACER");
+
+    // Nothing is reported once Stop returns.
+    watcher.Stop();
+    const int notified = notifications.load();
+    std::filesystem::remove_all(modulesRoot / "Games");
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+    CHECK(watcher.TakeChanges().empty());
+    CHECK(notifications.load() == notified);
+
+    std::filesystem::remove_all(root);
+}
+#endif
@@ -0,0 +1,38 @@
+#include "app/frame_scheduler.hpp"
+
+#include "doctest/doctest.h"
+
+TEST_CASE("FrameScheduler paces renders to the target frame rate")
+{
+    colony::FrameScheduler scheduler;
+    scheduler.SetTargetFrameRate(30);
+    scheduler.Reset(10.0);
+
+    CHECK(scheduler.IsRenderDue(10.0));
+    CHECK(scheduler.MarkRendered(10.0) == doctest::Approx(0.0));
+
+    CHECK_FALSE(scheduler.IsRenderDue(10.01));
+    CHECK(scheduler.SecondsUntilRenderDue(10.01) == doctest::Approx(1.0 / 30.0 - 0.01));
+    CHECK(scheduler.IsRenderDue(10.0 + 1.0 / 30.0));
+    CHECK(scheduler.MarkRendered(10.05) == doctest::Approx(0.05));
+
+    scheduler.SetTargetFrameRate(0);
+    CHECK(scheduler.IsRenderDue(10.05));
+}
+
+TEST_CASE("FrameScheduler advances animation time in fixed steps")
+{
+    colony::FrameScheduler scheduler;
+    scheduler.Reset(0.0);
+
+    const double step = colony::FrameScheduler::kAnimationStepSeconds;
+    CHECK(scheduler.AdvanceAnimation(step * 2.5, true) == 2);
+    CHECK(scheduler.AnimationTimeSeconds() == doctest::Approx(step * 2.0));
+    CHECK(scheduler.AdvanceAnimation(step * 3.0, true) == 1);
+
+    CHECK(scheduler.AdvanceAnimation(5.0, false) == 0);
+    CHECK(scheduler.AnimationTimeSeconds() == doctest::Approx(step * 3.0));
+
+    const int catchUpSteps = scheduler.AdvanceAnimation(10.0, true);
+    CHECK(catchUpSteps * step <= colony::FrameScheduler::kMaxCatchUpSeconds + step);
+}
@@ -0,0 +1,33 @@
+#include "core/hub_search_index.hpp"
+
+#include "doctest/doctest.h"
+
+#include <string>
+#include <vector>
+
+TEST_CASE("HubSearchIndex matches prefixes and substrings of every query token")
+{
+    colony::HubSearchIndex index;
+    index.Build({
+        "Creative Studio — Design, Paint",
+        "Dev Tools Terminal",
+        "Jeux / Games arcade",
+    });
+
+    CHECK(index.DocumentCount() == 3);
+    CHECK(index.Match({}) == std::vector<std::size_t>{0, 1, 2});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("stud")) == std::vector<std::size_t>{0});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("ool")) == std::vector<std::size_t>{1});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("SIGN")) == std::vector<std::size_t>{0});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("de")) == std::vector<std::size_t>{0, 1, 2});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("de term")) == std::vector<std::size_t>{1});
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("games paint")).empty());
+    CHECK(index.Match(colony::HubSearchIndex::Tokenize("zzz")).empty());
+}
+
+TEST_CASE("HubSearchIndex normalizes punctuation and case")
+{
+    CHECK(colony::HubSearchIndex::Normalize("  Hello,   World!! ") == "hello world");
+    CHECK(colony::HubSearchIndex::Tokenize("Dev-Tools  2") == std::vector<std::string>{"dev", "tools", "2"});
+    CHECK(colony::HubSearchIndex::Tokenize("  ").empty());
+}
@@ -0,0 +1,101 @@
+#include "core/launch_history.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+
+std::size_t CountLines(const std::filesystem::path& path)
+{
+    std::ifstream input{path};
+    std::size_t lines = 0;
+    for (std::string line; std::getline(input, line);)
+    {
+        ++lines;
+    }
+    return lines;
+}
+
+constexpr std::int64_t kDay = 24 * 60 * 60;
+constexpr std::int64_t kNow = 1'700'000'000;
+} // namespace
+
+TEST_CASE("LaunchHistory ranks by decayed launch frequency")
+{
+    colony::LaunchHistory history;
+    const std::uint64_t initialRevision = history.Revision();
+
+    history.RecordLaunch("old", kNow - 30 * kDay);
+    history.RecordLaunch("old", kNow - 30 * kDay + 60);
+    history.RecordLaunch("old", kNow - 29 * kDay);
+    history.RecordLaunch("recent", kNow);
+    CHECK(history.RankedProgramIds() == std::vector<std::string>{"recent", "old"});
+
+    // Two fresh launches outweigh one fresh launch.
+    history.RecordLaunch("busy", kNow - kDay);
+    history.RecordLaunch("busy", kNow - kDay + 5);
+    CHECK(history.RankedProgramIds() == std::vector<std::string>{"busy", "recent", "old"});
+
+    history.RecordSession("busy", 90);
+    history.RecordSession("unknown", 90);
+    history.RecordLaunch("", kNow);
+
+    const auto busy = history.Find("busy");
+    REQUIRE(busy.has_value());
+    CHECK(busy->launchCount == 2);
+    CHECK(busy->lastLaunchSeconds == kNow - kDay + 5);
+    CHECK(busy->totalDurationSeconds == 90);
+    CHECK_FALSE(history.Find("unknown").has_value());
+    CHECK(history.Revision() > initialRevision);
+}
+
+TEST_CASE("LaunchHistory replays and compacts its log")
+{
+    const auto path = GenerateUniqueTempPath("colony-launch-history");
+
+    {
+        colony::LaunchHistory history;
+        REQUIRE(history.Load(path));
+        history.RecordLaunch("Program With Spaces", kNow - kDay);
+        history.RecordSession("Program With Spaces", 42);
+        history.RecordLaunch("other", kNow);
+    }
+    CHECK(CountLines(path) == 3);
+
+    colony::LaunchHistory reloaded;
+    REQUIRE(reloaded.Load(path));
+    CHECK(reloaded.RankedProgramIds() == std::vector<std::string>{"other", "Program With Spaces"});
+    const auto stats = reloaded.Find("Program With Spaces");
+    REQUIRE(stats.has_value());
+    CHECK(stats->launchCount == 1);
+    CHECK(stats->totalDurationSeconds == 42);
+
+    for (int launch = 0; launch < 100; ++launch)
+    {
+        reloaded.RecordLaunch("other", kNow + launch);
+    }
+    CHECK(CountLines(path) < 64);
+
+    REQUIRE(reloaded.Compact());
+    CHECK(CountLines(path) == 2);
+
+    colony::LaunchHistory compacted;
+    REQUIRE(compacted.Load(path));
+    CHECK(compacted.RankedProgramIds() == reloaded.RankedProgramIds());
+    CHECK(compacted.Find("other")->launchCount == 101);
+    CHECK(compacted.Find("Program With Spaces")->totalDurationSeconds == 42);
+
+    // Two months on, a single launch outweighs a hundred stale ones.
+    compacted.RecordLaunch("Program With Spaces", kNow + 60 * kDay);
+    CHECK(compacted.RankedProgramIds().front() == "Program With Spaces");
+
+    std::filesystem::remove(path);
+}
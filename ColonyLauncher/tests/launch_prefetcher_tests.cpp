@@ -0,0 +1,102 @@
+#include "core/launch_prefetcher.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+#include <unistd.h>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+
+bool WaitUntilIdle(const colony::LaunchPrefetcher& prefetcher)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (!prefetcher.IsIdle())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("ResolveElfDependencies finds the loader and the libraries a binary needs")
+{
+    const auto dependencies = colony::ResolveElfDependencies("/proc/self/exe");
+    const auto hasLibrary = [&](std::string_view prefix) {
+        return std::any_of(dependencies.begin(), dependencies.end(), [&](const std::filesystem::path& path) {
+            return path.filename().string().rfind(prefix, 0) == 0 && std::filesystem::is_regular_file(path);
+        });
+    };
+    CHECK(hasLibrary("libc"));
+    CHECK(hasLibrary("libstdc++"));
+    CHECK(hasLibrary("ld-linux"));
+
+    const auto root = GenerateUniqueTempPath("colony-prefetch-elf");
+    std::filesystem::create_directories(root);
+    std::ofstream{root / "notes.txt"} << "not an executable";
+    CHECK(colony::ResolveElfDependencies(root / "notes.txt").empty());
+    CHECK(colony::ResolveElfDependencies(root / "missing").empty());
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("LaunchPrefetcher follows script interpreters and rate-limits repeats")
+{
+    const auto root = GenerateUniqueTempPath("colony-prefetch");
+    std::filesystem::create_directories(root);
+    const auto script = root / "tool.sh";
+    std::ofstream{script} << "#!/usr/bin/env sh\necho ready\n";
+
+    colony::LaunchPrefetcher prefetcher;
+    prefetcher.Prefetch("tool", {script});
+    prefetcher.Prefetch("tool", {script});
+    REQUIRE(WaitUntilIdle(prefetcher));
+
+    const auto stats = prefetcher.Stats();
+    CHECK(stats.requests == 2);
+    CHECK(stats.rateLimited == 1);
+    // The script, sh, and at least libc behind it.
+    CHECK(stats.fileHits + stats.fileMisses >= 3);
+    CHECK(stats.pageHits + stats.pageMisses >= 3);
+    CHECK(stats.bytesRequested <= stats.pageMisses * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE)));
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("LaunchPrefetcher prefetches again once the cooldown has passed")
+{
+    const auto root = GenerateUniqueTempPath("colony-prefetch-cooldown");
+    std::filesystem::create_directories(root);
+    const auto data = root / "data.bin";
+    std::ofstream{data} << std::string(64 * 1024, 'x');
+
+    colony::LaunchPrefetcher prefetcher{std::chrono::milliseconds{0}};
+    prefetcher.Prefetch("data", {data});
+    REQUIRE(WaitUntilIdle(prefetcher));
+    prefetcher.Prefetch("data", {data});
+    REQUIRE(WaitUntilIdle(prefetcher));
+
+    const auto stats = prefetcher.Stats();
+    CHECK(stats.rateLimited == 0);
+    CHECK(stats.fileHits + stats.fileMisses == 2);
+    // Just written, so the second pass at least finds it cached.
+    CHECK(stats.fileHits >= 1);
+
+    std::filesystem::remove_all(root);
+}
+
+#endif
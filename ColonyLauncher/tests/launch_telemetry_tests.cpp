@@ -0,0 +1,105 @@
+#include "core/launch_telemetry.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace
+{
+using namespace std::chrono_literals;
+
+using colony::test::GenerateUniqueTempPath;
+} // namespace
+
+TEST_CASE("LatencyHistogram answers quantiles with bucket upper bounds")
+{
+    colony::LatencyHistogram histogram;
+    CHECK_FALSE(histogram.Quantile(0.5).has_value());
+
+    histogram.Record(0ms);
+    histogram.Record(3ms);
+    histogram.Record(40ms);
+    histogram.Record(45ms);
+    histogram.Record(2min);
+
+    CHECK(histogram.Count() == 5);
+    CHECK(histogram.Quantile(0.0) == 1ms);
+    CHECK(histogram.Quantile(0.5) == 50ms);
+    CHECK(histogram.Quantile(0.9) == 60000ms);
+    CHECK(histogram.Buckets().back() == 1);
+}
+
+TEST_CASE("LaunchTelemetry counts only early exits, split by outcome")
+{
+    colony::LaunchTelemetry telemetry{10s};
+    telemetry.RecordExit("unknown", 1s, true);
+    CHECK(telemetry.Find("unknown") == nullptr);
+
+    telemetry.RecordSpawn("app", 12ms);
+    telemetry.RecordExit("app", 2s, true);
+    telemetry.RecordExit("app", 3s, false);
+    telemetry.RecordExit("app", 30s, true);
+
+    const auto* stats = telemetry.Find("app");
+    REQUIRE(stats != nullptr);
+    CHECK(stats->launches == 1);
+    CHECK(stats->crashes == 1);
+    CHECK(stats->quickExits == 1);
+}
+
+TEST_CASE("LaunchTelemetry round-trips through its file")
+{
+    const auto path = GenerateUniqueTempPath("colony-launch-telemetry");
+
+    colony::LaunchTelemetry telemetry;
+    telemetry.RecordSpawn("app", 12ms);
+    telemetry.RecordFirstWindow("app", 840ms);
+    telemetry.RecordSpawn("app", 8ms);
+    telemetry.RecordExit("app", 1s, true);
+    telemetry.RecordSpawn("other", 4ms);
+    REQUIRE(telemetry.Save(path));
+
+    colony::LaunchTelemetry reloaded;
+    REQUIRE(reloaded.Load(path));
+    REQUIRE(reloaded.Find("app") != nullptr);
+    CHECK(*reloaded.Find("app") == *telemetry.Find("app"));
+    CHECK_FALSE(reloaded.Find("app")->lastFirstWindowLatency.has_value());
+    REQUIRE(reloaded.Find("other") != nullptr);
+    CHECK(*reloaded.Find("other") == *telemetry.Find("other"));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("LaunchTelemetry ignores files it did not write")
+{
+    const auto path = GenerateUniqueTempPath("colony-launch-telemetry");
+    {
+        std::ofstream output{path};
+        output << "something else\n";
+    }
+
+    colony::LaunchTelemetry telemetry;
+    CHECK_FALSE(telemetry.Load(path));
+    CHECK(telemetry.Find("app") == nullptr);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FormatLaunchTelemetry shows the latest launch and crashes")
+{
+    colony::LaunchTelemetryStats stats;
+    CHECK(colony::FormatLaunchTelemetry(stats).empty());
+
+    stats.lastSpawnLatency = 12ms;
+    CHECK(colony::FormatLaunchTelemetry(stats) == "Start 12 ms");
+
+    stats.firstWindowLatency.Record(700ms);
+    stats.firstWindowLatency.Record(1500ms);
+    stats.lastFirstWindowLatency = 1500ms;
+    stats.crashes = 2;
+    CHECK(colony::FormatLaunchTelemetry(stats) == "Start 12 ms • Window 1.5 s (p50 1.0 s) • 2 crashes");
+}
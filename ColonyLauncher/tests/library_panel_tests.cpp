@@ -0,0 +1,97 @@
+#include "ui/panels/library_panel.hpp"
+
+#include "doctest/doctest.h"
+
+namespace
+{
+using colony::ui::panels::ComputeLibraryGridWindow;
+
+// 50 items in 4 columns: 13 rows of 100 px, the last holding 2 items, plus 20 px of padding.
+constexpr int kItems = 50;
+constexpr int kColumns = 4;
+constexpr int kRowStride = 100;
+constexpr int kViewport = 250;
+constexpr int kPadding = 20;
+constexpr int kMaxScroll = 13 * kRowStride + kPadding - kViewport;
+} // namespace
+
+TEST_CASE("ComputeLibraryGridWindow covers the rows the viewport touches")
+{
+    const auto top = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 0, kPadding);
+    CHECK(top.contentHeight == 1320);
+    CHECK(top.scrollOffset == 0);
+    CHECK(top.firstIndex == 0);
+    CHECK(top.lastIndex == 12);
+
+    // Rows cut off at either edge are still drawn.
+    const auto middle = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 150, kPadding);
+    CHECK(middle.scrollOffset == 150);
+    CHECK(middle.firstIndex == 4);
+    CHECK(middle.lastIndex == 20);
+
+    // The last row is partial; the window ends at the last item, not the row's end.
+    const auto bottom = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, kMaxScroll, kPadding);
+    CHECK(bottom.scrollOffset == kMaxScroll);
+    CHECK(bottom.firstIndex == 40);
+    CHECK(bottom.lastIndex == kItems);
+}
+
+TEST_CASE("ComputeLibraryGridWindow clamps the scroll offset to the content")
+{
+    const auto past = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 5000, kPadding);
+    CHECK(past.scrollOffset == kMaxScroll);
+    CHECK(past.lastIndex == kItems);
+
+    const auto before = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, -30, kPadding);
+    CHECK(before.scrollOffset == 0);
+    CHECK(before.firstIndex == 0);
+
+    // Content shorter than the viewport never scrolls and shows everything.
+    const auto tall = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, 2000, 300, kPadding);
+    CHECK(tall.scrollOffset == 0);
+    CHECK(tall.firstIndex == 0);
+    CHECK(tall.lastIndex == kItems);
+
+    // A single partial row.
+    const auto few = ComputeLibraryGridWindow(3, kColumns, kRowStride, kViewport, 40, kPadding);
+    CHECK(few.contentHeight == kRowStride + kPadding);
+    CHECK(few.scrollOffset == 0);
+    CHECK(few.firstIndex == 0);
+    CHECK(few.lastIndex == 3);
+}
+
+TEST_CASE("ComputeLibraryGridWindow scrolls just enough to reveal an item")
+{
+    // Item 45 sits in row 11; it ends up on the viewport's bottom edge.
+    const auto down = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 0, kPadding, 45);
+    CHECK(down.scrollOffset == 11 * kRowStride + kRowStride - kViewport);
+    CHECK(down.firstIndex <= 45);
+    CHECK(down.lastIndex > 45);
+
+    const auto up = ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, down.scrollOffset, kPadding, 2);
+    CHECK(up.scrollOffset == 0);
+
+    // Already visible, or out of range: the offset stays.
+    CHECK(ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 150, kPadding, 9).scrollOffset == 150);
+    CHECK(ComputeLibraryGridWindow(kItems, kColumns, kRowStride, kViewport, 150, kPadding, kItems).scrollOffset == 150);
+}
+
+TEST_CASE("ComputeLibraryGridWindow is empty without items or rows")
+{
+    for (const auto& window : {
+             ComputeLibraryGridWindow(0, kColumns, kRowStride, kViewport, 100, kPadding),
+             ComputeLibraryGridWindow(-1, kColumns, kRowStride, kViewport, 0, kPadding),
+             ComputeLibraryGridWindow(kItems, kColumns, 0, kViewport, 0, kPadding)})
+    {
+        CHECK(window.firstIndex == 0);
+        CHECK(window.lastIndex == 0);
+        CHECK(window.contentHeight == 0);
+        CHECK(window.scrollOffset == 0);
+    }
+
+    // Zero columns lay out as one.
+    const auto single = ComputeLibraryGridWindow(5, 0, kRowStride, kViewport, 0, 0);
+    CHECK(single.contentHeight == 5 * kRowStride);
+    CHECK(single.firstIndex == 0);
+    CHECK(single.lastIndex == 3);
+}
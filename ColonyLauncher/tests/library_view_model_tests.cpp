@@ -0,0 +1,91 @@
+#include "frontend/models/library_view_model.hpp"
+
+#include "doctest/doctest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+colony::AppContent MakeLibraryContent()
+{
+    colony::AppContent content;
+    content.channels.push_back(colony::Channel{"apps", "Apps", {"zeta", "alpha", "mid", "missing"}});
+    content.views["zeta"].heading = "Zeta Paint";
+    content.views["zeta"].tagline = "Draw things";
+    content.views["alpha"].heading = "alpha studio";
+    content.views["alpha"].tagline = "Edit video";
+    content.views["mid"].heading = "Middle";
+    content.views["mid"].tagline = "Paint and draw";
+    colony::MarkContentChanged(content);
+    return content;
+}
+
+std::vector<std::string> Ids(const std::vector<colony::frontend::models::LibraryProgramEntry>& entries)
+{
+    std::vector<std::string> ids;
+    for (const auto& entry : entries)
+    {
+        ids.push_back(entry.programId);
+    }
+    return ids;
+}
+} // namespace
+
+TEST_CASE("LibraryViewModel sorts, filters and tracks the selection")
+{
+    using colony::frontend::models::LibrarySortOption;
+
+    colony::AppContent content = MakeLibraryContent();
+    colony::frontend::models::LibraryViewModel model;
+    std::vector<int> selections{1};
+
+    const auto& entries = model.BuildProgramList(content, 0, selections);
+    CHECK(Ids(entries) == std::vector<std::string>{"zeta", "alpha", "mid"});
+    CHECK(entries[1].selected);
+    CHECK(&model.BuildProgramList(content, 0, selections) == &entries);
+
+    model.SetSortOption(LibrarySortOption::Alphabetical);
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"alpha", "mid", "zeta"});
+
+    model.SetFilter(" DRA ");
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid", "zeta"});
+    model.SetFilter("draw");
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid", "zeta"});
+    model.SetFilter("paint and");
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid"});
+    model.SetFilter("pa");
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid", "zeta"});
+
+    selections[0] = 0;
+    const auto& reselected = model.BuildProgramList(content, 0, selections);
+    CHECK(reselected[1].programId == "zeta");
+    CHECK(reselected[1].selected);
+
+    content.channels[0].programs.push_back("beta");
+    content.views["beta"].heading = "Beta Painter";
+    colony::MarkContentChanged(content);
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"beta", "mid", "zeta"});
+
+    CHECK(model.BuildProgramList(content, 3, selections).empty());
+}
+
+TEST_CASE("LibraryViewModel orders RecentlyPlayed by launch history")
+{
+    colony::AppContent content = MakeLibraryContent();
+    colony::LaunchHistory history;
+    colony::frontend::models::LibraryViewModel model;
+    model.SetLaunchHistory(&history);
+    std::vector<int> selections{0};
+
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"zeta", "alpha", "mid"});
+
+    history.RecordLaunch("mid", 1'700'000'000);
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid", "zeta", "alpha"});
+
+    history.RecordLaunch("alpha", 1'700'000'100);
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"alpha", "mid", "zeta"});
+
+    model.SetFilter("dra");
+    CHECK(Ids(model.BuildProgramList(content, 0, selections)) == std::vector<std::string>{"mid", "zeta"});
+}
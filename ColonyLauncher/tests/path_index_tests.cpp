@@ -0,0 +1,194 @@
+#include "core/path_index.hpp"
+#include "core/path_index_updater.hpp"
+
+#include "doctest/doctest.h"
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using colony::test::GenerateUniqueTempPath;
+using colony::test::WriteFile;
+
+const colony::PathIndexMatch* FindMatch(const std::vector<colony::PathIndexMatch>& matches, const std::filesystem::path& path)
+{
+    const auto it = std::find_if(matches.begin(), matches.end(), [&](const auto& match) { return match.path == path; });
+    return it != matches.end() ? &*it : nullptr;
+}
+} // namespace
+
+TEST_CASE("PathIndex ranks name matches and matches whole subtrees")
+{
+    const auto workspace = GenerateUniqueTempPath("colony-path-index");
+    const auto root = workspace / "root";
+    std::filesystem::create_directories(root / "Games" / "retro");
+    std::filesystem::create_directories(root / "tools");
+    WriteFile(root / "Games" / "retro" / "arcade.bin");
+    WriteFile(root / "tools" / "game");
+    WriteFile(root / "tools" / "endgame.sh");
+    WriteFile(root / "tools" / "notes.txt");
+
+    const auto indexFile = workspace / "index.bin";
+    REQUIRE(colony::PathIndex::Build(root, indexFile, nullptr, nullptr));
+
+    colony::PathIndex index;
+    REQUIRE(index.Open(indexFile));
+    CHECK(index.Root() == root);
+    CHECK(index.Size() == 7);
+
+    const auto matches = index.Search("game");
+    CHECK(matches.size() == 5);
+
+    const auto* exact = FindMatch(matches, root / "tools" / "game");
+    REQUIRE(exact != nullptr);
+    CHECK(exact->rank == colony::PathIndex::kRankExactName);
+    CHECK_FALSE(exact->isDirectory);
+
+    const auto* prefix = FindMatch(matches, root / "Games");
+    REQUIRE(prefix != nullptr);
+    CHECK(prefix->rank == colony::PathIndex::kRankNamePrefix);
+    CHECK(prefix->isDirectory);
+
+    const auto* contains = FindMatch(matches, root / "tools" / "endgame.sh");
+    REQUIRE(contains != nullptr);
+    CHECK(contains->rank == colony::PathIndex::kRankNameContains);
+
+    const auto* inside = FindMatch(matches, root / "Games" / "retro" / "arcade.bin");
+    REQUIRE(inside != nullptr);
+    CHECK(inside->rank == colony::PathIndex::kRankPathContains);
+    CHECK(FindMatch(matches, root / "tools" / "notes.txt") == nullptr);
+
+    const auto pathMatches = index.Search("retro/arc");
+    REQUIRE(pathMatches.size() == 1);
+    CHECK(pathMatches.front().path == root / "Games" / "retro" / "arcade.bin");
+
+    CHECK(index.Search("missing").empty());
+
+    std::filesystem::remove_all(workspace);
+}
+
+TEST_CASE("PathIndex rebuild picks up changed directories")
+{
+    const auto workspace = GenerateUniqueTempPath("colony-path-index");
+    const auto root = workspace / "root";
+    std::filesystem::create_directories(root / "stable");
+    std::filesystem::create_directories(root / "changing");
+    WriteFile(root / "stable" / "kept.sh");
+    WriteFile(root / "changing" / "old.sh");
+
+    const auto indexFile = workspace / "index.bin";
+    REQUIRE(colony::PathIndex::Build(root, indexFile, nullptr, nullptr));
+    colony::PathIndex previous;
+    REQUIRE(previous.Open(indexFile));
+
+    std::filesystem::remove(root / "changing" / "old.sh");
+    WriteFile(root / "changing" / "new.sh");
+    // Make the change visible even where directory mtimes are coarse.
+    std::filesystem::last_write_time(
+        root / "changing",
+        std::filesystem::last_write_time(root / "changing") + std::chrono::seconds{5});
+
+    REQUIRE(colony::PathIndex::Build(root, indexFile, &previous, nullptr));
+    colony::PathIndex rebuilt;
+    REQUIRE(rebuilt.Open(indexFile));
+
+    CHECK(rebuilt.Size() == 4);
+    CHECK(FindMatch(rebuilt.Search("kept"), root / "stable" / "kept.sh") != nullptr);
+    CHECK(FindMatch(rebuilt.Search("new"), root / "changing" / "new.sh") != nullptr);
+    CHECK(rebuilt.Search("old.sh").empty());
+
+    // The previous mapping stays valid after the file it came from was replaced.
+    CHECK(FindMatch(previous.Search("old"), root / "changing" / "old.sh") != nullptr);
+
+    std::filesystem::remove_all(workspace);
+}
+
+TEST_CASE("PathIndex refuses files it did not write")
+{
+    const auto workspace = GenerateUniqueTempPath("colony-path-index");
+    std::filesystem::create_directories(workspace);
+
+    colony::PathIndex index;
+    CHECK_FALSE(index.Open(workspace / "missing.bin"));
+
+    {
+        std::ofstream output{workspace / "garbage.bin", std::ios::binary};
+        output << std::string(256, 'x');
+    }
+    CHECK_FALSE(index.Open(workspace / "garbage.bin"));
+    CHECK(index.Search("x").empty());
+
+    std::filesystem::remove_all(workspace);
+}
+
+TEST_CASE("PathIndexUpdater rebuilds a stale index in the background")
+{
+    const auto workspace = GenerateUniqueTempPath("colony-path-index");
+    const auto root = workspace / "root";
+    std::filesystem::create_directories(root);
+    WriteFile(root / "launcher.sh");
+
+    colony::PathIndexUpdater updater;
+    updater.Load(workspace / "index.bin");
+    CHECK(updater.Current() == nullptr);
+
+    updater.RefreshIfStale(root, std::chrono::minutes{15});
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (updater.IsRefreshing() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    const auto index = updater.Current();
+    REQUIRE(index != nullptr);
+    CHECK(index->Root() == root);
+    CHECK(index->Search("launcher").size() == 1);
+
+    // Fresh enough: no second rebuild.
+    updater.RefreshIfStale(root, std::chrono::minutes{15});
+    CHECK_FALSE(updater.IsRefreshing());
+
+    std::filesystem::remove_all(workspace);
+}
+
+TEST_CASE("PathIndexUpdater rebuilds again once a cancelled worker has exited")
+{
+    const auto workspace = GenerateUniqueTempPath("colony-path-index");
+    const auto root = workspace / "root";
+    std::filesystem::create_directories(root);
+    WriteFile(root / "launcher.sh");
+
+    colony::PathIndexUpdater updater;
+    updater.Load(workspace / "index.bin");
+
+    const auto waitForWorker = [&updater]() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (updater.IsRefreshing() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        REQUIRE_FALSE(updater.IsRefreshing());
+    };
+
+    // Whether or not the worker got to finish, it exits before another rebuild may start.
+    updater.RefreshIfStale(root, std::chrono::seconds{0});
+    updater.Cancel();
+    waitForWorker();
+
+    updater.RefreshIfStale(root, std::chrono::seconds{0});
+    waitForWorker();
+    const auto index = updater.Current();
+    REQUIRE(index != nullptr);
+    CHECK(index->Search("launcher").size() == 1);
+    CHECK_FALSE(std::filesystem::exists(workspace / "index.bin.tmp"));
+
+    std::filesystem::remove_all(workspace);
+}
@@ -0,0 +1,164 @@
+#include "core/process_launcher.hpp"
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace
+{
+std::vector<colony::ProcessExit> WaitForExits(colony::ProcessLauncher& launcher, std::size_t count)
+{
+    std::vector<colony::ProcessExit> exits;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (exits.size() < count && std::chrono::steady_clock::now() < deadline)
+    {
+        for (auto& exit : launcher.TakeExits())
+        {
+            exits.push_back(std::move(exit));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    return exits;
+}
+} // namespace
+
+TEST_CASE("SplitCommandLine separates words and keeps quoted whitespace")
+{
+    CHECK(colony::SplitCommandLine("python3") == std::vector<std::string>{"python3"});
+    CHECK(colony::SplitCommandLine("  py   -3 ") == std::vector<std::string>{"py", "-3"});
+    CHECK(
+        colony::SplitCommandLine("\"C:\\Program Files\\Python\\python.exe\" -u")
+        == std::vector<std::string>{"C:\\Program Files\\Python\\python.exe", "-u"});
+    CHECK(colony::SplitCommandLine("a \"\" b") == std::vector<std::string>{"a", "", "b"});
+    CHECK(colony::SplitCommandLine("   ").empty());
+}
+
+#if !defined(_WIN32)
+
+TEST_CASE("ProcessLauncher reports exit codes, signals and runtimes")
+{
+    colony::ProcessLauncher launcher;
+    std::atomic<int> notifications{0};
+    launcher.SetNotify([&notifications]() { ++notifications; });
+
+    std::error_code ec;
+    const auto exited = launcher.Spawn({"sh", "-c", "sleep 0.1; exit 3"}, "exited", ec);
+    REQUIRE_FALSE(ec);
+    CHECK(exited > 0);
+    const auto killed = launcher.Spawn({"/bin/sh", "-c", "kill -TERM $$"}, "killed", ec);
+    REQUIRE_FALSE(ec);
+    CHECK(launcher.RunningCount() >= 1);
+
+    const auto exits = WaitForExits(launcher, 2);
+    REQUIRE(exits.size() == 2);
+    CHECK(notifications.load() >= 1);
+    CHECK(launcher.RunningCount() == 0);
+
+    for (const auto& exit : exits)
+    {
+        CHECK(exit.statusKnown);
+        if (exit.tag == "exited")
+        {
+            CHECK(exit.pid == exited);
+            CHECK(exit.exitCode == 3);
+            CHECK(exit.signal == 0);
+            CHECK(exit.runtime >= std::chrono::milliseconds{100});
+        }
+        else
+        {
+            CHECK(exit.tag == "killed");
+            CHECK(exit.pid == killed);
+            CHECK(exit.signal == SIGTERM);
+        }
+    }
+}
+
+TEST_CASE("ProcessLauncher passes arguments verbatim without a shell")
+{
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    launcher.Spawn({"sh", "-c", "test \"$1\" = 'two words; $HOME'", "sh", "two words; $HOME"}, "args", ec);
+    REQUIRE_FALSE(ec);
+
+    const auto exits = WaitForExits(launcher, 1);
+    REQUIRE(exits.size() == 1);
+    CHECK(exits.front().exitCode == 0);
+}
+
+TEST_CASE("ProcessLauncher children inherit only stdio")
+{
+    // A pipe opened without O_CLOEXEC, like one a library might leave behind.
+    int leaked[2]{-1, -1};
+    REQUIRE(pipe(leaked) == 0);
+
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    const std::string descriptor = std::to_string(leaked[1]);
+    launcher.Spawn({"sh", "-c", "exec 2>/dev/null; : >&" + descriptor}, "descriptors", ec);
+    REQUIRE_FALSE(ec);
+
+    const auto exits = WaitForExits(launcher, 1);
+    close(leaked[0]);
+    close(leaked[1]);
+    REQUIRE(exits.size() == 1);
+    CHECK(exits.front().exitCode != 0);
+}
+
+TEST_CASE("ProcessLauncher fails synchronously for programs that cannot start")
+{
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    CHECK(launcher.Spawn({"colony-no-such-program-7f3a"}, "missing", ec) == 0);
+    CHECK(ec);
+
+    CHECK(launcher.Spawn({}, "empty", ec) == 0);
+    CHECK(ec == std::errc::invalid_argument);
+    CHECK(launcher.RunningCount() == 0);
+}
+
+TEST_CASE("ProcessLauncher drops exits after Stop and leaves children running")
+{
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    launcher.Spawn({"sh", "-c", "sleep 0.2"}, "late", ec);
+    REQUIRE_FALSE(ec);
+    launcher.Stop();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{300});
+    CHECK(launcher.TakeExits().empty());
+}
+
+#if defined(__linux__)
+TEST_CASE("ProcessTree finds the descendants of a launched process")
+{
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    const auto pid = launcher.Spawn({"sh", "-c", "sleep 1 & sleep 1 & wait"}, "tree", ec);
+    REQUIRE_FALSE(ec);
+
+    std::vector<std::int64_t> tree;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (tree.size() < 3 && std::chrono::steady_clock::now() < deadline)
+    {
+        tree = colony::ProcessTree(pid);
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    REQUIRE(tree.size() == 3);
+    CHECK(tree.front() == pid);
+
+    CHECK(WaitForExits(launcher, 1).size() == 1);
+    CHECK(colony::ProcessTree(pid) == std::vector<std::int64_t>{pid});
+}
+#endif
+
+#endif
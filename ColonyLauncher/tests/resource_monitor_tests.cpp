@@ -0,0 +1,168 @@
+#include "core/resource_monitor.hpp"
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include "core/process_launcher.hpp"
+
+#include <csignal>
+#endif
+
+TEST_CASE("ParseProcessStat reads CPU ticks, threads and start time past odd command names")
+{
+    const std::string line = "4242 (my (odd) app) S 1 4242 4242 0 -1 4194560 1200 0 3 0 "
+                             "150 25 0 0 20 0 7 0 98765 123456789 2048 18446744073709551615";
+    const auto stat = colony::ParseProcessStat(line);
+    REQUIRE(stat.has_value());
+    CHECK(stat->cpuTicks == 175);
+    CHECK(stat->threads == 7);
+    CHECK(stat->startTime == 98765);
+
+    CHECK_FALSE(colony::ParseProcessStat("").has_value());
+    CHECK_FALSE(colony::ParseProcessStat("4242 (app) S 1 2 3").has_value());
+    CHECK_FALSE(colony::ParseProcessStat("4242 (app) S 1 2 3 4 5 6 7 8 9 10 x 12 13 14 15 16 17 18 19 20").has_value());
+}
+
+TEST_CASE("FormatResourceUsage keeps small values precise and large ones short")
+{
+    colony::ResourceUsage usage;
+    usage.processes = 1;
+    usage.cpuPercent = 2.345;
+    usage.residentBytes = 340ull * 1024 * 1024;
+    usage.threads = 1;
+    CHECK(colony::FormatResourceUsage(usage) == "CPU 2.3% • 340 MB • 1 thread");
+
+    usage.processes = 3;
+    usage.cpuPercent = 142.6;
+    usage.residentBytes = 3ull * 1024 * 1024 * 1024 / 2;
+    usage.threads = 18;
+    CHECK(colony::FormatResourceUsage(usage) == "CPU 143% • 1.5 GB • 18 threads • 3 processes");
+}
+
+#if defined(__linux__)
+TEST_CASE("ResourceMonitor samples a busy launched process once per tick")
+{
+    using namespace std::chrono_literals;
+
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    const auto pid = launcher.Spawn({"sh", "-c", "while :; do :; done"}, "busy", ec);
+    REQUIRE_FALSE(ec);
+
+    colony::ResourceMonitor monitor{50ms};
+    std::atomic<int> notifications{0};
+    monitor.SetNotify([&notifications]() { ++notifications; });
+    monitor.Watch(pid, "busy");
+
+    // The first tick only sets the CPU baseline.
+    std::vector<colony::ResourceUsage> usage;
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        usage = monitor.TakeUsage();
+        if (!usage.empty() && usage.front().cpuPercent > 0.0)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+
+    REQUIRE(usage.size() == 1);
+    CHECK(usage.front().tag == "busy");
+    CHECK(usage.front().processes >= 1);
+    CHECK(usage.front().threads >= 1);
+    CHECK(usage.front().residentBytes > 0);
+    CHECK(usage.front().cpuPercent > 0.0);
+    CHECK(notifications.load() >= 2);
+
+    ::kill(static_cast<pid_t>(pid), SIGKILL);
+    monitor.Forget(pid);
+    CHECK(monitor.TakeUsage().empty());
+    std::this_thread::sleep_for(150ms);
+    CHECK(monitor.TakeUsage().empty());
+    monitor.Stop();
+    launcher.Stop();
+}
+
+TEST_CASE("ResourceMonitor applies a new interval without waiting out the old one")
+{
+    using namespace std::chrono_literals;
+
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    const auto pid = launcher.Spawn({"sleep", "10"}, "idle", ec);
+    REQUIRE_FALSE(ec);
+
+    colony::ResourceMonitor monitor{1h};
+    std::atomic<int> notifications{0};
+    monitor.SetNotify([&notifications]() { ++notifications; });
+    monitor.Watch(pid, "idle");
+
+    const auto waitForNotifications = [&notifications](int count) {
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (notifications.load() < count && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(5ms);
+        }
+        return notifications.load() >= count;
+    };
+
+    // The first tick runs at once; the next would be an hour away.
+    REQUIRE(waitForNotifications(1));
+    monitor.SetInterval(20ms);
+    CHECK(waitForNotifications(3));
+
+    ::kill(static_cast<pid_t>(pid), SIGKILL);
+    monitor.Stop();
+    launcher.Stop();
+}
+
+TEST_CASE("ResourceMonitor keeps a tag's usage while another instance runs")
+{
+    using namespace std::chrono_literals;
+
+    colony::ProcessLauncher launcher;
+    std::error_code ec;
+    const auto first = launcher.Spawn({"sleep", "10"}, "twin", ec);
+    REQUIRE_FALSE(ec);
+    const auto second = launcher.Spawn({"sleep", "10"}, "twin", ec);
+    REQUIRE_FALSE(ec);
+
+    colony::ResourceMonitor monitor{20ms};
+    monitor.Watch(first, "twin");
+    monitor.Watch(second, "twin");
+
+    const auto waitForProcesses = [&monitor](std::size_t processes) {
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            const auto usage = monitor.TakeUsage();
+            if (usage.size() == 1 && usage.front().processes == processes)
+            {
+                return true;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        return false;
+    };
+
+    REQUIRE(waitForProcesses(2));
+    ::kill(static_cast<pid_t>(first), SIGKILL);
+    CHECK(monitor.Forget(first));
+    CHECK(waitForProcesses(1));
+
+    ::kill(static_cast<pid_t>(second), SIGKILL);
+    CHECK_FALSE(monitor.Forget(second));
+    CHECK(monitor.TakeUsage().empty());
+    CHECK_FALSE(monitor.Forget(second));
+    monitor.Stop();
+    launcher.Stop();
+}
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace colony::test
+{
+
+// A path under the temp directory that does not exist yet; callers create and remove it.
+inline std::filesystem::path GenerateUniqueTempPath(std::string_view prefix)
+{
+    const auto tempDir = std::filesystem::temp_directory_path();
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::uniform_int_distribution<std::uint64_t> dist;
+
+    for (int attempt = 0; attempt < 8; ++attempt)
+    {
+        std::filesystem::path candidate = tempDir / (std::string{prefix} + "-" + std::to_string(dist(gen)));
+        if (!std::filesystem::exists(candidate))
+        {
+            return candidate;
+        }
+    }
+
+    throw std::runtime_error("unable to find unique temp path");
+}
+
+// A small shell script; its parent directory must exist.
+inline void WriteFile(const std::filesystem::path& path)
+{
+    std::ofstream output{path};
+    REQUIRE(output.is_open());
+    output << "echo run";
+}
+
+inline std::filesystem::path WriteExecutableFile(const std::filesystem::path& path)
+{
+    WriteFile(path);
+    std::filesystem::permissions(
+        path,
+        std::filesystem::perms::owner_exec | std::filesystem::perms::owner_write | std::filesystem::perms::owner_read,
+        std::filesystem::perm_options::add);
+    return path;
+}
+
+} // namespace colony::test